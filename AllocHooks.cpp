@@ -0,0 +1,68 @@
+/***************************************************************************************
+ * AllocHooks.cpp
+ * Replacement global operator new/delete that feed AllocStats. Link this object into a
+ * binary to make its allocations countable (see AllocStats.hpp); it is deliberately not
+ * part of CORE_OBJ.
+ *
+ * STANDARD LIBRARIES USED:
+ *  <cstdlib> : malloc / aligned_alloc / free
+ *  <new>     : operator new signatures, std::bad_alloc
+ ****************************************************************************************/
+#include "AllocStats.hpp"
+
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+void* allocate(std::size_t n) {
+    if (n == 0) n = 1;
+    void* p = std::malloc(n);
+    if (!p) throw std::bad_alloc();
+    sb::AllocStats::recordAlloc(n);
+    return p;
+}
+
+void* allocateAligned(std::size_t n, std::align_val_t al) {
+    std::size_t a = static_cast<std::size_t>(al);
+    if (a < sizeof(void*)) a = sizeof(void*);
+    std::size_t rounded = (n + a - 1) / a * a; // aligned_alloc wants a multiple
+    void* p = std::aligned_alloc(a, rounded ? rounded : a);
+    if (!p) throw std::bad_alloc();
+    sb::AllocStats::recordAlloc(n);
+    return p;
+}
+
+void release(void* p) {
+    if (!p) return;
+    sb::AllocStats::recordFree();
+    std::free(p);
+}
+
+struct MarkHooked {
+    MarkHooked() { sb::AllocStats::markHooked(); }
+} markHooked;
+
+} // namespace
+
+void* operator new(std::size_t n) { return allocate(n); }
+void* operator new[](std::size_t n) { return allocate(n); }
+void* operator new(std::size_t n, const std::nothrow_t&) noexcept {
+    try { return allocate(n); } catch (...) { return nullptr; }
+}
+void* operator new[](std::size_t n, const std::nothrow_t&) noexcept {
+    try { return allocate(n); } catch (...) { return nullptr; }
+}
+void* operator new(std::size_t n, std::align_val_t al) { return allocateAligned(n, al); }
+void* operator new[](std::size_t n, std::align_val_t al) { return allocateAligned(n, al); }
+
+void operator delete(void* p) noexcept { release(p); }
+void operator delete[](void* p) noexcept { release(p); }
+void operator delete(void* p, std::size_t) noexcept { release(p); }
+void operator delete[](void* p, std::size_t) noexcept { release(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { release(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { release(p); }
+void operator delete(void* p, std::align_val_t) noexcept { release(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { release(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { release(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { release(p); }
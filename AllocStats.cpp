@@ -0,0 +1,141 @@
+/***************************************************************************************
+ * AllocStats.cpp — implementation
+ ****************************************************************************************/
+#include "AllocStats.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <mutex>
+
+namespace sb {
+
+std::atomic<bool> AllocStats::enabled_{false};
+
+namespace {
+
+std::atomic<bool> gHooked{false};
+std::atomic<std::size_t> gAllocs{0};
+std::atomic<std::size_t> gFrees{0};
+std::atomic<std::size_t> gBytes{0};
+
+// Fixed-size table so recording a finished scope never allocates (it runs inside
+// the accounting itself). Operations beyond kMaxOps are folded into the last row.
+constexpr std::size_t kMaxOps = 64;
+struct OpRow {
+    const char* name = nullptr;
+    std::size_t calls = 0, allocs = 0, bytes = 0;
+};
+std::mutex gOpsMu;
+OpRow gOps[kMaxOps];
+std::size_t gOpCount = 0;
+
+thread_local AllocScope::Counter* tlsCurrent = nullptr;
+
+void addToOp(const char* op, std::size_t allocs, std::size_t bytes) {
+    std::lock_guard<std::mutex> lk(gOpsMu);
+    std::size_t i = 0;
+    while (i < gOpCount && gOps[i].name != op && std::strcmp(gOps[i].name, op) != 0) ++i;
+    if (i == gOpCount) {
+        if (gOpCount == kMaxOps) i = kMaxOps - 1;
+        else gOps[gOpCount++].name = op;
+    }
+    gOps[i].calls += 1;
+    gOps[i].allocs += allocs;
+    gOps[i].bytes += bytes;
+}
+
+} // namespace
+
+void AllocStats::enable(bool on) { enabled_.store(on, std::memory_order_relaxed); }
+bool AllocStats::hooked() { return gHooked.load(std::memory_order_relaxed); }
+void AllocStats::markHooked() { gHooked.store(true, std::memory_order_relaxed); }
+
+void AllocStats::recordAlloc(std::size_t bytes) {
+    if (!enabled()) return;
+    gAllocs.fetch_add(1, std::memory_order_relaxed);
+    gBytes.fetch_add(bytes, std::memory_order_relaxed);
+    if (AllocScope::Counter* c = tlsCurrent) {
+        c->allocs.fetch_add(1, std::memory_order_relaxed);
+        c->bytes.fetch_add(bytes, std::memory_order_relaxed);
+    }
+}
+
+void AllocStats::recordFree() {
+    if (!enabled()) return;
+    gFrees.fetch_add(1, std::memory_order_relaxed);
+}
+
+std::vector<AllocStats::OpStats> AllocStats::report() {
+    OpRow copy[kMaxOps];
+    std::size_t n;
+    {
+        std::lock_guard<std::mutex> lk(gOpsMu);
+        n = gOpCount;
+        std::copy(gOps, gOps + n, copy);
+    }
+    std::vector<OpStats> out;
+    out.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        out.push_back(OpStats{copy[i].name, copy[i].calls, copy[i].allocs, copy[i].bytes});
+    }
+    return out;
+}
+
+AllocStats::Totals AllocStats::totals() {
+    return Totals{gAllocs.load(std::memory_order_relaxed), gFrees.load(std::memory_order_relaxed),
+                  gBytes.load(std::memory_order_relaxed)};
+}
+
+void AllocStats::reset() {
+    std::lock_guard<std::mutex> lk(gOpsMu);
+    for (std::size_t i = 0; i < gOpCount; ++i) gOps[i] = OpRow{};
+    gOpCount = 0;
+    gAllocs = 0;
+    gFrees = 0;
+    gBytes = 0;
+}
+
+void AllocStats::print(std::ostream& os) {
+    if (!hooked()) {
+        os << "(allocation accounting not linked into this binary)\n";
+        return;
+    }
+    auto rows = report();
+    auto t = totals();
+    std::ios::fmtflags flags = os.flags();
+    os << std::left << std::setw(20) << "operation" << std::right << std::setw(10) << "calls"
+       << std::setw(14) << "allocs/call" << std::setw(14) << "bytes/call" << "\n";
+    os << std::fixed << std::setprecision(1);
+    for (const auto& r : rows) {
+        os << std::left << std::setw(20) << r.name << std::right << std::setw(10) << r.calls
+           << std::setw(14) << r.allocsPerCall() << std::setw(14) << r.bytesPerCall() << "\n";
+    }
+    os << "total: " << t.allocs << " allocations, " << t.frees << " frees, " << t.bytes << " bytes\n";
+    os.flags(flags);
+}
+
+AllocScope::AllocScope(const char* op) : op_(op), active_(AllocStats::enabled()) {
+    if (!active_) return;
+    counter_.parent = tlsCurrent;
+    tlsCurrent = &counter_;
+}
+
+AllocScope::~AllocScope() {
+    if (!active_) return;
+    tlsCurrent = counter_.parent;
+    std::size_t allocs = counter_.allocs.load(std::memory_order_relaxed);
+    std::size_t bytes = counter_.bytes.load(std::memory_order_relaxed);
+    if (Counter* p = counter_.parent) {
+        p->allocs.fetch_add(allocs, std::memory_order_relaxed);
+        p->bytes.fetch_add(bytes, std::memory_order_relaxed);
+    }
+    addToOp(op_, allocs, bytes);
+}
+
+AllocScope::Counter* AllocScope::current() { return tlsCurrent; }
+
+AllocScope::Attach::Attach(Counter* c) : saved_(tlsCurrent) { tlsCurrent = c; }
+AllocScope::Attach::~Attach() { tlsCurrent = saved_; }
+
+} // namespace sb
@@ -0,0 +1,113 @@
+/***************************************************************************************
+ * AllocStats.hpp
+ * Opt-in heap allocation accounting, attributed to named operations.
+ *
+ * AllocHooks.cpp replaces the global operator new/delete with versions that report every
+ * allocation here. Binaries opt in by linking AllocHooks.o ($(ALLOC_HOOK_OBJ) in the
+ * Makefile; the other binaries keep the standard allocator) and counting only happens
+ * after AllocStats::enable(true), so a hooked binary without --stats pays one relaxed
+ * load per allocation.
+ *
+ * Operations mark themselves with an AllocScope:
+ *
+ *     AllocScope scope("suggest");
+ *
+ * Every allocation the thread makes while the scope is alive is charged to "suggest"
+ * (nested scopes are also charged to their parent, i.e. counts are inclusive).
+ * parallelCollectAbove carries the caller's scope onto pool workers, so parallel chunks
+ * of an operation are charged to it as well. report() returns calls, allocations and
+ * bytes per operation name.
+ *
+ * STANDARD LIBRARIES USED:
+ *  <atomic>   : counters shared with hooks and pool workers
+ *  <cstddef>  : size_t
+ *  <ostream>  : printed report
+ *  <string>   : operation names in reports
+ *  <vector>   : report rows
+ ****************************************************************************************/
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace sb {
+
+class AllocStats {
+public:
+    struct OpStats {
+        std::string name;
+        std::size_t calls = 0;
+        std::size_t allocs = 0;
+        std::size_t bytes = 0;
+        double allocsPerCall() const { return calls ? double(allocs) / double(calls) : 0.0; }
+        double bytesPerCall() const { return calls ? double(bytes) / double(calls) : 0.0; }
+    };
+
+    struct Totals {
+        std::size_t allocs = 0;
+        std::size_t frees = 0;
+        std::size_t bytes = 0;
+    };
+
+    // Start/stop counting (off by default).
+    static void enable(bool on);
+    static bool enabled() { return enabled_.load(std::memory_order_relaxed); }
+
+    // True when AllocHooks.o is linked in, i.e. counts can be non-zero.
+    static bool hooked();
+
+    // Per-operation rows in first-seen order, and process-wide totals while enabled.
+    static std::vector<OpStats> report();
+    static Totals totals();
+    static void reset();
+
+    // "op  calls  allocs/call  bytes/call" table (plus totals).
+    static void print(std::ostream& os);
+
+    // Called by AllocHooks.cpp only.
+    static void recordAlloc(std::size_t bytes);
+    static void recordFree();
+    static void markHooked();
+
+private:
+    static std::atomic<bool> enabled_;
+};
+
+class AllocScope {
+public:
+    // Running counts of one scope; updated from the owning thread and pool workers.
+    struct Counter {
+        std::atomic<std::size_t> allocs{0};
+        std::atomic<std::size_t> bytes{0};
+        Counter* parent = nullptr;
+    };
+
+    // 'op' must be a string literal (or otherwise outlive the process's reports).
+    explicit AllocScope(const char* op);
+    ~AllocScope();
+    AllocScope(const AllocScope&) = delete;
+    AllocScope& operator=(const AllocScope&) = delete;
+
+    // Scope the current thread is charging to (nullptr outside any scope).
+    static Counter* current();
+
+    // Charge this thread's allocations to 'c' (another thread's scope) until destroyed.
+    class Attach {
+    public:
+        explicit Attach(Counter* c);
+        ~Attach();
+        Attach(const Attach&) = delete;
+        Attach& operator=(const Attach&) = delete;
+    private:
+        Counter* saved_;
+    };
+
+private:
+    const char* op_;
+    bool active_;
+    Counter counter_;
+};
+
+} // namespace sb
@@ -0,0 +1,267 @@
+/***************************************************************************************
+ * Autocomplete.cpp — implementation
+ ****************************************************************************************/
+#include "Autocomplete.hpp"
+#include "Metrics.hpp"
+#include "StringPool.hpp"
+#include "Utils.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <utility>
+
+namespace sb {
+
+/* -------------------------------- PrefixIndex -------------------------------- */
+
+PrefixIndex::PrefixIndex() { nodes_.emplace_back(); }
+
+std::string PrefixIndex::normalize(std::string_view text) {
+    std::string out;
+    out.reserve(text.size());
+    bool space = false;
+    for (char ch : text) {
+        unsigned char c = static_cast<unsigned char>(ch);
+        if (std::isspace(c)) { space = !out.empty(); continue; }
+        if (space) { out.push_back(' '); space = false; }
+        out.push_back(static_cast<char>(std::tolower(c)));
+    }
+    return out;
+}
+
+bool PrefixIndex::better(std::uint32_t a, std::uint32_t b) const {
+    const Entry& x = entries_[a];
+    const Entry& y = entries_[b];
+    if (x.count != y.count) return x.count > y.count;
+    return x.key < y.key;
+}
+
+std::size_t PrefixIndex::childSlot(const Node& n, unsigned char c) const {
+    auto it = std::lower_bound(n.kids.begin(), n.kids.end(), c, [&](std::uint32_t kid, unsigned char v) {
+        return static_cast<unsigned char>(nodes_[kid].label[0]) < v;
+    });
+    return static_cast<std::size_t>(it - n.kids.begin());
+}
+
+std::uint32_t PrefixIndex::locate(std::string_view prefix) const {
+    std::uint32_t node = 0;
+    while (!prefix.empty()) {
+        const Node& n = nodes_[node];
+        unsigned char c = static_cast<unsigned char>(prefix[0]);
+        std::size_t slot = childSlot(n, c);
+        if (slot == n.kids.size()) return kNone;
+        std::uint32_t kid = n.kids[slot];
+        std::string_view label = nodes_[kid].label;
+        if (static_cast<unsigned char>(label[0]) != c) return kNone;
+        if (prefix.size() <= label.size()) {
+            // The prefix ends inside (or at the end of) this edge.
+            return label.compare(0, prefix.size(), prefix) == 0 ? kid : kNone;
+        }
+        if (prefix.compare(0, label.size(), label) != 0) return kNone;
+        prefix.remove_prefix(label.size());
+        node = kid;
+    }
+    return node;
+}
+
+std::uint32_t PrefixIndex::insertPath(std::string_view key) {
+    path_.clear();
+    path_.push_back(0);
+    std::uint32_t node = 0;
+    while (!key.empty()) {
+        unsigned char c = static_cast<unsigned char>(key[0]);
+        std::size_t slot = childSlot(nodes_[node], c);
+        bool found = slot < nodes_[node].kids.size() &&
+                     static_cast<unsigned char>(nodes_[nodes_[node].kids[slot]].label[0]) == c;
+        if (!found) {
+            // New leaf holding the rest of the key.
+            auto leaf = static_cast<std::uint32_t>(nodes_.size());
+            nodes_.emplace_back();
+            nodes_[leaf].label = key;
+            auto& kids = nodes_[node].kids;
+            kids.insert(kids.begin() + static_cast<std::ptrdiff_t>(slot), leaf);
+            path_.push_back(leaf);
+            return leaf;
+        }
+        std::uint32_t kid = nodes_[node].kids[slot];
+        std::string_view label = nodes_[kid].label;
+        std::size_t common = 0;
+        std::size_t limit = std::min(label.size(), key.size());
+        while (common < limit && label[common] == key[common]) ++common;
+        if (common < label.size()) {
+            // Split the edge: node → mid(label[0, common)) → kid(label[common, end)).
+            auto mid = static_cast<std::uint32_t>(nodes_.size());
+            nodes_.emplace_back();
+            Node& m = nodes_[mid];
+            m.label = label.substr(0, common);
+            m.kids.push_back(kid);
+            m.top = nodes_[kid].top;
+            m.topCount = nodes_[kid].topCount;
+            nodes_[kid].label = label.substr(common);
+            nodes_[node].kids[slot] = mid;
+            kid = mid;
+        }
+        path_.push_back(kid);
+        key.remove_prefix(common);
+        node = kid;
+    }
+    return node;
+}
+
+void PrefixIndex::rerank(std::uint32_t node) {
+    Node& n = nodes_[node];
+    scratch_.clear();
+    if (n.entry != kNone && entries_[n.entry].count > 0) scratch_.push_back(n.entry);
+    for (std::uint32_t kid : n.kids) {
+        const Node& k = nodes_[kid];
+        scratch_.insert(scratch_.end(), k.top.begin(), k.top.begin() + k.topCount);
+    }
+    auto cmp = [this](std::uint32_t a, std::uint32_t b) { return better(a, b); };
+    std::size_t keep = std::min(scratch_.size(), kMaxCompletions);
+    std::partial_sort(scratch_.begin(), scratch_.begin() + static_cast<std::ptrdiff_t>(keep),
+                      scratch_.end(), cmp);
+    std::copy(scratch_.begin(), scratch_.begin() + static_cast<std::ptrdiff_t>(keep), n.top.begin());
+    n.topCount = static_cast<std::uint32_t>(keep);
+}
+
+bool PrefixIndex::refresh(std::uint32_t node, std::uint32_t id, bool increased) {
+    Node& n = nodes_[node];
+    std::uint32_t* begin = n.top.data();
+    std::uint32_t* end = begin + n.topCount;
+    std::uint32_t* at = std::find(begin, end, id);
+    if (!increased) {
+        // Only a list that held the entry can change; refill it from the children.
+        if (at == end) return false;
+        rerank(node);
+        return true;
+    }
+    if (at == end) {
+        if (n.topCount < kMaxCompletions) {
+            ++n.topCount;
+        } else if (better(id, end[-1])) {
+            --end;
+        } else {
+            // Not among this subtree's best, so not among any ancestor's either.
+            return false;
+        }
+        at = end;
+        *at = id;
+    }
+    // Bubble the entry up to its new rank.
+    while (at != begin && better(id, at[-1])) {
+        *at = at[-1];
+        --at;
+    }
+    *at = id;
+    return true;
+}
+
+void PrefixIndex::adjust(std::string_view text, int delta) {
+    std::string key = normalize(text);
+    if (key.empty() || delta == 0) return;
+
+    std::uint32_t id;
+    if (const std::uint32_t* found = byKey_.find(std::string_view(key))) {
+        id = *found;
+    } else {
+        if (delta < 0) return;
+        id = static_cast<std::uint32_t>(entries_.size());
+        std::string_view stored = pool_->intern(key);
+        entries_.push_back(Entry{stored, pool_->intern(trimView(text)), 0});
+        byKey_.tryEmplace(stored, id);
+    }
+
+    Entry& e = entries_[id];
+    std::uint32_t before = e.count;
+    long long next = static_cast<long long>(before) + delta;
+    e.count = next < 0 ? 0u : static_cast<std::uint32_t>(next);
+    if (e.count == before) return;
+    if (before == 0) ++live_;
+    if (e.count == 0) --live_;
+
+    bool increased = e.count > before;
+    std::uint32_t terminal = insertPath(e.key);
+    nodes_[terminal].entry = id;
+    // Bottom-up; a node whose cached list is unaffected leaves every ancestor unaffected.
+    for (auto it = path_.rbegin(); it != path_.rend(); ++it) {
+        if (!refresh(*it, id, increased)) break;
+    }
+    // Renames leave dead keys behind; rebuild once they outnumber the live ones.
+    if (!increased && entries_.size() > 1024 && entries_.size() > 2 * live_) compact();
+}
+
+void PrefixIndex::compact() {
+    std::vector<std::pair<std::string, std::uint32_t>> keep; // display text, count
+    keep.reserve(live_);
+    for (const Entry& e : entries_) {
+        if (e.count > 0) keep.emplace_back(std::string(e.display), e.count);
+    }
+    byKey_.clear(); // its keys point into the old pool
+    entries_.clear();
+    nodes_.assign(1, Node{});
+    pool_ = std::make_unique<StringPool>();
+    live_ = 0;
+    for (const auto& [text, count] : keep) adjust(text, static_cast<int>(count));
+}
+
+std::vector<Completion> PrefixIndex::complete(std::string_view prefix, std::size_t n) const {
+    std::vector<Completion> out;
+    std::uint32_t node = locate(normalize(prefix));
+    if (node == kNone) return out;
+    const Node& at = nodes_[node];
+    std::size_t k = std::min<std::size_t>(n, at.topCount);
+    out.reserve(k);
+    for (std::size_t i = 0; i < k; ++i) {
+        const Entry& e = entries_[at.top[i]];
+        out.push_back(Completion{e.display, e.count});
+    }
+    return out;
+}
+
+std::uint32_t PrefixIndex::count(std::string_view text) const {
+    std::string key = normalize(text);
+    const std::uint32_t* id = byKey_.find(std::string_view(key));
+    return id ? entries_[*id].count : 0;
+}
+
+/* -------------------------------- Autocomplete -------------------------------- */
+
+Autocomplete::Autocomplete(const std::vector<Profile>& roster) {
+    byId_.reserve(roster.size());
+    for (std::size_t i = 0; i < roster.size(); ++i) update(i, roster[i]);
+}
+
+std::vector<Completion> Autocomplete::courses(std::string_view prefix, std::size_t n) const {
+    ApiTimer timer(Api::Autocomplete);
+    return courses_.complete(prefix, n);
+}
+
+std::vector<Completion> Autocomplete::names(std::string_view prefix, std::size_t n) const {
+    ApiTimer timer(Api::Autocomplete);
+    return names_.complete(prefix, n);
+}
+
+void Autocomplete::update(std::size_t id, const Profile& p) {
+    if (id >= byId_.size()) byId_.resize(id + 1);
+    Seen& old = byId_[id];
+
+    Seen now;
+    if (p.exists()) {
+        now.name = std::string(p.name());
+        now.courses = p.courses();
+    }
+
+    if (now.name != old.name) {
+        if (!old.name.empty()) names_.adjust(old.name, -1);
+        if (!now.name.empty()) names_.adjust(now.name, +1);
+    }
+    // Course lists are a handful of entries: a quadratic diff beats building sets.
+    auto has = [](const std::vector<std::string>& list, const std::string& c) {
+        return std::find(list.begin(), list.end(), c) != list.end();
+    };
+    for (const auto& c : old.courses) if (!has(now.courses, c)) courses_.adjust(c, -1);
+    for (const auto& c : now.courses) if (!has(old.courses, c)) courses_.adjust(c, +1);
+    old = std::move(now);
+}
+
+} // namespace sb
@@ -0,0 +1,138 @@
+/***************************************************************************************
+ * Autocomplete.hpp
+ * Type-ahead for course codes and classmate names: "CPSC 21" → CPSC 2150, CPSC 2120.
+ *
+ * PrefixIndex is a radix trie over normalized keys (trimmed, ASCII lower-case, runs of
+ * whitespace collapsed to one space). Every node caches the kMaxCompletions best entries
+ * of its subtree, ranked by count (descending) and then key, so complete() walks the
+ * prefix and copies that list: O(prefix + N), independent of how many keys share the
+ * prefix. adjust() changes one key's count and re-ranks nodes on its path, bottom-up,
+ * stopping at the first node whose cached list does not change.
+ * Keys whose count drops to zero are never returned. They stay in the trie until they
+ * outnumber the live keys; the trie and its pool are then rebuilt from the live ones, so
+ * a stream of renames cannot grow the index without bound.
+ *
+ * Autocomplete keeps two PrefixIndexes in step with a roster: course codes counted by
+ * enrollment and names counted by how many profiles carry them. update(id, profile)
+ * diffs the profile against what the index last saw for that id, so it can be wired to
+ * Roster::subscribe and follows CourseManager adds/removes without a rebuild.
+ *
+ * Keys and display texts are interned in a pool owned by the index, not in
+ * StringPool::global(): names and codes come from clients and are replaced at will, and
+ * the global pool never frees. Returned views stay valid until the next adjust() or
+ * update(), which may rebuild the pool. Not thread-safe.
+ *
+ * STANDARD LIBRARIES USED:
+ *  <array>       : per-node cached completions
+ *  <cstdint>     : node/entry indexes, counts
+ *  <memory>      : the index's string pool
+ *  <string>      : normalized keys, last-seen names and courses
+ *  <string_view> : keys, display texts, prefixes
+ *  <vector>      : nodes, entries, results
+ ****************************************************************************************/
+#pragma once
+#include "Profile.hpp"
+#include "FlatMap.hpp"
+#include "StringPool.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace sb {
+
+// One suggestion: the text to show and its count (enrollment or profiles with that name).
+struct Completion {
+    std::string_view text;
+    std::uint32_t count;
+};
+
+class PrefixIndex {
+public:
+    static constexpr std::size_t kMaxCompletions = 8;
+
+    PrefixIndex();
+
+    // Add 'delta' to the count of 'text' (clamped at zero). The first text seen for a
+    // normalized key is the one completions display.
+    void adjust(std::string_view text, int delta);
+
+    // Up to min(n, kMaxCompletions) keys starting with 'prefix', best first.
+    std::vector<Completion> complete(std::string_view prefix,
+                                     std::size_t n = kMaxCompletions) const;
+
+    std::uint32_t count(std::string_view text) const;
+    std::size_t size() const { return live_; } // keys with a non-zero count
+    std::size_t entryCount() const { return entries_.size(); } // live and dead keys
+    std::size_t nodeCount() const { return nodes_.size(); }
+
+    // Trim, ASCII lower-case, collapse whitespace runs.
+    static std::string normalize(std::string_view text);
+
+private:
+    static constexpr std::uint32_t kNone = 0xFFFFFFFFu;
+
+    struct Entry {
+        std::string_view key;     // normalized, in pool_
+        std::string_view display; // first text seen for the key, in pool_
+        std::uint32_t count;
+    };
+    struct Node {
+        std::string_view label;            // edge from the parent (slice of a pooled key)
+        std::vector<std::uint32_t> kids;   // ordered by first label byte
+        std::uint32_t entry = kNone;       // key ending at this node
+        std::uint32_t topCount = 0;
+        std::array<std::uint32_t, kMaxCompletions> top{}; // best entries in the subtree
+    };
+
+    bool better(std::uint32_t a, std::uint32_t b) const;
+    std::uint32_t locate(std::string_view prefix) const; // node covering 'prefix' or kNone
+    std::uint32_t insertPath(std::string_view key);      // fills path_, returns terminal
+    std::size_t childSlot(const Node& n, unsigned char c) const;
+    void rerank(std::uint32_t node);                     // rebuild a node's list from its kids
+    bool refresh(std::uint32_t node, std::uint32_t id, bool increased);
+    void compact(); // rebuild from the live keys
+
+    std::unique_ptr<StringPool> pool_ = std::make_unique<StringPool>(); // heap: views survive moves
+    std::vector<Node> nodes_; // nodes_[0] is the root
+    std::vector<Entry> entries_;
+    FlatMap<std::string_view, std::uint32_t, StrHash> byKey_;
+    std::vector<std::uint32_t> path_;    // scratch for adjust()
+    std::vector<std::uint32_t> scratch_; // scratch for rerank()
+    std::size_t live_ = 0;
+};
+
+class Autocomplete {
+public:
+    Autocomplete() = default;
+    explicit Autocomplete(const std::vector<Profile>& roster);
+
+    // Make profile 'id' contribute its current name and courses (profiles that do not
+    // exist contribute nothing). Call again after every change to that profile.
+    void update(std::size_t id, const Profile& p);
+
+    // Course codes by enrollment / names by frequency, starting with 'prefix'.
+    std::vector<Completion> courses(std::string_view prefix,
+                                    std::size_t n = PrefixIndex::kMaxCompletions) const;
+    std::vector<Completion> names(std::string_view prefix,
+                                  std::size_t n = PrefixIndex::kMaxCompletions) const;
+
+    const PrefixIndex& courseIndex() const { return courses_; }
+    const PrefixIndex& nameIndex() const { return names_; }
+
+private:
+    struct Seen {
+        std::string name;
+        std::vector<std::string> courses;
+    };
+
+    PrefixIndex courses_;
+    PrefixIndex names_;
+    std::vector<Seen> byId_;
+};
+
+} // namespace sb
@@ -3,7 +3,8 @@
  ****************************************************************************************/
 #include "AvailabilityBrowser.hpp"
 #include "Utils.hpp"
-#include <algorithm>  // remove_if
+#include "ThreadPool.hpp"
+#include "Metrics.hpp"
 
 namespace sb {
 
@@ -21,42 +22,83 @@ bool AvailabilityBrowser::hasCourse(const Profile& p, const std::string& normali
     return false;
 }
 
-std::vector<std::pair<std::string, std::vector<AvailabilitySlot>>>
+using BrowseEntry = std::pair<std::string, std::vector<AvailabilitySlot>>;
+
+static std::vector<BrowseEntry> copyOut(const std::vector<ClassmateSlotsView>& views) {
+    std::vector<BrowseEntry> out;
+    out.reserve(views.size());
+    for (const auto& v : views) {
+        out.emplace_back(std::string(v.name),
+                         std::vector<AvailabilitySlot>(v.slots.begin(), v.slots.end()));
+    }
+    return out;
+}
+
+std::vector<BrowseEntry>
 AvailabilityBrowser::browseByCourse(const std::vector<Profile>& all,
                                     const Profile& self,
                                     const std::string& courseCode) {
-    std::vector<std::pair<std::string, std::vector<AvailabilitySlot>>> out;
+    return copyOut(browseByCourseView(all, self, courseCode));
+}
+
+std::vector<BrowseEntry>
+AvailabilityBrowser::browseByCourseAndDay(const std::vector<Profile>& all,
+                                          const Profile& self,
+                                          const std::string& courseCode,
+                                          Day day) {
+    return copyOut(browseByCourseAndDayView(all, self, courseCode, day));
+}
+
+std::vector<ClassmateSlotsView>
+AvailabilityBrowser::browseByCourseView(const std::vector<Profile>& all,
+                                        const Profile& self,
+                                        const std::string& courseCode) {
+    ApiTimer timer(Api::BrowseByCourse);
+    std::vector<ClassmateSlotsView> out;
     std::string norm = upperCopy(trim(courseCode));
     for (const auto& p : all) {
         if (sameUser(p, self)) continue;
-        if (hasCourse(p, norm)) {
-            out.push_back({p.name().empty() ? p.email() : p.name(), p.availability()});
-        }
+        if (hasCourse(p, norm)) out.push_back({&p, p.displayName(), p.slots()});
     }
     return out;
 }
 
-std::vector<std::pair<std::string, std::vector<AvailabilitySlot>>>
-AvailabilityBrowser::browseByCourseAndDay(const std::vector<Profile>& all,
-                                          const Profile& self,
-                                          const std::string& courseCode,
-                                          Day day) {
-    // Start with all classmates in the course
-    auto base = browseByCourse(all, self, courseCode);
-
-    // Filter each classmate's slots to the chosen day; keep only if any remain
-    std::vector<std::pair<std::string, std::vector<AvailabilitySlot>>> out;
-    out.reserve(base.size());
-    for (auto& entry : base) {
-        auto& slots = entry.second;
-        slots.erase(std::remove_if(slots.begin(), slots.end(),
-                   [day](const AvailabilitySlot& s){ return s.day != day; }),
-                   slots.end());
-        if (!slots.empty()) {
-            out.push_back(std::move(entry));
-        }
+std::vector<ClassmateSlotsView>
+AvailabilityBrowser::browseByCourseAndDayView(const std::vector<Profile>& all,
+                                              const Profile& self,
+                                              const std::string& courseCode,
+                                              Day day) {
+    ApiTimer timer(Api::BrowseByCourseAndDay);
+    std::string norm = upperCopy(trim(courseCode));
+
+    // Keep classmates with at least one slot on the chosen day (a span via the day index).
+    // Large rosters are split into chunks on the shared pool (order is preserved).
+    return parallelCollectAbove<ClassmateSlotsView>(all.size(),
+        [&](std::size_t lo, std::size_t hi, std::vector<ClassmateSlotsView>& out) {
+            for (std::size_t i = lo; i < hi; ++i) {
+                const Profile& p = all[i];
+                if (sameUser(p, self) || !hasCourse(p, norm)) continue;
+                SlotView slots = p.slotsOn(day);
+                if (!slots.empty()) out.push_back({&p, p.displayName(), slots});
+            }
+        });
+}
+
+std::vector<ClassmateSlotsView>
+AvailabilityBrowser::freeInWindow(const OccupancyIndex& index,
+                                  const std::vector<Profile>& all,
+                                  const Profile& self,
+                                  const std::string& courseCode,
+                                  Day day, int start, int end,
+                                  OccupancyIndex::Match match) {
+    std::vector<ClassmateSlotsView> out;
+    for (std::size_t id : index.freeIn(courseCode, day, start, end, match)) {
+        if (id >= all.size()) continue;
+        const Profile& p = all[id];
+        if (sameUser(p, self)) continue;
+        out.push_back({&p, p.displayName(), p.slotsOn(day)});
     }
     return out;
 }
 
-} // namespace sb
\ No newline at end of file
+} // namespace sb
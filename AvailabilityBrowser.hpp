@@ -2,20 +2,38 @@
  * AvailabilityBrowser.hpp
  * Feature: Browse classmates’ availability (filter by course, optional day).
  *
+ * The *View variants return handles into the roster (a name view plus a SlotView span of
+ * the profile's slots) instead of copying names and slot vectors; the result vector is the
+ * only allocation. Views are valid while 'all' is alive and unmodified. The copying
+ * variants are thin wrappers over them.
+ *
+ * freeInWindow() answers "who in this course is free on this day between these times"
+ * from an OccupancyIndex instead of scanning and filtering every member's slots.
+ *
  * STANDARD LIBRARIES USED:
  *  <vector>    : to return lists of classmates and their slots
  *  <string>    : course code & names
+ *  <string_view>: classmate name views
  *  <utility>   : std::pair for (name, slots)
  *  <algorithm> : find, transform
  ****************************************************************************************/
 #pragma once
 #include "Profile.hpp"
+#include "OccupancyIndex.hpp"
 #include <vector>
 #include <string>
+#include <string_view>
 #include <utility>
 
 namespace sb {
 
+// One classmate in a browse result, pointing into the roster.
+struct ClassmateSlotsView {
+    const Profile* person;
+    std::string_view name; // name, or email if the name is blank
+    SlotView slots;
+};
+
 class AvailabilityBrowser {
 public:
     // Return (name, slots) for all classmates (excluding self) who are enrolled in courseCode.
@@ -28,6 +46,22 @@ public:
     browseByCourseAndDay(const std::vector<Profile>& all, const Profile& self,
                          const std::string& courseCode, Day day);
 
+    // Zero-copy forms of the two queries above (same filtering and order).
+    static std::vector<ClassmateSlotsView>
+    browseByCourseView(const std::vector<Profile>& all, const Profile& self, const std::string& courseCode);
+
+    static std::vector<ClassmateSlotsView>
+    browseByCourseAndDayView(const std::vector<Profile>& all, const Profile& self,
+                             const std::string& courseCode, Day day);
+
+    // Classmates (excluding self, roster order) enrolled in courseCode who are free on 'day'
+    // for all of [start, end) (Full) or some of it (Partial); slots are that day's slots.
+    // 'index' must mirror 'all' (same ids).
+    static std::vector<ClassmateSlotsView>
+    freeInWindow(const OccupancyIndex& index, const std::vector<Profile>& all, const Profile& self,
+                 const std::string& courseCode, Day day, int start, int end,
+                 OccupancyIndex::Match match = OccupancyIndex::Match::Full);
+
 private:
     static bool sameUser(const Profile& a, const Profile& b);
     static bool hasCourse(const Profile& p, const std::string& normalizedCourse);
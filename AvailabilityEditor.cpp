@@ -2,7 +2,7 @@
  * AvailabilityEditor.cpp — implementation
  ****************************************************************************************/
 #include "AvailabilityEditor.hpp"
-#include <algorithm>
+#include "WeeklySlots.hpp"
 #include <iostream>
 
 namespace sb {
@@ -17,14 +17,12 @@ bool AvailabilityEditor::editSlot(Profile& prof, int oneBasedIndex, Day day,
     if (newEndMin <= newStartMin) {
         std::cout << "End must be after start.\n"; return false;
     }
-    // Update slot
-    auto& slot = v[oneBasedIndex - 1];
-    slot.day = day;
-    slot.start = newStartMin;
-    slot.end = newEndMin;
-
-    // Sort and merge
-    mergeAll(prof);
+    // Rebuild without the old slot, then insert the new one (merges where they touch)
+    v.erase(v.begin() + (oneBasedIndex - 1));
+    WeeklySlots week(v);
+    week.add(AvailabilitySlot{day, newStartMin, newEndMin});
+    v = week.slots();
+    prof.commitAvailability();
     std::cout << "Availability edited (merged where necessary).\n";
     return true;
 }
@@ -37,27 +35,9 @@ bool AvailabilityEditor::removeSlot(Profile& prof, int oneBasedIndex) {
         std::cout << "Index out of range.\n"; return false;
     }
     v.erase(v.begin() + (oneBasedIndex - 1));
+    prof.commitAvailability();
     std::cout << "Availability removed.\n";
     return true;
 }
 
-void AvailabilityEditor::mergeAll(Profile& prof) {
-    auto& v = prof.availabilityMutable();
-    std::sort(v.begin(), v.end(), [](const AvailabilitySlot& x, const AvailabilitySlot& y){
-        if (x.day != y.day) return static_cast<int>(x.day) < static_cast<int>(y.day);
-        return x.start < y.start;
-    });
-    std::vector<AvailabilitySlot> merged;
-    for (const auto& s : v) {
-        if (merged.empty() ||
-            merged.back().day != s.day ||
-            merged.back().end < s.start) {
-            merged.push_back(s);
-        } else {
-            merged.back().end = std::max(merged.back().end, s.end);
-        }
-    }
-    v.swap(merged);
-}
-
 } // namespace sb
\ No newline at end of file
@@ -9,31 +9,27 @@
 
 namespace sb {
 
-bool AvailabilityManager::overlapsSameDay(const AvailabilitySlot& a, const AvailabilitySlot& b) {
-    if (a.day != b.day) return false;
-    return (a.start < b.end) && (a.end > b.start);
-}
-
 void AvailabilityManager::addMerged(Profile& prof, const AvailabilitySlot& s) {
-    auto& v = prof.availabilityMutable();
-    v.push_back(s);
+    applyBatch(prof, {AvailabilityEdit{AvailabilityEdit::Kind::Add, s}});
+}
 
-    std::sort(v.begin(), v.end(), [](const AvailabilitySlot& x, const AvailabilitySlot& y){
-        if (x.day != y.day) return static_cast<int>(x.day) < static_cast<int>(y.day);
-        return x.start < y.start;
-    });
+bool AvailabilityManager::removeRange(Profile& prof, Day day, int startMin, int endMin) {
+    return applyBatch(prof, {AvailabilityEdit{AvailabilityEdit::Kind::Remove, {day, startMin, endMin}}});
+}
 
-    std::vector<AvailabilitySlot> merged;
-    for (const auto& slot : v) {
-        if (merged.empty() ||
-            merged.back().day != slot.day ||
-            merged.back().end < slot.start) {
-            merged.push_back(slot);
-        } else {
-            merged.back().end = std::max(merged.back().end, slot.end);
-        }
-    }
-    v.swap(merged);
+bool AvailabilityManager::applyBatch(Profile& prof, const std::vector<AvailabilityEdit>& edits) {
+    WeeklySlots week(prof.availability());
+    bool changed = week.apply(edits);
+    // Also rewrite when the stored list was not in canonical (sorted, merged) form.
+    std::vector<AvailabilitySlot> next = week.slots();
+    const auto& now = prof.availability();
+    bool same = next.size() == now.size() &&
+                std::equal(next.begin(), next.end(), now.begin(), [](const AvailabilitySlot& x, const AvailabilitySlot& y) {
+                    return x.day == y.day && x.start == y.start && x.end == y.end;
+                });
+    if (!same) prof.availabilityMutable() = std::move(next);
+    prof.commitAvailability();
+    return changed;
 }
 
 void AvailabilityManager::addAvailability(Profile& prof, Day day, int startMin, int endMin) {
@@ -56,6 +52,7 @@ void AvailabilityManager::removeAvailability(Profile& prof, int oneBasedIndex) {
         return;
     }
     v.erase(v.begin() + (oneBasedIndex - 1));
+    prof.commitAvailability();
     std::cout << "Availability removed.\n";
 }
 
@@ -3,13 +3,14 @@
  * Feature 3: Add/Remove availability slots (with overlap merge on the same day).
  *
  * STANDARD LIBRARIES USED:
- *  <vector>     : for merged list construction.
- *  <algorithm>  : std::sort, std::max for merge step.
+ *  <vector>     : edit batches.
  *  <iostream>   : feedback and listing.
  ****************************************************************************************/
 #pragma once
 #include "Profile.hpp"
+#include "WeeklySlots.hpp"
 #include <string>
+#include <vector>
 
 namespace sb {
 
@@ -27,9 +28,18 @@ public:
     // Helper to list availability with indices (for removal).
     static void listIndexed(const Profile& prof);
 
-private:
-    static bool overlapsSameDay(const AvailabilitySlot& a, const AvailabilitySlot& b);
+    // Silent insert + same-day merge (no validation, no output). Used by non-interactive
+    // callers such as the server and synthetic roster generation.
     static void addMerged(Profile& prof, const AvailabilitySlot& s);
+
+    // Silent: clear [startMin, endMin) on 'day', splitting slots at the edges.
+    // Returns true if any availability was removed.
+    static bool removeRange(Profile& prof, Day day, int startMin, int endMin);
+
+    // Silent: apply adds/removes in order on a WeeklySlots copy of the profile's slots,
+    // then commit once. Use this for bulk edits (calendar imports) instead of a loop of
+    // addMerged(), which re-commits after every slot. Returns true if anything changed.
+    static bool applyBatch(Profile& prof, const std::vector<AvailabilityEdit>& edits);
 };
 
 } // namespace sb
\ No newline at end of file
@@ -0,0 +1,212 @@
+/***************************************************************************************
+ * BackgroundSnapshot.cpp — implementation
+ ****************************************************************************************/
+#include "BackgroundSnapshot.hpp"
+#include "Metrics.hpp"
+
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <vector>
+#include <fstream>
+#include <utility>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace sb {
+
+// What a child sends back before exiting: this header, then its error text.
+struct ChildReport {
+    double writeMs;
+    std::uint64_t bytes;
+    std::uint32_t ok;
+};
+
+// Error text is cut here so the report always fits the pipe buffer: the parent only
+// reads it after the child has exited.
+static constexpr std::size_t kMaxErrorBytes = 512;
+
+static void writeAll(int fd, const char* p, std::size_t n) {
+    while (n > 0) {
+        ssize_t w = ::write(fd, p, n);
+        if (w < 0 && errno == EINTR) continue;
+        if (w <= 0) return;
+        p += w;
+        n -= static_cast<std::size_t>(w);
+    }
+}
+
+static std::string readAll(int fd) {
+    std::string out;
+    char buf[1024];
+    for (;;) {
+        ssize_t r = ::read(fd, buf, sizeof buf);
+        if (r < 0 && errno == EINTR) continue;
+        if (r <= 0) return out;
+        out.append(buf, static_cast<std::size_t>(r));
+    }
+}
+
+// The child never execs, so O_CLOEXEC does not help it: close everything it inherited
+// (client sockets, the listen socket, other children's pipes). Otherwise a client the
+// parent closes sees no EOF until the snapshot finishes.
+static void closeInheritedFds(int keep) {
+#ifdef SYS_close_range
+    bool below = keep <= 3 || ::syscall(SYS_close_range, 3u, static_cast<unsigned>(keep - 1), 0u) == 0;
+    if (below && ::syscall(SYS_close_range, static_cast<unsigned>(keep + 1), ~0u, 0u) == 0) return;
+#endif
+    std::vector<int> open;
+    if (DIR* d = ::opendir("/proc/self/fd")) {
+        int self = ::dirfd(d);
+        while (dirent* e = ::readdir(d)) {
+            int fd = std::atoi(e->d_name); // "." and ".." give 0: skipped below
+            if (fd > 2 && fd != keep && fd != self) open.push_back(fd);
+        }
+        ::closedir(d);
+    }
+    for (int fd : open) ::close(fd);
+}
+
+[[noreturn]] static void runChild(int reportFd, const std::string& path,
+                                  const BackgroundSnapshots::Writer& write) {
+    auto t0 = std::chrono::steady_clock::now();
+    ChildReport report{0, 0, 0};
+    std::string err;
+    const std::string tmp = path + ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            err = "cannot open " + tmp + ": " + std::strerror(errno);
+        } else {
+            try {
+                if (!write(out, err) && err.empty()) err = "snapshot writer failed";
+            } catch (const std::exception& e) {
+                err = e.what();
+            }
+            out.flush();
+            if (err.empty() && !out) err = "write to " + tmp + " failed";
+            if (err.empty()) report.bytes = static_cast<std::uint64_t>(out.tellp());
+        }
+    }
+    if (err.empty()) {
+        int fd = ::open(tmp.c_str(), O_RDONLY);
+        if (fd >= 0) {
+            ::fsync(fd);
+            ::close(fd);
+        }
+        if (std::rename(tmp.c_str(), path.c_str()) != 0) {
+            err = "rename " + tmp + " -> " + path + ": " + std::strerror(errno);
+        }
+    }
+    if (!err.empty()) std::remove(tmp.c_str());
+    if (err.size() > kMaxErrorBytes) err.resize(kMaxErrorBytes);
+
+    report.ok = err.empty();
+    report.writeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    writeAll(reportFd, reinterpret_cast<const char*>(&report), sizeof report);
+    writeAll(reportFd, err.data(), err.size());
+    ::close(reportFd);
+    ::_exit(report.ok ? 0 : 1); // no atexit handlers or destructors of the parent's objects
+}
+
+BackgroundSnapshots::~BackgroundSnapshots() {
+    std::lock_guard<std::mutex> lk(mu_);
+    reap(true);
+}
+
+BackgroundSnapshots::Started BackgroundSnapshots::start(const std::string& path, const Writer& write) {
+    std::lock_guard<std::mutex> lk(mu_);
+    for (auto& r : reap(false)) finished_.push_back(std::move(r));
+    if (children_.size() >= maxConcurrent_) return Started{Start::Busy, 0, 0, {}};
+
+    int fds[2];
+    if (::pipe2(fds, O_CLOEXEC) != 0) return Started{Start::ForkFailed, 0, 0, std::string("pipe: ") + std::strerror(errno)};
+
+    pid_t pid;
+    double pauseUs;
+    {
+        ApiTimer timer(Api::SnapshotFork);
+        auto t0 = std::chrono::steady_clock::now();
+        pid = ::fork();
+        if (pid == 0) {
+            closeInheritedFds(fds[1]);
+            runChild(fds[1], path, write);
+        }
+        pauseUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count();
+        if (pid < 0) timer.fail();
+    }
+    ::close(fds[1]);
+    if (pid < 0) {
+        int e = errno;
+        ::close(fds[0]);
+        return Started{Start::ForkFailed, 0, pauseUs, std::string("fork: ") + std::strerror(e)};
+    }
+    std::uint32_t id = nextId_++;
+    children_.push_back(Child{pid, fds[0], id, path});
+    return Started{Start::Started, id, pauseUs, {}};
+}
+
+std::vector<SnapshotResult> BackgroundSnapshots::reap(bool block) {
+    std::vector<SnapshotResult> done;
+    for (auto it = children_.begin(); it != children_.end();) {
+        int status = 0;
+        pid_t r;
+        do {
+            r = ::waitpid(it->pid, &status, block ? 0 : WNOHANG);
+        } while (r < 0 && errno == EINTR);
+        if (r == 0) {
+            ++it;
+            continue;
+        }
+        SnapshotResult res{it->id, it->path, false, {}, 0, 0};
+        std::string report = readAll(it->pipeFd); // the child has exited: never blocks long
+        ::close(it->pipeFd);
+        if (r < 0) {
+            res.error = std::string("waitpid: ") + std::strerror(errno);
+        } else if (report.size() >= sizeof(ChildReport)) {
+            ChildReport head;
+            std::memcpy(&head, report.data(), sizeof head);
+            res.ok = head.ok && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+            res.writeMs = head.writeMs;
+            res.bytes = head.bytes;
+            res.error = report.substr(sizeof head);
+        } else if (WIFSIGNALED(status)) {
+            res.error = "snapshot child killed by signal " + std::to_string(WTERMSIG(status));
+        } else {
+            res.error = "snapshot child exited without a report";
+        }
+        done.push_back(std::move(res));
+        it = children_.erase(it);
+    }
+    return done;
+}
+
+std::vector<SnapshotResult> BackgroundSnapshots::poll() {
+    std::lock_guard<std::mutex> lk(mu_);
+    std::vector<SnapshotResult> out = std::move(finished_);
+    finished_.clear();
+    for (auto& r : reap(false)) out.push_back(std::move(r));
+    return out;
+}
+
+std::vector<SnapshotResult> BackgroundSnapshots::wait() {
+    std::lock_guard<std::mutex> lk(mu_);
+    std::vector<SnapshotResult> out = std::move(finished_);
+    finished_.clear();
+    for (auto& r : reap(true)) out.push_back(std::move(r));
+    return out;
+}
+
+std::size_t BackgroundSnapshots::running() const {
+    std::lock_guard<std::mutex> lk(mu_);
+    return children_.size();
+}
+
+} // namespace sb
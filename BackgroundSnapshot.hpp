@@ -0,0 +1,93 @@
+/***************************************************************************************
+ * BackgroundSnapshot.hpp
+ * Write snapshots from a forked child so the serving process never waits for the disk
+ * (POSIX; built with the server).
+ *
+ * start(path, write) forks. The child sees the parent's memory frozen at that instant
+ * (copy-on-write pages), runs write() into "<path>.tmp", fsyncs and renames it over
+ * 'path', reports the outcome through a pipe and exits with _exit(). It first closes
+ * every descriptor it inherited except stdin/stdout/stderr, so sockets the parent closes
+ * meanwhile really close. The parent only pays for fork() (page-table copy): that pause
+ * is returned, and recorded as Api::SnapshotFork in Metrics. Callers hold whatever locks
+ * make their state consistent across the start() call; the child needs none of them.
+ *
+ * At most maxConcurrent children run at once; start() answers Busy beyond that.
+ * poll() reaps finished children without blocking and returns their results; the
+ * destructor waits for any still running.
+ *
+ * In the child only the forking thread exists, so write() must not take locks other
+ * threads might have held (metrics timers, the string pool, ...) and must not log
+ * through shared state. Plain reads and stream output are fine.
+ *
+ * STANDARD LIBRARIES USED:
+ *  <cstdint>    : ids, byte counts
+ *  <functional> : writer callback
+ *  <mutex>      : child table
+ *  <ostream>    : writer target
+ *  <string>     : paths, errors
+ *  <vector>     : running children, results
+ ****************************************************************************************/
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace sb {
+
+struct SnapshotResult {
+    std::uint32_t id;
+    std::string path;
+    bool ok;
+    std::string error;     // empty when ok
+    double writeMs;        // time the child spent writing (0 if it never reported)
+    std::uint64_t bytes;   // size of the snapshot written
+};
+
+class BackgroundSnapshots {
+public:
+    // Runs in the child; return false (and fill 'err') to fail the snapshot.
+    using Writer = std::function<bool(std::ostream& out, std::string& err)>;
+
+    enum class Start { Started, Busy, ForkFailed };
+    struct Started {
+        Start status;
+        std::uint32_t id;   // 0 unless Started
+        double pauseUs;     // time the caller was held up by fork()
+        std::string error;  // ForkFailed reason
+    };
+
+    explicit BackgroundSnapshots(std::size_t maxConcurrent = 1) : maxConcurrent_(maxConcurrent) {}
+    ~BackgroundSnapshots();
+    BackgroundSnapshots(const BackgroundSnapshots&) = delete;
+    BackgroundSnapshots& operator=(const BackgroundSnapshots&) = delete;
+
+    Started start(const std::string& path, const Writer& write);
+
+    // Results of children that finished since the last poll()/wait(), oldest first.
+    std::vector<SnapshotResult> poll();
+    // Block until no child is running; returns their results like poll().
+    std::vector<SnapshotResult> wait();
+
+    std::size_t running() const;
+
+private:
+    struct Child {
+        int pid;
+        int pipeFd; // read end of the child's report
+        std::uint32_t id;
+        std::string path;
+    };
+    std::vector<SnapshotResult> reap(bool block); // caller holds mu_
+
+    std::size_t maxConcurrent_;
+    mutable std::mutex mu_;
+    std::vector<Child> children_;
+    std::vector<SnapshotResult> finished_; // reaped by start(), not yet returned
+    std::uint32_t nextId_ = 1;
+};
+
+} // namespace sb
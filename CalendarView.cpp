@@ -13,9 +13,9 @@ std::vector<StudySession> CalendarView::list(const Profile& user, const SessionR
 std::string CalendarView::pretty(const StudySession& s, const std::string& selfEmail) {
     const char* kDayNames[7] = {"Mon","Tue","Wed","Thu","Fri","Sat","Sun"};
     std::string times = formatHHMM(s.start) + "-" + formatHHMM(s.end);
-    std::string partner = (s.requester == selfEmail) ? s.invitee : s.requester;
+    std::string_view partner = (s.requester == selfEmail) ? s.invitee : s.requester;
     return std::string(kDayNames[static_cast<int>(s.day)]) + " " + times +
-           " " + s.course + " with " + partner + " [" + s.id + "]";
+           " " + std::string(s.course) + " with " + std::string(partner) + " [" + s.id + "]";
 }
 
 bool CalendarView::cancel(const std::string& sessionId, const Profile& by, SessionRequests& sr) {
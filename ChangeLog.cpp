@@ -0,0 +1,179 @@
+/***************************************************************************************
+ * ChangeLog.cpp — implementation
+ ****************************************************************************************/
+#include "ChangeLog.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace sb {
+
+const char* changeKindName(ChangeEvent::Kind k) {
+    switch (k) {
+        case ChangeEvent::Kind::ProfileAdded:        return "profileAdded";
+        case ChangeEvent::Kind::IdentityChanged:     return "identityChanged";
+        case ChangeEvent::Kind::CoursesChanged:      return "coursesChanged";
+        case ChangeEvent::Kind::AvailabilityChanged: return "availabilityChanged";
+        case ChangeEvent::Kind::SessionRequested:    return "sessionRequested";
+        case ChangeEvent::Kind::SessionConfirmed:    return "sessionConfirmed";
+        case ChangeEvent::Kind::SessionCancelled:    return "sessionCancelled";
+    }
+    return "?";
+}
+
+/* -------------------------------- ChangeQueue -------------------------------- */
+
+ChangeQueue::ChangeQueue(std::size_t capacity) {
+    std::size_t n = 2;
+    while (n < capacity) n *= 2;
+    ring_.resize(n);
+    mask_ = n - 1;
+}
+
+void ChangeQueue::push(const ChangeEvent& e) {
+    std::size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail - head_.load(std::memory_order_acquire) == ring_.size()) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    ring_[tail & mask_] = e;
+    tail_.store(tail + 1, std::memory_order_release);
+}
+
+bool ChangeQueue::tryPop(ChangeEvent& out) {
+    std::size_t head = head_.load(std::memory_order_relaxed);
+    if (head == tail_.load(std::memory_order_acquire)) return false;
+    out = std::move(ring_[head & mask_]);
+    ring_[head & mask_] = ChangeEvent{}; // release the slot's profile/session references
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+std::size_t ChangeQueue::drain(std::vector<ChangeEvent>& out, std::size_t max) {
+    std::size_t head = head_.load(std::memory_order_relaxed);
+    std::size_t tail = tail_.load(std::memory_order_acquire);
+    std::size_t n = std::min(tail - head, max);
+    for (std::size_t i = 0; i < n; ++i) {
+        ChangeEvent& slot = ring_[(head + i) & mask_];
+        out.push_back(std::move(slot));
+        slot = ChangeEvent{};
+    }
+    head_.store(head + n, std::memory_order_release);
+    return n;
+}
+
+/* --------------------------------- ChangeLog --------------------------------- */
+
+ChangeLog::Batch::Batch(ChangeLog& log) : log_(log) {
+    std::lock_guard<std::mutex> lk(log_.mu_);
+    ++log_.batchDepth_;
+}
+
+ChangeLog::Batch::~Batch() { log_.endBatch(); }
+
+ChangeLog::~ChangeLog() {
+    if (roster_) roster_->unsubscribe(rosterToken_);
+}
+
+std::uint64_t ChangeLog::publish(ChangeEvent e) {
+    std::vector<ChangeEvent> single;
+    std::vector<std::pair<std::size_t, BatchListener>> batchListeners;
+    std::uint64_t seq;
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        seq = seq_.load(std::memory_order_relaxed) + 1;
+        e.seq = seq;
+        seq_.store(seq, std::memory_order_release);
+
+        for (const auto& l : listeners_) l.second(e);
+
+        queues_.erase(std::remove_if(queues_.begin(), queues_.end(),
+                                     [](const std::shared_ptr<ChangeQueue>& q) { return q.use_count() == 1; }),
+                      queues_.end());
+        for (const auto& q : queues_) q->push(e);
+
+        if (batchListeners_.empty()) return seq;
+        if (batchDepth_ > 0) {
+            pending_.push_back(std::move(e));
+            return seq;
+        }
+        single.push_back(std::move(e));
+        batchListeners = batchListeners_;
+    }
+    for (const auto& l : batchListeners) l.second(single);
+    return seq;
+}
+
+void ChangeLog::endBatch() {
+    std::vector<ChangeEvent> batch;
+    std::vector<std::pair<std::size_t, BatchListener>> batchListeners;
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        if (--batchDepth_ > 0 || pending_.empty()) return;
+        batch.swap(pending_);
+        batchListeners = batchListeners_;
+    }
+    for (const auto& l : batchListeners) l.second(batch);
+}
+
+std::size_t ChangeLog::subscribe(Listener fn) {
+    std::lock_guard<std::mutex> lk(mu_);
+    listeners_.emplace_back(nextToken_, std::move(fn));
+    return nextToken_++;
+}
+
+std::size_t ChangeLog::subscribeBatch(BatchListener fn) {
+    std::lock_guard<std::mutex> lk(mu_);
+    batchListeners_.emplace_back(nextToken_, std::move(fn));
+    return nextToken_++;
+}
+
+void ChangeLog::unsubscribe(std::size_t token) {
+    std::lock_guard<std::mutex> lk(mu_);
+    auto byToken = [token](const auto& l) { return l.first == token; };
+    listeners_.erase(std::remove_if(listeners_.begin(), listeners_.end(), byToken), listeners_.end());
+    batchListeners_.erase(std::remove_if(batchListeners_.begin(), batchListeners_.end(), byToken),
+                          batchListeners_.end());
+}
+
+std::shared_ptr<ChangeQueue> ChangeLog::openQueue(std::size_t capacity) {
+    auto q = std::make_shared<ChangeQueue>(capacity);
+    std::lock_guard<std::mutex> lk(mu_);
+    queues_.push_back(q);
+    return q;
+}
+
+void ChangeLog::watch(Roster& roster) {
+    if (roster_) roster_->unsubscribe(rosterToken_);
+    roster_ = &roster;
+    lastSeen_ = roster.profiles(); // shared handles: no profile data is copied
+    rosterToken_ = roster.subscribe([this](const RosterChange& c) { onRosterChange(c); });
+}
+
+void ChangeLog::onRosterChange(const RosterChange& c) {
+    if (c.id >= lastSeen_.size()) lastSeen_.resize(c.id + 1);
+    Profile before = std::move(lastSeen_[c.id]);
+    lastSeen_[c.id] = c.profile;
+
+    auto emit = [&](ChangeEvent::Kind kind) {
+        ChangeEvent e;
+        e.kind = kind;
+        e.profileId = c.id;
+        e.profile = c.profile;
+        e.before = before;
+        publish(std::move(e));
+    };
+    if (c.kind == RosterChange::Kind::Added) {
+        emit(ChangeEvent::Kind::ProfileAdded);
+        return;
+    }
+    if (before.sharesDataWith(c.profile)) return;
+    if (before.exists() != c.profile.exists() || before.name() != c.profile.name() ||
+        before.email() != c.profile.email()) {
+        emit(ChangeEvent::Kind::IdentityChanged);
+    }
+    if (before.courses() != c.profile.courses()) emit(ChangeEvent::Kind::CoursesChanged);
+    if (before.schedule() != c.profile.schedule()) emit(ChangeEvent::Kind::AvailabilityChanged);
+}
+
+} // namespace sb
@@ -0,0 +1,149 @@
+/***************************************************************************************
+ * ChangeLog.hpp
+ * In-process change-data-capture stream: one typed, sequenced event per core mutation.
+ *
+ * Producers:
+ *  - watch(roster) turns Roster add/edit events into ProfileAdded / IdentityChanged /
+ *    CoursesChanged / AvailabilityChanged, by comparing with the last state seen for that
+ *    id (schedules compare by pointer, so this is cheap). Every manager that edits through
+ *    Roster::edit is covered without publishing anything itself.
+ *  - SessionRequests publishes SessionRequested / SessionConfirmed / SessionCancelled when
+ *    constructed with a ChangeLog.
+ * Sequence numbers start at 1 and increase by one per event, in publish order.
+ *
+ * Consumers pick one of three forms:
+ *  - subscribe(fn)      : called synchronously for every event, on the publishing thread;
+ *  - subscribeBatch(fn) : called with a vector of events: one per event normally, but once
+ *                         for everything published while a ChangeLog::Batch is alive, so a
+ *                         10k-row import becomes a single rebuild;
+ *  - openQueue(cap)     : a bounded single-producer/single-consumer ring another thread
+ *                         drains without locks. If the consumer falls behind, events are
+ *                         dropped and counted (dropped()); the consumer should then resync
+ *                         from the source instead of trusting the stream.
+ * publish() is serialized by a mutex (the queues' single producer). Listeners run inside
+ * it and must not publish.
+ *
+ * STANDARD LIBRARIES USED:
+ *  <atomic>     : ring indexes, sequence and drop counters
+ *  <cstdint>    : sequence numbers
+ *  <functional> : listeners
+ *  <memory>     : shared queues
+ *  <mutex>      : publish serialization
+ *  <vector>     : rings, batches, last-seen profiles
+ ****************************************************************************************/
+#pragma once
+#include "Roster.hpp"
+#include "SessionRequests.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace sb {
+
+struct ChangeEvent {
+    enum class Kind {
+        ProfileAdded,        // profileId, profile
+        IdentityChanged,     // name/email/reset; profileId, profile, before
+        CoursesChanged,      // profileId, profile, before
+        AvailabilityChanged, // profileId, profile, before
+        SessionRequested,    // session
+        SessionConfirmed,    // session
+        SessionCancelled,    // session (as it was before removal)
+    };
+
+    std::uint64_t seq = 0;
+    Kind kind = Kind::ProfileAdded;
+    std::size_t profileId = 0;
+    Profile profile;      // state after the change (shared copy-on-write handle)
+    Profile before;       // state before (profile updates only)
+    StudySession session{};
+
+    bool isProfileEvent() const { return kind <= Kind::AvailabilityChanged; }
+};
+
+const char* changeKindName(ChangeEvent::Kind k);
+
+// Bounded SPSC ring filled by ChangeLog::publish and drained by one consumer thread.
+class ChangeQueue {
+public:
+    explicit ChangeQueue(std::size_t capacity); // rounded up to a power of two
+
+    bool tryPop(ChangeEvent& out);
+    // Move up to 'max' events into 'out' (appended). Returns how many.
+    std::size_t drain(std::vector<ChangeEvent>& out, std::size_t max = static_cast<std::size_t>(-1));
+    std::uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+    std::size_t capacity() const { return ring_.size(); }
+
+private:
+    friend class ChangeLog;
+    void push(const ChangeEvent& e); // producer side (under the log's mutex)
+
+    std::vector<ChangeEvent> ring_;
+    std::size_t mask_;
+    alignas(64) std::atomic<std::size_t> head_{0}; // next slot to read (consumer)
+    alignas(64) std::atomic<std::size_t> tail_{0}; // next slot to write (producer)
+    std::atomic<std::uint64_t> dropped_{0};
+};
+
+class ChangeLog {
+public:
+    using Listener = std::function<void(const ChangeEvent&)>;
+    using BatchListener = std::function<void(const std::vector<ChangeEvent>&)>;
+
+    // Defers batch listeners until the outermost Batch on this log ends.
+    class Batch {
+    public:
+        explicit Batch(ChangeLog& log);
+        ~Batch();
+        Batch(const Batch&) = delete;
+        Batch& operator=(const Batch&) = delete;
+    private:
+        ChangeLog& log_;
+    };
+
+    ChangeLog() = default;
+    ~ChangeLog();
+    ChangeLog(const ChangeLog&) = delete;
+    ChangeLog& operator=(const ChangeLog&) = delete;
+
+    // Assign the next sequence number and deliver. Returns the sequence number.
+    std::uint64_t publish(ChangeEvent e);
+    // Last sequence number handed out (0 before the first event).
+    std::uint64_t lastSeq() const { return seq_.load(std::memory_order_acquire); }
+
+    std::size_t subscribe(Listener fn);
+    std::size_t subscribeBatch(BatchListener fn);
+    void unsubscribe(std::size_t token);
+
+    // New queue receiving every later event. The log stops feeding it once the caller
+    // drops its last reference.
+    std::shared_ptr<ChangeQueue> openQueue(std::size_t capacity = 1 << 16);
+
+    // Publish profile events for 'roster' (existing profiles are taken as the baseline,
+    // not published). One roster at a time; the log must not outlive it.
+    void watch(Roster& roster);
+
+private:
+    void onRosterChange(const RosterChange& c);
+    void endBatch();
+
+    std::mutex mu_;
+    std::atomic<std::uint64_t> seq_{0};
+    std::vector<std::pair<std::size_t, Listener>> listeners_;
+    std::vector<std::pair<std::size_t, BatchListener>> batchListeners_;
+    std::vector<std::shared_ptr<ChangeQueue>> queues_;
+    std::size_t nextToken_ = 1;
+    int batchDepth_ = 0;
+    std::vector<ChangeEvent> pending_; // for batch listeners while batchDepth_ > 0
+
+    Roster* roster_ = nullptr;
+    std::size_t rosterToken_ = 0;
+    std::vector<Profile> lastSeen_;    // per roster id
+};
+
+} // namespace sb
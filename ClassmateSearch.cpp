@@ -3,6 +3,9 @@
  ****************************************************************************************/
 #include "ClassmateSearch.hpp"
 #include "Utils.hpp"
+#include "ThreadPool.hpp"
+#include "AllocStats.hpp"
+#include "Metrics.hpp"
 #include <algorithm>
 
 namespace sb {
@@ -29,6 +32,8 @@ bool ClassmateSearch::icontains(const std::string& hay, const std::string& needl
 std::vector<const Profile*> ClassmateSearch::byCourse(const std::vector<Profile>& all,
                                                       const Profile& self,
                                                       const std::string& courseCode) {
+    ApiTimer timer(Api::ByCourse);
+    AllocScope allocScope("byCourse");
     std::vector<const Profile*> out;
     std::string normalized = upperCopy(trim(courseCode));
     for (const auto& p : all) {
@@ -41,11 +46,55 @@ std::vector<const Profile*> ClassmateSearch::byCourse(const std::vector<Profile>
 std::vector<const Profile*> ClassmateSearch::byName(const std::vector<Profile>& all,
                                                     const Profile& self,
                                                     const std::string& nameSubstr) {
-    std::vector<const Profile*> out;
-    for (const auto& p : all) {
-        if (isSelf(p, self)) continue;
-        std::string key = p.name().empty() ? p.email() : p.name();
-        if (icontains(key, nameSubstr)) out.push_back(&p);
+    ApiTimer timer(Api::ByName);
+    AllocScope allocScope("byName");
+    return parallelCollectAbove<const Profile*>(all.size(),
+        [&](std::size_t lo, std::size_t hi, std::vector<const Profile*>& out) {
+            for (std::size_t i = lo; i < hi; ++i) {
+                const Profile& p = all[i];
+                if (isSelf(p, self)) continue;
+                std::string key(p.displayName());
+                if (icontains(key, nameSubstr)) out.push_back(&p);
+            }
+        });
+}
+
+std::vector<NameMatch> ClassmateSearch::byNameFuzzy(const std::vector<Profile>& all,
+                                                    const Profile& self,
+                                                    const std::string& query,
+                                                    int maxEdits) {
+    ApiTimer timer(Api::ByNameFuzzy);
+    std::string q = foldCase(trimView(query));
+    if (q.empty()) return {};
+    FuzzyPattern pat(q);
+    int k = pat.clampEdits(maxEdits);
+    auto out = parallelCollectAbove<NameMatch>(all.size(),
+        [&](std::size_t lo, std::size_t hi, std::vector<NameMatch>& part) {
+            for (std::size_t i = lo; i < hi; ++i) {
+                const Profile& p = all[i];
+                if (isSelf(p, self)) continue;
+                std::string_view email = trimView(p.email());
+                int d = std::min(pat.bestDistance(foldCase(trimView(p.name()))),
+                                 pat.bestDistance(foldCase(email.substr(0, email.find('@')))));
+                if (d <= k) part.push_back(NameMatch{&p, d});
+            }
+        });
+    // Closest first; equal distances stay in roster order, like byName.
+    std::stable_sort(out.begin(), out.end(),
+                     [](const NameMatch& a, const NameMatch& b) { return a.distance < b.distance; });
+    return out;
+}
+
+std::vector<NameMatch> ClassmateSearch::byNameFuzzy(const FuzzyNameIndex& index,
+                                                    const std::vector<Profile>& all,
+                                                    const Profile& self,
+                                                    const std::string& query,
+                                                    int maxEdits) {
+    ApiTimer timer(Api::ByNameFuzzy);
+    std::vector<NameMatch> out;
+    for (const auto& hit : index.search(query, maxEdits)) {
+        if (hit.id >= all.size() || isSelf(all[hit.id], self)) continue;
+        out.push_back(NameMatch{&all[hit.id], hit.distance}); // already ranked
     }
     return out;
 }
@@ -1,6 +1,7 @@
 /***************************************************************************************
  * ClassmateSearch.hpp
- * Feature: Search classmates by course OR by name (substring, case-insensitive).
+ * Feature: Search classmates by course OR by name (substring, case-insensitive), or by
+ * name with typos tolerated (byNameFuzzy, see FuzzySearch.hpp).
  *
  * STANDARD LIBRARIES USED:
  *  <vector>    : results
@@ -9,6 +10,7 @@
  ****************************************************************************************/
 #pragma once
 #include "Profile.hpp"
+#include "FuzzySearch.hpp"
 #include <vector>
 #include <string>
 
@@ -27,6 +29,22 @@ public:
                                               const Profile& self,
                                               const std::string& nameSubstr);
 
+    // Typo-tolerant byName: classmates (excluding self) whose name or email local part
+    // contains 'query' within 'maxEdits' edits (see FuzzyPattern::clampEdits).
+    // Closest first, then in roster order.
+    // Scans 'all' directly; use the index overload for repeated queries on large rosters.
+    static std::vector<NameMatch> byNameFuzzy(const std::vector<Profile>& all,
+                                              const Profile& self,
+                                              const std::string& query,
+                                              int maxEdits);
+
+    // Same results, using 'index' (built over, and kept in sync with, 'all').
+    static std::vector<NameMatch> byNameFuzzy(const FuzzyNameIndex& index,
+                                              const std::vector<Profile>& all,
+                                              const Profile& self,
+                                              const std::string& query,
+                                              int maxEdits);
+
 private:
     static bool isSelf(const Profile& a, const Profile& b);
     static bool hasCourse(const Profile& p, const std::string& normalized);
@@ -0,0 +1,182 @@
+/***************************************************************************************
+ * CoEnrollment.cpp — implementation
+ ****************************************************************************************/
+#include "CoEnrollment.hpp"
+#include "Metrics.hpp"
+#include "StringPool.hpp"
+#include "ThreadPool.hpp"
+#include "Utils.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace sb {
+
+CoEnrollment::CoEnrollment(const std::vector<Profile>& roster) {
+    byId_.resize(roster.size());
+    for (std::size_t i = 0; i < roster.size(); ++i) {
+        byId_[i] = courseSet(roster[i]);
+        for (std::uint32_t c : byId_[i]) ++enrolled_[c];
+    }
+    const std::size_t courses = names_.size();
+
+    // Course -> students, by counting sort.
+    std::vector<std::size_t> memberStart(courses + 1, 0);
+    for (const auto& set : byId_) {
+        for (std::uint32_t c : set) ++memberStart[c + 1];
+    }
+    for (std::size_t c = 0; c < courses; ++c) memberStart[c + 1] += memberStart[c];
+    std::vector<std::uint32_t> members(memberStart.back());
+    {
+        std::vector<std::size_t> fill(memberStart.begin(), memberStart.end() - 1);
+        for (std::size_t i = 0; i < byId_.size(); ++i) {
+            for (std::uint32_t c : byId_[i]) members[fill[c]++] = static_cast<std::uint32_t>(i);
+        }
+    }
+
+    // Row r: every other course of every student in r, counted in a dense accumulator.
+    using Entry = SparseCounts::Entry;
+    auto rows = [&](std::size_t lo, std::size_t hi) {
+        std::vector<Entry> out;
+        std::vector<std::uint32_t> acc(courses, 0);
+        std::vector<std::uint32_t> touched;
+        for (std::size_t r = lo; r < hi; ++r) {
+            for (std::size_t k = memberStart[r]; k < memberStart[r + 1]; ++k) {
+                for (std::uint32_t c : byId_[members[k]]) {
+                    if (c != r && acc[c]++ == 0) touched.push_back(c);
+                }
+            }
+            std::sort(touched.begin(), touched.end());
+            for (std::uint32_t c : touched) {
+                out.push_back(Entry{static_cast<std::uint32_t>(r), c, acc[c]});
+                acc[c] = 0;
+            }
+            touched.clear();
+        }
+        return out;
+    };
+    std::vector<Entry> entries;
+    if (members.size() < parallelThreshold()) {
+        entries = rows(0, courses);
+    } else {
+        // Chunks cover consecutive rows and are joined left to right, so rows stay in order.
+        entries = ThreadPool::shared().parallel_reduce(
+            0, courses, 0, std::vector<Entry>{}, rows,
+            [](std::vector<Entry> acc, std::vector<Entry> next) {
+                if (acc.empty()) return next;
+                acc.insert(acc.end(), next.begin(), next.end());
+                return acc;
+            });
+    }
+
+    counts_.assign(courses, entries);
+}
+
+const std::uint32_t* CoEnrollment::findCourse(const std::string& code) const {
+    // Profile course lists are usually normalized already: try the code as given first.
+    if (const std::uint32_t* id = courseIds_.find(std::string_view(code))) return id;
+    std::string key = upperCopy(trim(code));
+    return courseIds_.find(std::string_view(key));
+}
+
+std::uint32_t CoEnrollment::courseId(std::string_view code) {
+    if (const std::uint32_t* id = courseIds_.find(code)) return *id; // already normalized
+    std::string key = upperCopy(trim(std::string(code)));
+    if (const std::uint32_t* id = courseIds_.find(std::string_view(key))) return *id;
+    auto id = static_cast<std::uint32_t>(names_.size());
+    std::string_view name = intern(key);
+    courseIds_.tryEmplace(name, id);
+    names_.push_back(name);
+    enrolled_.push_back(0);
+    counts_.addRow();
+    return id;
+}
+
+std::vector<std::uint32_t> CoEnrollment::courseSet(const Profile& p) {
+    std::vector<std::uint32_t> set;
+    set.reserve(p.courses().size());
+    for (const auto& c : p.courses()) set.push_back(courseId(c));
+    std::sort(set.begin(), set.end());
+    set.erase(std::unique(set.begin(), set.end()), set.end());
+    return set;
+}
+
+void CoEnrollment::update(std::size_t id, const Profile& p) {
+    if (id >= byId_.size()) byId_.resize(id + 1);
+    std::vector<std::uint32_t> now = courseSet(p);
+    std::vector<std::uint32_t>& old = byId_[id];
+    if (now == old) return;
+
+    auto has = [](const std::vector<std::uint32_t>& set, std::uint32_t c) {
+        return std::binary_search(set.begin(), set.end(), c);
+    };
+    // Pairs that lost a member lose one student; pairs that gained one gain one.
+    for (std::uint32_t x : old) {
+        bool gone = !has(now, x);
+        if (gone) --enrolled_[x];
+        for (std::uint32_t y : old) {
+            if (y != x && (gone || !has(now, y))) counts_.add(x, y, -1);
+        }
+    }
+    for (std::uint32_t x : now) {
+        bool added = !has(old, x);
+        if (added) ++enrolled_[x];
+        for (std::uint32_t y : now) {
+            if (y != x && (added || !has(old, y))) counts_.add(x, y, +1);
+        }
+    }
+    old = std::move(now);
+}
+
+std::vector<CoEnrollment::Related> CoEnrollment::topWith(const std::string& course, std::size_t n) const {
+    ApiTimer timer(Api::TopCoEnrolled);
+    std::vector<Related> out;
+    const std::uint32_t* id = findCourse(course);
+    if (!id || n == 0 || enrolled_[*id] == 0) return out;
+
+    std::uint32_t r = *id;
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> row; // (column, count)
+    row.reserve(counts_.rowSizeBound(r));
+    counts_.forEach(r, [&](std::uint32_t col, std::uint32_t n) { row.emplace_back(col, n); });
+
+    auto better = [&](const std::pair<std::uint32_t, std::uint32_t>& a, const std::pair<std::uint32_t, std::uint32_t>& b) {
+        if (a.second != b.second) return a.second > b.second;
+        return names_[a.first] < names_[b.first];
+    };
+    std::size_t k = std::min(n, row.size());
+    std::partial_sort(row.begin(), row.begin() + static_cast<std::ptrdiff_t>(k), row.end(), better);
+    out.reserve(k);
+    double total = enrolled_[r];
+    for (std::size_t j = 0; j < k; ++j) {
+        out.push_back(Related{names_[row[j].first], row[j].second, row[j].second / total});
+    }
+    return out;
+}
+
+std::uint32_t CoEnrollment::together(const std::string& a, const std::string& b) const {
+    const std::uint32_t* x = findCourse(a);
+    const std::uint32_t* y = findCourse(b);
+    if (!x || !y || *x == *y) return 0;
+    return counts_.get(*x, *y);
+}
+
+std::uint32_t CoEnrollment::enrolled(const std::string& course) const {
+    const std::uint32_t* id = findCourse(course);
+    return id ? enrolled_[*id] : 0;
+}
+
+double CoEnrollment::affinity(const Profile& self, const Profile& other) const {
+    double sum = 0;
+    for (const auto& mine : self.courses()) {
+        const std::uint32_t* a = findCourse(mine);
+        if (!a || enrolled_[*a] == 0) continue;
+        for (const auto& theirs : other.courses()) {
+            if (std::find(self.courses().begin(), self.courses().end(), theirs) != self.courses().end()) continue;
+            const std::uint32_t* b = findCourse(theirs);
+            if (b && *b != *a) sum += static_cast<double>(counts_.get(*a, *b)) / enrolled_[*a];
+        }
+    }
+    return sum;
+}
+
+} // namespace sb
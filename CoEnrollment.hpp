@@ -0,0 +1,83 @@
+/***************************************************************************************
+ * CoEnrollment.hpp
+ * "Students who take CPSC 2150 also take ..." Sparse course x course co-enrollment counts.
+ *
+ * Entry (a, b) is the number of students enrolled in both a and b. It is stored as
+ * SparseCounts (CSR rows of (column, count) pairs sorted by column), so
+ *  - topWith(course, n) scans one row: O(row + n log n);
+ *  - together(a, b) is a binary search in row a.
+ *
+ * Build: course codes get ids (trim + upper-case, interned), a course -> students CSR is
+ * laid out by counting sort, and then each course row is computed independently (for every
+ * student of the course, count each of their other courses in a dense accumulator). Rows
+ * are split across the shared ThreadPool on large rosters.
+ *
+ * Updates: like OccupancyIndex, ids are Roster ids and update(id, p) diffs the student's
+ * course set against what the matrix last saw, so it can be driven by Roster::subscribe.
+ * A change touches O(courses^2) cells, each a SparseCounts::add into a per-row delta that
+ * is folded back into the CSR now and then. Queries are const and safe to call
+ * concurrently; update() is not.
+ *
+ * STANDARD LIBRARIES USED:
+ *  <cstdint>     : compact ids and counts
+ *  <string>      : course codes
+ *  <string_view> : interned course keys
+ *  <vector>      : course sets, results
+ ****************************************************************************************/
+#pragma once
+#include "Profile.hpp"
+#include "FlatMap.hpp"
+#include "SparseCounts.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace sb {
+
+class CoEnrollment {
+public:
+    struct Related {
+        std::string_view course; // interned upper-case code
+        std::uint32_t together;  // students enrolled in both
+        double share;            // together / students in the queried course
+    };
+
+    CoEnrollment() = default;
+    explicit CoEnrollment(const std::vector<Profile>& roster);
+
+    // Re-count profile 'id' from its current courses.
+    void update(std::size_t id, const Profile& p);
+
+    // Up to 'n' courses most often taken with 'course', by count DESC then code ASC.
+    std::vector<Related> topWith(const std::string& course, std::size_t n) const;
+
+    // Students enrolled in both (0 if either course is unknown or a == b).
+    std::uint32_t together(const std::string& a, const std::string& b) const;
+    // Students enrolled in the course (0 if unknown).
+    std::uint32_t enrolled(const std::string& course) const;
+
+    // How strongly 'other' takes courses that go with self's: for each of self's courses
+    // a and each of other's courses b that self does not take, the share of a's students
+    // also in b, summed. 0 when nothing is related. Used by MatchSuggester to rank ties.
+    double affinity(const Profile& self, const Profile& other) const;
+
+    std::size_t courseCount() const { return names_.size(); }
+    std::size_t nonZeros() const { return counts_.nonZeros(); } // upper bound while deltas are pending
+
+private:
+    const std::uint32_t* findCourse(const std::string& code) const;
+    std::uint32_t courseId(std::string_view code); // creates on first use
+    std::vector<std::uint32_t> courseSet(const Profile& p); // sorted, unique ids
+
+    FlatMap<std::string_view, std::uint32_t, StrHash> courseIds_; // interned upper-case codes
+    std::vector<std::string_view> names_;                         // by course id
+    std::vector<std::uint32_t> enrolled_;                         // by course id
+    SparseCounts counts_;                                         // course x course
+
+    std::vector<std::vector<std::uint32_t>> byId_; // course set last seen per roster id
+};
+
+} // namespace sb
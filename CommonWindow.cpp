@@ -0,0 +1,134 @@
+/***************************************************************************************
+ * CommonWindow.cpp — implementation
+ ****************************************************************************************/
+#include "CommonWindow.hpp"
+#include "Metrics.hpp"
+
+#include <algorithm>
+#include <array>
+
+namespace sb {
+
+namespace {
+
+constexpr int kDayMinutes = 24 * 60;
+constexpr int kWeekMinutes = 7 * kDayMinutes;
+
+// Slots and sessions on one absolute axis: minutes since Monday 00:00.
+int weekStart(Day day, int minute) { return static_cast<int>(day) * kDayMinutes + minute; }
+int weekStart(const AvailabilitySlot& s) { return weekStart(s.day, s.start); }
+int weekEnd(const AvailabilitySlot& s) { return weekStart(s.day, s.end); }
+
+bool inWeekOrder(const std::vector<AvailabilitySlot>& slots) {
+    for (std::size_t i = 1; i < slots.size(); ++i) {
+        if (weekStart(slots[i]) < weekStart(slots[i - 1])) return false;
+    }
+    return true;
+}
+
+struct Cursor {
+    const AvailabilitySlot* first;
+    const AvailabilitySlot* p;
+    const AvailabilitySlot* end;
+};
+
+// End of the coalesced same-day run starting at c.p.
+int runEnd(const Cursor& c) {
+    int end = weekEnd(*c.p);
+    for (const AvailabilitySlot* q = c.p + 1; q != c.end && q->day == c.p->day && weekStart(*q) <= end; ++q) {
+        end = std::max(end, weekEnd(*q));
+    }
+    return end;
+}
+
+// Earliest start >= t of a 'duration' window free for every cursor and clear of 'busy',
+// or -1. Cursors and the busy index only move forward.
+int scan(Cursor* cur, std::size_t n, const std::vector<const StudySession*>& busy, int t, int duration) {
+    std::size_t b = 0;
+    while (t + duration <= kWeekMinutes) {
+        int common = kWeekMinutes;
+        bool moved = false;
+        for (std::size_t i = 0; i < n; ++i) {
+            Cursor& c = cur[i];
+            while (c.p != c.end && weekEnd(*c.p) <= t) ++c.p;
+            if (c.p == c.end) return -1;
+            int start = weekStart(*c.p);
+            if (start > t) { // not free at t: jump to this student's next run
+                t = start;
+                moved = true;
+                break;
+            }
+            common = std::min(common, runEnd(c));
+        }
+        if (moved) continue;
+        if (common - t < duration) {
+            t = common;
+            continue;
+        }
+        while (b < busy.size() && weekStart(busy[b]->day, busy[b]->end) <= t) ++b;
+        if (b < busy.size() && weekStart(busy[b]->day, busy[b]->start) < t + duration) {
+            t = weekStart(busy[b]->day, busy[b]->end);
+            continue;
+        }
+        return t;
+    }
+    return -1;
+}
+
+std::optional<FreeWindow> search(Cursor* cur, std::size_t n, WeekTime from, int duration,
+                                 const std::vector<const StudySession*>& busy) {
+    if (n == 0 || duration <= 0 || duration > kDayMinutes) return std::nullopt;
+    int t = weekStart(from.day, std::clamp(from.minute, 0, kDayMinutes));
+    bool nextWeek = false;
+    int found = scan(cur, n, busy, t, duration);
+    if (found < 0 && t > 0) {
+        for (std::size_t i = 0; i < n; ++i) cur[i].p = cur[i].first;
+        found = scan(cur, n, busy, 0, duration);
+        nextWeek = true;
+    }
+    if (found < 0) return std::nullopt;
+    int start = found % kDayMinutes;
+    return FreeWindow{static_cast<Day>(found / kDayMinutes), start, start + duration, nextWeek};
+}
+
+// Cursors over each student's slots (sorting a copy if needed), then search.
+std::optional<FreeWindow> searchPeople(const Profile* const* people, std::size_t n, WeekTime from,
+                                       int duration, const std::vector<const StudySession*>& busy) {
+    ApiTimer timer(Api::NextCommonWindow);
+    std::array<Cursor, kInlinePeople> inlineCursors;
+    std::vector<Cursor> heapCursors;
+    Cursor* cur = inlineCursors.data();
+    if (n > kInlinePeople) {
+        heapCursors.resize(n);
+        cur = heapCursors.data();
+    }
+
+    std::vector<std::vector<AvailabilitySlot>> sortedCopies; // out-of-order profiles only
+    for (std::size_t i = 0; i < n; ++i) {
+        const std::vector<AvailabilitySlot>* slots = &people[i]->availability();
+        if (!inWeekOrder(*slots)) {
+            sortedCopies.push_back(*slots);
+            std::sort(sortedCopies.back().begin(), sortedCopies.back().end(),
+                      [](const AvailabilitySlot& x, const AvailabilitySlot& y) { return weekStart(x) < weekStart(y); });
+            slots = &sortedCopies.back(); // its buffer survives later push_backs
+        }
+        const AvailabilitySlot* first = slots->data();
+        cur[i] = Cursor{first, first, first + slots->size()};
+    }
+    return search(cur, n, from, duration, busy);
+}
+
+} // namespace
+
+std::optional<FreeWindow> nextCommonWindow(const Profile& a, const Profile& b, WeekTime from,
+                                           int durationMin, const std::vector<const StudySession*>& busy) {
+    const Profile* pair[] = {&a, &b};
+    return searchPeople(pair, 2, from, durationMin, busy);
+}
+
+std::optional<FreeWindow> nextCommonWindow(const std::vector<const Profile*>& people, WeekTime from,
+                                           int durationMin, const std::vector<const StudySession*>& busy) {
+    return searchPeople(people.data(), people.size(), from, durationMin, busy);
+}
+
+} // namespace sb
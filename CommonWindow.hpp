@@ -0,0 +1,59 @@
+/***************************************************************************************
+ * CommonWindow.hpp
+ * "When can we next meet?" First window of a given length, at or after a point in the
+ * week, in which every listed student is free and none of them has a confirmed session.
+ *
+ * Each student's slots are walked with one cursor in (day, start) order, the order
+ * AvailabilityManager / AvailabilityEditor keep them in; touching slots on a day are
+ * coalesced on the fly. The candidate start only moves forward: to the latest run start
+ * among the students, past the earliest run end when the overlap is too short, or past a
+ * clashing session. Each step is O(students) and there are at most slots + sessions
+ * steps, so a pair query is linear in their slots. Nothing is allocated for up to
+ * kInlinePeople students (a profile whose slots are out of order is sorted into a copy).
+ *
+ * Windows stay within one day. The search covers [from, end of week) and then wraps to
+ * the start of the week, in which case the result is flagged nextWeek.
+ *
+ * STANDARD LIBRARIES USED:
+ *  <optional> : "no common window"
+ *  <vector>   : people, busy sessions
+ ****************************************************************************************/
+#pragma once
+#include "Profile.hpp"
+#include "SessionRequests.hpp"
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+namespace sb {
+
+// A point in the weekly timetable.
+struct WeekTime {
+    Day day;
+    int minute; // minutes since midnight
+};
+
+struct FreeWindow {
+    Day day;
+    int start;     // minutes since midnight
+    int end;       // start + requested duration
+    bool nextWeek; // found only after wrapping past the end of the week
+};
+
+// Students handled without any heap allocation by the n-user form.
+constexpr std::size_t kInlinePeople = 16;
+
+// First 'durationMin'-minute window at or after 'from' (wrapping once) in which 'a' and
+// 'b' are both free. 'busy' must be sorted by (day, start), e.g. from
+// SessionRequests::confirmedAmong(); any overlap with one of them rejects a window.
+std::optional<FreeWindow> nextCommonWindow(const Profile& a, const Profile& b, WeekTime from,
+                                           int durationMin,
+                                           const std::vector<const StudySession*>& busy = {});
+
+// Same for any number of students (empty 'people' finds nothing).
+std::optional<FreeWindow> nextCommonWindow(const std::vector<const Profile*>& people, WeekTime from,
+                                           int durationMin,
+                                           const std::vector<const StudySession*>& busy = {});
+
+} // namespace sb
@@ -0,0 +1,181 @@
+/***************************************************************************************
+ * CourseHeatmap.cpp — implementation
+ ****************************************************************************************/
+#include "CourseHeatmap.hpp"
+#include "Metrics.hpp"
+#include "OccupancyIndex.hpp"
+#include "StringPool.hpp"
+#include "Utils.hpp"
+
+#include <algorithm>
+
+namespace sb {
+
+/* ------------------------------ Fenwick pair ------------------------------ */
+
+// Trees are 1-based over positions [0, kBuckets]; position i lives at index i + 1.
+static constexpr int kTreeSize = CourseHeatmap::kBuckets + 1;
+
+static void fenwickAdd(std::vector<long long>& t, int pos, long long v) {
+    for (int j = pos + 1; j <= kTreeSize; j += j & -j) t[static_cast<std::size_t>(j)] += v;
+}
+
+static long long fenwickSum(const std::vector<long long>& t, int k) { // positions [0, k)
+    long long s = 0;
+    for (int j = k; j > 0; j -= j & -j) s += t[static_cast<std::size_t>(j)];
+    return s;
+}
+
+void CourseHeatmap::Course::rangeAdd(int lo, int hi, int v) {
+    fenwickAdd(d, lo, v);
+    fenwickAdd(d, hi, -v);
+    fenwickAdd(di, lo, static_cast<long long>(v) * lo);
+    fenwickAdd(di, hi, -static_cast<long long>(v) * hi);
+}
+
+long long CourseHeatmap::Course::prefix(int k) const {
+    // sum_{b<k} counts[b] = sum_{i<k} D[i] * (k - i)
+    return static_cast<long long>(k) * fenwickSum(d, k) - fenwickSum(di, k);
+}
+
+std::vector<long long> CourseHeatmap::Course::counts(int lo, int hi) const {
+    // Undo the O(n) Fenwick construction to get D back, then prefix-sum it.
+    std::vector<long long> t(d);
+    for (int j = kTreeSize; j >= 1; --j) {
+        int parent = j + (j & -j);
+        if (parent <= kTreeSize) t[static_cast<std::size_t>(parent)] -= t[static_cast<std::size_t>(j)];
+    }
+    std::vector<long long> out;
+    out.reserve(static_cast<std::size_t>(hi - lo));
+    long long running = 0;
+    for (int b = 0; b < hi; ++b) {
+        running += t[static_cast<std::size_t>(b + 1)];
+        if (b >= lo) out.push_back(running);
+    }
+    return out;
+}
+
+/* ------------------------------ CourseHeatmap ------------------------------ */
+
+CourseHeatmap::CourseHeatmap(const std::vector<Profile>& roster) {
+    for (std::size_t i = 0; i < roster.size(); ++i) update(i, roster[i]);
+}
+
+std::uint32_t CourseHeatmap::courseId(std::string_view code) {
+    std::string key = upperCopy(trim(std::string(code)));
+    if (const std::uint32_t* id = courseIds_.find(std::string_view(key))) return *id;
+    auto id = static_cast<std::uint32_t>(courses_.size());
+    courses_.emplace_back();
+    courseIds_.tryEmplace(intern(key), id);
+    return id;
+}
+
+const CourseHeatmap::Course* CourseHeatmap::find(const std::string& course) const {
+    std::string key = upperCopy(trim(course));
+    const std::uint32_t* id = courseIds_.find(std::string_view(key));
+    return id ? &courses_[*id] : nullptr;
+}
+
+std::vector<std::pair<std::uint16_t, std::uint16_t>> CourseHeatmap::bucketRanges(const Profile& p) {
+    std::vector<std::pair<std::uint16_t, std::uint16_t>> out;
+    DayRuns runs = freeRunsByDay(p.availability());
+    for (int d = 0; d < 7; ++d) {
+        for (const auto& r : runs[d]) {
+            // Only buckets the run covers completely.
+            int lo = std::max(0, (r.first + kBucketMinutes - 1) / kBucketMinutes);
+            int hi = std::min(kBucketsPerDay, r.second / kBucketMinutes);
+            if (lo < hi) {
+                out.push_back({static_cast<std::uint16_t>(d * kBucketsPerDay + lo),
+                               static_cast<std::uint16_t>(d * kBucketsPerDay + hi)});
+            }
+        }
+    }
+    return out;
+}
+
+void CourseHeatmap::apply(const Seen& s, int sign) {
+    for (std::uint32_t cid : s.courses) {
+        Course& c = courses_[cid];
+        c.enrolled += sign;
+        for (const auto& r : s.ranges) c.rangeAdd(r.first, r.second, sign);
+    }
+}
+
+void CourseHeatmap::update(std::size_t id, const Profile& p) {
+    if (id >= byId_.size()) byId_.resize(id + 1);
+    Seen now;
+    for (const auto& c : p.courses()) {
+        std::uint32_t cid = courseId(c);
+        if (std::find(now.courses.begin(), now.courses.end(), cid) == now.courses.end()) now.courses.push_back(cid);
+    }
+    now.schedule = p.availabilityCommitted() ? p.schedule() : nullptr;
+
+    Seen& old = byId_[id];
+    if (now.courses == old.courses && now.schedule && now.schedule == old.schedule) return;
+    if (!now.courses.empty()) now.ranges = bucketRanges(p);
+    apply(old, -1);
+    apply(now, +1);
+    old = std::move(now);
+}
+
+int CourseHeatmap::enrolled(const std::string& course) const {
+    const Course* c = find(course);
+    return c ? c->enrolled : 0;
+}
+
+std::vector<int> CourseHeatmap::dayCounts(const std::string& course, Day day) const {
+    std::vector<int> out;
+    const Course* c = find(course);
+    if (!c) return out;
+    int base = static_cast<int>(day) * kBucketsPerDay;
+    for (long long n : c->counts(base, base + kBucketsPerDay)) out.push_back(static_cast<int>(n));
+    return out;
+}
+
+long long CourseHeatmap::freeStudentBuckets(const std::string& course, Day day, int start, int end) const {
+    const Course* c = find(course);
+    if (!c) return 0;
+    int lo = std::max(0, (start + kBucketMinutes - 1) / kBucketMinutes);
+    int hi = std::min(kBucketsPerDay, end / kBucketMinutes);
+    if (lo >= hi) return 0;
+    int base = static_cast<int>(day) * kBucketsPerDay;
+    return c->prefix(base + hi) - c->prefix(base + lo);
+}
+
+std::optional<CourseHeatmap::Window>
+CourseHeatmap::bestWindow(const std::string& course, int minutes, std::optional<Day> onlyDay,
+                          int earliest, int latest) const {
+    ApiTimer timer(Api::BestWindow);
+    const Course* c = find(course);
+    int width = (minutes + kBucketMinutes - 1) / kBucketMinutes;
+    int first = std::max(0, (earliest + kBucketMinutes - 1) / kBucketMinutes);
+    int last = std::min(kBucketsPerDay, latest / kBucketMinutes);
+    if (!c || width <= 0 || last - first < width) return std::nullopt;
+
+    std::vector<long long> week = c->counts(0, kBuckets);
+    std::optional<Window> best;
+    long long bestSum = -1;
+    for (int d = 0; d < 7; ++d) {
+        if (onlyDay && static_cast<int>(*onlyDay) != d) continue;
+        const long long* counts = week.data() + d * kBucketsPerDay;
+        long long sum = 0;
+        for (int b = first; b < first + width; ++b) sum += counts[b];
+        for (int b = first;; ++b) { // window [b, b + width)
+            if (sum > bestSum) {
+                bestSum = sum;
+                best = Window{static_cast<Day>(d), b * kBucketMinutes, (b + width) * kBucketMinutes,
+                              static_cast<double>(sum) / width, 0};
+            }
+            if (b + width >= last) break;
+            sum += counts[b + width] - counts[b];
+        }
+    }
+    if (best) {
+        const long long* counts = week.data() + static_cast<int>(best->day) * kBucketsPerDay;
+        int lo = best->start / kBucketMinutes;
+        best->minFree = static_cast<int>(*std::min_element(counts + lo, counts + lo + width));
+    }
+    return best;
+}
+
+} // namespace sb
@@ -0,0 +1,107 @@
+/***************************************************************************************
+ * CourseHeatmap.hpp
+ * When is most of a course free? Per-course weekly histogram of free students.
+ *
+ * The week is cut into kBuckets buckets of kBucketMinutes; a student counts as free in a
+ * bucket when one of their (coalesced) free runs covers all of it. Each course keeps two
+ * Fenwick trees over the difference array of those counts (D and i*D), so:
+ *  - an availability edit is a +1/-1 range update per free run: O(log buckets);
+ *  - the free student-buckets in any window come from two prefix sums: O(log buckets);
+ *  - a whole day's counts are recovered from the tree in O(buckets), which is what
+ *    bestWindow() slides over (O(buckets) per query, no per-student work).
+ *
+ * Like OccupancyIndex, ids are Roster ids and update(id, p) diffs against what the map
+ * last saw for that id, so it can be driven by Roster::subscribe. Course codes match
+ * after trim + upper-case. Queries are const and safe to call concurrently; update() is not.
+ *
+ * STANDARD LIBRARIES USED:
+ *  <cstdint>     : bucket indexes
+ *  <optional>    : "no such course" / day filter
+ *  <string>      : course codes
+ *  <string_view> : interned course keys
+ *  <utility>     : bucket ranges
+ *  <vector>      : Fenwick trees, per-day counts
+ ****************************************************************************************/
+#pragma once
+#include "Profile.hpp"
+#include "FlatMap.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace sb {
+
+class CourseHeatmap {
+public:
+    static constexpr int kBucketMinutes = 15;
+    static constexpr int kBucketsPerDay = 24 * 60 / kBucketMinutes;
+    static constexpr int kBuckets = 7 * kBucketsPerDay;
+
+    // The best window found by bestWindow().
+    struct Window {
+        Day day;
+        int start;          // minutes since midnight
+        int end;
+        double averageFree; // mean free students over the window's buckets
+        int minFree;        // fewest free students in any bucket of the window
+    };
+
+    CourseHeatmap() = default;
+    explicit CourseHeatmap(const std::vector<Profile>& roster);
+
+    // Re-count profile 'id' from its current courses and availability.
+    void update(std::size_t id, const Profile& p);
+
+    // Students enrolled in the course (0 if unknown).
+    int enrolled(const std::string& course) const;
+
+    // Free students in each bucket of 'day' (kBucketsPerDay entries; empty if unknown course).
+    std::vector<int> dayCounts(const std::string& course, Day day) const;
+
+    // Sum over the whole buckets inside [start, end) on 'day' of the free-student count.
+    long long freeStudentBuckets(const std::string& course, Day day, int start, int end) const;
+
+    // Window of 'minutes' (rounded up to whole buckets) inside [earliest, latest) with the
+    // highest average number of free students; ties go to the earliest day and time.
+    // Restricted to 'onlyDay' when given. nullopt for an unknown course or a window
+    // that does not fit.
+    std::optional<Window> bestWindow(const std::string& course, int minutes,
+                                     std::optional<Day> onlyDay = std::nullopt,
+                                     int earliest = 0, int latest = 24 * 60) const;
+
+    std::size_t courseCount() const { return courseIds_.size(); }
+
+private:
+    // Range-update / range-query Fenwick pair over bucket indexes [0, kBuckets].
+    struct Course {
+        int enrolled = 0;
+        std::vector<long long> d;  // Fenwick over D (count differences)
+        std::vector<long long> di; // Fenwick over i * D
+        Course() : d(kBuckets + 2, 0), di(kBuckets + 2, 0) {}
+        void rangeAdd(int lo, int hi, int v); // counts[lo, hi) += v
+        long long prefix(int k) const;        // sum of counts[0, k)
+        std::vector<long long> counts(int lo, int hi) const; // counts[lo, hi) in O(kBuckets)
+    };
+
+    struct Seen {
+        std::vector<std::uint32_t> courses;
+        std::vector<std::pair<std::uint16_t, std::uint16_t>> ranges; // week buckets [lo, hi)
+        ScheduleRef schedule;
+    };
+
+    const Course* find(const std::string& course) const;
+    std::uint32_t courseId(std::string_view code);
+    static std::vector<std::pair<std::uint16_t, std::uint16_t>> bucketRanges(const Profile& p);
+    void apply(const Seen& s, int sign);
+
+    FlatMap<std::string_view, std::uint32_t, StrHash> courseIds_; // interned upper-case codes
+    std::vector<Course> courses_;
+    std::vector<Seen> byId_;
+};
+
+} // namespace sb
@@ -0,0 +1,149 @@
+/***************************************************************************************
+ * EnrollmentSync.cpp — implementation
+ ****************************************************************************************/
+#include "EnrollmentSync.hpp"
+#include "Utils.hpp"
+
+#include <algorithm>
+#include <istream>
+#include <iterator>
+#include <limits>
+
+namespace sb {
+
+static std::string courseKey(const std::string& raw) { return upperCopy(trim(raw)); }
+
+static void sortUnique(std::vector<std::string>& v) {
+    std::sort(v.begin(), v.end());
+    v.erase(std::unique(v.begin(), v.end()), v.end());
+}
+
+std::vector<Enrollment> EnrollmentSync::groupRows(std::vector<std::pair<std::string, std::string>> rows) {
+    for (auto& r : rows) r.first = trim(std::move(r.first));
+    std::sort(rows.begin(), rows.end(),
+              [](const auto& a, const auto& b) { return a.first < b.first; });
+    std::vector<Enrollment> out;
+    for (auto& r : rows) {
+        if (r.first.empty()) continue;
+        if (out.empty() || out.back().email != r.first) out.push_back(Enrollment{r.first, {}});
+        out.back().courses.push_back(std::move(r.second));
+    }
+    return out;
+}
+
+std::vector<std::pair<std::string, std::string>> EnrollmentSync::readRows(std::istream& in) {
+    std::vector<std::pair<std::string, std::string>> rows;
+    std::string line;
+    while (std::getline(in, line)) {
+        std::string_view v = trimView(line);
+        if (v.empty() || v.front() == '#') continue;
+        auto comma = v.find(',');
+        if (comma == std::string_view::npos) continue;
+        std::string_view email = trimView(v.substr(0, comma));
+        std::string_view course = trimView(v.substr(comma + 1));
+        if (email.empty() || course.empty()) continue;
+        rows.emplace_back(std::string(email), std::string(course));
+    }
+    return rows;
+}
+
+static constexpr std::size_t kNone = std::numeric_limits<std::size_t>::max();
+
+// plan() for any roster: 'idOf(email)' is the profile's index, or kNone.
+template <class IdOf>
+static EnrollmentPlan planFor(const std::vector<Profile>& profiles, IdOf&& idOf,
+                              const std::vector<Enrollment>& dump, EnrollmentSync::Unlisted unlisted) {
+    constexpr std::size_t none = kNone;
+    EnrollmentPlan out;
+
+    // Wanted course set per listed roster id.
+    std::vector<std::size_t> slotOf(profiles.size(), none);
+    std::vector<std::vector<std::string>> wanted;
+    for (const auto& e : dump) {
+        std::size_t id = idOf(e.email);
+        if (id == none) { out.unknownEmails.push_back(trim(e.email)); continue; }
+        std::size_t& slot = slotOf[id];
+        if (slot == none) { slot = wanted.size(); wanted.emplace_back(); }
+        for (const auto& c : e.courses) {
+            std::string key = courseKey(c);
+            if (!key.empty()) wanted[slot].push_back(std::move(key));
+        }
+    }
+    sortUnique(out.unknownEmails);
+    for (auto& w : wanted) sortUnique(w);
+
+    static const std::vector<std::string> nothing;
+    std::vector<std::string> have;
+    for (std::size_t id = 0; id < profiles.size(); ++id) {
+        if (slotOf[id] == none && unlisted == EnrollmentSync::Unlisted::Keep) continue;
+        const std::vector<std::string>& want = slotOf[id] == none ? nothing : wanted[slotOf[id]];
+
+        have.clear();
+        for (const auto& c : profiles[id].courses()) {
+            std::string key = courseKey(c);
+            if (!key.empty()) have.push_back(std::move(key));
+        }
+        sortUnique(have);
+
+        EnrollmentChange change{id, {}, {}};
+        std::set_difference(want.begin(), want.end(), have.begin(), have.end(), std::back_inserter(change.added));
+        std::set_difference(have.begin(), have.end(), want.begin(), want.end(), std::back_inserter(change.dropped));
+        if (change.added.empty() && change.dropped.empty()) {
+            if (slotOf[id] != none) ++out.unchanged;
+            continue;
+        }
+        out.changes.push_back(std::move(change));
+    }
+    return out;
+}
+
+EnrollmentPlan EnrollmentSync::plan(const Roster& roster, const std::vector<Enrollment>& dump,
+                                    Unlisted unlisted) {
+    auto idOf = [&](const std::string& email) {
+        Roster::Handle h = roster.handleByEmail(email);
+        return h.valid() ? h.id() : kNone;
+    };
+    return planFor(roster.profiles(), idOf, dump, unlisted);
+}
+
+EnrollmentPlan EnrollmentSync::plan(const RosterSnapshot::Pin& roster, const std::vector<Enrollment>& dump,
+                                    Unlisted unlisted) {
+    const std::vector<Profile>& profiles = roster.profiles();
+    auto idOf = [&](const std::string& email) {
+        const Profile* p = roster.findByEmail(email);
+        return p ? static_cast<std::size_t>(p - profiles.data()) : kNone;
+    };
+    return planFor(profiles, idOf, dump, unlisted);
+}
+
+static void applyChange(Profile& p, const EnrollmentChange& change) {
+    auto& list = p.coursesMutable();
+    if (!change.dropped.empty()) {
+        list.erase(std::remove_if(list.begin(), list.end(), [&](const std::string& c) {
+                       return std::binary_search(change.dropped.begin(), change.dropped.end(), courseKey(c));
+                   }),
+                   list.end());
+    }
+    list.insert(list.end(), change.added.begin(), change.added.end());
+}
+
+void EnrollmentSync::apply(Roster& roster, const EnrollmentPlan& plan) {
+    for (const auto& change : plan.changes) {
+        roster.edit(roster.handle(change.id), [&](Profile& p) { applyChange(p, change); });
+    }
+}
+
+void EnrollmentSync::apply(RosterSnapshot& roster, const EnrollmentPlan& plan) {
+    if (plan.changes.empty()) return;
+    roster.update([&](std::vector<Profile>& profiles) {
+        for (const auto& change : plan.changes) applyChange(profiles[change.id], change);
+    }, false); // emails are unchanged
+}
+
+EnrollmentPlan EnrollmentSync::sync(Roster& roster, const std::vector<Enrollment>& dump, Unlisted unlisted) {
+    EnrollmentPlan p = plan(roster, dump, unlisted);
+    apply(roster, p);
+    return p;
+}
+
+} // namespace sb
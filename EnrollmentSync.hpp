@@ -0,0 +1,87 @@
+/***************************************************************************************
+ * EnrollmentSync.hpp
+ * Reconcile a registrar enrollment dump against the roster in one silent batch.
+ *
+ * The dump says, for each student (by email), exactly which courses they are in. plan()
+ * normalizes every set (trim + upper-case, sorted, de-duplicated), compares it with the
+ * student's current courses by a sorted merge and records only the differences; apply()
+ * then performs one Roster::edit per changed student, so subscribed indexes see exactly
+ * one event per student whose enrollment actually moved. Nothing is printed; unknown
+ * emails are reported back instead of creating profiles.
+ *
+ * Cost: O(R log R) for R dump rows (the sorts) plus O(c) per student for the merge,
+ * independent of how the per-course lists are displayed or indexed.
+ *
+ * The same plan/apply pair works on a RosterSnapshot (the server's roster): plan() reads a
+ * pinned version, apply() publishes every change as one new version, in which only the
+ * changed profiles are new copies. Readers see the old roster or the new one, never a mix.
+ *
+ * STANDARD LIBRARIES USED:
+ *  <cstddef>  : roster ids, counts
+ *  <iosfwd>   : CSV dumps (std::istream)
+ *  <string>   : emails, course codes
+ *  <utility>  : (email, course) rows
+ *  <vector>   : enrollments, change lists
+ ****************************************************************************************/
+#pragma once
+#include "Roster.hpp"
+#include "RosterSnapshot.hpp"
+
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace sb {
+
+// One student's complete course set according to the registrar.
+struct Enrollment {
+    std::string email;
+    std::vector<std::string> courses;
+};
+
+// Difference for one roster profile; both lists are normalized and sorted.
+struct EnrollmentChange {
+    std::size_t id;
+    std::vector<std::string> added;
+    std::vector<std::string> dropped;
+};
+
+struct EnrollmentPlan {
+    std::vector<EnrollmentChange> changes;  // ascending id
+    std::vector<std::string> unknownEmails; // in the dump, not in the roster (sorted)
+    std::size_t unchanged = 0;              // listed students whose set already matched
+};
+
+class EnrollmentSync {
+public:
+    // What happens to roster students the dump does not mention.
+    enum class Unlisted { Keep, DropAll };
+
+    // Group flat (email, course) rows into one Enrollment per email.
+    static std::vector<Enrollment> groupRows(std::vector<std::pair<std::string, std::string>> rows);
+
+    // Read "email,course" lines (blank lines and lines starting with '#' are skipped).
+    static std::vector<std::pair<std::string, std::string>> readRows(std::istream& in);
+
+    // Compute per-student differences without touching the roster. An email listed more
+    // than once contributes the union of its sets.
+    static EnrollmentPlan plan(const Roster& roster, const std::vector<Enrollment>& dump,
+                               Unlisted unlisted = Unlisted::Keep);
+
+    static EnrollmentPlan plan(const RosterSnapshot::Pin& roster, const std::vector<Enrollment>& dump,
+                               Unlisted unlisted = Unlisted::Keep);
+
+    // Apply a plan: kept courses stay in their current order, added ones are appended.
+    static void apply(Roster& roster, const EnrollmentPlan& plan);
+    // The plan must come from a pin of the version being replaced (profile ids are stable,
+    // but a profile edited in between would be diffed against stale courses).
+    static void apply(RosterSnapshot& roster, const EnrollmentPlan& plan);
+
+    // plan() followed by apply(); returns the plan that was applied.
+    static EnrollmentPlan sync(Roster& roster, const std::vector<Enrollment>& dump,
+                               Unlisted unlisted = Unlisted::Keep);
+};
+
+} // namespace sb
@@ -0,0 +1,246 @@
+/***************************************************************************************
+ * EpollServer.cpp — implementation (Linux: epoll, eventfd, AF_UNIX)
+ ****************************************************************************************/
+#include "EpollServer.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace sb {
+
+// Stop reading from a client whose unsent responses exceed this many bytes.
+static constexpr std::size_t kMaxPendingOut = 4u << 20;
+// Read at most this much from one client per wakeup (level-triggered: the rest is read
+// on the next round, after the other ready clients).
+static constexpr std::size_t kMaxReadPerWakeup = 256u << 10;
+// Heavy requests one client may have on the pool; further frames wait in its buffer.
+static constexpr std::size_t kMaxHeavyInFlight = 32;
+
+/* -------------------------------- EpollServer -------------------------------- */
+
+EpollServer::EpollServer(StudyBuddyService& svc, std::string socketPath, std::size_t workers)
+    : svc_(svc), path_(std::move(socketPath)), pool_(workers == 0 ? 1 : workers) {}
+
+EpollServer::~EpollServer() {
+    for (auto& kv : conns_) ::close(kv.first);
+    if (listenFd_ >= 0) { ::close(listenFd_); ::unlink(path_.c_str()); }
+    if (wakeFd_ >= 0) ::close(wakeFd_);
+    if (epollFd_ >= 0) ::close(epollFd_);
+}
+
+bool EpollServer::start(std::string& err) {
+    sockaddr_un addr{};
+    if (path_.size() >= sizeof(addr.sun_path)) { err = "socket path too long"; return false; }
+    addr.sun_family = AF_UNIX;
+    std::memcpy(addr.sun_path, path_.c_str(), path_.size() + 1);
+
+    listenFd_ = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listenFd_ < 0) { err = std::string("socket: ") + std::strerror(errno); return false; }
+    ::unlink(path_.c_str());
+    if (::bind(listenFd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        err = std::string("bind: ") + std::strerror(errno); return false;
+    }
+    if (::listen(listenFd_, SOMAXCONN) < 0) {
+        err = std::string("listen: ") + std::strerror(errno); return false;
+    }
+
+    epollFd_ = ::epoll_create1(EPOLL_CLOEXEC);
+    wakeFd_  = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (epollFd_ < 0 || wakeFd_ < 0) { err = std::string("epoll/eventfd: ") + std::strerror(errno); return false; }
+
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.fd = listenFd_;
+    ::epoll_ctl(epollFd_, EPOLL_CTL_ADD, listenFd_, &ev);
+    ev.data.fd = wakeFd_;
+    ::epoll_ctl(epollFd_, EPOLL_CTL_ADD, wakeFd_, &ev);
+    return true;
+}
+
+void EpollServer::stop() {
+    stop_.store(true, std::memory_order_relaxed);
+    if (wakeFd_ >= 0) {
+        std::uint64_t one = 1;
+        ssize_t r = ::write(wakeFd_, &one, sizeof(one));
+        (void)r;
+    }
+}
+
+void EpollServer::run() {
+    epoll_event events[64];
+    while (!stop_.load(std::memory_order_relaxed)) {
+        int n = ::epoll_wait(epollFd_, events, 64, -1);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        for (int i = 0; i < n; ++i) {
+            int fd = events[i].data.fd;
+            std::uint32_t e = events[i].events;
+            if (fd == listenFd_) { acceptAll(); continue; }
+            if (fd == wakeFd_) {
+                std::uint64_t cnt;
+                while (::read(wakeFd_, &cnt, sizeof(cnt)) > 0) {}
+                drainCompletions();
+                continue;
+            }
+            if (e & (EPOLLERR | EPOLLHUP)) { closeConn(fd); continue; }
+            if (e & EPOLLIN)  onReadable(fd);
+            if ((e & EPOLLOUT) && conns_.count(fd)) onWritable(fd);
+        }
+    }
+}
+
+void EpollServer::acceptAll() {
+    while (true) {
+        int fd = ::accept4(listenFd_, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) return; // EAGAIN or transient error; retry on next readiness
+        Conn& c = conns_[fd];
+        c = Conn{};
+        c.id = nextConnId_++;
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.fd = fd;
+        ::epoll_ctl(epollFd_, EPOLL_CTL_ADD, fd, &ev);
+    }
+}
+
+void EpollServer::onReadable(int fd) {
+    auto it = conns_.find(fd);
+    if (it == conns_.end()) return;
+    Conn& c = it->second;
+
+    std::uint8_t buf[16384];
+    std::size_t total = 0;
+    while (total < kMaxReadPerWakeup) {
+        ssize_t r = ::read(fd, buf, sizeof(buf));
+        if (r > 0) {
+            c.in.insert(c.in.end(), buf, buf + r);
+            total += static_cast<std::size_t>(r);
+            continue;
+        }
+        if (r == 0) { closeConn(fd); return; }
+        if (errno == EINTR) continue;
+        if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+        closeConn(fd);
+        return;
+    }
+    processFrames(fd, c);
+}
+
+void EpollServer::processFrames(int fd, Conn& c) {
+    std::size_t pos = 0;
+    while (true) {
+        std::uint32_t bodyLen = 0;
+        bool malformed = false;
+        if (!wire::peekFrame(c.in.data() + pos, c.in.size() - pos, bodyLen, malformed)) {
+            if (malformed) { closeConn(fd); return; }
+            break;
+        }
+        if (bodyLen == 0) { closeConn(fd); return; }
+        const std::uint8_t* body = c.in.data() + pos + 4;
+        auto op = static_cast<wire::Op>(body[0]);
+        bool heavy = StudyBuddyService::isHeavy(op);
+        if (heavy && c.inFlight >= kMaxHeavyInFlight) break; // resumed by drainCompletions
+        pos += 4 + bodyLen;
+
+        if (heavy) {
+            ++c.inFlight;
+            std::vector<std::uint8_t> copy(body, body + bodyLen);
+            std::uint64_t connId = c.id;
+            pool_.submit([this, fd, connId, copy = std::move(copy)] {
+                auto frame = svc_.handle(copy.data(), copy.size());
+                {
+                    std::lock_guard<std::mutex> lk(doneMu_);
+                    done_.push_back(Completion{fd, connId, std::move(frame)});
+                }
+                std::uint64_t one = 1;
+                ssize_t r = ::write(wakeFd_, &one, sizeof(one));
+                (void)r;
+            });
+        } else {
+            auto frame = svc_.handle(body, bodyLen);
+            c.out.insert(c.out.end(), frame.begin(), frame.end());
+        }
+    }
+    c.in.erase(c.in.begin(), c.in.begin() + static_cast<std::ptrdiff_t>(pos));
+    if (flush(fd, c)) updateInterest(fd, c);
+}
+
+void EpollServer::queueOutput(int fd, Conn& c, const std::vector<std::uint8_t>& frame) {
+    c.out.insert(c.out.end(), frame.begin(), frame.end());
+    if (flush(fd, c)) updateInterest(fd, c);
+}
+
+void EpollServer::drainCompletions() {
+    std::vector<Completion> batch;
+    {
+        std::lock_guard<std::mutex> lk(doneMu_);
+        batch.swap(done_);
+    }
+    for (auto& d : batch) {
+        auto it = conns_.find(d.fd);
+        // The client may have disconnected (and its fd been reused) meanwhile.
+        if (it == conns_.end() || it->second.id != d.connId) continue;
+        Conn& c = it->second;
+        if (c.inFlight-- < kMaxHeavyInFlight) {
+            queueOutput(d.fd, c, d.frame);
+            continue;
+        }
+        c.out.insert(c.out.end(), d.frame.begin(), d.frame.end());
+        processFrames(d.fd, c); // frames held back by the cap; flushes and re-arms reading
+    }
+}
+
+void EpollServer::onWritable(int fd) {
+    auto it = conns_.find(fd);
+    if (it == conns_.end()) return;
+    if (flush(fd, it->second)) updateInterest(fd, it->second);
+}
+
+bool EpollServer::flush(int fd, Conn& c) {
+    while (c.outPos < c.out.size()) {
+        ssize_t w = ::send(fd, c.out.data() + c.outPos, c.out.size() - c.outPos, MSG_NOSIGNAL);
+        if (w > 0) { c.outPos += static_cast<std::size_t>(w); continue; }
+        if (w < 0 && errno == EINTR) continue;
+        if (w < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+        closeConn(fd);
+        return false;
+    }
+    if (c.outPos == c.out.size()) {
+        c.out.clear();
+        c.outPos = 0;
+    }
+    return true;
+}
+
+void EpollServer::updateInterest(int fd, Conn& c) {
+    bool wantWrite = c.outPos < c.out.size();
+    bool pauseRead = (c.out.size() - c.outPos) > kMaxPendingOut ||
+                     c.inFlight >= kMaxHeavyInFlight;
+    if (wantWrite == c.wantWrite && pauseRead == c.readPaused) return;
+    c.wantWrite = wantWrite;
+    c.readPaused = pauseRead;
+    epoll_event ev{};
+    ev.events = (pauseRead ? 0u : static_cast<std::uint32_t>(EPOLLIN)) |
+                (wantWrite ? static_cast<std::uint32_t>(EPOLLOUT) : 0u);
+    ev.data.fd = fd;
+    ::epoll_ctl(epollFd_, EPOLL_CTL_MOD, fd, &ev);
+}
+
+void EpollServer::closeConn(int fd) {
+    if (!conns_.count(fd)) return; // already closed earlier in this epoll batch
+    ::epoll_ctl(epollFd_, EPOLL_CTL_DEL, fd, nullptr);
+    ::close(fd);
+    conns_.erase(fd);
+}
+
+} // namespace sb
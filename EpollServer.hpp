@@ -0,0 +1,94 @@
+/***************************************************************************************
+ * EpollServer.hpp
+ * Unix-domain-socket front end for StudyBuddyService (Linux only).
+ *
+ * One thread runs a non-blocking, level-triggered epoll loop that accepts connections,
+ * splits the byte stream into length-prefixed frames (see Protocol.hpp) and answers light
+ * requests inline. Heavy requests (StudyBuddyService::isHeavy) go to a dedicated
+ * ThreadPool; their response frames are handed back to the loop through a completion
+ * queue + eventfd.
+ *
+ * One client cannot monopolise the loop or the pool: each wakeup reads a bounded number
+ * of bytes from it, and once it has too many heavy requests in flight, its remaining
+ * frames wait in its buffer and its socket is not read until completions come back.
+ *
+ * STANDARD LIBRARIES USED:
+ *  <atomic>             : stop flag
+ *  <mutex>              : completion queue guard
+ *  <string>             : socket path, errors
+ *  <unordered_map>      : fd → connection
+ *  <vector>             : stream buffers
+ ****************************************************************************************/
+#pragma once
+#include "StudyBuddyService.hpp"
+#include "ThreadPool.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace sb {
+
+class EpollServer {
+public:
+    EpollServer(StudyBuddyService& svc, std::string socketPath, std::size_t workers);
+    ~EpollServer();
+
+    EpollServer(const EpollServer&) = delete;
+    EpollServer& operator=(const EpollServer&) = delete;
+
+    // Bind + listen on the socket path (an existing socket file is replaced).
+    // Returns false and fills 'err' on failure.
+    bool start(std::string& err);
+
+    // Run the event loop on the calling thread until stop() is called.
+    void run();
+
+    // Ask run() to return. Async-signal-safe (sets a flag and writes the eventfd).
+    void stop();
+
+private:
+    struct Conn {
+        std::uint64_t id = 0;
+        std::vector<std::uint8_t> in;
+        std::vector<std::uint8_t> out;
+        std::size_t outPos = 0;
+        bool wantWrite = false;
+        bool readPaused = false;
+        std::size_t inFlight = 0; // heavy requests submitted, response not yet queued
+    };
+    struct Completion {
+        int fd;
+        std::uint64_t connId;
+        std::vector<std::uint8_t> frame;
+    };
+
+    void acceptAll();
+    void onReadable(int fd);
+    void onWritable(int fd);
+    void drainCompletions();
+    void processFrames(int fd, Conn& c);
+    void queueOutput(int fd, Conn& c, const std::vector<std::uint8_t>& frame);
+    bool flush(int fd, Conn& c);  // false if the connection was closed
+    void updateInterest(int fd, Conn& c);
+    void closeConn(int fd);
+
+    StudyBuddyService& svc_;
+    std::string path_;
+    int listenFd_ = -1;
+    int epollFd_ = -1;
+    int wakeFd_ = -1;
+    std::atomic<bool> stop_{false};
+    std::uint64_t nextConnId_ = 1;
+    std::unordered_map<int, Conn> conns_;
+
+    std::mutex doneMu_;
+    std::vector<Completion> done_;
+
+    ThreadPool pool_; // declared last: destroyed (joined) first
+};
+
+} // namespace sb
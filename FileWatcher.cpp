@@ -0,0 +1,153 @@
+/***************************************************************************************
+ * FileWatcher.cpp — implementation (Linux: inotify, eventfd, poll)
+ ****************************************************************************************/
+#include "FileWatcher.hpp"
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+namespace sb {
+
+static constexpr std::uint32_t kEvents = IN_CLOSE_WRITE | IN_MOVED_TO;
+
+FileWatcher::FileWatcher(std::vector<std::string> paths, Callback onChange,
+                         std::chrono::milliseconds settle)
+    : onChange_(std::move(onChange)), settle_(settle) {
+    for (auto& p : paths) {
+        Watched w;
+        std::size_t slash = p.rfind('/');
+        w.dir = slash == std::string::npos ? "." : slash == 0 ? "/" : p.substr(0, slash);
+        w.name = slash == std::string::npos ? p : p.substr(slash + 1);
+        w.path = std::move(p);
+        files_.push_back(std::move(w));
+    }
+}
+
+FileWatcher::~FileWatcher() {
+    stop();
+    if (inotifyFd_ >= 0) ::close(inotifyFd_);
+    if (stopFd_ >= 0) ::close(stopFd_);
+}
+
+bool FileWatcher::start(std::string& err) {
+    if (running_.load()) return true;
+    if (inotifyFd_ < 0) inotifyFd_ = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (stopFd_ < 0) stopFd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (inotifyFd_ < 0 || stopFd_ < 0) {
+        err = std::string("inotify/eventfd: ") + std::strerror(errno);
+        return false;
+    }
+    for (auto& w : files_) {
+        if (w.name.empty()) { err = "not a file: " + w.path; return false; }
+        // Same directory, same watch descriptor: the kernel deduplicates.
+        w.wd = ::inotify_add_watch(inotifyFd_, w.dir.c_str(), kEvents);
+        if (w.wd < 0) { err = "watch " + w.dir + ": " + std::strerror(errno); return false; }
+    }
+    running_.store(true);
+    thread_ = std::thread([this] { run(); });
+    return true;
+}
+
+void FileWatcher::stop() {
+    if (!running_.exchange(false)) return;
+    std::uint64_t one = 1;
+    ssize_t r = ::write(stopFd_, &one, sizeof(one));
+    (void)r;
+    if (thread_.joinable()) thread_.join();
+    std::uint64_t drain;
+    r = ::read(stopFd_, &drain, sizeof(drain)); // so a later start() does not stop at once
+    (void)r;
+}
+
+bool FileWatcher::rewatch() {
+    bool restored = false;
+    for (auto& w : files_) {
+        if (w.wd >= 0) continue;
+        w.wd = ::inotify_add_watch(inotifyFd_, w.dir.c_str(), kEvents);
+        if (w.wd < 0) continue;
+        restored = true;
+        if (onError_) onError_("watching " + w.dir + " again");
+        for (auto& other : files_) { // same directory, same descriptor
+            if (other.wd < 0 && other.dir == w.dir) other.wd = w.wd;
+        }
+    }
+    return restored;
+}
+
+void FileWatcher::run() {
+    std::vector<char> changed(files_.size(), 0);
+    bool pending = false;
+    bool lost = false; // some watch is gone: retry it on a timer
+    alignas(inotify_event) char buf[16 * 1024];
+    auto markAll = [&] {
+        for (std::size_t i = 0; i < files_.size(); ++i) changed[i] = files_[i].wd >= 0;
+        pending = true;
+    };
+
+    while (running_.load()) {
+        pollfd fds[2] = {{inotifyFd_, POLLIN, 0}, {stopFd_, POLLIN, 0}};
+        int timeout = pending ? static_cast<int>(settle_.count()) : lost ? kRetryMs : -1;
+        int n = ::poll(fds, 2, timeout);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        if (fds[1].revents) break;
+
+        if (n == 0) { // quiet for 'settle' (or the retry interval)
+            if (lost && rewatch()) {
+                lost = false;
+                for (const auto& w : files_) lost = lost || w.wd < 0;
+                markAll(); // whatever happened while unwatched is unknown
+                continue;
+            }
+            pending = false;
+            for (std::size_t i = 0; i < files_.size(); ++i) {
+                if (!changed[i]) continue;
+                changed[i] = 0;
+                onChange_(files_[i].path);
+            }
+            continue;
+        }
+
+        for (;;) {
+            ssize_t len = ::read(inotifyFd_, buf, sizeof buf);
+            if (len <= 0) break; // EAGAIN: drained
+            for (char* p = buf; p < buf + len;) {
+                auto* ev = reinterpret_cast<inotify_event*>(p);
+                p += sizeof(inotify_event) + ev->len;
+                if (ev->mask & IN_Q_OVERFLOW) { // events were dropped: any file may have changed
+                    markAll();
+                    continue;
+                }
+                if (ev->mask & IN_IGNORED) { // the watch is gone with its directory
+                    std::string dir;
+                    for (auto& w : files_) {
+                        if (w.wd != ev->wd) continue;
+                        dir = w.dir;
+                        w.wd = -1;
+                        lost = true;
+                    }
+                    if (onError_ && !dir.empty()) onError_("lost watch on " + dir + "; retrying");
+                    continue;
+                }
+                if (ev->len == 0 || !(ev->mask & kEvents)) continue;
+                for (std::size_t i = 0; i < files_.size(); ++i) {
+                    if (files_[i].wd == ev->wd && files_[i].name == ev->name) {
+                        changed[i] = 1;
+                        pending = true;
+                    }
+                }
+            }
+        }
+    }
+}
+
+} // namespace sb
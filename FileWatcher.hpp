@@ -0,0 +1,82 @@
+/***************************************************************************************
+ * FileWatcher.hpp
+ * Calls back when any of a set of files is rewritten (Linux only: inotify, eventfd).
+ *
+ * Each file's directory is watched, not the file itself, so both ways of replacing a data
+ * file are seen: writing it in place (IN_CLOSE_WRITE) and renaming a finished copy over
+ * it (IN_MOVED_TO). A watch on the file's inode would be lost with the first rename.
+ *
+ * A background thread waits on the inotify descriptor. Events arriving within 'settle'
+ * of each other are coalesced, then onChange(path) runs once per changed file, on that
+ * thread, in the order the paths were given. The callback may be slow (a reload): events
+ * that arrive meanwhile queue up in the kernel and produce one more call afterwards.
+ *
+ * If the kernel's event queue overflows, every file is treated as changed (a rewrite may
+ * have been dropped). If a directory's watch goes away (directory removed, filesystem
+ * unmounted), the error handler is told and the watch is retried every second; once it
+ * is back, its files are treated as changed.
+ *
+ * STANDARD LIBRARIES USED:
+ *  <atomic>     : running flag
+ *  <chrono>     : settle interval
+ *  <functional> : change callback
+ *  <string>     : paths, errors
+ *  <thread>     : watcher thread
+ *  <utility>    : std::move
+ *  <vector>     : watched files
+ ****************************************************************************************/
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace sb {
+
+class FileWatcher {
+public:
+    using Callback = std::function<void(const std::string& path)>;
+
+    FileWatcher(std::vector<std::string> paths, Callback onChange,
+                std::chrono::milliseconds settle = std::chrono::milliseconds(50));
+    ~FileWatcher(); // stop()s
+
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+
+    // Add the watches and start the thread. The files need not exist yet; their
+    // directories must. Returns false and fills 'err' on failure.
+    bool start(std::string& err);
+
+    // Join the thread (waits for a callback in progress). Idempotent.
+    void stop();
+
+    // Receives lost/restored watch messages, on the watcher thread. Set before start().
+    void setErrorHandler(Callback onError) { onError_ = std::move(onError); }
+
+private:
+    struct Watched {
+        std::string path;
+        std::string dir;
+        std::string name; // basename, as inotify reports it
+        int wd = -1;
+    };
+    void run();
+    bool rewatch(); // re-add lost watches; true if any came back
+
+    static constexpr int kRetryMs = 1000;
+
+    std::vector<Watched> files_;
+    Callback onChange_;
+    Callback onError_;
+    std::chrono::milliseconds settle_;
+    int inotifyFd_ = -1;
+    int stopFd_ = -1; // eventfd
+    std::atomic<bool> running_{false};
+    std::thread thread_;
+};
+
+} // namespace sb
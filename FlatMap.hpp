@@ -0,0 +1,241 @@
+/***************************************************************************************
+ * FlatMap.hpp
+ * Open-addressing hash map (Robin Hood probing, backward-shift deletion) for the
+ * identity-keyed indexes: email → inbox, session id → session.
+ *
+ * Entries live in one flat array next to a byte of probe-distance metadata, so a lookup is
+ * a hash plus a short linear scan over adjacent memory instead of a bucket → node chase.
+ * find()/erase() accept any key type the hasher and key_equal accept (heterogeneous
+ * lookup): with StrHash, a FlatMap<std::string, V> can be probed with a string_view or a
+ * string literal without building a temporary std::string.
+ *
+ * Not thread-safe. Pointers/references to values are invalidated by insertion (rehash
+ * or Robin Hood displacement) and by erase.
+ *
+ * STANDARD LIBRARIES USED:
+ *  <cstdint>      : probe-distance bytes
+ *  <functional>   : default hasher, std::equal_to<>
+ *  <memory>       : raw slot storage
+ *  <string_view>  : StrHash
+ *  <utility>      : move, swap
+ ****************************************************************************************/
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <new>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace sb {
+
+// Transparent hasher for std::string / std::string_view / const char* keys.
+struct StrHash {
+    using is_transparent = void;
+    std::size_t operator()(std::string_view s) const { return std::hash<std::string_view>{}(s); }
+};
+
+template <class K, class V, class Hash = std::hash<K>, class KeyEq = std::equal_to<>>
+class FlatMap {
+public:
+    struct Entry {
+        K key;
+        V value;
+    };
+
+    FlatMap() = default;
+    explicit FlatMap(std::size_t expected) { reserve(expected); }
+    ~FlatMap() { destroyAll(); }
+
+    FlatMap(const FlatMap&) = delete;
+    FlatMap& operator=(const FlatMap&) = delete;
+    FlatMap(FlatMap&& o) noexcept { swap(o); }
+    FlatMap& operator=(FlatMap&& o) noexcept {
+        if (this != &o) {
+            FlatMap tmp(std::move(o));
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    std::size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    std::size_t capacity() const { return cap_; }
+
+    // Make room for 'n' entries without rehashing.
+    void reserve(std::size_t n) {
+        std::size_t want = kMinCapacity;
+        while (want * kMaxLoadNum < n * kMaxLoadDen) want *= 2;
+        if (want > cap_) rehash(want);
+    }
+
+    template <class Q>
+    V* find(const Q& key) {
+        std::size_t i = indexOf(key);
+        return i == npos ? nullptr : &slots_[i].value;
+    }
+    template <class Q>
+    const V* find(const Q& key) const { return const_cast<FlatMap*>(this)->find(key); }
+
+    template <class Q>
+    bool contains(const Q& key) const { return find(key) != nullptr; }
+
+    // Insert key → V(args...) if absent. Returns the value and whether it was inserted.
+    template <class... Args>
+    std::pair<V*, bool> tryEmplace(K key, Args&&... args) {
+        if (std::size_t i = indexOf(key); i != npos) return {&slots_[i].value, false};
+        if ((size_ + 1) * kMaxLoadDen > cap_ * kMaxLoadNum) rehash(cap_ ? cap_ * 2 : kMinCapacity);
+        std::size_t h = hashOf(key);
+        std::size_t i = insertFresh(Entry{std::move(key), V(std::forward<Args>(args)...)}, h);
+        ++size_;
+        return {&slots_[i].value, true};
+    }
+
+    V& operator[](K key) { return *tryEmplace(std::move(key)).first; }
+
+    template <class Q>
+    bool erase(const Q& key) {
+        std::size_t i = indexOf(key);
+        if (i == npos) return false;
+        slots_[i].~Entry();
+        // Backward-shift: pull following displaced entries one step closer to home.
+        std::size_t next = (i + 1) & mask_;
+        while (dist_[next] > 1) {
+            new (&slots_[i]) Entry(std::move(slots_[next]));
+            slots_[next].~Entry();
+            dist_[i] = static_cast<std::uint8_t>(dist_[next] - 1);
+            i = next;
+            next = (next + 1) & mask_;
+        }
+        dist_[i] = 0;
+        --size_;
+        return true;
+    }
+
+    void clear() {
+        for (std::size_t i = 0; i < cap_; ++i) {
+            if (dist_[i]) { slots_[i].~Entry(); dist_[i] = 0; }
+        }
+        size_ = 0;
+    }
+
+    // Visit every entry as (const K&, V&), in unspecified order.
+    template <class F>
+    void forEach(F&& f) {
+        for (std::size_t i = 0; i < cap_; ++i) if (dist_[i]) f(static_cast<const K&>(slots_[i].key), slots_[i].value);
+    }
+    template <class F>
+    void forEach(F&& f) const {
+        for (std::size_t i = 0; i < cap_; ++i) if (dist_[i]) f(slots_[i].key, static_cast<const V&>(slots_[i].value));
+    }
+
+    // Approximate heap bytes held (slot array + metadata), for memory reports.
+    std::size_t heapBytes() const { return cap_ * (sizeof(Entry) + 1); }
+
+private:
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+    static constexpr std::size_t kMinCapacity = 16;
+    static constexpr std::size_t kMaxLoadNum = 7; // max load 7/8
+    static constexpr std::size_t kMaxLoadDen = 8;
+    static constexpr std::uint8_t kMaxDist = 255;
+
+    template <class Q>
+    std::size_t hashOf(const Q& key) const {
+        // Fibonacci mix so weak hashes (identity for integers/pointers) spread over the mask.
+        return static_cast<std::size_t>((static_cast<std::uint64_t>(Hash{}(key)) * 0x9E3779B97F4A7C15ull) >> 32);
+    }
+
+    template <class Q>
+    std::size_t indexOf(const Q& key) const {
+        if (!cap_) return npos;
+        return indexOfHashed(key, hashOf(key));
+    }
+
+    template <class Q>
+    std::size_t indexOfHashed(const Q& key, std::size_t h) const {
+        std::size_t i = h & mask_;
+        for (std::uint8_t d = 1;; ++d) {
+            // Robin Hood invariant: once our distance exceeds the resident's, the key is absent.
+            if (dist_[i] < d) return npos;
+            if (KeyEq{}(slots_[i].key, key)) return i;
+            i = (i + 1) & mask_;
+            if (d == kMaxDist) return npos;
+        }
+    }
+
+    // Place an entry known to be absent and return its slot. Robin Hood by shifting: the
+    // entry goes to the first slot whose resident is closer to home than we are, and the
+    // rest of that run moves down by one.
+    std::size_t insertFresh(Entry&& e, std::size_t h) {
+        for (;;) {
+            std::size_t i = h & mask_;
+            std::uint8_t d = 1;
+            bool overflow = false;
+            while (dist_[i] >= d) {
+                i = (i + 1) & mask_;
+                if (++d == kMaxDist) { overflow = true; break; }
+            }
+            std::size_t j = i;
+            while (!overflow && dist_[j]) {
+                if (dist_[j] == kMaxDist) overflow = true;
+                j = (j + 1) & mask_;
+            }
+            if (overflow) { rehash(cap_ * 2); continue; } // nothing moved yet
+
+            while (j != i) {
+                std::size_t prev = (j - 1) & mask_;
+                new (&slots_[j]) Entry(std::move(slots_[prev]));
+                slots_[prev].~Entry();
+                dist_[j] = static_cast<std::uint8_t>(dist_[prev] + 1);
+                j = prev;
+            }
+            new (&slots_[i]) Entry(std::move(e));
+            dist_[i] = d;
+            return i;
+        }
+    }
+
+    void rehash(std::size_t newCap) {
+        std::unique_ptr<std::uint8_t[]> oldDist(std::move(dist_));
+        Entry* oldSlots = slots_;
+        std::size_t oldCap = cap_;
+
+        slots_ = static_cast<Entry*>(::operator new(newCap * sizeof(Entry), std::align_val_t(alignof(Entry))));
+        dist_.reset(new std::uint8_t[newCap]());
+        cap_ = newCap;
+        mask_ = newCap - 1;
+
+        for (std::size_t i = 0; i < oldCap; ++i) {
+            if (!oldDist[i]) continue;
+            std::size_t h = hashOf(oldSlots[i].key);
+            insertFresh(std::move(oldSlots[i]), h);
+            oldSlots[i].~Entry();
+        }
+        if (oldSlots) ::operator delete(oldSlots, std::align_val_t(alignof(Entry)));
+    }
+
+    void destroyAll() {
+        if (!slots_) return;
+        clear();
+        ::operator delete(slots_, std::align_val_t(alignof(Entry)));
+        slots_ = nullptr;
+    }
+
+    void swap(FlatMap& o) noexcept {
+        std::swap(slots_, o.slots_);
+        std::swap(dist_, o.dist_);
+        std::swap(cap_, o.cap_);
+        std::swap(mask_, o.mask_);
+        std::swap(size_, o.size_);
+    }
+
+    Entry* slots_ = nullptr;
+    std::unique_ptr<std::uint8_t[]> dist_; // 0 = empty, else probe distance + 1
+    std::size_t cap_ = 0;                  // power of two
+    std::size_t mask_ = 0;
+    std::size_t size_ = 0;
+};
+
+} // namespace sb
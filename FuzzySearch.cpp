@@ -0,0 +1,206 @@
+/***************************************************************************************
+ * FuzzySearch.cpp — implementation
+ ****************************************************************************************/
+#include "FuzzySearch.hpp"
+#include "Utils.hpp"
+#include "StringPool.hpp"
+
+#include <algorithm>
+
+namespace sb {
+
+std::string foldCase(std::string_view s) {
+    std::string out(s);
+    for (char& c : out) {
+        if (c >= 'A' && c <= 'Z') c = static_cast<char>(c - 'A' + 'a');
+    }
+    return out;
+}
+
+/* ---------------- FuzzyPattern ---------------- */
+
+FuzzyPattern::FuzzyPattern(std::string_view folded) : m_(std::min(folded.size(), kMaxLength)) {
+    for (std::size_t i = 0; i < m_; ++i) {
+        peq_[static_cast<unsigned char>(folded[i])] |= std::uint64_t{1} << i;
+    }
+}
+
+int FuzzyPattern::bestDistance(std::string_view text) const {
+    if (m_ == 0) return 0;
+    // Column state of the DP over (pattern prefix, text position) as bit vectors:
+    // VP/VN = vertical +1/-1 deltas. Row 0 is all zeros (a match may start anywhere), so
+    // no horizontal delta is shifted in at the bottom.
+    const std::uint64_t last = std::uint64_t{1} << (m_ - 1);
+    std::uint64_t vp = ~std::uint64_t{0}, vn = 0;
+    std::uint64_t prevD0 = 0, prevEq = 0;
+    int score = static_cast<int>(m_);
+    int best = score;
+    for (char ch : text) {
+        const std::uint64_t eq = peq_[static_cast<unsigned char>(ch)];
+        // Hyyrö's transposition term: pattern[i-1..i] == text[j..j-1] swapped.
+        const std::uint64_t tr = (((~prevD0) & eq) << 1) & prevEq;
+        const std::uint64_t d0 = (((eq & vp) + vp) ^ vp) | eq | vn | tr;
+        std::uint64_t hp = vn | ~(d0 | vp);
+        std::uint64_t hn = vp & d0;
+        if (hp & last) ++score;
+        else if (hn & last) --score;
+        hp <<= 1;
+        hn <<= 1;
+        vp = hn | ~(d0 | hp);
+        vn = hp & d0;
+        prevD0 = d0;
+        prevEq = eq;
+        if (score < best) {
+            best = score;
+            if (best == 0) break;
+        }
+    }
+    return best;
+}
+
+/* ---------------- FuzzyNameIndex ---------------- */
+
+FuzzyNameIndex::FuzzyNameIndex() : postings_(1u << 16) {}
+
+FuzzyNameIndex::FuzzyNameIndex(const std::vector<Profile>& all) : FuzzyNameIndex() {
+    for (std::size_t i = 0; i < all.size(); ++i) add(i, all[i]);
+}
+
+std::uint64_t FuzzyNameIndex::signature(std::string_view folded) {
+    std::uint64_t sig = 0;
+    for (char ch : folded) {
+        unsigned c = static_cast<unsigned char>(ch);
+        unsigned bit = (c >= 'a' && c <= 'z') ? c - 'a'
+                     : (c >= '0' && c <= '9') ? 26 + (c - '0')
+                     : 36 + c % 28; // everything else shares the top bits
+        sig |= std::uint64_t{1} << bit;
+    }
+    return sig;
+}
+
+void FuzzyNameIndex::add(std::size_t id, const Profile& p) {
+    const auto uid = static_cast<std::uint32_t>(id);
+    if (id >= byId_.size()) byId_.resize(id + 1);
+    for (std::uint32_t t : byId_[id]) dropKey(uid, t);
+    byId_[id].clear();
+
+    addKey(uid, foldCase(trimView(p.name())));
+    std::string_view email = trimView(p.email());
+    addKey(uid, foldCase(email.substr(0, email.find('@'))));
+
+    // Renames leave keys nobody holds; rebuild once they outnumber the live ones.
+    if (texts_.size() > 1024 && texts_.size() > 2 * liveTexts_) compact();
+}
+
+void FuzzyNameIndex::addKey(std::uint32_t id, std::string_view folded) {
+    if (folded.empty()) return;
+    std::uint32_t t;
+    if (const std::uint32_t* found = textIds_.find(folded)) {
+        t = *found;
+        if (texts_[t].owners.empty()) ++liveTexts_;
+    } else {
+        t = static_cast<std::uint32_t>(texts_.size());
+        std::string_view stored = intern(folded);
+        texts_.push_back(Text{stored, {}});
+        sigs_.push_back(signature(stored));
+        textIds_.tryEmplace(stored, t);
+        ++liveTexts_;
+        // Each distinct bigram is posted once, so counts in search() are per distinct
+        // query bigram.
+        std::vector<std::uint16_t> grams;
+        for (std::size_t i = 0; i + 1 < stored.size(); ++i) {
+            grams.push_back(bigram(static_cast<unsigned char>(stored[i]), static_cast<unsigned char>(stored[i + 1])));
+        }
+        std::sort(grams.begin(), grams.end());
+        grams.erase(std::unique(grams.begin(), grams.end()), grams.end());
+        for (std::uint16_t g : grams) postings_[g].push_back(t);
+    }
+    texts_[t].owners.push_back(id);
+    byId_[id].push_back(t);
+    ++keyCount_;
+}
+
+void FuzzyNameIndex::dropKey(std::uint32_t id, std::uint32_t text) {
+    auto& owners = texts_[text].owners;
+    auto it = std::find(owners.begin(), owners.end(), id);
+    if (it == owners.end()) return;
+    *it = owners.back();
+    owners.pop_back();
+    --keyCount_;
+    if (owners.empty()) --liveTexts_;
+}
+
+void FuzzyNameIndex::compact() {
+    std::vector<Text> texts;
+    std::vector<std::vector<std::uint32_t>> byId;
+    texts.swap(texts_);
+    byId.swap(byId_);
+    sigs_.clear();
+    textIds_.clear();
+    for (auto& list : postings_) list.clear();
+    keyCount_ = 0;
+    liveTexts_ = 0;
+    byId_.resize(byId.size());
+    for (std::size_t id = 0; id < byId.size(); ++id) {
+        for (std::uint32_t t : byId[id]) addKey(static_cast<std::uint32_t>(id), texts[t].folded);
+    }
+}
+
+std::vector<FuzzyNameIndex::Hit> FuzzyNameIndex::search(std::string_view query, int maxEdits) const {
+    const std::string q = foldCase(trimView(query));
+    std::vector<Hit> hits;
+    if (q.empty()) return hits;
+    const FuzzyPattern pat(q);
+    const int m = static_cast<int>(pat.length());
+    const int k = pat.clampEdits(maxEdits);
+
+    std::vector<std::uint16_t> grams;
+    for (int i = 0; i + 1 < m; ++i) {
+        grams.push_back(bigram(static_cast<unsigned char>(q[i]), static_cast<unsigned char>(q[i + 1])));
+    }
+    std::sort(grams.begin(), grams.end());
+    grams.erase(std::unique(grams.begin(), grams.end()), grams.end());
+    const int need = static_cast<int>(grams.size()) - 3 * k;
+    const std::uint64_t qsig = signature(std::string_view(q).substr(0, pat.length()));
+    const int needChars = __builtin_popcountll(qsig) - k;
+
+    // Best distance per id (-1: no hit yet); k < 64 fits in int8.
+    std::vector<std::int8_t> best(byId_.size(), -1);
+    std::vector<std::uint32_t> touched;
+    auto verify = [&](std::uint32_t t) {
+        if (needChars > 0 && __builtin_popcountll(sigs_[t] & qsig) < needChars) return;
+        const Text& text = texts_[t];
+        // A substring within k edits has at least m - k bytes.
+        if (text.owners.empty() || static_cast<int>(text.folded.size()) + k < m) return;
+        int d = pat.bestDistance(text.folded);
+        if (d > k) return;
+        for (std::uint32_t id : text.owners) {
+            std::int8_t& b = best[id];
+            if (b < 0) touched.push_back(id);
+            if (b < 0 || d < b) b = static_cast<std::int8_t>(d);
+        }
+    };
+
+    if (need >= 1) {
+        std::vector<std::uint8_t> count(texts_.size(), 0); // <= 63 distinct query bigrams
+        for (std::uint16_t g : grams) {
+            for (std::uint32_t t : postings_[g]) {
+                if (++count[t] == need) verify(t);
+            }
+        }
+    } else {
+        for (std::uint32_t t = 0; t < texts_.size(); ++t) verify(t);
+    }
+
+    // Rank by distance, then id: one pass per distance over the sorted ids.
+    std::sort(touched.begin(), touched.end());
+    hits.reserve(touched.size());
+    for (int d = 0; d <= k; ++d) {
+        for (std::uint32_t id : touched) {
+            if (best[id] == d) hits.push_back(Hit{id, d});
+        }
+    }
+    return hits;
+}
+
+} // namespace sb
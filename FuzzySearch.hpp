@@ -0,0 +1,120 @@
+/***************************************************************************************
+ * FuzzySearch.hpp
+ * Typo-tolerant name search: "Jonh" finds "John Smith".
+ *
+ * Distance is optimal string alignment (Levenshtein plus adjacent transposition, so
+ * "jonh" → "john" is one edit), measured between the query and the best-matching
+ * SUBSTRING of a name or email local part, both case-folded. That keeps the
+ * substring semantics of ClassmateSearch::byName: distance 0 is a plain substring hit.
+ *
+ * FuzzyPattern is Hyyrö's bit-parallel formulation of Myers' algorithm with the
+ * transposition term: one 64-bit word per pattern (queries are capped at 64 bytes), about
+ * a dozen word operations per text byte regardless of the query length.
+ *
+ * FuzzyNameIndex stores each distinct folded key once (interned in the StringPool), so a
+ * name shared by many classmates is verified once per query. Two complete prefilters
+ * run before the matcher:
+ *  - bigram posting lists: a query with d distinct bigrams can only match a key within
+ *    k edits if the key contains at least d - 3k of them (an edit destroys at most 3);
+ *  - a 64-bit character signature per key: with c distinct query characters, the key
+ *    must contain at least c - k of them (only substitutions/deletions lose characters,
+ *    one each). This is what keeps short queries like "jonh" (d - 3k <= 0) cheap.
+ *
+ * Ids are indexes into the profile vector the index mirrors (Roster ids). add() on an
+ * existing id replaces its keys, so a Roster listener keeps the index current.
+ * search() is const and safe to call concurrently; add() is not.
+ *
+ * STANDARD LIBRARIES USED:
+ *  <array>       : pattern match vectors
+ *  <cstdint>     : bit vectors, key offsets
+ *  <string>      : folded keys and queries
+ *  <string_view> : keys and queries
+ *  <vector>      : posting lists, results
+ ****************************************************************************************/
+#pragma once
+#include "Profile.hpp"
+#include "FlatMap.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace sb {
+
+// One fuzzy result: the classmate and the edit distance of their best key.
+struct NameMatch {
+    const Profile* person;
+    int distance;
+};
+
+// ASCII lower-case copy, other bytes unchanged.
+std::string foldCase(std::string_view s);
+
+class FuzzyPattern {
+public:
+    static constexpr std::size_t kMaxLength = 64;
+
+    // 'folded' should already be case-folded; bytes past kMaxLength are ignored.
+    explicit FuzzyPattern(std::string_view folded);
+
+    std::size_t length() const { return m_; }
+
+    // Edit budget actually used for 'maxEdits': at least two query bytes must survive
+    // (k <= length - 2), otherwise a short query matches nearly every key.
+    int clampEdits(int maxEdits) const {
+        int cap = static_cast<int>(m_) - 2;
+        return maxEdits < 0 || cap < 0 ? 0 : (maxEdits < cap ? maxEdits : cap);
+    }
+
+    // Smallest OSA distance between the pattern and any substring of 'text'
+    // (length() when nothing matches at all; 0 for an empty pattern).
+    int bestDistance(std::string_view text) const;
+
+private:
+    std::array<std::uint64_t, 256> peq_{}; // bit i set: pattern[i] == byte
+    std::size_t m_ = 0;
+};
+
+class FuzzyNameIndex {
+public:
+    FuzzyNameIndex();
+    explicit FuzzyNameIndex(const std::vector<Profile>& all);
+
+    // Index (or re-index) profile 'id' under its current name and email local part.
+    void add(std::size_t id, const Profile& p);
+
+    // Ids within 'maxEdits' of 'query', best distance first, ties by id.
+    // maxEdits is clamped by FuzzyPattern::clampEdits.
+    struct Hit { std::size_t id; int distance; };
+    std::vector<Hit> search(std::string_view query, int maxEdits) const;
+
+    std::size_t size() const { return keyCount_; }  // (id, key) pairs indexed
+    std::size_t distinctKeys() const { return liveTexts_; }
+
+private:
+    struct Text {
+        std::string_view folded;           // interned
+        std::vector<std::uint32_t> owners; // ids with this key (empty: dead)
+    };
+
+    static std::uint64_t signature(std::string_view folded);
+    static std::uint16_t bigram(unsigned char a, unsigned char b) {
+        return static_cast<std::uint16_t>((a << 8) | b);
+    }
+    void addKey(std::uint32_t id, std::string_view folded);
+    void dropKey(std::uint32_t id, std::uint32_t text);
+    void compact();
+
+    std::vector<Text> texts_;
+    std::vector<std::uint64_t> sigs_;                           // per text, scanned first
+    FlatMap<std::string_view, std::uint32_t, StrHash> textIds_; // folded → texts_ index
+    std::vector<std::vector<std::uint32_t>> postings_;          // bigram → text indexes
+    std::vector<std::vector<std::uint32_t>> byId_;              // id → its text indexes
+    std::size_t keyCount_ = 0;
+    std::size_t liveTexts_ = 0;
+};
+
+} // namespace sb
@@ -3,7 +3,12 @@
  ****************************************************************************************/
 #include "MatchSuggester.hpp"
 #include "Utils.hpp"
+#include "ThreadPool.hpp"
+#include "AllocStats.hpp"
+#include "Metrics.hpp"
+#include "Trace.hpp"
 #include <algorithm>
+#include <cstdint>
 
 namespace sb {
 
@@ -26,6 +31,14 @@ std::vector<std::string> MatchSuggester::sharedCoursesUpper(const Profile& a, co
     return shared;
 }
 
+static constexpr std::size_t kOverlapMemoSize = 512;
+
+// The key SessionRequests (and so StudyGraph) files a student under.
+static std::string_view sessionKey(const Profile& p) {
+    std::string_view e = trimView(p.email());
+    return e.empty() ? trimView(p.name()) : e;
+}
+
 static int overlapSpan(int a1, int a2, int b1, int b2) {
     // Overlap between [a1,a2) and [b1,b2)
     int lo = std::max(a1, b1);
@@ -35,13 +48,10 @@ static int overlapSpan(int a1, int a2, int b1, int b2) {
 
 int MatchSuggester::totalOverlapMinutes(const Profile& a, const Profile& b) {
     int total = 0;
-    // For each day, sum overlaps of slots
+    // For each day, sum overlaps of slots (per-day spans, no copies)
     for (int d = 0; d < 7; ++d) {
         Day day = static_cast<Day>(d);
-        // collect slots for day
-        std::vector<AvailabilitySlot> A, B;
-        for (const auto& s : a.availability()) if (s.day == day) A.push_back(s);
-        for (const auto& s : b.availability()) if (s.day == day) B.push_back(s);
+        SlotView A = a.slotsOn(day), B = b.slotsOn(day);
         // both lists should already be merged; but even if not, logic still works
         for (const auto& sa : A)
             for (const auto& sb : B)
@@ -54,21 +64,67 @@ std::vector<Match> MatchSuggester::suggest(const Profile& self,
                                            const std::vector<Profile>& all,
                                            int minOverlapMinutes,
                                            std::size_t maxResults) const {
-    std::vector<Match> res;
-    for (const auto& p : all) {
-        if (sameUser(self, p)) continue;
-        auto shared = sharedCoursesUpper(self, p);
-        if (shared.empty()) continue;
-        int overlap = totalOverlapMinutes(self, p);
-        if (overlap < minOverlapMinutes) continue;
-        res.push_back(Match{&p, shared, overlap});
-    }
+    ApiTimer timer(Api::Suggest);
+    AllocScope allocScope("suggest");
+    TraceSpan span("suggest", "match");
+    const std::string_view selfKey = sessionKey(self);
+    // Score candidates in parallel chunks on large rosters; chunk results are concatenated
+    // in roster order, so the sort below sees exactly the sequential input.
+    auto res = parallelCollectAbove<Match>(all.size(),
+        [&](std::size_t lo, std::size_t hi, std::vector<Match>& out) {
+            // One span per chunk; course intersection and overlap run per candidate, so
+            // their time is summed into span args rather than recorded as 2 spans each.
+            TraceSpan chunk("suggest.score", "match");
+            const bool timed = chunk.active();
+            std::uint64_t coursesNs = 0, overlapNs = 0, t0 = 0;
+            // Overlap memo keyed by the candidate's shared schedule (self is fixed):
+            // a small direct-mapped table, so a miss costs no more than computing.
+            struct MemoEntry { const Schedule* key; int overlap; };
+            MemoEntry memo[kOverlapMemoSize] = {};
+            for (std::size_t i = lo; i < hi; ++i) {
+                const Profile& p = all[i];
+                if (sameUser(self, p)) continue;
+                const Schedule* key = self.availabilityCommitted() && p.availabilityCommitted()
+                                    ? p.schedule().get() : nullptr;
+                MemoEntry* slot = key ? &memo[(reinterpret_cast<std::uintptr_t>(key) >> 4) % kOverlapMemoSize]
+                                      : nullptr;
+                bool hit = slot && slot->key == key;
+                // A remembered overlap is the cheapest filter, so test it before courses.
+                if (hit && slot->overlap < minOverlapMinutes) continue;
+                if (timed) t0 = traceNowNs();
+                auto shared = sharedCoursesUpper(self, p);
+                if (timed) coursesNs += traceNowNs() - t0;
+                if (shared.empty()) continue;
+                int overlap;
+                if (hit) {
+                    overlap = slot->overlap;
+                } else {
+                    if (timed) t0 = traceNowNs();
+                    overlap = totalOverlapMinutes(self, p);
+                    if (timed) overlapNs += traceNowNs() - t0;
+                    if (slot) *slot = MemoEntry{key, overlap};
+                }
+                if (overlap < minOverlapMinutes) continue;
+                double affinity = co_ ? co_->affinity(self, p) : 0.0;
+                std::uint64_t social = graph_ ? graph_->mutualScore(selfKey, sessionKey(p)) : 0;
+                out.push_back(Match{&p, std::move(shared), overlap, affinity, social});
+            }
+            chunk.arg("candidates", static_cast<std::int64_t>(hi - lo));
+            chunk.arg("matched", static_cast<std::int64_t>(out.size()));
+            chunk.arg("courses_ns", static_cast<std::int64_t>(coursesNs));
+            chunk.arg("overlap_ns", static_cast<std::int64_t>(overlapNs));
+        });
+    span.arg("roster", static_cast<std::int64_t>(all.size()));
+    span.arg("matched", static_cast<std::int64_t>(res.size()));
+    TraceSpan sortSpan("suggest.sort", "match");
     std::sort(res.begin(), res.end(),
               [](const Match& x, const Match& y){
                   if (x.overlapMinutes != y.overlapMinutes)
                       return x.overlapMinutes > y.overlapMinutes; // DESC
-                  const std::string& nx = x.person->name().empty() ? x.person->email() : x.person->name();
-                  const std::string& ny = y.person->name().empty() ? y.person->email() : y.person->name();
+                  if (x.social != y.social) return x.social > y.social;
+                  if (x.affinity != y.affinity) return x.affinity > y.affinity;
+                  std::string_view nx = x.person->displayName();
+                  std::string_view ny = y.person->displayName();
                   return nx < ny;
               });
     if (res.size() > maxResults) res.resize(maxResults);
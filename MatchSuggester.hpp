@@ -2,6 +2,16 @@
  * MatchSuggester.hpp
  * Feature: Suggest study partners using shared courses + overlapping availability.
  *
+ * Profiles with identical availability share one Schedule (Schedule.hpp), so within one
+ * suggest() call the overlap with each distinct schedule is computed once and reused.
+ *
+ * With a CoEnrollment attached (useCoEnrollment), matches with equal overlap are ranked
+ * by co-enrollment affinity: partners whose other courses are often taken alongside
+ * yours come first.
+ *
+ * With a StudyGraph attached (useStudyGraph), equal overlap is first ranked by the 2-hop
+ * session score: partners your study partners have studied with come before strangers.
+ *
  * STANDARD LIBRARIES USED:
  *  <vector>    : collections of profiles and matches
  *  <string>    : course codes & names
@@ -9,6 +19,8 @@
  ****************************************************************************************/
 #pragma once
 #include "Profile.hpp"
+#include "CoEnrollment.hpp"
+#include "StudyGraph.hpp"
 #include <vector>
 #include <string>
 
@@ -18,22 +30,33 @@ struct Match {
     const Profile* person;                  // pointer to matched profile
     std::vector<std::string> sharedCourses; // uppercased
     int overlapMinutes;                     // total overlap across the week
+    double affinity = 0;                    // CoEnrollment::affinity (0 without one)
+    std::uint64_t social = 0;               // StudyGraph::mutualScore (0 without one)
 };
 
 class MatchSuggester {
 public:
     // Suggest up to maxResults partners from 'all' (excluding 'self') who share at least
     // one course AND have at least minOverlapMinutes of overlapping availability (any days).
-    // Results are sorted by overlapMinutes DESC, then by name ASC.
+    // Results are sorted by overlapMinutes DESC, then social DESC, then affinity DESC, then by name ASC.
     std::vector<Match> suggest(const Profile& self,
                                const std::vector<Profile>& all,
                                int minOverlapMinutes = 30,
                                std::size_t maxResults = 5) const;
 
+    // Rank ties by 'co' (nullptr detaches). 'co' must outlive later suggest() calls and
+    // not be updated while one runs.
+    void useCoEnrollment(const CoEnrollment* co) { co_ = co; }
+    // Rank ties by 2-hop study-session score in 'graph' (nullptr detaches); same rules.
+    void useStudyGraph(const StudyGraph* graph) { graph_ = graph; }
+
 private:
     static bool sameUser(const Profile& a, const Profile& b);
     static std::vector<std::string> sharedCoursesUpper(const Profile& a, const Profile& b);
     static int totalOverlapMinutes(const Profile& a, const Profile& b);
+
+    const CoEnrollment* co_ = nullptr;
+    const StudyGraph* graph_ = nullptr;
 };
 
 } // namespace sb
\ No newline at end of file
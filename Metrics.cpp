@@ -0,0 +1,225 @@
+/***************************************************************************************
+ * Metrics.cpp — implementation
+ ****************************************************************************************/
+#include "Metrics.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <utility>
+
+namespace sb {
+
+const char* apiName(Api api) {
+    switch (api) {
+    case Api::Suggest:              return "suggest";
+    case Api::BrowseByCourse:       return "browseByCourse";
+    case Api::BrowseByCourseAndDay: return "browseByCourseAndDay";
+    case Api::FreeInWindow:         return "freeInWindow";
+    case Api::BestWindow:           return "bestWindow";
+    case Api::NextCommonWindow:     return "nextCommonWindow";
+    case Api::TopCoEnrolled:        return "topCoEnrolled";
+    case Api::StudyPartnersOfPartners: return "studyPartnersOfPartners";
+    case Api::ByCourse:             return "byCourse";
+    case Api::ByName:               return "byName";
+    case Api::ByNameFuzzy:          return "byNameFuzzy";
+    case Api::Autocomplete:         return "autocomplete";
+    case Api::SendRequest:          return "sendRequest";
+    case Api::ConfirmRequest:       return "confirmRequest";
+    case Api::CancelConfirmed:      return "cancelConfirmed";
+    case Api::PendingFor:           return "pendingFor";
+    case Api::ConfirmedFor:         return "confirmedFor";
+    case Api::Notify:               return "notify";
+    case Api::FetchAndClear:        return "fetchAndClear";
+    case Api::SnapshotFork:         return "snapshotFork";
+    case Api::Count:                break;
+    }
+    return "?";
+}
+
+/* ---------------- LatencyHistogram ---------------- */
+
+std::size_t LatencyHistogram::bucketOf(std::uint64_t ns) {
+    if (ns < kSub) return static_cast<std::size_t>(ns);
+    int e = 63 - __builtin_clzll(ns); // ns >= kSub, so e >= kSubBits
+    int shift = e - kSubBits;
+    std::size_t sub = static_cast<std::size_t>(ns >> shift) & (kSub - 1);
+    return static_cast<std::size_t>(e - kSubBits + 1) * kSub + sub;
+}
+
+std::uint64_t LatencyHistogram::bucketUpper(std::size_t bucket) {
+    if (bucket < kSub) return bucket;
+    int shift = static_cast<int>(bucket / kSub) - 1;
+    std::uint64_t sub = bucket % kSub;
+    std::uint64_t low = (kSub + sub) << shift;
+    return low + ((std::uint64_t{1} << shift) - 1);
+}
+
+void LatencyHistogram::record(std::uint64_t ns) {
+    buckets_[bucketOf(ns)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(ns, std::memory_order_relaxed);
+    std::uint64_t seen = max_.load(std::memory_order_relaxed);
+    while (ns > seen && !max_.compare_exchange_weak(seen, ns, std::memory_order_relaxed)) {
+    }
+}
+
+LatencyHistogram::Snapshot LatencyHistogram::snapshot() const {
+    Snapshot s;
+    std::array<std::uint64_t, kBuckets> counts;
+    for (std::size_t i = 0; i < kBuckets; ++i) {
+        counts[i] = buckets_[i].load(std::memory_order_relaxed);
+        s.count += counts[i]; // consistent with the buckets even while writers race
+    }
+    s.sumNs = sum_.load(std::memory_order_relaxed);
+    s.maxNs = max_.load(std::memory_order_relaxed);
+    if (s.count == 0) return s;
+
+    struct Target { double q; std::uint64_t* out; };
+    Target targets[] = {{0.5, &s.p50Ns}, {0.9, &s.p90Ns}, {0.99, &s.p99Ns}, {0.999, &s.p999Ns}};
+    std::uint64_t seen = 0;
+    std::size_t t = 0;
+    for (std::size_t i = 0; i < kBuckets && t < 4; ++i) {
+        seen += counts[i];
+        while (t < 4 && static_cast<double>(seen) >= targets[t].q * static_cast<double>(s.count)) {
+            std::uint64_t v = bucketUpper(i);
+            *targets[t].out = v < s.maxNs ? v : s.maxNs;
+            ++t;
+        }
+    }
+    return s;
+}
+
+void LatencyHistogram::reset() {
+    for (auto& b : buckets_) b.store(0, std::memory_order_relaxed);
+    count_.store(0, std::memory_order_relaxed);
+    sum_.store(0, std::memory_order_relaxed);
+    max_.store(0, std::memory_order_relaxed);
+}
+
+/* ---------------- Metrics ---------------- */
+
+Metrics& Metrics::global() {
+    static Metrics* m = new Metrics(); // never destroyed: timers may run during static dtors
+    return *m;
+}
+
+void Metrics::reset() {
+    for (auto& s : slots_) {
+        s.latency.reset();
+        s.failures.store(0, std::memory_order_relaxed);
+    }
+}
+
+static double seconds(std::uint64_t ns) { return static_cast<double>(ns) / 1e9; }
+
+void Metrics::writePrometheus(std::ostream& os) const {
+    std::ios::fmtflags flags = os.flags();
+    os << std::setprecision(9);
+    if (!kMetricsEnabled) os << "# metrics compiled out (SB_METRICS=0)\n";
+    os << "# HELP sb_api_latency_seconds Latency of Study Buddy API calls.\n"
+       << "# TYPE sb_api_latency_seconds summary\n";
+    for (std::size_t i = 0; i < slots_.size(); ++i) {
+        const char* name = apiName(static_cast<Api>(i));
+        auto s = slots_[i].latency.snapshot();
+        const std::pair<const char*, std::uint64_t> qs[] = {
+            {"0.5", s.p50Ns}, {"0.9", s.p90Ns}, {"0.99", s.p99Ns}, {"0.999", s.p999Ns}};
+        for (const auto& q : qs) {
+            os << "sb_api_latency_seconds{api=\"" << name << "\",quantile=\"" << q.first << "\"} "
+               << seconds(q.second) << "\n";
+        }
+        os << "sb_api_latency_seconds_sum{api=\"" << name << "\"} " << seconds(s.sumNs) << "\n"
+           << "sb_api_latency_seconds_count{api=\"" << name << "\"} " << s.count << "\n";
+    }
+    os << "# HELP sb_api_latency_max_seconds Slowest call seen per API.\n"
+       << "# TYPE sb_api_latency_max_seconds gauge\n";
+    for (std::size_t i = 0; i < slots_.size(); ++i) {
+        os << "sb_api_latency_max_seconds{api=\"" << apiName(static_cast<Api>(i)) << "\"} "
+           << seconds(slots_[i].latency.snapshot().maxNs) << "\n";
+    }
+    os << "# HELP sb_api_failures_total API calls that were rejected or found nothing to do.\n"
+       << "# TYPE sb_api_failures_total counter\n";
+    for (std::size_t i = 0; i < slots_.size(); ++i) {
+        os << "sb_api_failures_total{api=\"" << apiName(static_cast<Api>(i)) << "\"} "
+           << slots_[i].failures.load(std::memory_order_relaxed) << "\n";
+    }
+    os.flags(flags);
+}
+
+void Metrics::writeJson(std::ostream& os) const {
+    os << "{\"metrics_enabled\":" << (kMetricsEnabled ? "true" : "false") << ",\"apis\":{";
+    for (std::size_t i = 0; i < slots_.size(); ++i) {
+        auto s = slots_[i].latency.snapshot();
+        if (i) os << ",";
+        os << "\"" << apiName(static_cast<Api>(i)) << "\":{"
+           << "\"count\":" << s.count
+           << ",\"failures\":" << slots_[i].failures.load(std::memory_order_relaxed)
+           << ",\"sum_ns\":" << s.sumNs
+           << ",\"max_ns\":" << s.maxNs
+           << ",\"p50_ns\":" << s.p50Ns
+           << ",\"p90_ns\":" << s.p90Ns
+           << ",\"p99_ns\":" << s.p99Ns
+           << ",\"p999_ns\":" << s.p999Ns << "}";
+    }
+    os << "}}\n";
+}
+
+bool Metrics::dumpToFile(const std::string& path, std::string& err) const {
+    const std::string tmp = path + ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::trunc);
+        if (!out) { err = "cannot open " + tmp; return false; }
+        bool json = path.size() >= 5 && path.compare(path.size() - 5, 5, ".json") == 0;
+        if (json) writeJson(out);
+        else writePrometheus(out);
+        if (!out.flush()) { err = "write failed: " + tmp; return false; }
+    }
+    if (std::rename(tmp.c_str(), path.c_str()) != 0) {
+        std::remove(tmp.c_str());
+        err = "cannot replace " + path;
+        return false;
+    }
+    err.clear();
+    return true;
+}
+
+/* ---------------- MetricsDumper ---------------- */
+
+MetricsDumper::MetricsDumper(const Metrics& metrics, std::string path, std::chrono::milliseconds interval)
+    : metrics_(metrics), path_(std::move(path)), interval_(interval) {
+    thread_ = std::thread([this] { loop(); });
+}
+
+MetricsDumper::~MetricsDumper() {
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+    thread_.join();
+    dumpOnce(); // final state
+}
+
+std::string MetricsDumper::lastError() const {
+    std::lock_guard<std::mutex> lk(mu_);
+    return lastError_;
+}
+
+void MetricsDumper::dumpOnce() {
+    std::string err;
+    metrics_.dumpToFile(path_, err);
+    std::lock_guard<std::mutex> lk(mu_);
+    lastError_ = err;
+}
+
+void MetricsDumper::loop() {
+    std::unique_lock<std::mutex> lk(mu_);
+    while (!stopping_) {
+        if (cv_.wait_for(lk, interval_, [this] { return stopping_; })) break;
+        lk.unlock();
+        dumpOnce();
+        lk.lock();
+    }
+}
+
+} // namespace sb
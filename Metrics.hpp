@@ -0,0 +1,196 @@
+/***************************************************************************************
+ * Metrics.hpp
+ * Latency histograms and counters for the public APIs, with Prometheus/JSON export.
+ *
+ * Each API (Api enum) has a fixed slot in the registry, so recording is just atomic adds
+ * with no lookup and no locks:
+ *
+ *     ApiTimer timer(Api::Suggest);   // records elapsed time on scope exit
+ *     if (!ok) timer.fail();          // also counts the call as failed
+ *
+ * Histograms are HDR-style log-linear: 16 sub-buckets per power of two of nanoseconds,
+ * so any recorded value (and every reported quantile) is within ~6% of the true value.
+ * Buckets are relaxed atomics; readers may see a snapshot that is a few records behind.
+ *
+ * Compile-out: building with -DSB_METRICS=0 (make METRICS=0) makes ApiTimer an empty
+ * type whose constructor does nothing, so the instrumented APIs contain no clock reads
+ * or atomics at all. The registry and exporters still exist and report zeros.
+ *
+ * MetricsDumper rewrites a file every interval (Prometheus text, or JSON when the path
+ * ends in ".json") for a local scraper to pick up; the file is replaced atomically.
+ *
+ * STANDARD LIBRARIES USED:
+ *  <array>              : per-API slots, buckets
+ *  <atomic>             : lock-free counters
+ *  <chrono>             : timing, dump interval
+ *  <condition_variable> : dumper wake-up / stop
+ *  <cstdint>            : 64-bit counters
+ *  <mutex>              : dumper state
+ *  <ostream>            : exporters
+ *  <string>             : file paths, errors
+ *  <thread>             : dumper thread
+ ****************************************************************************************/
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+
+#ifndef SB_METRICS
+#define SB_METRICS 1
+#endif
+
+namespace sb {
+
+inline constexpr bool kMetricsEnabled = SB_METRICS != 0;
+
+// Instrumented public APIs. Keep apiName() in sync.
+enum class Api : int {
+    Suggest,
+    BrowseByCourse,
+    BrowseByCourseAndDay,
+    FreeInWindow,
+    BestWindow,
+    NextCommonWindow,
+    TopCoEnrolled,
+    StudyPartnersOfPartners,
+    ByCourse,
+    ByName,
+    ByNameFuzzy,
+    Autocomplete,
+    SendRequest,
+    ConfirmRequest,
+    CancelConfirmed,
+    PendingFor,
+    ConfirmedFor,
+    Notify,
+    FetchAndClear,
+    SnapshotFork,
+    Count
+};
+const char* apiName(Api api);
+
+class LatencyHistogram {
+public:
+    static constexpr int kSubBits = 4;
+    static constexpr std::size_t kSub = std::size_t{1} << kSubBits;
+    static constexpr std::size_t kBuckets = (64 - kSubBits + 1) * kSub;
+
+    struct Snapshot {
+        std::uint64_t count = 0;
+        std::uint64_t sumNs = 0;
+        std::uint64_t maxNs = 0;
+        std::uint64_t p50Ns = 0, p90Ns = 0, p99Ns = 0, p999Ns = 0;
+    };
+
+    void record(std::uint64_t ns);
+    Snapshot snapshot() const;
+    void reset();
+
+    // Bucket of a value, and the largest value that maps to a bucket.
+    static std::size_t bucketOf(std::uint64_t ns);
+    static std::uint64_t bucketUpper(std::size_t bucket);
+
+private:
+    std::array<std::atomic<std::uint64_t>, kBuckets> buckets_{};
+    std::atomic<std::uint64_t> count_{0};
+    std::atomic<std::uint64_t> sum_{0};
+    std::atomic<std::uint64_t> max_{0};
+};
+
+class Metrics {
+public:
+    Metrics() = default;
+    Metrics(const Metrics&) = delete;
+    Metrics& operator=(const Metrics&) = delete;
+
+    // Process-wide registry the APIs record into.
+    static Metrics& global();
+
+    LatencyHistogram& latency(Api api) { return slots_[index(api)].latency; }
+    void countFailure(Api api) { slots_[index(api)].failures.fetch_add(1, std::memory_order_relaxed); }
+    std::uint64_t failures(Api api) const { return slots_[index(api)].failures.load(std::memory_order_relaxed); }
+    void reset();
+
+    // Exposition formats. Histograms are exported as summaries (quantiles, sum, count).
+    void writePrometheus(std::ostream& os) const;
+    void writeJson(std::ostream& os) const;
+
+    // Write to 'path' via a temporary file + rename. JSON if the path ends in ".json".
+    bool dumpToFile(const std::string& path, std::string& err) const;
+
+private:
+    static std::size_t index(Api api) { return static_cast<std::size_t>(api); }
+
+    struct Slot {
+        LatencyHistogram latency;
+        std::atomic<std::uint64_t> failures{0};
+    };
+    std::array<Slot, static_cast<std::size_t>(Api::Count)> slots_;
+};
+
+// Records the lifetime of a scope into Metrics::global() (see the policy note above).
+template <bool Enabled>
+class BasicApiTimer;
+
+template <>
+class BasicApiTimer<true> {
+public:
+    explicit BasicApiTimer(Api api) : api_(api), start_(std::chrono::steady_clock::now()) {}
+    ~BasicApiTimer() {
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start_).count();
+        Metrics::global().latency(api_).record(static_cast<std::uint64_t>(ns));
+    }
+    BasicApiTimer(const BasicApiTimer&) = delete;
+    BasicApiTimer& operator=(const BasicApiTimer&) = delete;
+
+    void fail() { Metrics::global().countFailure(api_); }
+
+private:
+    Api api_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+template <>
+class BasicApiTimer<false> {
+public:
+    explicit BasicApiTimer(Api) {}
+    void fail() {}
+};
+
+using ApiTimer = BasicApiTimer<kMetricsEnabled>;
+
+// Background thread that dumps a registry to a file every 'interval' and once more on
+// destruction.
+class MetricsDumper {
+public:
+    MetricsDumper(const Metrics& metrics, std::string path, std::chrono::milliseconds interval);
+    ~MetricsDumper();
+    MetricsDumper(const MetricsDumper&) = delete;
+    MetricsDumper& operator=(const MetricsDumper&) = delete;
+
+    // Last write error (empty if the last dump succeeded).
+    std::string lastError() const;
+
+private:
+    void loop();
+    void dumpOnce();
+
+    const Metrics& metrics_;
+    std::string path_;
+    std::chrono::milliseconds interval_;
+    mutable std::mutex mu_;
+    std::condition_variable cv_;
+    bool stopping_ = false;
+    std::string lastError_;
+    std::thread thread_;
+};
+
+} // namespace sb
@@ -2,27 +2,34 @@
  * NotificationCenter.cpp — implementation
  ****************************************************************************************/
 #include "NotificationCenter.hpp"
+#include "StringPool.hpp"
+#include "Metrics.hpp"
+#include "Trace.hpp"
 
 namespace sb {
 
-void NotificationCenter::notify(const std::string& email, const std::string& message) {
-    inbox_[email].push_back(message);
+void NotificationCenter::notify(std::string_view email, const std::string& message) {
+    ApiTimer timer(Api::Notify);
+    TraceSpan span("notify", "notifications");
+    // Intern only when the inbox is new; existing inboxes are found by the view itself.
+    if (auto* box = inbox_.find(email)) box->push_back(message);
+    else inbox_.tryEmplace(intern(email)).first->push_back(message);
 }
 
-std::vector<std::string> NotificationCenter::fetchAndClear(const std::string& email) {
+std::vector<std::string> NotificationCenter::fetchAndClear(std::string_view email) {
+    ApiTimer timer(Api::FetchAndClear);
+    TraceSpan span("fetchAndClear", "notifications");
     std::vector<std::string> out;
-    auto it = inbox_.find(email);
-    if (it != inbox_.end()) {
-        out = std::move(it->second);
-        inbox_.erase(it);
+    if (auto* box = inbox_.find(email)) {
+        out = std::move(*box);
+        inbox_.erase(email);
     }
     return out;
 }
 
-std::vector<std::string> NotificationCenter::peek(const std::string& email) const {
-    auto it = inbox_.find(email);
-    if (it == inbox_.end()) return {};
-    return it->second;
+std::vector<std::string> NotificationCenter::peek(std::string_view email) const {
+    const auto* box = inbox_.find(email);
+    return box ? *box : std::vector<std::string>{};
 }
 
 } // namespace sb
\ No newline at end of file
@@ -2,14 +2,19 @@
  * NotificationCenter.hpp
  * Feature: Simple per-user notification inbox (request/confirm messages).
  *
+ * Inboxes are keyed by the interned email (StringPool.hpp), so the key shares its bytes
+ * with the profile and the sessions that mention the same user.
+ *
  * STANDARD LIBRARIES USED:
- *  <unordered_map> : per-email inbox
- *  <string>        : message text and email keys
+ *  FlatMap.hpp     : per-email inbox (open addressing, one flat array)
+ *  <string>        : message text
+ *  <string_view>   : interned email keys
  *  <vector>        : fetch results
  ****************************************************************************************/
 #pragma once
-#include <unordered_map>
+#include "FlatMap.hpp"
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace sb {
@@ -17,16 +22,16 @@ namespace sb {
 class NotificationCenter {
 public:
     // Push a notification to a user's inbox (keyed by email).
-    void notify(const std::string& email, const std::string& message);
+    void notify(std::string_view email, const std::string& message);
 
     // Retrieve all messages for 'email' and CLEAR the inbox.
-    std::vector<std::string> fetchAndClear(const std::string& email);
+    std::vector<std::string> fetchAndClear(std::string_view email);
 
     // Peek without clearing (useful for tests).
-    std::vector<std::string> peek(const std::string& email) const;
+    std::vector<std::string> peek(std::string_view email) const;
 
 private:
-    std::unordered_map<std::string, std::vector<std::string>> inbox_;
+    FlatMap<std::string_view, std::vector<std::string>, StrHash> inbox_; // interned keys
 };
 
 } // namespace sb
\ No newline at end of file
@@ -0,0 +1,217 @@
+/***************************************************************************************
+ * OccupancyIndex.cpp — implementation
+ ****************************************************************************************/
+#include "OccupancyIndex.hpp"
+#include "Metrics.hpp"
+#include "StringPool.hpp"
+#include "Utils.hpp"
+
+#include <algorithm>
+#include <climits>
+
+namespace sb {
+
+/* ---------------------------------- DayList ---------------------------------- */
+
+long OccupancyIndex::DayList::replace(std::uint32_t id, const std::vector<std::pair<int, int>>& runs) {
+    auto keep = std::remove_if(byStart_.begin(), byStart_.end(),
+                               [id](const Interval& x) { return x.id == id; });
+    long removed = static_cast<long>(byStart_.end() - keep);
+    if (removed == 0 && runs.empty()) return 0;
+    byStart_.erase(keep, byStart_.end());
+    for (const auto& r : runs) {
+        auto pos = std::upper_bound(byStart_.begin(), byStart_.end(), r.first,
+                                    [](int s, const Interval& x) { return s < x.start; });
+        byStart_.insert(pos, Interval{r.first, r.second, id});
+    }
+    build();
+    return static_cast<long>(runs.size()) - removed;
+}
+
+void OccupancyIndex::DayList::finish() {
+    std::stable_sort(byStart_.begin(), byStart_.end(),
+                     [](const Interval& a, const Interval& b) { return a.start < b.start; });
+    build();
+}
+
+void OccupancyIndex::DayList::build() {
+    cap_ = 1;
+    while (cap_ < byStart_.size()) cap_ *= 2;
+    maxEnd_.assign(2 * cap_, INT_MIN);
+    for (std::size_t i = 0; i < byStart_.size(); ++i) maxEnd_[cap_ + i] = byStart_[i].end;
+    for (std::size_t i = cap_ - 1; i >= 1; --i) maxEnd_[i] = std::max(maxEnd_[2 * i], maxEnd_[2 * i + 1]);
+}
+
+void OccupancyIndex::DayList::collect(std::size_t node, std::size_t lo, std::size_t hi, std::size_t limit,
+                                      int endAtLeast, std::vector<std::size_t>& out) const {
+    // [lo, hi) is the range of positions under 'node'; only [0, limit) is eligible.
+    if (lo >= limit || maxEnd_[node] < endAtLeast) return;
+    if (hi - lo == 1) {
+        out.push_back(byStart_[lo].id);
+        return;
+    }
+    std::size_t mid = lo + (hi - lo) / 2;
+    collect(2 * node, lo, mid, limit, endAtLeast, out);
+    collect(2 * node + 1, mid, hi, limit, endAtLeast, out);
+}
+
+void OccupancyIndex::DayList::query(int startBefore, int endAtLeast, std::vector<std::size_t>& out) const {
+    auto limit = std::lower_bound(byStart_.begin(), byStart_.end(), startBefore,
+                                  [](const Interval& x, int s) { return x.start < s; });
+    std::size_t n = static_cast<std::size_t>(limit - byStart_.begin());
+    if (n) collect(1, 0, cap_, n, endAtLeast, out);
+}
+
+/* ------------------------------- OccupancyIndex ------------------------------- */
+
+DayRuns freeRunsByDay(const std::vector<AvailabilitySlot>& slots) {
+    DayRuns runs;
+    for (const auto& s : slots) {
+        int d = static_cast<int>(s.day);
+        if (d >= 0 && d < 7 && s.start < s.end) runs[d].push_back({s.start, s.end});
+    }
+    for (auto& day : runs) {
+        if (day.size() < 2) continue;
+        std::sort(day.begin(), day.end());
+        std::size_t w = 0;
+        for (std::size_t r = 1; r < day.size(); ++r) {
+            if (day[r].first <= day[w].second) day[w].second = std::max(day[w].second, day[r].second);
+            else day[++w] = day[r];
+        }
+        day.resize(w + 1);
+    }
+    return runs;
+}
+
+OccupancyIndex::OccupancyIndex(const std::vector<Profile>& roster) {
+    byId_.resize(roster.size());
+    for (std::size_t i = 0; i < roster.size(); ++i) {
+        Seen& s = byId_[i];
+        for (const auto& c : roster[i].courses()) {
+            std::uint32_t cid = courseId(c);
+            if (std::find(s.courses.begin(), s.courses.end(), cid) != s.courses.end()) continue;
+            s.courses.push_back(cid);
+            if (enrolled_[cid]++ == 0) ++liveCourses_;
+        }
+        s.schedule = roster[i].availabilityCommitted() ? roster[i].schedule() : nullptr;
+        if (!s.courses.empty()) {
+            auto runs = freeRunsByDay(roster[i].availability());
+            for (std::uint32_t cid : s.courses) {
+                for (int d = 0; d < 7; ++d) {
+                    for (const auto& r : runs[d]) lists_[cid][d].append(Interval{r.first, r.second, static_cast<std::uint32_t>(i)});
+                    intervals_ += runs[d].size();
+                }
+            }
+        }
+    }
+    for (auto& course : lists_) {
+        for (auto& day : course) day.finish();
+    }
+}
+
+std::uint32_t OccupancyIndex::courseId(std::string_view code) {
+    std::string key = upperCopy(trim(std::string(code)));
+    if (const std::uint32_t* id = courseIds_.find(std::string_view(key))) return *id;
+    auto id = static_cast<std::uint32_t>(lists_.size());
+    lists_.emplace_back();
+    enrolled_.push_back(0);
+    courseIds_.tryEmplace(codes_->intern(key), id);
+    return id;
+}
+
+void OccupancyIndex::update(std::size_t id, const Profile& p) {
+    if (id >= byId_.size()) byId_.resize(id + 1);
+    Seen now;
+    for (const auto& c : p.courses()) {
+        std::uint32_t cid = courseId(c);
+        if (std::find(now.courses.begin(), now.courses.end(), cid) == now.courses.end()) now.courses.push_back(cid);
+    }
+    now.schedule = p.availabilityCommitted() ? p.schedule() : nullptr;
+
+    Seen& old = byId_[id];
+    // Schedules are hash-consed: the same pointer means the same slots.
+    bool sameCourses = now.courses == old.courses;
+    if (sameCourses && now.schedule && now.schedule == old.schedule) return;
+
+    auto uid = static_cast<std::uint32_t>(id);
+    DayRuns runs = freeRunsByDay(p.availability());
+    static const std::vector<std::pair<int, int>> none;
+    if (sameCourses && old.schedule) {
+        // Same courses: rewrite only the days whose free time changed.
+        DayRuns before = freeRunsByDay(old.schedule->slots());
+        for (int d = 0; d < 7; ++d) {
+            if (runs[d] == before[d]) continue;
+            for (std::uint32_t cid : now.courses) intervals_ += lists_[cid][d].replace(uid, runs[d]);
+        }
+    } else {
+        for (std::uint32_t cid : old.courses) {
+            if (std::find(now.courses.begin(), now.courses.end(), cid) != now.courses.end()) continue;
+            for (auto& day : lists_[cid]) intervals_ += day.replace(uid, none);
+        }
+        // Same schedule: lists of courses kept are already right (enrollment reloads).
+        bool sameSchedule = now.schedule && now.schedule == old.schedule;
+        for (std::uint32_t cid : now.courses) {
+            if (sameSchedule && std::find(old.courses.begin(), old.courses.end(), cid) != old.courses.end()) continue;
+            for (int d = 0; d < 7; ++d) intervals_ += lists_[cid][d].replace(uid, runs[d]);
+        }
+    }
+    if (sameCourses) {
+        old = std::move(now);
+        return;
+    }
+    auto has = [](const std::vector<std::uint32_t>& list, std::uint32_t cid) {
+        return std::find(list.begin(), list.end(), cid) != list.end();
+    };
+    for (std::uint32_t cid : old.courses) if (!has(now.courses, cid) && --enrolled_[cid] == 0) --liveCourses_;
+    for (std::uint32_t cid : now.courses) if (!has(old.courses, cid) && enrolled_[cid]++ == 0) ++liveCourses_;
+    old = std::move(now);
+    // Clients can invent course codes at will; rebuild once dead ones outnumber the rest.
+    if (lists_.size() > 1024 && lists_.size() > 2 * liveCourses_) compact();
+}
+
+void OccupancyIndex::compact() {
+    // A course without students has no intervals left: only its id and code go.
+    static constexpr std::uint32_t kDropped = 0xFFFFFFFFu;
+    std::vector<std::uint32_t> remap(lists_.size(), kDropped);
+    std::vector<std::array<DayList, 7>> lists;
+    std::vector<std::uint32_t> enrolled;
+    auto codes = std::make_unique<StringPool>();
+    FlatMap<std::string_view, std::uint32_t, StrHash> ids(liveCourses_);
+    courseIds_.forEach([&](std::string_view code, std::uint32_t cid) {
+        if (enrolled_[cid] == 0) return;
+        remap[cid] = static_cast<std::uint32_t>(lists.size());
+        ids.tryEmplace(codes->intern(code), remap[cid]);
+        lists.push_back(std::move(lists_[cid]));
+        enrolled.push_back(enrolled_[cid]);
+    });
+    courseIds_ = std::move(ids); // before codes_: the old keys point into the old pool
+    codes_ = std::move(codes);
+    lists_ = std::move(lists);
+    enrolled_ = std::move(enrolled);
+    for (Seen& s : byId_) {
+        for (std::uint32_t& cid : s.courses) cid = remap[cid];
+    }
+}
+
+std::vector<std::size_t> OccupancyIndex::freeIn(const std::string& course, Day day, int start, int end,
+                                                Match match) const {
+    ApiTimer timer(Api::FreeInWindow);
+    std::vector<std::size_t> out;
+    int d = static_cast<int>(day);
+    if (start >= end || d < 0 || d >= 7) return out;
+    std::string key = upperCopy(trim(course));
+    const std::uint32_t* cid = courseIds_.find(std::string_view(key));
+    if (!cid) return out;
+
+    const DayList& list = lists_[*cid][d];
+    if (match == Match::Full) {
+        list.query(start + 1, end, out);  // start <= s, end >= e
+    } else {
+        list.query(end, start + 1, out);  // start < e, end > s
+    }
+    std::sort(out.begin(), out.end());
+    if (match == Match::Partial) out.erase(std::unique(out.begin(), out.end()), out.end());
+    return out;
+}
+
+} // namespace sb
@@ -0,0 +1,123 @@
+/***************************************************************************************
+ * OccupancyIndex.hpp
+ * "Who in CPSC 2150 is free Tuesday 14:00-15:00?" without scanning the roster.
+ *
+ * For every (course, day) the index keeps the free intervals of the enrolled students,
+ * sorted by start, with a max-end segment tree on top. Both query shapes reduce to "in the
+ * prefix of intervals starting before X, report those ending at or after Y":
+ *  - Full    : free for the whole window   (start <= s and end >= e)
+ *  - Partial : free at some point in it    (start <  e and end >  s)
+ * A binary search finds the prefix and the tree descent only enters subtrees holding a
+ * match, so a query costs O(log n + k log n) for k results in a course of n intervals.
+ *
+ * A student's slots are coalesced per day first (overlapping or touching slots become one
+ * run), so "fully free" means free without a gap even if AvailabilityEditor left the slots
+ * split.
+ *
+ * Ids are indexes into the profile vector the index mirrors (Roster ids). update(id, p)
+ * is incremental: it is a no-op when the profile's courses and (hash-consed) schedule are
+ * unchanged; otherwise it rewrites only that student's entries (O(n) per list touched):
+ * with unchanged courses only on the days whose free time changed, with an unchanged
+ * schedule only in the courses added or dropped. Course codes match exactly after
+ * trim + upper-case, like AvailabilityBrowser. Codes nobody is enrolled in any more are
+ * dropped (lists, ids and pooled text) once they outnumber the live ones.
+ * Queries are const and safe to call concurrently; update() is not.
+ *
+ * STANDARD LIBRARIES USED:
+ *  <array>       : one list per weekday
+ *  <cstdint>     : compact ids
+ *  <memory>      : the index's course-code pool
+ *  <string_view> : pooled course keys
+ *  <utility>     : (start, end) runs
+ *  <vector>      : interval lists, segment trees, results
+ ****************************************************************************************/
+#pragma once
+#include "Profile.hpp"
+#include "FlatMap.hpp"
+#include "StringPool.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace sb {
+
+// Free time per weekday as [start, end) runs: slots sorted by start, overlapping or
+// touching slots coalesced. Shared by the availability indexes.
+using DayRuns = std::array<std::vector<std::pair<int, int>>, 7>;
+DayRuns freeRunsByDay(const std::vector<AvailabilitySlot>& slots);
+
+class OccupancyIndex {
+public:
+    enum class Match { Full, Partial };
+
+    OccupancyIndex() = default;
+    explicit OccupancyIndex(const std::vector<Profile>& roster);
+
+    // Re-index profile 'id' from its current courses and availability.
+    void update(std::size_t id, const Profile& p);
+
+    // Ids (ascending) of students enrolled in 'course' who are free on 'day' for the whole
+    // of [start, end) (Full) or for some part of it (Partial). Empty if start >= end.
+    std::vector<std::size_t> freeIn(const std::string& course, Day day, int start, int end,
+                                    Match match = Match::Full) const;
+
+    // Ids of students in 'course' free at minute 't' on 'day'.
+    std::vector<std::size_t> freeAt(const std::string& course, Day day, int t) const {
+        return freeIn(course, day, t, t + 1, Match::Full);
+    }
+
+    std::size_t courseCount() const { return courseIds_.size(); }
+    std::size_t intervalCount() const { return intervals_; }
+
+private:
+    struct Interval {
+        int start;
+        int end;
+        std::uint32_t id;
+    };
+
+    // Free intervals of one course on one day.
+    class DayList {
+    public:
+        // Replace every interval of 'id' with 'runs' (kept sorted, one tree rebuild).
+        // Returns the change in the number of intervals.
+        long replace(std::uint32_t id, const std::vector<std::pair<int, int>>& runs);
+        void append(const Interval& iv) { byStart_.push_back(iv); } // bulk load, then finish()
+        void finish();                        // sort + build after append()
+        void query(int startBefore, int endAtLeast, std::vector<std::size_t>& out) const;
+        std::size_t size() const { return byStart_.size(); }
+
+    private:
+        void build();
+        void collect(std::size_t node, std::size_t lo, std::size_t hi, std::size_t limit,
+                     int endAtLeast, std::vector<std::size_t>& out) const;
+
+        std::vector<Interval> byStart_;
+        std::vector<int> maxEnd_; // segment tree, leaves at [cap_, 2*cap_)
+        std::size_t cap_ = 0;
+    };
+
+    struct Seen {
+        std::vector<std::uint32_t> courses; // course list ids
+        ScheduleRef schedule;
+    };
+
+    std::uint32_t courseId(std::string_view code); // creates on first use
+    void compact();                                // drop courses with no students
+
+    std::unique_ptr<StringPool> codes_ = std::make_unique<StringPool>(); // client text: not the global pool
+    FlatMap<std::string_view, std::uint32_t, StrHash> courseIds_; // upper-case codes in codes_
+    std::vector<std::array<DayList, 7>> lists_;
+    std::vector<std::uint32_t> enrolled_; // students per course id
+    std::size_t liveCourses_ = 0;         // course ids with students
+    std::vector<Seen> byId_;
+    std::size_t intervals_ = 0;
+};
+
+} // namespace sb
@@ -3,6 +3,8 @@
  ****************************************************************************************/
 #include "Profile.hpp"
 #include "Utils.hpp"
+#include "StringPool.hpp"
+#include "Schedule.hpp"
 
 #include <algorithm>
 #include <iostream>
@@ -11,40 +13,91 @@ namespace sb {
 
 const char* kDayNames[7] = {"Mon","Tue","Wed","Thu","Fri","Sat","Sun"};
 
-void Profile::createOrReset(const std::string& name,
-                            const std::string& email,
+// All default-constructed profiles share one empty Data until first mutation.
+const std::shared_ptr<Profile::Data>& Profile::emptyData() {
+    static const std::shared_ptr<Data> empty = std::make_shared<Data>();
+    return empty;
+}
+
+Profile::Profile() : d_(emptyData()) {}
+
+Profile::Data& Profile::detach() {
+    // use_count()==1 means no other handle (in this or any other thread) can reach d_.
+    if (d_.use_count() != 1) d_ = std::make_shared<Data>(*d_);
+    return *d_;
+}
+
+void Profile::createOrReset(std::string_view name,
+                            std::string_view email,
                             const std::vector<std::string>& coursesUpperDedup) {
-    // Set simple fields
-    name_ = name;
-    email_ = email;
+    // Fresh data: nothing from the previous profile (or other sharers) is kept.
+    auto fresh = std::make_shared<Data>();
+    fresh->name = std::string(name);
+    fresh->email = intern(email);
     // Replace courses with normalized & de-duplicated list provided by caller.
-    courses_ = coursesUpperDedup;
-    // Reset availability to avoid stale windows from a previous profile.
-    availability_.clear();
-    exists_ = true;
+    fresh->courses = coursesUpperDedup;
+    // Availability starts empty to avoid stale windows from a previous profile.
+    fresh->exists = true;
+    d_ = std::move(fresh);
 }
 
 void Profile::clearAvailability() {
-    availability_.clear();
+    if (!d_->editing && d_->schedule->empty()) return;
+    Data& d = detach();
+    d.schedule = Schedule::emptySchedule();
+    d.editSlots.clear();
+    d.editing = false;
+}
+
+std::vector<AvailabilitySlot>& Profile::availabilityMutable() {
+    Data& d = detach();
+    if (!d.editing) {
+        d.editSlots = d.schedule->slots();
+        d.editing = true;
+    }
+    return d.editSlots;
+}
+
+SlotView Profile::slotsOn(Day day) const {
+    if (!d_->editing) return d_->schedule->on(day);
+    const auto& v = d_->editSlots;
+    return SlotView(v.data(), v.data() + v.size(), static_cast<int>(day));
+}
+
+SlotView Profile::slots() const {
+    const auto& v = availability();
+    return SlotView(v.data(), v.data() + v.size());
+}
+
+bool Profile::commitAvailability() {
+    if (d_->editing) {
+        Data& d = detach();
+        d.schedule = SchedulePool::global().intern(std::move(d.editSlots));
+        d.editSlots = {};
+        d.editing = false;
+    }
+    return d_->schedule->dayIndexed();
 }
 
 void Profile::printCourses() const {
-    if (courses_.empty()) {
+    const auto& courses = d_->courses;
+    if (courses.empty()) {
         std::cout << "  (no courses yet)\n";
         return;
     }
-    for (size_t i = 0; i < courses_.size(); ++i) {
-        std::cout << "  [" << (i+1) << "] " << courses_[i] << "\n";
+    for (size_t i = 0; i < courses.size(); ++i) {
+        std::cout << "  [" << (i+1) << "] " << courses[i] << "\n";
     }
 }
 
 void Profile::printAvailability() const {
-    if (availability_.empty()) {
+    const auto& slots = availability();
+    if (slots.empty()) {
         std::cout << "  (no availability yet)\n";
         return;
     }
     Day current = static_cast<Day>(-1);
-    for (const auto& s : availability_) {
+    for (const auto& s : slots) {
         if (current != s.day) {
             current = s.day;
             std::cout << "  " << kDayNames[static_cast<int>(s.day)] << ": ";
@@ -56,13 +109,13 @@ void Profile::printAvailability() const {
 }
 
 void Profile::show() const {
-    if (!exists_) {
+    if (!d_->exists) {
         std::cout << "No profile exists yet. Choose '1' to create one.\n";
         return;
     }
     std::cout << "\n==== Your Profile ====\n";
-    std::cout << "Name   : " << (name_.empty() ? "(not set)" : name_) << "\n";
-    std::cout << "Email  : " << (email_.empty() ? "(not set)" : email_) << "\n";
+    std::cout << "Name   : " << (d_->name.empty() ? "(not set)" : d_->name) << "\n";
+    std::cout << "Email  : " << (d_->email.empty() ? "(not set)" : d_->email) << "\n";
     std::cout << "Courses:\n";
     printCourses();
     std::cout << "Availability:\n";
@@ -2,46 +2,90 @@
  * Profile.hpp
  * Feature 1: A student's profile containing name, Clemson email, courses, and availability.
  *
+ * Profiles are copy-on-write handles: copying one shares the underlying data, and the
+ * first mutation through a *Mutable()/createOrReset()/clear* call on a shared handle
+ * detaches a private copy. This keeps roster snapshots (RosterSnapshot.hpp) cheap to
+ * publish. Note: references obtained from *Mutable() must not be used after copying
+ * the profile, since the copy shares the same data until one side detaches.
+ *
+ * Emails are interned in StringPool::global(): profiles hold string_views into the pool,
+ * so equal identities (and copies of a profile) never duplicate the bytes. Names are
+ * display text that can be replaced at will, so each profile owns its own (the pool
+ * never frees, and would grow with every rename).
+ *
+ * Availability is a shared, hash-consed Schedule (Schedule.hpp): profiles with identical
+ * slots point at one immutable object. availabilityMutable() hands out a private copy of
+ * the slots; commitAvailability() interns the edited list as the profile's schedule again
+ * (AvailabilityManager, AvailabilityEditor, Roster and RosterSnapshot commit for you).
+ * Reads work in either state; slotsOn(day) is a direct span once committed.
+ *
  * STANDARD LIBRARIES USED:
- *  <string>     : user name/email fields.
+ *  <string>     : name, course codes.
+ *  <string_view>: interned email.
  *  <vector>     : course list and availability vector.
+ *  <memory>     : shared_ptr for copy-on-write profile data.
  *  <iostream>   : for printing helpers (declarations only; implemented in .cpp).
  ****************************************************************************************/
 #pragma once
+#include "Schedule.hpp"
+
+#include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace sb {
 
-// Days of the week kept compact for availability.
-enum class Day : int { Mon=0, Tue, Wed, Thu, Fri, Sat, Sun };
 extern const char* kDayNames[7];
 
-// Single availability window on a day: [start,end) minutes since midnight.
-struct AvailabilitySlot {
-    Day  day;
-    int  start; // minutes since midnight
-    int  end;   // minutes since midnight
-};
-
 // The student profile object (single user in this CLI prototype).
 class Profile {
 public:
+    Profile();
+    Profile(const Profile&) = default;
+    Profile& operator=(const Profile&) = default;
+    // Moved-from profiles are left empty (not null) so they stay safe to read.
+    Profile(Profile&& other) noexcept : d_(std::move(other.d_)) { other.d_ = emptyData(); }
+    Profile& operator=(Profile&& other) noexcept {
+        if (this != &other) { d_ = std::move(other.d_); other.d_ = emptyData(); }
+        return *this;
+    }
+
     // Create/Reset fields (Feature 1). Returns true on success.
-    void createOrReset(const std::string& name,
-                       const std::string& email,
+    void createOrReset(std::string_view name,
+                       std::string_view email,
                        const std::vector<std::string>& coursesUpperDedup);
 
     // Accessors / modifiers
-    const std::string& name()  const { return name_;  }
-    const std::string& email() const { return email_; }
-    const std::vector<std::string>& courses() const { return courses_; }
-    std::vector<std::string>& coursesMutable() { return courses_; }
+    std::string_view name()  const { return d_->name;  }
+    std::string_view email() const { return d_->email; }
+    // Name, or email when the name is blank (how listings label a classmate).
+    std::string_view displayName() const { return d_->name.empty() ? d_->email : d_->name; }
+    const std::vector<std::string>& courses() const { return d_->courses; }
+    std::vector<std::string>& coursesMutable() { return detach().courses; }
 
-    const std::vector<AvailabilitySlot>& availability() const { return availability_; }
-    std::vector<AvailabilitySlot>& availabilityMutable() { return availability_; }
+    const std::vector<AvailabilitySlot>& availability() const {
+        return d_->editing ? d_->editSlots : d_->schedule->slots();
+    }
+    // Private, editable copy of the slots; call commitAvailability() when done.
+    std::vector<AvailabilitySlot>& availabilityMutable();
 
-    bool exists() const { return exists_; }
+    // All slots on 'day' (a direct span once committed, see header comment).
+    SlotView slotsOn(Day day) const;
+    SlotView slots() const;
+
+    // Intern edited slots as the profile's shared schedule. Returns true if the committed
+    // schedule is day-indexed (slots in day order).
+    bool commitAvailability();
+    bool availabilityCommitted() const { return !d_->editing; }
+
+    // Last committed schedule (shared with every profile that has the same slots).
+    const ScheduleRef& schedule() const { return d_->schedule; }
+
+    bool exists() const { return d_->exists; }
+
+    // True if both handles currently share the same data (no copy has been made).
+    bool sharesDataWith(const Profile& other) const { return d_ == other.d_; }
     void clearAvailability(); // utility used on reset
 
     // Pretty printers (to keep main lean)
@@ -50,11 +94,21 @@ public:
     void show() const;
 
 private:
-    std::string name_;
-    std::string email_;
-    std::vector<std::string> courses_;
-    std::vector<AvailabilitySlot> availability_;
-    bool exists_ = false;
+    struct Data {
+        std::string name;
+        std::string_view email; // interned
+        std::vector<std::string> courses;
+        ScheduleRef schedule = Schedule::emptySchedule();
+        std::vector<AvailabilitySlot> editSlots; // used while 'editing'
+        bool editing = false;
+        bool exists = false;
+    };
+
+    // Make d_ exclusively owned (copying it if shared) and return it for mutation.
+    Data& detach();
+    static const std::shared_ptr<Data>& emptyData();
+
+    std::shared_ptr<Data> d_;
 };
 
 } // namespace sb
\ No newline at end of file
@@ -0,0 +1,72 @@
+/***************************************************************************************
+ * ProfileHistory.cpp — implementation
+ ****************************************************************************************/
+#include "ProfileHistory.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+namespace sb {
+
+// Same observable state (committed schedules compare by pointer: they are hash-consed).
+static bool sameState(const Profile& a, const Profile& b) {
+    if (a.sharesDataWith(b)) return true;
+    return a.exists() == b.exists() && a.name() == b.name() && a.email() == b.email() &&
+           a.courses() == b.courses() && a.schedule() == b.schedule();
+}
+
+ProfileHistory::ProfileHistory(Roster& roster, std::size_t keepPerProfile)
+    : roster_(roster), keep_(std::max<std::size_t>(1, keepPerProfile)) {
+    for (std::size_t id = 0; id < roster.size(); ++id) {
+        record(RosterChange{RosterChange::Kind::Added, id, roster.profiles()[id], {}});
+    }
+    token_ = roster_.subscribe([this](const RosterChange& c) { record(c); });
+}
+
+ProfileHistory::~ProfileHistory() { roster_.unsubscribe(token_); }
+
+void ProfileHistory::record(const RosterChange& c) {
+    if (c.id >= logs_.size()) logs_.resize(c.id + 1);
+    std::deque<Entry>& log = logs_[c.id];
+    if (!log.empty() && sameState(log.back().profile, c.profile)) return;
+
+    Version parent = restoringParent_ ? *restoringParent_ : (log.empty() ? 0 : log.back().version);
+    log.push_back(Entry{next_++, parent, c.profile});
+    ++retained_;
+    if (log.size() > keep_) {
+        log.pop_front();
+        --retained_;
+    }
+}
+
+std::optional<Profile> ProfileHistory::at(std::size_t id, Version v) const {
+    if (id >= logs_.size()) return std::nullopt;
+    const std::deque<Entry>& log = logs_[id];
+    auto it = std::upper_bound(log.begin(), log.end(), v,
+                               [](Version x, const Entry& e) { return x < e.version; });
+    if (it == log.begin()) return std::nullopt;
+    return std::prev(it)->profile;
+}
+
+const std::deque<ProfileHistory::Entry>& ProfileHistory::versions(std::size_t id) const {
+    static const std::deque<Entry> none;
+    return id < logs_.size() ? logs_[id] : none;
+}
+
+bool ProfileHistory::undo(std::size_t id) {
+    if (id >= logs_.size() || logs_[id].empty() || id >= roster_.size()) return false;
+    const std::deque<Entry>& log = logs_[id];
+    Version target = log.back().parent;
+    if (target == 0) return false;
+    auto it = std::lower_bound(log.begin(), log.end(), target,
+                               [](const Entry& e, Version x) { return e.version < x; });
+    if (it == log.end() || it->version != target) return false;
+
+    Profile restore = it->profile;
+    restoringParent_ = it->parent;
+    roster_.edit(roster_.handle(id), [&](Profile& p) { p = restore; });
+    restoringParent_.reset();
+    return true;
+}
+
+} // namespace sb
@@ -0,0 +1,81 @@
+/***************************************************************************************
+ * ProfileHistory.hpp
+ * Versioned history of every roster profile: undo, point-in-time reads, bounded retention.
+ *
+ * The history subscribes to a Roster and records a version after every add/edit that
+ * changed a profile (CourseManager, AvailabilityManager, AvailabilityEditor, ... all edit
+ * through Roster::edit). A version is just a Profile handle: profiles are copy-on-write and
+ * schedules are hash-consed (Profile.hpp, Schedule.hpp), so a version shares its schedule
+ * with the live profile and with every other version that has the same slots, and costs
+ * one small profile header plus its course list, never a copy of the availability.
+ *
+ * Version numbers come from one counter shared by all profiles, so "the roster as of
+ * version v" is well defined: record now() when something happens (a session request)
+ * and ask at(id, v) later. undo(id) restores the state before the last change as a new
+ * version; the log itself is append-only, so audits still see what was undone.
+ * Each profile keeps its last keepPerProfile versions.
+ *
+ * Not thread-safe, like Roster.
+ *
+ * STANDARD LIBRARIES USED:
+ *  <cstdint>  : version numbers
+ *  <deque>    : per-profile version log (pop oldest)
+ *  <optional> : "not retained / did not exist"
+ *  <vector>   : logs by profile id
+ ****************************************************************************************/
+#pragma once
+#include "Roster.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <vector>
+
+namespace sb {
+
+class ProfileHistory {
+public:
+    using Version = std::uint64_t; // 0 = before any recorded change
+
+    struct Entry {
+        Version version;
+        Version parent;  // version this state was derived from (0 for the first one)
+        Profile profile; // shared, read-only snapshot
+    };
+
+    explicit ProfileHistory(Roster& roster, std::size_t keepPerProfile = 32);
+    ~ProfileHistory();
+    ProfileHistory(const ProfileHistory&) = delete; // subscribed to one roster
+    ProfileHistory& operator=(const ProfileHistory&) = delete;
+
+    // Latest version number handed out (to any profile).
+    Version now() const { return next_ - 1; }
+
+    // Profile 'id' as it was at global version 'v'; nullopt if it did not exist yet or
+    // that state is no longer retained.
+    std::optional<Profile> at(std::size_t id, Version v) const;
+
+    // Retained versions of profile 'id', oldest first.
+    const std::deque<Entry>& versions(std::size_t id) const;
+
+    // Put profile 'id' back to the state its current version was derived from (through
+    // Roster::edit, so indexes follow). Repeated calls keep walking back. Returns false
+    // if there is nothing to undo or the earlier state is no longer retained.
+    bool undo(std::size_t id);
+
+    std::size_t versionCount() const { return retained_; }
+
+private:
+    void record(const RosterChange& c);
+
+    Roster& roster_;
+    std::size_t keep_;
+    std::size_t token_;
+    std::vector<std::deque<Entry>> logs_;
+    Version next_ = 1;
+    std::size_t retained_ = 0;
+    std::optional<Version> restoringParent_; // set while undo() edits the roster
+};
+
+} // namespace sb
@@ -0,0 +1,79 @@
+/***************************************************************************************
+ * Protocol.cpp — implementation
+ ****************************************************************************************/
+#include "Protocol.hpp"
+
+namespace sb {
+namespace wire {
+
+void Writer::u16(std::uint16_t v) {
+    buf_.push_back(static_cast<std::uint8_t>(v));
+    buf_.push_back(static_cast<std::uint8_t>(v >> 8));
+}
+
+void Writer::u32(std::uint32_t v) {
+    for (int i = 0; i < 4; ++i) buf_.push_back(static_cast<std::uint8_t>(v >> (8 * i)));
+}
+
+void Writer::str(std::string_view s) {
+    std::size_t n = s.size() > 0xFFFF ? 0xFFFF : s.size();
+    u16(static_cast<std::uint16_t>(n));
+    buf_.insert(buf_.end(), s.begin(), s.begin() + static_cast<std::ptrdiff_t>(n));
+}
+
+std::vector<std::uint8_t> Writer::finishFrame() {
+    std::uint32_t body = static_cast<std::uint32_t>(buf_.size() - 4);
+    for (int i = 0; i < 4; ++i) buf_[i] = static_cast<std::uint8_t>(body >> (8 * i));
+    std::vector<std::uint8_t> out;
+    out.swap(buf_);
+    buf_.resize(4);
+    return out;
+}
+
+bool Reader::need(std::size_t n) {
+    if (!ok_ || static_cast<std::size_t>(end_ - p_) < n) { ok_ = false; return false; }
+    return true;
+}
+
+std::uint8_t Reader::u8() {
+    if (!need(1)) return 0;
+    return *p_++;
+}
+
+std::uint16_t Reader::u16() {
+    if (!need(2)) return 0;
+    std::uint16_t v = static_cast<std::uint16_t>(p_[0] | (p_[1] << 8));
+    p_ += 2;
+    return v;
+}
+
+std::uint32_t Reader::u32() {
+    if (!need(4)) return 0;
+    std::uint32_t v = 0;
+    for (int i = 0; i < 4; ++i) v |= static_cast<std::uint32_t>(p_[i]) << (8 * i);
+    p_ += 4;
+    return v;
+}
+
+std::string Reader::str() {
+    std::uint16_t n = u16();
+    if (!need(n)) return {};
+    std::string s(reinterpret_cast<const char*>(p_), n);
+    p_ += n;
+    return s;
+}
+
+bool peekFrame(const std::uint8_t* data, std::size_t len,
+               std::uint32_t& bodyLen, bool& malformed) {
+    malformed = false;
+    if (len < 4) return false;
+    std::uint32_t n = 0;
+    for (int i = 0; i < 4; ++i) n |= static_cast<std::uint32_t>(data[i]) << (8 * i);
+    if (n > kMaxFrameBytes) { malformed = true; return false; }
+    if (len - 4 < n) return false;
+    bodyLen = n;
+    return true;
+}
+
+} // namespace wire
+} // namespace sb
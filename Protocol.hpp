@@ -0,0 +1,110 @@
+/***************************************************************************************
+ * Protocol.hpp
+ * Compact length-prefixed binary wire format shared by study_buddy_server and its clients.
+ *
+ * Frame layout (all integers little-endian):
+ *   [u32 bodyLength][body ...]
+ * Request body  : [u8 Op][u32 tag][op-specific fields]
+ * Response body : [u8 Status][u32 tag][op-specific fields]
+ * Field encodings: u8/u16/u32/i32 fixed width; strings are [u16 length][bytes].
+ * The tag is chosen by the client and echoed back, so responses may arrive out of order
+ * (heavy requests finish on worker threads).
+ *
+ * STANDARD LIBRARIES USED:
+ *  <cstdint>  : fixed-width integer fields
+ *  <string>   : string fields
+ *  <vector>   : byte buffers
+ ****************************************************************************************/
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace sb {
+namespace wire {
+
+// Largest body either side will accept; anything bigger is treated as a protocol error.
+constexpr std::uint32_t kMaxFrameBytes = 1u << 20;
+
+enum class Op : std::uint8_t {
+    Ping               = 0,
+    AddProfile         = 1,  // name (<=64 B), email (<=254 B), u16 n (<=16), n x course (<=15 B)
+    AddAvailability    = 2,  // email, u8 day, i32 start, i32 end
+    Suggest            = 3,  // email, i32 minOverlap, u16 maxResults           (worker pool)
+    SearchByName       = 4,  // email(self), query                              (worker pool)
+    SearchByCourse     = 5,  // email(self), course
+    SendRequest        = 6,  // fromEmail, toEmail, course (<=15 B), u8 day, i32 start, i32 end
+    ConfirmRequest     = 7,  // byEmail, sessionId
+    PendingFor         = 8,  // email
+    FetchNotifications = 9,  // email
+    Complete           = 10, // u8 kind (0 course codes, 1 names), prefix, u16 maxResults
+    FreeIn             = 11, // email(self), course, u8 day, i32 start, i32 end, u8 partial
+    NextCommon         = 12, // u8 n, n x email, u8 day, i32 fromMinute, i32 duration
+    Snapshot           = 13, // name → u32 id, u32 pauseMicros (written by a forked child into
+                             //   the server's snapshot dir; name is 1-64 of [A-Za-z0-9._-], no leading '.')
+    SnapshotStatus     = 14, // u32 id → u8 running, u8 ok, name, error, u32 writeMs
+                             //   (NotFound once the id has aged out of the recent results)
+};
+
+enum class Status : std::uint8_t {
+    Ok         = 0,
+    NotFound   = 1,
+    BadRequest = 2,
+    Rejected   = 3,
+    Throttled  = 4, // SendRequest refused by admission control; body: u8 reason (SessionRequests::Admission)
+};
+
+// Appends fields to a byte buffer. Call finishFrame() once to patch in the length prefix.
+class Writer {
+public:
+    Writer() { buf_.resize(4); } // reserve the length prefix
+
+    void u8(std::uint8_t v)   { buf_.push_back(v); }
+    void u16(std::uint16_t v);
+    void u32(std::uint32_t v);
+    void i32(std::int32_t v)  { u32(static_cast<std::uint32_t>(v)); }
+    void str(std::string_view s); // truncated to 65535 bytes
+
+    // Overwrite a byte already written (offset counted from the start of the body).
+    void patch8(std::size_t bodyOffset, std::uint8_t v) { buf_[4 + bodyOffset] = v; }
+
+    // Patch the length prefix and hand over the finished frame.
+    std::vector<std::uint8_t> finishFrame();
+
+private:
+    std::vector<std::uint8_t> buf_;
+};
+
+// Reads fields from a frame body. Any read past the end sets ok() to false and
+// yields zero/empty values, so handlers can decode first and validate once.
+class Reader {
+public:
+    Reader(const std::uint8_t* data, std::size_t len) : p_(data), end_(data + len) {}
+
+    std::uint8_t  u8();
+    std::uint16_t u16();
+    std::uint32_t u32();
+    std::int32_t  i32() { return static_cast<std::int32_t>(u32()); }
+    std::string   str();
+
+    bool ok() const { return ok_; }
+    bool atEnd() const { return p_ == end_; }
+
+private:
+    bool need(std::size_t n);
+
+    const std::uint8_t* p_;
+    const std::uint8_t* end_;
+    bool ok_ = true;
+};
+
+// Incremental frame extraction from a stream buffer. Returns the body length of the first
+// complete frame in [data, data+len) via bodyLen, or false if more bytes are needed.
+// Sets 'malformed' when the declared length exceeds kMaxFrameBytes.
+bool peekFrame(const std::uint8_t* data, std::size_t len,
+               std::uint32_t& bodyLen, bool& malformed);
+
+} // namespace wire
+} // namespace sb
@@ -0,0 +1,85 @@
+/***************************************************************************************
+ * Roster.cpp — implementation
+ ****************************************************************************************/
+#include "Roster.hpp"
+#include "Utils.hpp"
+
+#include <algorithm>
+
+namespace sb {
+
+const Profile& Roster::Handle::operator*() const {
+    static const Profile none;
+    return r_ ? r_->profiles_[id_] : none;
+}
+
+Roster::Handle Roster::add(Profile p) {
+    std::size_t id = profiles_.size();
+    profiles_.push_back(std::move(p));
+    indexEmail(id, {});
+    notify(RosterChange{RosterChange::Kind::Added, id, profiles_[id], {}});
+    return Handle(this, id);
+}
+
+void Roster::edit(const Handle& h, const std::function<void(Profile&)>& fn) {
+    if (h.r_ != this || h.id_ >= profiles_.size()) return;
+    Profile& p = profiles_[h.id_];
+    std::string_view before = trimView(p.email()); // interned: outlives the edit
+    fn(p);
+    p.commitAvailability(); // no-op unless fn edited the slots directly
+    indexEmail(h.id_, before);
+    notify(RosterChange{RosterChange::Kind::Updated, h.id_, p, before});
+}
+
+const Profile* Roster::findByEmail(const std::string& email) const {
+    std::string_view key = trimView(email);
+    if (key.empty()) return nullptr;
+    auto it = byEmail_.find(key);
+    return it == byEmail_.end() ? nullptr : &profiles_[it->second];
+}
+
+Roster::Handle Roster::handleByEmail(const std::string& email) const {
+    std::string_view key = trimView(email);
+    if (key.empty()) return Handle();
+    auto it = byEmail_.find(key);
+    return it == byEmail_.end() ? Handle() : Handle(this, it->second);
+}
+
+void Roster::indexEmail(std::size_t id, std::string_view previousEmail) {
+    std::string_view now = trimView(profiles_[id].email());
+    if (now == previousEmail) return;
+    if (!previousEmail.empty()) {
+        auto it = byEmail_.find(previousEmail);
+        if (it != byEmail_.end() && it->second == id) {
+            byEmail_.erase(it);
+            // Another profile may have been shadowed by this one; let it take over.
+            for (std::size_t i = 0; i < profiles_.size(); ++i) {
+                if (i != id && trimView(profiles_[i].email()) == previousEmail) {
+                    byEmail_.emplace(trimView(profiles_[i].email()), i);
+                    break;
+                }
+            }
+        }
+    }
+    if (!now.empty()) {
+        auto it = byEmail_.find(now);
+        if (it == byEmail_.end() || it->second > id) byEmail_[now] = id;
+    }
+}
+
+std::size_t Roster::subscribe(Listener fn) {
+    listeners_.emplace_back(nextToken_, std::move(fn));
+    return nextToken_++;
+}
+
+void Roster::unsubscribe(std::size_t token) {
+    listeners_.erase(std::remove_if(listeners_.begin(), listeners_.end(),
+                                    [token](const auto& l) { return l.first == token; }),
+                     listeners_.end());
+}
+
+void Roster::notify(const RosterChange& change) {
+    for (const auto& l : listeners_) l.second(change);
+}
+
+} // namespace sb
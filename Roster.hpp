@@ -0,0 +1,98 @@
+/***************************************************************************************
+ * Roster.hpp
+ * Single owner of every Profile in the CLI (yourself and classmates).
+ *
+ * Profiles are addressed by a stable id (their index; profiles are never removed).
+ * Callers keep a Roster::Handle instead of a copy of a Profile, and change profiles in
+ * place through edit(), so there is exactly one copy of each profile and nothing to
+ * keep in sync. Availability edits are committed (Profile::commitAvailability) on
+ * return. Every add/edit is announced to subscribers, which is how indexes and caches
+ * built on top of the roster stay current (the roster's own email index is maintained
+ * the same way).
+ *
+ * Not thread-safe; the server shares its roster through RosterSnapshot instead.
+ *
+ * STANDARD LIBRARIES USED:
+ *  <vector>        : profile storage, listeners
+ *  <string>        : email lookups
+ *  <string_view>   : interned email keys, previous email in change events
+ *  <unordered_map> : email → id index
+ *  <functional>    : edit callbacks and listeners
+ ****************************************************************************************/
+#pragma once
+#include "Profile.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace sb {
+
+// Sent to subscribers after a profile was added or edited.
+struct RosterChange {
+    enum class Kind { Added, Updated };
+    Kind kind;
+    std::size_t id;
+    const Profile& profile;        // state after the change
+    std::string_view previousEmail; // trimmed email before the change (empty for Added)
+};
+
+class Roster {
+public:
+    using Listener = std::function<void(const RosterChange&)>;
+
+    // Refers to one profile of a roster by id. An unset handle reads as an empty,
+    // non-existent Profile, so 'handle->exists()' is the usual "is it set up" check.
+    class Handle {
+    public:
+        Handle() = default;
+        bool valid() const { return r_ != nullptr; }
+        std::size_t id() const { return id_; }
+        const Profile& operator*() const;
+        const Profile* operator->() const { return &**this; }
+
+    private:
+        friend class Roster;
+        Handle(const Roster* r, std::size_t id) : r_(r), id_(id) {}
+        const Roster* r_ = nullptr;
+        std::size_t id_ = 0;
+    };
+
+    Roster() = default;
+    Roster(const Roster&) = delete; // handles and listeners point at this instance
+    Roster& operator=(const Roster&) = delete;
+
+    // Take ownership of a profile; returns its handle.
+    Handle add(Profile p);
+
+    // Mutate a profile in place (no copy) and notify subscribers.
+    void edit(const Handle& h, const std::function<void(Profile&)>& fn);
+
+    const std::vector<Profile>& profiles() const { return profiles_; }
+    std::size_t size() const { return profiles_.size(); }
+    Handle handle(std::size_t id) const { return Handle(this, id); }
+
+    // Trimmed, exact email match (first profile added with that email wins).
+    const Profile* findByEmail(const std::string& email) const;
+    // Same lookup, as a handle (invalid if no profile has that email).
+    Handle handleByEmail(const std::string& email) const;
+
+    // Register for change events; returns a token for unsubscribe().
+    std::size_t subscribe(Listener fn);
+    void unsubscribe(std::size_t token);
+
+private:
+    void notify(const RosterChange& change);
+    void indexEmail(std::size_t id, std::string_view previousEmail);
+
+    std::vector<Profile> profiles_;
+    std::unordered_map<std::string_view, std::size_t> byEmail_; // interned keys
+    std::vector<std::pair<std::size_t, Listener>> listeners_;
+    std::size_t nextToken_ = 1;
+};
+
+} // namespace sb
@@ -0,0 +1,202 @@
+/***************************************************************************************
+ * RosterSnapshot.cpp — implementation
+ ****************************************************************************************/
+#include "RosterSnapshot.hpp"
+#include "Utils.hpp"
+
+#include <functional>
+#include <thread>
+
+namespace sb {
+
+// Reader slot. Each live Pin owns one; 'epoch' is 0 while the slot is idle.
+// Padded to a cache line so readers on different cores never share a line.
+struct alignas(64) RosterSnapshot::Pin::Slot {
+    std::atomic<bool> busy{false};
+    std::atomic<std::uint64_t> epoch{0};
+};
+
+// Commit pending availability edits (shared, day-indexed schedules) before publishing.
+static void indexStale(std::vector<Profile>& ps) {
+    for (auto& p : ps) {
+        if (!p.availabilityCommitted()) p.commitAvailability();
+    }
+}
+
+RosterSnapshot::Pin::~Pin() {
+    if (!slot_) return;
+    slot_->epoch.store(0, std::memory_order_seq_cst);
+    slot_->busy.store(false, std::memory_order_release);
+}
+
+const Profile* RosterSnapshot::Pin::findByEmail(const std::string& email) const {
+    auto it = v_->byEmail->find(trimView(email));
+    return it == v_->byEmail->end() ? nullptr : &v_->profiles[it->second];
+}
+
+RosterSnapshot::RosterSnapshot(std::vector<Profile> initial) : slots_(new Pin::Slot[kMaxReaders]) {
+    indexStale(initial);
+    auto v = std::make_unique<Version>();
+    v->number = 1;
+    v->byEmail = buildIndex(initial);
+    v->profiles = std::move(initial);
+    current_.store(v.release());
+}
+
+RosterSnapshot::~RosterSnapshot() {
+    for (auto& r : retired_) delete r.v;
+    delete current_.load();
+    delete[] slots_;
+}
+
+RosterSnapshot::Pin RosterSnapshot::pin() const {
+    // Start at a per-thread slot so that repeated pins from one thread hit the same
+    // (uncontended) cache line.
+    static thread_local std::size_t hint =
+        std::hash<std::thread::id>{}(std::this_thread::get_id()) % kMaxReaders;
+
+    Pin::Slot* slot = nullptr;
+    for (std::size_t k = 0; !slot; ++k) {
+        Pin::Slot& s = slots_[(hint + k) % kMaxReaders];
+        bool expected = false;
+        if (!s.busy.load(std::memory_order_relaxed) &&
+            s.busy.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+            slot = &s;
+        } else if (k > 0 && k % kMaxReaders == 0) {
+            std::this_thread::yield(); // every slot is pinned; wait for one to free up
+        }
+    }
+
+    // Announce the epoch before reading the version pointer (both seq_cst): a writer that
+    // retires the version we are about to read is guaranteed to see our announcement.
+    slot->epoch.store(epoch_.load(std::memory_order_seq_cst), std::memory_order_seq_cst);
+    const Version* v = current_.load(std::memory_order_seq_cst);
+    return Pin(slot, v);
+}
+
+std::shared_ptr<const RosterSnapshot::EmailIndex>
+RosterSnapshot::buildIndex(const std::vector<Profile>& ps) {
+    auto idx = std::make_shared<EmailIndex>();
+    idx->reserve(ps.size());
+    for (std::size_t i = 0; i < ps.size(); ++i) {
+        std::string_view e = trimView(ps[i].email());
+        if (!e.empty()) (*idx)[e] = i;
+    }
+    return idx;
+}
+
+void RosterSnapshot::publishLocked(std::unique_ptr<Version> next) {
+    const Version* prev = current_.load(std::memory_order_relaxed);
+    next->number = prev->number + 1;
+    current_.store(next.release(), std::memory_order_seq_cst);
+    std::uint64_t e = epoch_.fetch_add(1, std::memory_order_seq_cst);
+    retired_.push_back(Retired{prev, e});
+    collectLocked();
+}
+
+void RosterSnapshot::collectLocked() {
+    std::uint64_t minActive = UINT64_MAX;
+    for (std::size_t i = 0; i < kMaxReaders; ++i) {
+        std::uint64_t r = slots_[i].epoch.load(std::memory_order_seq_cst);
+        if (r != 0 && r < minActive) minActive = r;
+    }
+    // A version retired at epoch e may still be seen by readers that announced epoch <= e.
+    std::size_t kept = 0;
+    for (auto& r : retired_) {
+        if (r.epoch < minActive) delete r.v;
+        else retired_[kept++] = r;
+    }
+    retired_.resize(kept);
+}
+
+void RosterSnapshot::collect() {
+    std::lock_guard<std::mutex> lk(writeMu_);
+    collectLocked();
+}
+
+std::size_t RosterSnapshot::retiredCount() const {
+    std::lock_guard<std::mutex> lk(writeMu_);
+    return retired_.size();
+}
+
+std::uint64_t RosterSnapshot::currentVersion() const {
+    return current_.load(std::memory_order_acquire)->number;
+}
+
+std::size_t RosterSnapshot::upsert(Profile p) {
+    if (!p.availabilityCommitted()) p.commitAvailability();
+    std::lock_guard<std::mutex> lk(writeMu_);
+    const Version* cur = current_.load(std::memory_order_relaxed);
+    auto next = std::make_unique<Version>();
+    next->profiles = cur->profiles; // handle copies only
+    next->byEmail = cur->byEmail;
+
+    std::string_view e = trimView(p.email());
+    auto it = e.empty() ? cur->byEmail->end() : cur->byEmail->find(e);
+    std::size_t index;
+    if (it != cur->byEmail->end()) {
+        index = it->second;
+        next->profiles[index] = std::move(p);
+    } else {
+        index = next->profiles.size();
+        next->profiles.push_back(std::move(p));
+        if (!e.empty()) {
+            auto idx = std::make_shared<EmailIndex>(*cur->byEmail);
+            (*idx)[e] = index;
+            next->byEmail = std::move(idx);
+        }
+    }
+    publishLocked(std::move(next));
+    return index;
+}
+
+bool RosterSnapshot::updateLocked(std::size_t index, const std::function<void(Profile&)>& edit) {
+    const Version* cur = current_.load(std::memory_order_relaxed);
+    if (index >= cur->profiles.size()) return false;
+
+    auto next = std::make_unique<Version>();
+    next->profiles = cur->profiles;
+    std::string_view before = next->profiles[index].email();
+    Profile& p = next->profiles[index];
+    edit(p); // detaches just this profile
+    if (!p.availabilityCommitted()) p.commitAvailability();
+    next->byEmail = before == p.email() ? cur->byEmail
+                                        : buildIndex(next->profiles);
+    publishLocked(std::move(next));
+    return true;
+}
+
+bool RosterSnapshot::updateProfile(std::size_t index, const std::function<void(Profile&)>& edit) {
+    std::lock_guard<std::mutex> lk(writeMu_);
+    return updateLocked(index, edit);
+}
+
+bool RosterSnapshot::updateByEmail(const std::string& email, const std::function<void(Profile&)>& edit) {
+    std::lock_guard<std::mutex> lk(writeMu_);
+    const Version* cur = current_.load(std::memory_order_relaxed);
+    auto it = cur->byEmail->find(trimView(email));
+    if (it == cur->byEmail->end()) return false;
+    return updateLocked(it->second, edit);
+}
+
+void RosterSnapshot::update(const std::function<void(std::vector<Profile>&)>& edit, bool rebuildIndex) {
+    std::lock_guard<std::mutex> lk(writeMu_);
+    const Version* cur = current_.load(std::memory_order_relaxed);
+    auto next = std::make_unique<Version>();
+    next->profiles = cur->profiles;
+    edit(next->profiles);
+    indexStale(next->profiles);
+    next->byEmail = rebuildIndex ? buildIndex(next->profiles) : cur->byEmail;
+    publishLocked(std::move(next));
+}
+
+void RosterSnapshot::replaceAll(std::vector<Profile> profiles) {
+    indexStale(profiles);
+    std::lock_guard<std::mutex> lk(writeMu_);
+    auto next = std::make_unique<Version>();
+    next->byEmail = buildIndex(profiles);
+    next->profiles = std::move(profiles);
+    publishLocked(std::move(next));
+}
+
+} // namespace sb
@@ -0,0 +1,129 @@
+/***************************************************************************************
+ * RosterSnapshot.hpp
+ * Read-copy-update roster: readers pin an immutable version without locks, writers
+ * publish new versions with copy-on-write updates to individual profiles.
+ *
+ * Readers:
+ *   auto pin = snap.pin();                       // no mutex, no shared counter
+ *   matcher.suggest(*pin.findByEmail(e), pin.profiles());
+ * A Pin keeps its version (and every Profile/pointer obtained from it) alive and
+ * unchanged until it is destroyed. Pins are cheap but not meant to be held for long:
+ * versions retired while a pin is active are only reclaimed after it is released.
+ *
+ * Writers are serialized by an internal mutex. Each publish copies the vector of
+ * Profile handles (O(n) pointer copies, see Profile.hpp) and detaches only the profiles
+ * being edited. Use update() to apply many edits in a single publish.
+ *
+ * Reclamation is epoch based: each pin records the global epoch in a per-thread slot;
+ * a retired version is freed once no slot holds an epoch at or before its retirement.
+ *
+ * STANDARD LIBRARIES USED:
+ *  <atomic>         : current version pointer, epochs, reader slots
+ *  <functional>     : profile edit callbacks
+ *  <memory>         : shared email index between versions
+ *  <mutex>          : writer serialization
+ *  <string>         : email lookups
+ *  <unordered_map>  : email → index
+ *  <vector>         : profiles, retired list
+ ****************************************************************************************/
+#pragma once
+#include "Profile.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace sb {
+
+class RosterSnapshot {
+public:
+    using EmailIndex = std::unordered_map<std::string_view, std::size_t>; // interned keys
+
+    // One immutable published state of the roster.
+    struct Version {
+        std::uint64_t number = 0;
+        std::vector<Profile> profiles;
+        std::shared_ptr<const EmailIndex> byEmail; // shared until membership changes
+    };
+
+    class Pin {
+    public:
+        Pin(Pin&& other) noexcept : slot_(other.slot_), v_(other.v_) { other.slot_ = nullptr; }
+        Pin& operator=(Pin&&) = delete;
+        Pin(const Pin&) = delete;
+        Pin& operator=(const Pin&) = delete;
+        ~Pin();
+
+        const std::vector<Profile>& profiles() const { return v_->profiles; }
+        std::uint64_t version() const { return v_->number; }
+        const Profile* findByEmail(const std::string& email) const; // trimmed exact match
+
+    private:
+        friend class RosterSnapshot;
+        struct Slot;
+        Pin(Slot* slot, const Version* v) : slot_(slot), v_(v) {}
+        Slot* slot_;
+        const Version* v_;
+    };
+
+    explicit RosterSnapshot(std::vector<Profile> initial = {});
+    ~RosterSnapshot(); // all pins must have been released
+
+    RosterSnapshot(const RosterSnapshot&) = delete;
+    RosterSnapshot& operator=(const RosterSnapshot&) = delete;
+
+    // Pin the current version. Lock-free; at most kMaxReaders pins may be live at once
+    // (further pins spin until a slot frees up).
+    Pin pin() const;
+
+    /* ---- writers (serialized) ---- */
+
+    // Append a profile, or replace the existing one with the same email. Returns its index.
+    std::size_t upsert(Profile p);
+
+    // Edit one profile in a new version. Returns false if the index/email is unknown.
+    bool updateProfile(std::size_t index, const std::function<void(Profile&)>& edit);
+    bool updateByEmail(const std::string& email, const std::function<void(Profile&)>& edit);
+
+    // Apply arbitrary edits to a private copy of the profile list and publish once.
+    // The email index is rebuilt only if 'rebuildIndex' is true.
+    void update(const std::function<void(std::vector<Profile>&)>& edit, bool rebuildIndex);
+
+    // Replace the whole roster.
+    void replaceAll(std::vector<Profile> profiles);
+
+    // Free retired versions that no pin can still see (also runs after every publish).
+    void collect();
+
+    std::size_t retiredCount() const; // versions awaiting reclamation (for tests/benchmarks)
+    std::uint64_t currentVersion() const;
+
+    static constexpr std::size_t kMaxReaders = 128;
+
+private:
+    struct Retired {
+        const Version* v;
+        std::uint64_t epoch; // global epoch when it stopped being current
+    };
+
+    static std::shared_ptr<const EmailIndex> buildIndex(const std::vector<Profile>& ps);
+    bool updateLocked(std::size_t index, const std::function<void(Profile&)>& edit);
+    void publishLocked(std::unique_ptr<Version> next);
+    void collectLocked();
+
+    std::atomic<const Version*> current_;
+    mutable std::atomic<std::uint64_t> epoch_{1};
+    Pin::Slot* slots_; // kMaxReaders cache-line padded slots
+
+    mutable std::mutex writeMu_;
+    std::vector<Retired> retired_;
+};
+
+} // namespace sb
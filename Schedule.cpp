@@ -0,0 +1,115 @@
+/***************************************************************************************
+ * Schedule.cpp — implementation
+ ****************************************************************************************/
+#include "Schedule.hpp"
+
+namespace sb {
+
+std::size_t SlotView::size() const {
+    std::size_t n = 0;
+    for (auto it = begin(); it != end(); ++it) ++n;
+    return n;
+}
+
+std::size_t Schedule::hashSlots(const std::vector<AvailabilitySlot>& slots) {
+    // FNV-1a over (day, start, end) triples.
+    std::uint64_t h = 1469598103934665603ull;
+    auto mix = [&h](std::uint64_t v) { h ^= v; h *= 1099511628211ull; };
+    for (const auto& s : slots) {
+        mix(static_cast<std::uint64_t>(static_cast<int>(s.day)));
+        mix(static_cast<std::uint64_t>(static_cast<std::uint32_t>(s.start)));
+        mix(static_cast<std::uint64_t>(static_cast<std::uint32_t>(s.end)));
+    }
+    return static_cast<std::size_t>(h);
+}
+
+Schedule::Schedule(std::vector<AvailabilitySlot> slots) : slots_(std::move(slots)) {
+    hash_ = hashSlots(slots_);
+    for (std::size_t i = 1; i < slots_.size(); ++i) {
+        if (static_cast<int>(slots_[i].day) < static_cast<int>(slots_[i - 1].day)) {
+            dayIndexed_ = false;
+            return;
+        }
+    }
+    std::size_t i = 0;
+    for (int day = 0; day < 7; ++day) {
+        dayStart_[day] = static_cast<std::uint32_t>(i);
+        while (i < slots_.size() && static_cast<int>(slots_[i].day) == day) ++i;
+    }
+    dayStart_[7] = static_cast<std::uint32_t>(slots_.size());
+}
+
+SlotView Schedule::on(Day day) const {
+    const AvailabilitySlot* base = slots_.data();
+    int d = static_cast<int>(day);
+    if (dayIndexed_) return SlotView(base + dayStart_[d], base + dayStart_[d + 1]);
+    return SlotView(base, base + slots_.size(), d);
+}
+
+const std::shared_ptr<const Schedule>& Schedule::emptySchedule() {
+    static const std::shared_ptr<const Schedule> empty(new Schedule({}));
+    return empty;
+}
+
+SchedulePool& SchedulePool::global() {
+    static SchedulePool* pool = new SchedulePool(); // never destroyed: outlives every profile
+    return *pool;
+}
+
+static bool sameSlots(const std::vector<AvailabilitySlot>& a, const std::vector<AvailabilitySlot>& b) {
+    if (a.size() != b.size()) return false;
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        if (a[i].day != b[i].day || a[i].start != b[i].start || a[i].end != b[i].end) return false;
+    }
+    return true;
+}
+
+ScheduleRef SchedulePool::intern(std::vector<AvailabilitySlot> slots) {
+    if (slots.empty()) return Schedule::emptySchedule();
+    std::size_t h = Schedule::hashSlots(slots);
+
+    std::lock_guard<std::mutex> lk(mu_);
+    ++requests_;
+    auto range = table_.equal_range(h);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (!sameSlots(it->second.raw->slots(), slots)) continue;
+        if (ScheduleRef live = it->second.ref.lock()) {
+            ++hits_;
+            return live;
+        }
+        // Last reference just dropped; release() will erase this entry. Add a fresh one.
+    }
+
+    const Schedule* raw = new Schedule(std::move(slots));
+    ScheduleRef ref(raw, [this](const Schedule* s) { release(s); });
+    table_.emplace(h, Entry{raw, ref});
+    liveSlots_ += raw->slots().size();
+    return ref;
+}
+
+void SchedulePool::release(const Schedule* s) {
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        auto range = table_.equal_range(s->hash());
+        for (auto it = range.first; it != range.second; ++it) {
+            if (it->second.raw == s) {
+                table_.erase(it);
+                break;
+            }
+        }
+        liveSlots_ -= s->slots().size();
+    }
+    delete s;
+}
+
+SchedulePool::Stats SchedulePool::stats() const {
+    std::lock_guard<std::mutex> lk(mu_);
+    Stats st;
+    st.live = table_.size();
+    st.liveSlots = liveSlots_;
+    st.requests = requests_;
+    st.hits = hits_;
+    return st;
+}
+
+} // namespace sb
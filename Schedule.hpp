@@ -0,0 +1,150 @@
+/***************************************************************************************
+ * Schedule.hpp
+ * Immutable, hash-consed weekly availability shared between profiles.
+ *
+ * Students in the same section usually have identical availability (it comes from the
+ * same timetable). SchedulePool::intern() returns the one shared Schedule for a given
+ * list of slots, so identical schedules are stored once and compare equal by pointer.
+ * Profiles edit a private copy of the slots and re-intern it when the edit is committed
+ * (copy-on-write, see Profile.hpp); a Schedule itself never changes.
+ *
+ * A Schedule whose slots are in day order (as AvailabilityManager/AvailabilityEditor keep
+ * them) carries a day-offset table, so on(day) is a direct span.
+ *
+ * STANDARD LIBRARIES USED:
+ *  <array>         : per-day offset table
+ *  <iterator>      : SlotView iterator category
+ *  <memory>        : shared schedule handles
+ *  <mutex>         : pool table guard
+ *  <unordered_map> : hash → schedules table
+ *  <vector>        : slot storage
+ ****************************************************************************************/
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace sb {
+
+// Days of the week kept compact for availability.
+enum class Day : int { Mon=0, Tue, Wed, Thu, Fri, Sat, Sun };
+
+// Single availability window on a day: [start,end) minutes since midnight.
+struct AvailabilitySlot {
+    Day  day;
+    int  start; // minutes since midnight
+    int  end;   // minutes since midnight
+};
+
+// Non-owning view of a list of slots, optionally restricted to one day.
+// Valid while the Schedule (or profile being edited) it points into is alive and unchanged.
+class SlotView {
+public:
+    class iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = AvailabilitySlot;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const AvailabilitySlot*;
+        using reference = const AvailabilitySlot&;
+
+        iterator(const AvailabilitySlot* p, const AvailabilitySlot* end, int day)
+            : p_(p), end_(end), day_(day) { skip(); }
+        reference operator*() const { return *p_; }
+        pointer operator->() const { return p_; }
+        iterator& operator++() { ++p_; skip(); return *this; }
+        bool operator==(const iterator& o) const { return p_ == o.p_; }
+        bool operator!=(const iterator& o) const { return p_ != o.p_; }
+
+    private:
+        void skip() { while (day_ >= 0 && p_ != end_ && static_cast<int>(p_->day) != day_) ++p_; }
+        const AvailabilitySlot* p_;
+        const AvailabilitySlot* end_;
+        int day_;
+    };
+
+    SlotView() = default;
+    // 'day' < 0 keeps every slot in [first,last).
+    SlotView(const AvailabilitySlot* first, const AvailabilitySlot* last, int day = -1)
+        : first_(first), last_(last), day_(day) {}
+
+    iterator begin() const { return iterator(first_, last_, day_); }
+    iterator end() const { return iterator(last_, last_, day_); }
+    bool empty() const { return begin() == end(); }
+    std::size_t size() const;
+
+private:
+    const AvailabilitySlot* first_ = nullptr;
+    const AvailabilitySlot* last_ = nullptr;
+    int day_ = -1;
+};
+
+class Schedule {
+public:
+    const std::vector<AvailabilitySlot>& slots() const { return slots_; }
+    SlotView all() const { return SlotView(slots_.data(), slots_.data() + slots_.size()); }
+    SlotView on(Day day) const;
+    bool empty() const { return slots_.empty(); }
+    bool dayIndexed() const { return dayIndexed_; }
+    std::size_t hash() const { return hash_; }
+
+    // The shared empty schedule (every new profile starts with it).
+    static const std::shared_ptr<const Schedule>& emptySchedule();
+
+    static std::size_t hashSlots(const std::vector<AvailabilitySlot>& slots);
+
+private:
+    friend class SchedulePool;
+    explicit Schedule(std::vector<AvailabilitySlot> slots);
+
+    std::vector<AvailabilitySlot> slots_;
+    std::array<std::uint32_t, 8> dayStart_{}; // slots of day d: [dayStart_[d], dayStart_[d+1])
+    bool dayIndexed_ = true;
+    std::size_t hash_ = 0;
+};
+
+using ScheduleRef = std::shared_ptr<const Schedule>;
+
+class SchedulePool {
+public:
+    struct Stats {
+        std::size_t live = 0;       // distinct schedules currently referenced
+        std::size_t liveSlots = 0;  // slots stored across those schedules
+        std::size_t requests = 0;   // intern() calls with a non-empty slot list
+        std::size_t hits = 0;       // ... answered with an existing schedule
+    };
+
+    SchedulePool() = default;
+    SchedulePool(const SchedulePool&) = delete;
+    SchedulePool& operator=(const SchedulePool&) = delete;
+
+    // Process-wide pool used by Profile.
+    static SchedulePool& global();
+
+    // Shared schedule with exactly these slots (same order). Thread-safe. A schedule
+    // leaves the pool when its last reference is dropped.
+    ScheduleRef intern(std::vector<AvailabilitySlot> slots);
+
+    Stats stats() const;
+
+private:
+    void release(const Schedule* s);
+
+    struct Entry {
+        const Schedule* raw;
+        std::weak_ptr<const Schedule> ref;
+    };
+
+    mutable std::mutex mu_;
+    std::unordered_multimap<std::size_t, Entry> table_;
+    std::size_t liveSlots_ = 0;
+    std::size_t requests_ = 0;
+    std::size_t hits_ = 0;
+};
+
+} // namespace sb
@@ -2,27 +2,38 @@
  * SessionRequests.cpp — hardened identity & matching
  ****************************************************************************************/
 #include "SessionRequests.hpp"
+#include "ChangeLog.hpp"
 #include "Utils.hpp"
+#include "StringPool.hpp"
+#include "AllocStats.hpp"
+#include "Metrics.hpp"
+#include "Trace.hpp"
 #include <algorithm>
+#include <cmath>
 
 namespace sb {
 
-// Prefer email; if blank, fallback to name. Always trimmed.
-static std::string primaryKey(const Profile& p) {
-    std::string e = trim(p.email());
-    if (!e.empty()) return e;
-    return trim(p.name());
+static void publishSession(ChangeLog* log, ChangeEvent::Kind kind, const StudySession& s) {
+    if (!log) return;
+    ChangeEvent e;
+    e.kind = kind;
+    e.session = s;
+    log->publish(std::move(e));
+}
+
+// Prefer email; if blank, fallback to name. Always trimmed (a view into the profile).
+static std::string_view primaryKey(const Profile& p) {
+    std::string_view e = trimView(p.email());
+    return e.empty() ? trimView(p.name()) : e;
 }
 
 // Secondary identifier: if email exists, this is the trimmed name; else empty.
-static std::string secondaryKey(const Profile& p) {
-    std::string e = trim(p.email());
-    if (!e.empty()) return trim(p.name());
-    return std::string{};
+static std::string_view secondaryKey(const Profile& p) {
+    return trimView(p.email()).empty() ? std::string_view{} : trimView(p.name());
 }
 
 // Keep the class-private declaration intact for ABI; do not use elsewhere.
-const std::string& SessionRequests::userKey(const Profile& p) {
+std::string_view SessionRequests::userKey(const Profile& p) {
     return p.email().empty() ? p.name() : p.email();
 }
 
@@ -34,65 +45,196 @@ std::string SessionRequests::nextId() {
 const StudySession& SessionRequests::sendRequest(const Profile& from, const Profile& to,
                                                  const std::string& courseUpper,
                                                  Day day, int startMin, int endMin) {
+    ApiTimer timer(Api::SendRequest);
+    TraceSpan span("sendRequest", "sessions");
+    AllocScope allocScope("sendRequest");
+    return store(from, to, upperCopy(trim(courseUpper)), day, startMin, endMin);
+}
+
+// Buckets tolerated before full (idle) ones are swept out, as a floor.
+static constexpr std::size_t kMinBucketsBeforePrune = 1024;
+static constexpr double kNsPerHour = 3.6e12;
+
+static std::int64_t nsPerToken(double perHour) {
+    return std::max<std::int64_t>(1, std::llround(kNsPerHour / perHour));
+}
+
+bool SessionRequests::RateBuckets::ready(std::string_view key, double perHour, double burst,
+                                         std::int64_t nowNs) const {
+    if (perHour <= 0) return true;
+    const std::int64_t* fullAt = fullAt_.find(key);
+    std::int64_t debt = fullAt ? std::max<std::int64_t>(0, *fullAt - nowNs) : 0;
+    std::int64_t perToken = nsPerToken(perHour);
+    return static_cast<double>(debt + perToken) <= burst * static_cast<double>(perToken);
+}
+
+void SessionRequests::RateBuckets::take(std::string_view key, double perHour, std::int64_t nowNs) {
+    if (perHour <= 0) return;
+    std::int64_t* fullAt = fullAt_.find(key);
+    if (!fullAt) {
+        // A full bucket is the same as no bucket: sweep those out before growing, so memory
+        // follows the users active within the last burst / rate hours.
+        if (fullAt_.size() >= std::max(kMinBucketsBeforePrune, 2 * prunedSize_)) {
+            std::vector<std::string_view> idle;
+            fullAt_.forEach([&](std::string_view k, std::int64_t t) { if (t <= nowNs) idle.push_back(k); });
+            for (std::string_view k : idle) fullAt_.erase(k);
+            prunedSize_ = fullAt_.size();
+        }
+        fullAt = fullAt_.tryEmplace(intern(key), nowNs).first;
+    }
+    *fullAt = std::max(*fullAt, nowNs) + nsPerToken(perHour);
+}
+
+SessionRequests::SendResult SessionRequests::trySendRequest(const Profile& from, const Profile& to,
+                                                            const std::string& courseUpper,
+                                                            Day day, int startMin, int endMin,
+                                                            Clock::time_point now) {
+    ApiTimer timer(Api::SendRequest);
+    TraceSpan span("trySendRequest", "sessions");
+    AllocScope allocScope("sendRequest");
+    const std::string_view requester = primaryKey(from);
+    const std::string_view invitee = primaryKey(to);
+    const std::string course = upperCopy(trim(courseUpper));
+
+    if (const std::vector<std::size_t>* pending = pendingByInvitee_.find(invitee)) {
+        for (std::size_t i : *pending) {
+            const StudySession& s = sessions_[i];
+            if (s.requester == requester && s.course == course && s.day == day &&
+                s.start < endMin && startMin < s.end) {
+                return SendResult{Admission::Coalesced, &s};
+            }
+        }
+        if (policy_.maxPendingPerInvitee && pending->size() >= policy_.maxPendingPerInvitee) {
+            timer.fail();
+            return SendResult{Admission::InviteeQueueFull, nullptr};
+        }
+    }
+
+    const std::int64_t nowNs =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(now.time_since_epoch()).count();
+    if (!sendBuckets_.ready(requester, policy_.requesterPerHour, policy_.requesterBurst, nowNs)) {
+        timer.fail();
+        return SendResult{Admission::RequesterThrottled, nullptr};
+    }
+    if (!receiveBuckets_.ready(invitee, policy_.inviteePerHour, policy_.inviteeBurst, nowNs)) {
+        timer.fail();
+        return SendResult{Admission::InviteeThrottled, nullptr};
+    }
+    sendBuckets_.take(requester, policy_.requesterPerHour, nowNs);
+    receiveBuckets_.take(invitee, policy_.inviteePerHour, nowNs);
+    return SendResult{Admission::Admitted, &store(from, to, course, day, startMin, endMin)};
+}
+
+const StudySession& SessionRequests::store(const Profile& from, const Profile& to, std::string_view course,
+                                           Day day, int startMin, int endMin) {
     StudySession s;
     s.id        = nextId();
-    s.course    = upperCopy(trim(courseUpper));
+    s.course    = std::string(course);
     s.day       = day;
     s.start     = startMin;
     s.end       = endMin;
 
-    // Store robust, TRIMMED identifiers
-    s.requester = primaryKey(from);
-    s.invitee   = primaryKey(to);
+    // Store robust, TRIMMED identifiers (pooled, so they share the profile's bytes)
+    s.requester = intern(primaryKey(from));
+    s.invitee   = intern(primaryKey(to));
     s.status    = StudySession::Status::Pending;
 
     sessions_.push_back(s);
+    byId_.tryEmplace(s.id, sessions_.size() - 1);
+    pendingByInvitee_[s.invitee].push_back(sessions_.size() - 1);
 
     if (nc_) {
-        nc_->notify(s.invitee, "New study request " + s.id + " from " + s.requester +
-                               " for " + s.course);
+        nc_->notify(s.invitee, "New study request " + s.id + " from " + std::string(s.requester) +
+                               " for " + std::string(s.course));
     }
+    publishSession(changes_, ChangeEvent::Kind::SessionRequested, sessions_.back());
     return sessions_.back();
 }
 
 bool SessionRequests::confirmRequest(const std::string& sessionId, const Profile& byInvitee) {
-    const std::string whoP = primaryKey(byInvitee);
-    const std::string whoS = secondaryKey(byInvitee);
+    ApiTimer timer(Api::ConfirmRequest);
+    TraceSpan span("confirmRequest", "sessions");
+    const std::string_view whoP = primaryKey(byInvitee);
+    const std::string_view whoS = secondaryKey(byInvitee);
 
-    for (auto& s : sessions_) {
-        if (s.id != sessionId || s.status != StudySession::Status::Pending) continue;
+    const std::size_t* idx = byId_.find(sessionId);
+    if (!idx || sessions_[*idx].status != StudySession::Status::Pending) {
+        timer.fail();
+        return false;
+    }
+    StudySession& s = sessions_[*idx];
 
-        if (s.invitee == whoP || (!whoS.empty() && s.invitee == whoS)) {
-            s.status = StudySession::Status::Confirmed;
-            if (nc_) {
-                nc_->notify(s.requester, "Study request " + s.id + " confirmed by " + s.invitee);
-                nc_->notify(s.invitee,   "You confirmed study request " + s.id);
-            }
-            return true;
+    if (s.invitee == whoP || (!whoS.empty() && s.invitee == whoS)) {
+        s.status = StudySession::Status::Confirmed;
+        dropPending(s, *idx);
+        if (nc_) {
+            nc_->notify(s.requester, "Study request " + s.id + " confirmed by " + std::string(s.invitee));
+            nc_->notify(s.invitee,   "You confirmed study request " + s.id);
         }
+        publishSession(changes_, ChangeEvent::Kind::SessionConfirmed, s);
+        return true;
     }
+    timer.fail();
     return false;
 }
 
-std::vector<StudySession> SessionRequests::pendingFor(const Profile& user) const {
-    const std::string whoP = primaryKey(user);
-    const std::string whoS = secondaryKey(user);
+void SessionRequests::dropPending(const StudySession& s, std::size_t index) {
+    std::vector<std::size_t>* pending = pendingByInvitee_.find(s.invitee);
+    if (!pending) return;
+    pending->erase(std::remove(pending->begin(), pending->end(), index), pending->end());
+    if (pending->empty()) pendingByInvitee_.erase(s.invitee);
+}
 
+const StudySession* SessionRequests::findById(std::string_view sessionId) const {
+    const std::size_t* idx = byId_.find(sessionId);
+    return idx ? &sessions_[*idx] : nullptr;
+}
+
+static std::vector<StudySession> copyOut(const std::vector<const StudySession*>& refs) {
     std::vector<StudySession> out;
-    for (const auto& s : sessions_) {
-        if (s.status == StudySession::Status::Pending &&
-            (s.invitee == whoP || (!whoS.empty() && s.invitee == whoS))) {
-            out.push_back(s);
-        }
-    }
+    out.reserve(refs.size());
+    for (const StudySession* s : refs) out.push_back(*s);
     return out;
 }
 
+std::vector<StudySession> SessionRequests::pendingFor(const Profile& user) const {
+    return copyOut(pendingRefs(user));
+}
+
 std::vector<StudySession> SessionRequests::confirmedFor(const Profile& user) const {
-    const std::string whoP = primaryKey(user);
-    const std::string whoS = secondaryKey(user);
+    return copyOut(confirmedRefs(user));
+}
 
-    std::vector<StudySession> out;
+std::vector<const StudySession*> SessionRequests::pendingRefs(const Profile& user) const {
+    ApiTimer timer(Api::PendingFor);
+    TraceSpan span("pendingFor", "sessions");
+    const std::string_view whoP = primaryKey(user);
+    const std::string_view whoS = secondaryKey(user);
+
+    // Requests are filed under the invitee's key at send time: the email, or the name for
+    // profiles without one. Both lists are in send order; merge them to keep it.
+    static const std::vector<std::size_t> kNone;
+    const std::vector<std::size_t>* byP = pendingByInvitee_.find(whoP);
+    const std::vector<std::size_t>* byS = whoS.empty() || whoS == whoP ? nullptr : pendingByInvitee_.find(whoS);
+    const std::vector<std::size_t>& a = byP ? *byP : kNone;
+    const std::vector<std::size_t>& b = byS ? *byS : kNone;
+    std::vector<const StudySession*> out;
+    out.reserve(a.size() + b.size());
+    std::size_t i = 0, j = 0;
+    while (i < a.size() || j < b.size()) {
+        std::size_t next = j == b.size() || (i < a.size() && a[i] < b[j]) ? a[i++] : b[j++];
+        out.push_back(&sessions_[next]);
+    }
+    return out;
+}
+
+std::vector<const StudySession*> SessionRequests::confirmedRefs(const Profile& user) const {
+    ApiTimer timer(Api::ConfirmedFor);
+    TraceSpan span("confirmedFor", "sessions");
+    const std::string_view whoP = primaryKey(user);
+    const std::string_view whoS = secondaryKey(user);
+
+    std::vector<const StudySession*> out;
     for (const auto& s : sessions_) {
         if (s.status != StudySession::Status::Confirmed) continue;
 
@@ -100,37 +242,71 @@ std::vector<StudySession> SessionRequests::confirmedFor(const Profile& user) con
             (s.invitee == whoP || s.requester == whoP) ||
             (!whoS.empty() && (s.invitee == whoS || s.requester == whoS));
 
-        if (matches) out.push_back(s);
+        if (matches) out.push_back(&s);
     }
 
-    std::sort(out.begin(), out.end(), [](const StudySession& a, const StudySession& b){
-        if (a.day != b.day) return static_cast<int>(a.day) < static_cast<int>(b.day);
-        return a.start < b.start;
+    std::sort(out.begin(), out.end(), [](const StudySession* a, const StudySession* b){
+        if (a->day != b->day) return static_cast<int>(a->day) < static_cast<int>(b->day);
+        return a->start < b->start;
+    });
+    return out;
+}
+
+std::vector<const StudySession*>
+SessionRequests::confirmedAmong(const std::vector<const Profile*>& people) const {
+    std::vector<const StudySession*> out;
+    for (const auto& s : sessions_) {
+        if (s.status != StudySession::Status::Confirmed) continue;
+        bool involved = std::any_of(people.begin(), people.end(), [&](const Profile* p) {
+            const std::string_view whoP = primaryKey(*p);
+            const std::string_view whoS = secondaryKey(*p);
+            return s.invitee == whoP || s.requester == whoP ||
+                   (!whoS.empty() && (s.invitee == whoS || s.requester == whoS));
+        });
+        if (involved) out.push_back(&s);
+    }
+    std::sort(out.begin(), out.end(), [](const StudySession* a, const StudySession* b) {
+        if (a->day != b->day) return static_cast<int>(a->day) < static_cast<int>(b->day);
+        return a->start < b->start;
     });
     return out;
 }
 
 bool SessionRequests::cancelConfirmed(const std::string& sessionId, const Profile& byEither) {
-    const std::string whoP = primaryKey(byEither);
-    const std::string whoS = secondaryKey(byEither);
-
-    for (auto it = sessions_.begin(); it != sessions_.end(); ++it) {
-        if (it->id == sessionId && it->status == StudySession::Status::Confirmed) {
-            bool matches = (it->requester == whoP || it->invitee == whoP) ||
-                           (!whoS.empty() && (it->requester == whoS || it->invitee == whoS));
-            if (matches) {
-                if (nc_) {
-                    const std::string other =
-                        (it->requester == whoP || (!whoS.empty() && it->requester == whoS))
-                        ? it->invitee : it->requester;
-                    nc_->notify(other, "Study session " + it->id + " was canceled by " + whoP);
-                }
-                sessions_.erase(it);
-                return true;
-            }
-        }
+    ApiTimer timer(Api::CancelConfirmed);
+    TraceSpan span("cancelConfirmed", "sessions");
+    const std::string_view whoP = primaryKey(byEither);
+    const std::string_view whoS = secondaryKey(byEither);
+
+    const std::size_t* idx = byId_.find(sessionId);
+    if (!idx || sessions_[*idx].status != StudySession::Status::Confirmed) {
+        timer.fail();
+        return false;
     }
-    return false;
+    auto it = sessions_.begin() + static_cast<std::ptrdiff_t>(*idx);
+
+    bool matches = (it->requester == whoP || it->invitee == whoP) ||
+                   (!whoS.empty() && (it->requester == whoS || it->invitee == whoS));
+    if (!matches) {
+        timer.fail();
+        return false;
+    }
+    if (nc_) {
+        const std::string_view other =
+            (it->requester == whoP || (!whoS.empty() && it->requester == whoS))
+            ? it->invitee : it->requester;
+        nc_->notify(other, "Study session " + it->id + " was canceled by " + std::string(whoP));
+    }
+    publishSession(changes_, ChangeEvent::Kind::SessionCancelled, *it);
+    std::size_t removed = *idx; // before erase(): it shifts entries into idx's slot
+    byId_.erase(it->id);
+    sessions_.erase(it);
+    // Sessions after the removed one moved down by one slot.
+    for (std::size_t i = removed; i < sessions_.size(); ++i) *byId_.find(sessions_[i].id) = i;
+    pendingByInvitee_.forEach([&](std::string_view, std::vector<std::size_t>& pending) {
+        for (std::size_t& i : pending) i -= i > removed;
+    });
+    return true;
 }
 
 } // namespace sb
\ No newline at end of file
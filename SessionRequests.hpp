@@ -2,43 +2,101 @@
  * SessionRequests.hpp
  * Feature: Send & confirm study session requests; emit notifications; list sessions.
  *
+ * Admission control (trySendRequest): popular invitees would otherwise collect hundreds of
+ * requests an hour. A request that repeats a pending one (same requester, invitee, course,
+ * day and an overlapping window) is coalesced into it. New requests need a token from the
+ * requester's bucket and from the invitee's bucket (lazy refill: a bucket is one timestamp,
+ * read against the clock when touched; full buckets are dropped), and
+ * the invitee's pending queue must be below its bound. Otherwise the request is refused
+ * with the reason; nothing is stored or sent.
+ *
+ * Pending requests are indexed by invitee, so pendingFor() reads one short list instead
+ * of every session.
+ *
  * STANDARD LIBRARIES USED:
- *  <vector>      : store sessions
- *  <string>      : ids, emails, course codes
+ *  <chrono>      : token bucket refill
+ *  <deque>       : store sessions (stable references across sendRequest calls)
+ *  FlatMap.hpp   : session id → index, invitee → pending, user → bucket
+ *  <vector>      : query results
+ *  <string>      : ids
+ *  <string_view> : interned emails
  *  <algorithm>   : remove_if, sort
  *  <utility>     : move
  ****************************************************************************************/
 #pragma once
 #include "Profile.hpp"
 #include "NotificationCenter.hpp"
+#include "FlatMap.hpp"
+#include <chrono>
+#include <cstdint>
+#include <deque>
 #include <vector>
 #include <string>
+#include <string_view>
 
 namespace sb {
 
 // A scheduled study session (pending or confirmed).
+// Identity fields are interned (StringPool.hpp), shared with the profiles. The course is
+// whatever the requester sent, so it is owned (course codes fit the small-string buffer).
 struct StudySession {
-    std::string id;          // simple incrementing id (e.g., "S1")
-    std::string course;      // normalized uppercase
+    std::string id;              // simple incrementing id (e.g., "S1")
+    std::string course;          // normalized uppercase
     Day day;
-    int start;               // minutes since midnight
-    int end;                 // minutes since midnight
-    std::string requester;   // email
-    std::string invitee;     // email
+    int start;                   // minutes since midnight
+    int end;                     // minutes since midnight
+    std::string_view requester;  // email
+    std::string_view invitee;    // email
     enum class Status { Pending, Confirmed, Declined };
     Status status;
 };
 
+class ChangeLog;
+
 class SessionRequests {
 public:
-    explicit SessionRequests(NotificationCenter* nc) : nc_(nc) {}
+    // Limits applied by trySendRequest(). A rate of 0 disables that bucket; a queue bound of
+    // 0 disables the bound.
+    struct AdmissionPolicy {
+        double requesterPerHour = 30;           // sustained requests a student may send
+        double requesterBurst = 10;             // ... and how many at once
+        double inviteePerHour = 120;            // sustained requests a student may receive
+        double inviteeBurst = 30;
+        std::size_t maxPendingPerInvitee = 50;  // unanswered requests waiting on one student
+    };
+    enum class Admission {
+        Admitted,           // stored and the invitee notified
+        Coalesced,          // duplicate of a pending request, which is returned instead
+        RequesterThrottled, // sender is over their rate
+        InviteeThrottled,   // invitee is receiving too many requests
+        InviteeQueueFull,   // invitee already has maxPendingPerInvitee pending
+    };
+    struct SendResult {
+        Admission admission;
+        const StudySession* session; // new or coalesced request; nullptr when refused
+    };
+    using Clock = std::chrono::steady_clock;
+
+    // 'changes' (optional) receives SessionRequested/Confirmed/Cancelled events.
+    explicit SessionRequests(NotificationCenter* nc, ChangeLog* changes = nullptr)
+        : nc_(nc), changes_(changes) {}
 
     // Send a request from 'from' to 'to' for 'course' and time window.
-    // Returns the created session object reference.
+    // Returns the created session object reference (stays valid across later sendRequest calls).
     const StudySession& sendRequest(const Profile& from, const Profile& to,
                                     const std::string& courseUpper,
                                     Day day, int startMin, int endMin);
 
+    // sendRequest() behind admission control (see top of file). Refused requests are counted
+    // as SendRequest failures in Metrics. The pointer follows the sendRequest() lifetime.
+    SendResult trySendRequest(const Profile& from, const Profile& to,
+                              const std::string& courseUpper,
+                              Day day, int startMin, int endMin,
+                              Clock::time_point now = Clock::now());
+
+    void setAdmissionPolicy(const AdmissionPolicy& policy) { policy_ = policy; }
+    const AdmissionPolicy& admissionPolicy() const { return policy_; }
+
     // Confirm a pending request (only invitee may confirm).
     // Returns true if state changed to Confirmed and a notification was sent.
     bool confirmRequest(const std::string& sessionId, const Profile& byInvitee);
@@ -49,15 +107,57 @@ public:
     // Get all confirmed sessions where 'user' is either requester or invitee.
     std::vector<StudySession> confirmedFor(const Profile& user) const;
 
+    // Reference forms of the two queries above: pointers into the session store instead of
+    // copies. Valid until the next cancelConfirmed() call.
+    std::vector<const StudySession*> pendingRefs(const Profile& user) const;
+    std::vector<const StudySession*> confirmedRefs(const Profile& user) const;
+
+    // Confirmed sessions involving any of 'people', each once, sorted by (day, start):
+    // the busy list nextCommonWindow() expects. Valid until the next cancelConfirmed() call.
+    std::vector<const StudySession*> confirmedAmong(const std::vector<const Profile*>& people) const;
+
     // Cancel a confirmed session (either party may cancel); removes it entirely.
     bool cancelConfirmed(const std::string& sessionId, const Profile& byEither);
 
+    // Session with this id, or nullptr. Valid until the next cancelConfirmed() call.
+    const StudySession* findById(std::string_view sessionId) const;
+
+    // Every stored session (pending and confirmed), in send order.
+    std::size_t size() const { return sessions_.size(); }
+    template <class Fn>
+    void forEach(Fn&& fn) const {
+        for (const auto& s : sessions_) fn(s);
+    }
+
 private:
-    static const std::string& userKey(const Profile& p); // email identity
+    static std::string_view userKey(const Profile& p); // email identity
     static std::string nextId();
+    const StudySession& store(const Profile& from, const Profile& to, std::string_view course,
+                              Day day, int startMin, int endMin);
+    void dropPending(const StudySession& s, std::size_t index);
+
+    // Token buckets keyed by user, in "theoretical arrival time" form: each user keeps the
+    // time at which their bucket will be full again. A request pushes it 1/rate later and is
+    // allowed while it stays within burst/rate of now. Integer times, so refill is exact.
+    class RateBuckets {
+    public:
+        // True if 'key' has a token at 'nowNs' (always true if perHour <= 0).
+        bool ready(std::string_view key, double perHour, double burst, std::int64_t nowNs) const;
+        void take(std::string_view key, double perHour, std::int64_t nowNs);
+        std::size_t size() const { return fullAt_.size(); }
+
+    private:
+        FlatMap<std::string_view, std::int64_t, StrHash> fullAt_; // interned key → ns; absent = full
+        std::size_t prunedSize_ = 0;                             // size after the last prune
+    };
 
-    std::vector<StudySession> sessions_;
+    std::deque<StudySession> sessions_;
+    FlatMap<std::string, std::size_t, StrHash> byId_; // id → index in sessions_
+    FlatMap<std::string_view, std::vector<std::size_t>, StrHash> pendingByInvitee_; // ascending indices
+    AdmissionPolicy policy_;
+    RateBuckets sendBuckets_, receiveBuckets_;
     NotificationCenter* nc_;
+    ChangeLog* changes_;
 };
 
 } // namespace sb
\ No newline at end of file
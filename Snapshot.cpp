@@ -0,0 +1,64 @@
+/***************************************************************************************
+ * Snapshot.cpp — implementation
+ ****************************************************************************************/
+#include "Snapshot.hpp"
+
+#include <string_view>
+
+namespace sb {
+
+// Field text with the separators replaced, so every record stays on one line.
+static void field(std::ostream& out, std::string_view s) {
+    for (char c : s) out.put(c == '\t' || c == '\n' || c == '\r' ? ' ' : c);
+}
+
+static const char* statusName(StudySession::Status s) {
+    switch (s) {
+    case StudySession::Status::Pending:   return "pending";
+    case StudySession::Status::Confirmed: return "confirmed";
+    case StudySession::Status::Declined:  return "declined";
+    }
+    return "?";
+}
+
+bool writeSnapshot(std::ostream& out, const std::vector<Profile>& profiles,
+                   const SessionRequests& sessions) {
+    out << "studybuddy-snapshot 1\n";
+    out << "profiles " << profiles.size() << '\n';
+    for (const auto& p : profiles) {
+        out << "P\t";
+        field(out, p.name());
+        out << '\t';
+        field(out, p.email());
+        out << '\t';
+        for (std::size_t i = 0; i < p.courses().size(); ++i) {
+            if (i) out << ',';
+            field(out, p.courses()[i]);
+        }
+        out << '\t';
+        bool first = true;
+        for (const auto& s : p.availability()) {
+            if (!first) out << ',';
+            first = false;
+            out << static_cast<int>(s.day) << ':' << s.start << '-' << s.end;
+        }
+        out << '\n';
+    }
+    out << "sessions " << sessions.size() << '\n';
+    sessions.forEach([&](const StudySession& s) {
+        out << "S\t";
+        field(out, s.id);
+        out << '\t';
+        field(out, s.course);
+        out << '\t' << static_cast<int>(s.day) << '\t' << s.start << '\t' << s.end << '\t';
+        field(out, s.requester);
+        out << '\t';
+        field(out, s.invitee);
+        out << '\t' << statusName(s.status) << '\n';
+    });
+    out << "end\n";
+    out.flush();
+    return static_cast<bool>(out);
+}
+
+} // namespace sb
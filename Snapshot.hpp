@@ -0,0 +1,35 @@
+/***************************************************************************************
+ * Snapshot.hpp
+ * Point-in-time dump of the resident state: every profile and every stored session.
+ *
+ * Text, one record per line, fields separated by tabs (tabs/newlines inside a field are
+ * written as spaces):
+ *   studybuddy-snapshot 1
+ *   profiles <n>
+ *   P <name> <email> <course,course,...> <day:start-end,...>      (day 0 = Mon, minutes)
+ *   sessions <m>
+ *   S <id> <course> <day> <start> <end> <requester> <invitee> <pending|confirmed|declined>
+ *   end
+ * A file without the trailing "end" line is incomplete.
+ *
+ * writeSnapshot() only reads; BackgroundSnapshot.hpp runs it in a forked child so the
+ * serving process does not wait for the disk.
+ *
+ * STANDARD LIBRARIES USED:
+ *  <ostream> : output
+ *  <vector>  : profiles
+ ****************************************************************************************/
+#pragma once
+#include "Profile.hpp"
+#include "SessionRequests.hpp"
+
+#include <ostream>
+#include <vector>
+
+namespace sb {
+
+// Write the snapshot; returns false if the stream failed.
+bool writeSnapshot(std::ostream& out, const std::vector<Profile>& profiles,
+                   const SessionRequests& sessions);
+
+} // namespace sb
@@ -0,0 +1,79 @@
+/***************************************************************************************
+ * SparseCounts.cpp — implementation
+ ****************************************************************************************/
+#include "SparseCounts.hpp"
+
+#include <algorithm>
+
+namespace sb {
+
+// Pending delta entries tolerated before compact(), as a floor and as a share of the CSR.
+static constexpr std::size_t kMinPending = 1024;
+static constexpr std::size_t kPendingDivisor = 4;
+
+static bool colBefore(const std::pair<std::uint32_t, std::int32_t>& e, std::uint32_t col) {
+    return e.first < col;
+}
+
+void SparseCounts::assign(std::size_t rowCount, const std::vector<Entry>& entries) {
+    rowStart_.assign(rowCount + 1, 0);
+    cols_.resize(entries.size());
+    counts_.resize(entries.size());
+    for (std::size_t i = 0; i < entries.size(); ++i) {
+        ++rowStart_[entries[i].row + 1];
+        cols_[i] = entries[i].col;
+        counts_[i] = entries[i].count;
+    }
+    for (std::size_t r = 0; r < rowCount; ++r) rowStart_[r + 1] += rowStart_[r];
+    deltas_.assign(rowCount, Delta());
+    pending_ = 0;
+}
+
+std::uint32_t SparseCounts::get(std::uint32_t row, std::uint32_t col) const {
+    std::int64_t n = 0;
+    auto first = cols_.begin() + static_cast<std::ptrdiff_t>(rowStart_[row]);
+    auto last = cols_.begin() + static_cast<std::ptrdiff_t>(rowStart_[row + 1]);
+    auto it = std::lower_bound(first, last, col);
+    if (it != last && *it == col) n = counts_[static_cast<std::size_t>(it - cols_.begin())];
+    const Delta& d = deltas_[row];
+    auto dt = std::lower_bound(d.begin(), d.end(), col, colBefore);
+    if (dt != d.end() && dt->first == col) n += dt->second;
+    return static_cast<std::uint32_t>(std::max<std::int64_t>(0, n));
+}
+
+void SparseCounts::add(std::uint32_t row, std::uint32_t col, std::int32_t by) {
+    if (by == 0) return;
+    Delta& d = deltas_[row];
+    auto it = std::lower_bound(d.begin(), d.end(), col, colBefore);
+    if (it != d.end() && it->first == col) {
+        if ((it->second += by) == 0) {
+            d.erase(it);
+            --pending_;
+        }
+    } else {
+        d.insert(it, {col, by});
+        ++pending_;
+    }
+    if (pending_ > std::max(kMinPending, cols_.size() / kPendingDivisor)) compact();
+}
+
+void SparseCounts::compact() {
+    std::vector<std::size_t> rowStart(rows() + 1, 0);
+    std::vector<std::uint32_t> cols, counts;
+    cols.reserve(cols_.size() + pending_);
+    counts.reserve(cols_.size() + pending_);
+    for (std::uint32_t r = 0; r < rows(); ++r) {
+        forEach(r, [&](std::uint32_t col, std::uint32_t n) {
+            cols.push_back(col);
+            counts.push_back(n);
+        });
+        rowStart[r + 1] = cols.size();
+    }
+    rowStart_ = std::move(rowStart);
+    cols_ = std::move(cols);
+    counts_ = std::move(counts);
+    for (auto& d : deltas_) Delta().swap(d);
+    pending_ = 0;
+}
+
+} // namespace sb
@@ -0,0 +1,90 @@
+/***************************************************************************************
+ * SparseCounts.hpp
+ * Growable sparse matrix of non-negative counts: CSR rows plus a small sorted delta per
+ * row, folded back into the CSR when the deltas get large.
+ *
+ * Reads see CSR and delta merged: get(r, c) is two binary searches, forEach(r, fn) walks
+ * row r in column order without allocating. add(r, c, by) touches only the row's delta
+ * (O(log row + delta row)); once pending deltas exceed max(1024, nnz / 4) the whole
+ * matrix is rewritten in one O(nnz) pass, so writes stay cheap amortized and reads never
+ * merge more than a quarter of the matrix's size in pending entries.
+ *
+ * Used by CoEnrollment (course x course) and StudyGraph (student x student).
+ * Const members are safe to call concurrently; add()/compact() are not.
+ *
+ * STANDARD LIBRARIES USED:
+ *  <cstdint> : compact ids and counts
+ *  <utility> : (column, change) pairs
+ *  <vector>  : CSR arrays and deltas
+ ****************************************************************************************/
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace sb {
+
+class SparseCounts {
+public:
+    struct Entry {
+        std::uint32_t row, col, count;
+    };
+
+    std::size_t rows() const { return deltas_.size(); }
+    void addRow() { rowStart_.push_back(rowStart_.back()); deltas_.emplace_back(); }
+
+    // Replace everything with 'rowCount' rows holding 'entries', which must be sorted by
+    // (row, col) with no duplicates or zero counts.
+    void assign(std::size_t rowCount, const std::vector<Entry>& entries);
+
+    std::uint32_t get(std::uint32_t row, std::uint32_t col) const;
+    // Change a count by 'by' (the result must not go negative).
+    void add(std::uint32_t row, std::uint32_t col, std::int32_t by);
+
+    // Call fn(col, count) for every non-zero of 'row', in column order.
+    template <class Fn>
+    void forEach(std::uint32_t row, Fn&& fn) const;
+
+    std::size_t rowSizeBound(std::uint32_t row) const {
+        return rowStart_[row + 1] - rowStart_[row] + deltas_[row].size();
+    }
+    // Stored entries (an upper bound on non-zeros while deltas are pending).
+    std::size_t nonZeros() const { return cols_.size() + pending_; }
+    std::size_t pending() const { return pending_; }
+
+    void compact();
+
+private:
+    using Delta = std::vector<std::pair<std::uint32_t, std::int32_t>>; // (column, change), sorted
+
+    std::vector<std::size_t> rowStart_{0}; // row r: [rowStart_[r], rowStart_[r + 1]) of cols_/counts_
+    std::vector<std::uint32_t> cols_;
+    std::vector<std::uint32_t> counts_;
+    std::vector<Delta> deltas_;
+    std::size_t pending_ = 0;
+};
+
+/* ------------------------------ template members ------------------------------ */
+
+template <class Fn>
+void SparseCounts::forEach(std::uint32_t row, Fn&& fn) const {
+    std::size_t i = rowStart_[row], end = rowStart_[row + 1];
+    const Delta& d = deltas_[row];
+    auto dt = d.begin();
+    while (i < end || dt != d.end()) {
+        std::uint32_t col;
+        std::int64_t n = 0;
+        if (dt == d.end() || (i < end && cols_[i] < dt->first)) {
+            col = cols_[i];
+            n = counts_[i++];
+        } else {
+            col = dt->first;
+            if (i < end && cols_[i] == col) n = counts_[i++];
+            n += (dt++)->second;
+        }
+        if (n > 0) fn(col, static_cast<std::uint32_t>(n));
+    }
+}
+
+} // namespace sb
@@ -0,0 +1,62 @@
+/***************************************************************************************
+ * StringPool.cpp — implementation
+ ****************************************************************************************/
+#include "StringPool.hpp"
+
+#include <cstring>
+
+namespace sb {
+
+StringPool& StringPool::global() {
+    static StringPool* pool = new StringPool(); // never destroyed: views outlive static dtors
+    return *pool;
+}
+
+char* StringPool::allocate(std::size_t n) {
+    if (n > kBlockSize / 4) {
+        // Oversized strings get a block of their own so they do not waste the current one.
+        blocks_.emplace_back(new char[n]);
+        arenaBytes_ += n;
+        return blocks_.back().get();
+    }
+    if (n > left_) {
+        blocks_.emplace_back(new char[kBlockSize]);
+        cur_ = blocks_.back().get();
+        left_ = kBlockSize;
+        arenaBytes_ += kBlockSize;
+    }
+    char* p = cur_;
+    cur_ += n;
+    left_ -= n;
+    return p;
+}
+
+std::string_view StringPool::intern(std::string_view s) {
+    if (s.empty()) return {};
+    std::lock_guard<std::mutex> lk(mu_);
+    ++requests_;
+    auto it = index_.find(s);
+    if (it != index_.end()) return *it;
+
+    char* p = allocate(s.size());
+    std::memcpy(p, s.data(), s.size());
+    std::string_view stored(p, s.size());
+    index_.insert(stored);
+    bytes_ += s.size();
+    return stored;
+}
+
+StringPool::Stats StringPool::stats() const {
+    std::lock_guard<std::mutex> lk(mu_);
+    Stats st;
+    st.strings = index_.size();
+    st.bytes = bytes_;
+    st.arenaBytes = arenaBytes_;
+    // One node (view + cached hash + next pointer) per string plus the bucket array.
+    st.indexBytes = index_.size() * (sizeof(std::string_view) + 2 * sizeof(void*)) +
+                    index_.bucket_count() * sizeof(void*);
+    st.requests = requests_;
+    return st;
+}
+
+} // namespace sb
@@ -0,0 +1,75 @@
+/***************************************************************************************
+ * StringPool.hpp
+ * Append-only arena of interned strings: identities (emails) and index keys.
+ *
+ * intern() stores each distinct string once, in large arena blocks, and returns a
+ * std::string_view that stays valid for the life of the pool (nothing is ever freed or
+ * moved). Equal strings interned in the same pool share one copy, so a profile's email,
+ * the sessions that mention it and the notification inbox keyed by it all point at the
+ * same bytes.
+ *
+ * Profile, StudySession and NotificationCenter use StringPool::global() for emails.
+ * Nothing is ever freed, so code the server runs keeps text a client can replace or
+ * invent at will (names, course codes) out of it: such text is owned by its holder or by
+ * a pool the holder owns (Autocomplete, OccupancyIndex). CLI-only indexes still intern
+ * course codes globally; a single-user session cannot grow them much.
+ * intern() is thread-safe; reading a returned view needs no lock.
+ *
+ * STANDARD LIBRARIES USED:
+ *  <memory>        : arena blocks
+ *  <mutex>         : intern() serialization
+ *  <string_view>   : interned string handles
+ *  <unordered_set> : dedup index over interned views
+ *  <vector>        : block list
+ ****************************************************************************************/
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+namespace sb {
+
+class StringPool {
+public:
+    struct Stats {
+        std::size_t strings = 0;      // distinct strings stored
+        std::size_t bytes = 0;        // payload bytes of those strings
+        std::size_t arenaBytes = 0;   // bytes reserved in arena blocks
+        std::size_t indexBytes = 0;   // approximate size of the dedup index
+        std::size_t requests = 0;     // intern() calls with a non-empty string
+    };
+
+    StringPool() = default;
+    StringPool(const StringPool&) = delete;
+    StringPool& operator=(const StringPool&) = delete;
+
+    // Process-wide pool used by the core modules.
+    static StringPool& global();
+
+    // Return the pooled copy of 's' (stored on first use). Empty input returns an empty view.
+    std::string_view intern(std::string_view s);
+
+    Stats stats() const;
+
+    static constexpr std::size_t kBlockSize = 64 * 1024;
+
+private:
+    char* allocate(std::size_t n);
+
+    mutable std::mutex mu_;
+    std::vector<std::unique_ptr<char[]>> blocks_;
+    char* cur_ = nullptr;
+    std::size_t left_ = 0;
+    std::size_t arenaBytes_ = 0;
+    std::size_t bytes_ = 0;
+    std::size_t requests_ = 0;
+    std::unordered_set<std::string_view> index_;
+};
+
+// Shorthand for StringPool::global().intern(s).
+inline std::string_view intern(std::string_view s) { return StringPool::global().intern(s); }
+
+} // namespace sb
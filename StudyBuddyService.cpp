@@ -0,0 +1,467 @@
+/***************************************************************************************
+ * StudyBuddyService.cpp — implementation
+ ****************************************************************************************/
+#include "StudyBuddyService.hpp"
+#include "AvailabilityBrowser.hpp"
+#include "AvailabilityManager.hpp"
+#include "ClassmateSearch.hpp"
+#include "CommonWindow.hpp"
+#include "CourseManager.hpp"
+#include "Snapshot.hpp"
+#include "SyntheticRoster.hpp"
+#include "Utils.hpp"
+
+#include <chrono>
+
+namespace sb {
+
+using wire::Status;
+
+static double msSince(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+// Field limits for client text. Rejected at the door: what is accepted is kept for the
+// life of the process (emails in the global StringPool) or for the life of the roster.
+static constexpr std::size_t kMaxNameBytes = 64;
+static constexpr std::size_t kMaxEmailBytes = 254;
+static constexpr std::size_t kMaxCourseBytes = 15; // "CPSC 2150" with room; fits std::string's SSO
+static constexpr std::size_t kMaxCourses = 16;
+
+static bool validDay(std::uint8_t d) { return d < 7; }
+
+static bool validCourse(const std::string& course) {
+    return !course.empty() && course.size() <= kMaxCourseBytes;
+}
+
+static bool validWindow(std::int32_t start, std::int32_t end) {
+    return start >= 0 && end <= 24 * 60 && start < end;
+}
+
+bool StudyBuddyService::isHeavy(wire::Op op) {
+    return op == wire::Op::Suggest || op == wire::Op::SearchByName;
+}
+
+std::vector<std::uint8_t> StudyBuddyService::handle(const std::uint8_t* body, std::size_t len) {
+    wire::Reader in(body, len);
+    auto op = static_cast<wire::Op>(in.u8());
+    std::uint32_t tag = in.u32();
+
+    wire::Writer out;
+    out.u8(static_cast<std::uint8_t>(Status::Ok)); // patched below
+    out.u32(tag);
+
+    Status st = Status::BadRequest;
+    if (in.ok()) {
+        switch (op) {
+        case wire::Op::Ping:               st = Status::Ok; break;
+        case wire::Op::AddProfile:         st = addProfile(in, out); break;
+        case wire::Op::AddAvailability:    st = addAvailability(in, out); break;
+        case wire::Op::Suggest:            st = suggest(in, out); break;
+        case wire::Op::SearchByName:       st = searchByName(in, out); break;
+        case wire::Op::SearchByCourse:     st = searchByCourse(in, out); break;
+        case wire::Op::SendRequest:        st = sendRequest(in, out); break;
+        case wire::Op::ConfirmRequest:     st = confirmRequest(in, out); break;
+        case wire::Op::PendingFor:         st = pendingFor(in, out); break;
+        case wire::Op::FetchNotifications: st = fetchNotifications(in, out); break;
+        case wire::Op::Complete:           st = complete(in, out); break;
+        case wire::Op::FreeIn:             st = freeIn(in, out); break;
+        case wire::Op::NextCommon:         st = nextCommon(in, out); break;
+        case wire::Op::Snapshot:           st = snapshot(in, out); break;
+        case wire::Op::SnapshotStatus:     st = snapshotStatus(in, out); break;
+        default:                           st = Status::BadRequest; break;
+        }
+    }
+    out.patch8(0, static_cast<std::uint8_t>(st));
+    return out.finishFrame();
+}
+
+void StudyBuddyService::seedSynthetic(std::size_t count, unsigned seed) {
+    std::lock_guard<std::mutex> lk(indexMu_);
+    roster_.replaceAll(makeSyntheticRoster(count, seed));
+    auto pin = roster_.pin();
+    completions_ = Autocomplete(pin.profiles());
+    occupancy_ = OccupancyIndex(pin.profiles());
+}
+
+std::size_t StudyBuddyService::rosterSize() const {
+    return roster_.pin().profiles().size();
+}
+
+/* ------------------------------ roster writers ------------------------------ */
+
+StudyBuddyService::ReloadStats StudyBuddyService::reloadEnrollments(std::istream& in,
+                                                                    EnrollmentSync::Unlisted unlisted) {
+    using Clock = std::chrono::steady_clock;
+    ReloadStats stats;
+    auto t0 = Clock::now();
+    auto dump = EnrollmentSync::groupRows(EnrollmentSync::readRows(in));
+    stats.parseMs = msSince(t0);
+
+    // The diff is the expensive part: do it against a pinned version, outside every lock.
+    t0 = Clock::now();
+    std::uint64_t planned;
+    EnrollmentPlan plan;
+    {
+        auto pin = roster_.pin();
+        planned = pin.version();
+        plan = EnrollmentSync::plan(pin, dump, unlisted);
+    }
+    stats.planMs = msSince(t0);
+
+    t0 = Clock::now();
+    std::lock_guard<std::mutex> lk(indexMu_);
+    if (roster_.currentVersion() != planned) { // rare: redo it against what we will replace
+        plan = EnrollmentSync::plan(roster_.pin(), dump, unlisted);
+        stats.replanned = true;
+    }
+    EnrollmentSync::apply(roster_, plan);
+    if (!plan.changes.empty()) {
+        auto pin = roster_.pin();
+        for (const auto& change : plan.changes) {
+            completions_.update(change.id, pin.profiles()[change.id]);
+            occupancy_.update(change.id, pin.profiles()[change.id]);
+        }
+    }
+    stats.applyMs = msSince(t0);
+
+    stats.changed = plan.changes.size();
+    stats.unchanged = plan.unchanged;
+    stats.unknownEmails = std::move(plan.unknownEmails);
+    return stats;
+}
+
+Status StudyBuddyService::addProfile(wire::Reader& in, wire::Writer&) {
+    std::string name  = trim(in.str());
+    std::string email = trim(in.str());
+    std::uint16_t n = in.u16();
+    if (n > kMaxCourses || name.size() > kMaxNameBytes || email.size() > kMaxEmailBytes) return Status::BadRequest;
+    std::vector<std::string> raw;
+    for (std::uint16_t i = 0; i < n && in.ok(); ++i) {
+        raw.push_back(trim(in.str()));
+        if (!validCourse(raw.back())) return Status::BadRequest;
+    }
+    if (!in.ok() || email.empty()) return Status::BadRequest;
+
+    Profile p;
+    p.createOrReset(name, email, CourseManager::normalizeDedup(raw));
+    std::lock_guard<std::mutex> lk(indexMu_);
+    std::size_t id = roster_.upsert(p); // reset semantics for a known email, like CLI option 1
+    completions_.update(id, p);
+    occupancy_.update(id, roster_.pin().profiles()[id]); // with committed availability
+    return Status::Ok;
+}
+
+Status StudyBuddyService::addAvailability(wire::Reader& in, wire::Writer&) {
+    std::string email = in.str();
+    std::uint8_t day = in.u8();
+    std::int32_t start = in.i32();
+    std::int32_t end = in.i32();
+    if (!in.ok() || !validDay(day) || !validWindow(start, end)) return Status::BadRequest;
+
+    AvailabilitySlot slot{static_cast<Day>(day), start, end};
+    std::lock_guard<std::mutex> lk(indexMu_);
+    bool found = roster_.updateByEmail(email, [&](Profile& p) {
+        AvailabilityManager::addMerged(p, slot);
+    });
+    if (!found) return Status::NotFound;
+    auto pin = roster_.pin();
+    if (const Profile* p = pin.findByEmail(email)) {
+        occupancy_.update(static_cast<std::size_t>(p - pin.profiles().data()), *p);
+    }
+    return Status::Ok;
+}
+
+/* ------------------------------ roster readers ------------------------------ */
+
+Status StudyBuddyService::suggest(wire::Reader& in, wire::Writer& out) {
+    std::string email = in.str();
+    std::int32_t minOverlap = in.i32();
+    std::uint16_t maxResults = in.u16();
+    if (!in.ok()) return Status::BadRequest;
+
+    auto pin = roster_.pin();
+    const Profile* self = pin.findByEmail(email);
+    if (!self) return Status::NotFound;
+    auto matches = matcher_.suggest(*self, pin.profiles(), minOverlap, maxResults);
+    out.u16(static_cast<std::uint16_t>(matches.size()));
+    for (const auto& m : matches) {
+        out.str(m.person->email());
+        out.str(m.person->name());
+        out.i32(m.overlapMinutes);
+        out.u16(static_cast<std::uint16_t>(m.sharedCourses.size()));
+        for (const auto& c : m.sharedCourses) out.str(c);
+    }
+    return Status::Ok;
+}
+
+static void writeProfiles(wire::Writer& out, const std::vector<const Profile*>& ps) {
+    std::size_t n = ps.size() > 0xFFFF ? 0xFFFF : ps.size();
+    out.u16(static_cast<std::uint16_t>(n));
+    for (std::size_t i = 0; i < n; ++i) {
+        out.str(ps[i]->email());
+        out.str(ps[i]->name());
+    }
+}
+
+Status StudyBuddyService::searchByName(wire::Reader& in, wire::Writer& out) {
+    std::string email = in.str();
+    std::string query = in.str();
+    if (!in.ok()) return Status::BadRequest;
+
+    auto pin = roster_.pin();
+    const Profile* self = pin.findByEmail(email);
+    if (!self) return Status::NotFound;
+    writeProfiles(out, ClassmateSearch::byName(pin.profiles(), *self, query));
+    return Status::Ok;
+}
+
+Status StudyBuddyService::searchByCourse(wire::Reader& in, wire::Writer& out) {
+    std::string email = in.str();
+    std::string course = in.str();
+    if (!in.ok()) return Status::BadRequest;
+
+    auto pin = roster_.pin();
+    const Profile* self = pin.findByEmail(email);
+    if (!self) return Status::NotFound;
+    writeProfiles(out, ClassmateSearch::byCourse(pin.profiles(), *self, course));
+    return Status::Ok;
+}
+
+Status StudyBuddyService::complete(wire::Reader& in, wire::Writer& out) {
+    std::uint8_t kind = in.u8();
+    std::string prefix = in.str();
+    std::uint16_t maxResults = in.u16();
+    if (!in.ok() || kind > 1) return Status::BadRequest;
+
+    std::lock_guard<std::mutex> lk(indexMu_); // texts live in the index's own pool
+    auto hits = kind == 0 ? completions_.courses(prefix, maxResults) : completions_.names(prefix, maxResults);
+    out.u16(static_cast<std::uint16_t>(hits.size()));
+    for (const auto& h : hits) {
+        out.str(h.text);
+        out.u32(h.count);
+    }
+    return Status::Ok;
+}
+
+Status StudyBuddyService::freeIn(wire::Reader& in, wire::Writer& out) {
+    std::string email = in.str();
+    std::string course = in.str();
+    std::uint8_t day = in.u8();
+    std::int32_t start = in.i32();
+    std::int32_t end = in.i32();
+    std::uint8_t partial = in.u8();
+    if (!in.ok() || !validDay(day) || !validWindow(start, end)) return Status::BadRequest;
+
+    auto match = partial ? OccupancyIndex::Match::Partial : OccupancyIndex::Match::Full;
+    std::lock_guard<std::mutex> lk(indexMu_); // pin the version the index currently mirrors
+    auto pin = roster_.pin();
+    const Profile* self = pin.findByEmail(email);
+    if (!self) return Status::NotFound;
+    auto free = AvailabilityBrowser::freeInWindow(occupancy_, pin.profiles(), *self, course,
+                                                  static_cast<Day>(day), start, end, match);
+    std::vector<const Profile*> people;
+    people.reserve(free.size());
+    for (const auto& f : free) people.push_back(f.person);
+    writeProfiles(out, people);
+    return Status::Ok;
+}
+
+// Response: u8 found, u8 day, i32 start, i32 end, u8 nextWeek (zeros when not found).
+Status StudyBuddyService::nextCommon(wire::Reader& in, wire::Writer& out) {
+    std::uint8_t n = in.u8();
+    std::vector<std::string> emails(n);
+    for (auto& e : emails) e = in.str();
+    std::uint8_t day = in.u8();
+    std::int32_t from = in.i32();
+    std::int32_t duration = in.i32();
+    if (!in.ok() || n == 0 || !validDay(day) || from < 0 || from > 24 * 60 || duration <= 0 ||
+        duration > 24 * 60) {
+        return Status::BadRequest;
+    }
+
+    auto pin = roster_.pin();
+    std::vector<const Profile*> people;
+    people.reserve(n);
+    for (const auto& e : emails) {
+        const Profile* p = pin.findByEmail(e);
+        if (!p) return Status::NotFound;
+        people.push_back(p);
+    }
+
+    std::lock_guard<std::mutex> st(stateMu_); // busy sessions point into sessions_
+    auto w = nextCommonWindow(people, WeekTime{static_cast<Day>(day), from}, duration,
+                              sessions_.confirmedAmong(people));
+    out.u8(w ? 1 : 0);
+    out.u8(w ? static_cast<std::uint8_t>(w->day) : 0);
+    out.i32(w ? w->start : 0);
+    out.i32(w ? w->end : 0);
+    out.u8(w && w->nextWeek ? 1 : 0);
+    return Status::Ok;
+}
+
+/* -------------------------- sessions / notifications -------------------------- */
+
+Status StudyBuddyService::sendRequest(wire::Reader& in, wire::Writer& out) {
+    std::string fromEmail = in.str();
+    std::string toEmail   = in.str();
+    std::string course    = trim(in.str());
+    std::uint8_t day = in.u8();
+    std::int32_t start = in.i32();
+    std::int32_t end = in.i32();
+    if (!in.ok() || !validDay(day) || !validWindow(start, end) || !validCourse(course)) return Status::BadRequest;
+
+    auto pin = roster_.pin();
+    const Profile* from = pin.findByEmail(fromEmail);
+    const Profile* to   = pin.findByEmail(toEmail);
+    if (!from || !to) return Status::NotFound;
+
+    std::lock_guard<std::mutex> st(stateMu_);
+    auto sent = sessions_.trySendRequest(*from, *to, course, static_cast<Day>(day), start, end);
+    if (!sent.session) {
+        out.u8(static_cast<std::uint8_t>(sent.admission));
+        return Status::Throttled;
+    }
+    out.str(sent.session->id); // a coalesced duplicate answers with the pending request's id
+    return Status::Ok;
+}
+
+Status StudyBuddyService::confirmRequest(wire::Reader& in, wire::Writer&) {
+    std::string email = in.str();
+    std::string id    = trim(in.str());
+    if (!in.ok()) return Status::BadRequest;
+
+    auto pin = roster_.pin();
+    const Profile* by = pin.findByEmail(email);
+    if (!by) return Status::NotFound;
+
+    std::lock_guard<std::mutex> st(stateMu_);
+    return sessions_.confirmRequest(id, *by) ? Status::Ok : Status::Rejected;
+}
+
+Status StudyBuddyService::pendingFor(wire::Reader& in, wire::Writer& out) {
+    std::string email = in.str();
+    if (!in.ok()) return Status::BadRequest;
+
+    auto pin = roster_.pin();
+    const Profile* user = pin.findByEmail(email);
+    if (!user) return Status::NotFound;
+
+    std::lock_guard<std::mutex> st(stateMu_);
+    auto pending = sessions_.pendingRefs(*user); // written out while stateMu_ is held
+    std::size_t n = pending.size() > 0xFFFF ? 0xFFFF : pending.size();
+    out.u16(static_cast<std::uint16_t>(n));
+    for (std::size_t i = 0; i < n; ++i) {
+        const StudySession& s = *pending[i];
+        out.str(s.id);
+        out.str(s.course);
+        out.str(s.requester);
+        out.u8(static_cast<std::uint8_t>(s.day));
+        out.i32(s.start);
+        out.i32(s.end);
+    }
+    return Status::Ok;
+}
+
+Status StudyBuddyService::fetchNotifications(wire::Reader& in, wire::Writer& out) {
+    std::string email = trim(in.str());
+    if (!in.ok()) return Status::BadRequest;
+
+    std::lock_guard<std::mutex> st(stateMu_);
+    auto msgs = notif_.fetchAndClear(email);
+    std::size_t n = msgs.size() > 0xFFFF ? 0xFFFF : msgs.size();
+    out.u16(static_cast<std::uint16_t>(n));
+    for (std::size_t i = 0; i < n; ++i) out.str(msgs[i]);
+    return Status::Ok;
+}
+
+// Finished snapshots remembered for SnapshotStatus; older ids answer NotFound.
+static constexpr std::size_t kMaxSnapshotResults = 64;
+
+// A plain file name: no separators, no hidden files, nothing that walks out of the dir.
+static bool validSnapshotName(const std::string& name) {
+    if (name.empty() || name.size() > 64 || name[0] == '.') return false;
+    for (char c : name) {
+        bool ok = (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') ||
+                  c == '.' || c == '_' || c == '-';
+        if (!ok) return false;
+    }
+    return true;
+}
+
+void StudyBuddyService::setSnapshotDir(std::string dir) {
+    while (dir.size() > 1 && dir.back() == '/') dir.pop_back();
+    std::lock_guard<std::mutex> lk(snapMu_);
+    snapshotDir_ = std::move(dir);
+}
+
+Status StudyBuddyService::snapshot(wire::Reader& in, wire::Writer& out) {
+    std::string name = in.str();
+    if (!in.ok() || !validSnapshotName(name)) return Status::BadRequest;
+    std::string path;
+    {
+        std::lock_guard<std::mutex> lk(snapMu_);
+        if (snapshotDir_.empty()) {
+            out.str("snapshots are disabled (no --snapshot-dir)");
+            return Status::Rejected;
+        }
+        path = snapshotDir_ + "/" + name;
+    }
+
+    auto pin = roster_.pin();
+    BackgroundSnapshots::Started started;
+    {
+        std::lock_guard<std::mutex> st(stateMu_);
+        started = snapshots_.start(path, [&](std::ostream& os, std::string&) {
+            return writeSnapshot(os, pin.profiles(), sessions_);
+        });
+    }
+    switch (started.status) {
+    case BackgroundSnapshots::Start::Started: {
+        std::lock_guard<std::mutex> lk(snapMu_);
+        lastSnapshotId_ = started.id;
+        out.u32(started.id);
+        out.u32(static_cast<std::uint32_t>(started.pauseUs));
+        return Status::Ok;
+    }
+    case BackgroundSnapshots::Start::Busy:
+        out.str("a snapshot is already being written");
+        return Status::Rejected;
+    case BackgroundSnapshots::Start::ForkFailed:
+        out.str(started.error);
+        return Status::Rejected;
+    }
+    return Status::Rejected;
+}
+
+Status StudyBuddyService::snapshotStatus(wire::Reader& in, wire::Writer& out) {
+    std::uint32_t id = in.u32();
+    if (!in.ok() || id == 0) return Status::BadRequest;
+
+    std::lock_guard<std::mutex> lk(snapMu_);
+    for (auto& r : snapshots_.poll()) {
+        snapshotResults_[r.id] = std::move(r);
+        if (snapshotResults_.size() > kMaxSnapshotResults) snapshotResults_.erase(snapshotResults_.begin());
+    }
+    auto it = snapshotResults_.find(id);
+    if (it == snapshotResults_.end()) {
+        // Every finished id was just collected: an issued, unforgotten id is still running.
+        bool forgotten = !snapshotResults_.empty() && id < snapshotResults_.begin()->first;
+        if (forgotten || id > lastSnapshotId_) return Status::NotFound;
+        out.u8(1);
+        out.u8(0);
+        out.str({});
+        out.str({});
+        out.u32(0);
+        return Status::Ok;
+    }
+    const SnapshotResult& r = it->second;
+    out.u8(0);
+    out.u8(r.ok ? 1 : 0);
+    out.str(r.path.substr(r.path.rfind('/') + 1)); // the name the client gave; not the server's dir
+    out.str(r.error);
+    out.u32(static_cast<std::uint32_t>(r.writeMs));
+    return Status::Ok;
+}
+
+} // namespace sb
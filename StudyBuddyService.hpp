@@ -0,0 +1,114 @@
+/***************************************************************************************
+ * StudyBuddyService.hpp
+ * Resident application state for study_buddy_server: roster, SessionRequests and
+ * NotificationCenter, plus decoding of wire requests into calls on the core modules.
+ * The service knows nothing about sockets; EpollServer feeds it frame bodies.
+ *
+ * Threading:
+ *  - Roster readers (Suggest, SearchByName, ...) pin a RosterSnapshot version and never
+ *    block, even while AddProfile/AddAvailability publish new versions.
+ *  - Sessions and notifications are guarded by their own mutex.
+ *  - The secondary indexes (Autocomplete, OccupancyIndex) share one mutex; roster writes
+ *    update them in the same critical section so they agree with the roster.
+ *  - Snapshot forks while holding the sessions lock with a roster version pinned, so the
+ *    child writes one consistent state; requests wait only for the fork itself. Clients
+ *    name the file, the operator picks the directory (setSnapshotDir); outcomes are kept
+ *    by id so any client can ask about its own snapshot.
+ *  - reloadEnrollments() parses and diffs a roster file against a pinned version without
+ *    any lock, then publishes only the changed profiles in one version. Readers never
+ *    wait; sessions and inboxes are keyed by email and are left alone.
+ *
+ * STANDARD LIBRARIES USED:
+ *  <vector>         : response buffers
+ *  <string>         : emails
+ *  <istream>        : enrollment reloads
+ *  <map>            : recent snapshot results by id
+ *  <mutex>          : sessions/notifications lock
+ ****************************************************************************************/
+#pragma once
+#include "Profile.hpp"
+#include "Autocomplete.hpp"
+#include "BackgroundSnapshot.hpp"
+#include "EnrollmentSync.hpp"
+#include "OccupancyIndex.hpp"
+#include "NotificationCenter.hpp"
+#include "SessionRequests.hpp"
+#include "MatchSuggester.hpp"
+#include "Protocol.hpp"
+#include "RosterSnapshot.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <istream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace sb {
+
+class StudyBuddyService {
+public:
+    StudyBuddyService() : sessions_(&notif_) {}
+
+    // True for CPU-heavy ops the server should run on its worker pool.
+    static bool isHeavy(wire::Op op);
+
+    // Decode one request body ([u8 op][u32 tag][fields]) and return a complete response frame.
+    // Safe to call from several threads at once.
+    std::vector<std::uint8_t> handle(const std::uint8_t* body, std::size_t len);
+
+    // Replace the roster with 'count' synthetic classmates (see SyntheticRoster.hpp).
+    void seedSynthetic(std::size_t count, unsigned seed = 2150);
+
+    std::size_t rosterSize() const;
+
+    // Directory Snapshot requests write into. Empty (the default) disables the op.
+    void setSnapshotDir(std::string dir);
+
+    struct ReloadStats {
+        std::size_t changed = 0;   // profiles whose courses were replaced
+        std::size_t unchanged = 0;
+        std::vector<std::string> unknownEmails; // listed but not on the roster (not created)
+        double parseMs = 0, planMs = 0, applyMs = 0; // applyMs: time holding the writer lock
+        bool replanned = false;    // a roster write landed between plan and apply
+    };
+    // Sync course enrollments with an "email,course" CSV (EnrollmentSync format).
+    ReloadStats reloadEnrollments(std::istream& in,
+                                  EnrollmentSync::Unlisted unlisted = EnrollmentSync::Unlisted::Keep);
+
+private:
+    wire::Status addProfile(wire::Reader& in, wire::Writer& out);
+    wire::Status addAvailability(wire::Reader& in, wire::Writer& out);
+    wire::Status suggest(wire::Reader& in, wire::Writer& out);
+    wire::Status searchByName(wire::Reader& in, wire::Writer& out);
+    wire::Status searchByCourse(wire::Reader& in, wire::Writer& out);
+    wire::Status sendRequest(wire::Reader& in, wire::Writer& out);
+    wire::Status confirmRequest(wire::Reader& in, wire::Writer& out);
+    wire::Status pendingFor(wire::Reader& in, wire::Writer& out);
+    wire::Status fetchNotifications(wire::Reader& in, wire::Writer& out);
+    wire::Status complete(wire::Reader& in, wire::Writer& out);
+    wire::Status freeIn(wire::Reader& in, wire::Writer& out);
+    wire::Status nextCommon(wire::Reader& in, wire::Writer& out);
+    wire::Status snapshot(wire::Reader& in, wire::Writer& out);
+    wire::Status snapshotStatus(wire::Reader& in, wire::Writer& out);
+
+    RosterSnapshot roster_;
+
+    std::mutex indexMu_; // guards completions_/occupancy_ (and orders roster writes with them)
+    Autocomplete completions_;
+    OccupancyIndex occupancy_;
+
+    std::mutex stateMu_; // guards notif_ and sessions_
+    NotificationCenter notif_;
+    SessionRequests sessions_;
+    MatchSuggester matcher_;
+
+    BackgroundSnapshots snapshots_{1}; // one child at a time: each holds copy-on-write pages
+    std::mutex snapMu_;                // guards the two below
+    std::string snapshotDir_;
+    std::uint32_t lastSnapshotId_ = 0;
+    std::map<std::uint32_t, SnapshotResult> snapshotResults_; // finished, most recent kMaxSnapshotResults
+};
+
+} // namespace sb
@@ -0,0 +1,122 @@
+/***************************************************************************************
+ * StudyGraph.cpp — implementation
+ ****************************************************************************************/
+#include "StudyGraph.hpp"
+#include "ChangeLog.hpp"
+#include "Metrics.hpp"
+#include "StringPool.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace sb {
+
+StudyGraph::~StudyGraph() {
+    if (log_) log_->unsubscribe(logToken_);
+}
+
+std::uint32_t StudyGraph::idOf(std::string_view key) {
+    if (const std::uint32_t* id = ids_.find(key)) return *id;
+    auto id = static_cast<std::uint32_t>(keys_.size());
+    std::string_view stored = intern(key);
+    ids_.tryEmplace(stored, id);
+    keys_.push_back(stored);
+    weights_.addRow();
+    return id;
+}
+
+void StudyGraph::addSessions(std::string_view a, std::string_view b, std::int32_t by) {
+    if (a == b || by == 0) return;
+    std::uint32_t x = idOf(a), y = idOf(b);
+    if (by < 0) by = std::max(by, -static_cast<std::int32_t>(weights_.get(x, y)));
+    if (by == 0) return;
+    weights_.add(x, y, by);
+    weights_.add(y, x, by);
+}
+
+void StudyGraph::watch(ChangeLog& log) {
+    if (log_) log_->unsubscribe(logToken_);
+    log_ = &log;
+    logToken_ = log.subscribe([this](const ChangeEvent& e) {
+        if (e.kind == ChangeEvent::Kind::SessionConfirmed) {
+            addSessions(e.session.requester, e.session.invitee, +1);
+        } else if (e.kind == ChangeEvent::Kind::SessionCancelled &&
+                   e.session.status == StudySession::Status::Confirmed) {
+            addSessions(e.session.requester, e.session.invitee, -1);
+        }
+    });
+}
+
+std::uint32_t StudyGraph::sessionsBetween(std::string_view a, std::string_view b) const {
+    const std::uint32_t* x = find(a);
+    const std::uint32_t* y = find(b);
+    if (!x || !y || *x == *y) return 0;
+    return weights_.get(*x, *y);
+}
+
+std::vector<StudyGraph::Partner> StudyGraph::partnersOf(std::string_view student) const {
+    std::vector<Partner> out;
+    const std::uint32_t* id = find(student);
+    if (!id) return out;
+    out.reserve(weights_.rowSizeBound(*id));
+    weights_.forEach(*id, [&](std::uint32_t m, std::uint32_t w) { out.push_back(Partner{keys_[m], w}); });
+    std::sort(out.begin(), out.end(), [](const Partner& a, const Partner& b) {
+        if (a.sessions != b.sessions) return a.sessions > b.sessions;
+        return a.student < b.student;
+    });
+    return out;
+}
+
+std::vector<StudyGraph::Suggestion> StudyGraph::suggest(std::string_view student, std::size_t n) const {
+    ApiTimer timer(Api::StudyPartnersOfPartners);
+    std::vector<Suggestion> out;
+    const std::uint32_t* id = find(student);
+    if (!id || n == 0) return out;
+    const std::uint32_t u = *id;
+
+    // Every (v, w(u,m) * w(m,v)) reached through a partner m; rows hold each v once, so
+    // after sorting by v the run length is the number of shared partners.
+    std::vector<std::pair<std::uint32_t, std::uint64_t>> reached;
+    std::size_t bound = 0;
+    weights_.forEach(u, [&](std::uint32_t m, std::uint32_t) { bound += weights_.rowSizeBound(m); });
+    reached.reserve(bound);
+    weights_.forEach(u, [&](std::uint32_t m, std::uint32_t w1) {
+        weights_.forEach(m, [&](std::uint32_t v, std::uint32_t w2) {
+            if (v != u) reached.emplace_back(v, static_cast<std::uint64_t>(w1) * w2);
+        });
+    });
+    std::sort(reached.begin(), reached.end(),
+              [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    for (std::size_t i = 0; i < reached.size();) {
+        std::uint32_t v = reached[i].first;
+        Suggestion s{keys_[v], 0, 0};
+        for (; i < reached.size() && reached[i].first == v; ++i) {
+            s.score += reached[i].second;
+            ++s.via;
+        }
+        if (weights_.get(u, v) == 0) out.push_back(s); // direct partners are not news
+    }
+    auto better = [](const Suggestion& a, const Suggestion& b) {
+        if (a.score != b.score) return a.score > b.score;
+        if (a.via != b.via) return a.via > b.via;
+        return a.student < b.student;
+    };
+    std::size_t k = std::min(n, out.size());
+    std::partial_sort(out.begin(), out.begin() + static_cast<std::ptrdiff_t>(k), out.end(), better);
+    out.resize(k);
+    return out;
+}
+
+std::uint64_t StudyGraph::mutualScore(std::string_view a, std::string_view b) const {
+    const std::uint32_t* x = find(a);
+    const std::uint32_t* y = find(b);
+    if (!x || !y || *x == *y) return 0;
+    std::uint64_t score = 0;
+    weights_.forEach(*x, [&](std::uint32_t m, std::uint32_t w1) {
+        if (m != *y) score += static_cast<std::uint64_t>(w1) * weights_.get(m, *y);
+    });
+    return score;
+}
+
+} // namespace sb
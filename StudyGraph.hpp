@@ -0,0 +1,89 @@
+/***************************************************************************************
+ * StudyGraph.hpp
+ * Who studies with whom: a weighted student graph built from confirmed study sessions.
+ *
+ * Edge weight (a, b) is the number of confirmed sessions between a and b. watch(log)
+ * follows a ChangeLog: SessionConfirmed adds one, SessionCancelled takes it back, so the
+ * graph keeps counting after SessionRequests has dropped a cancelled record, and never
+ * counts plans that were called off. Students are keyed like SessionRequests keys them
+ * (email, or name when the email is blank).
+ *
+ * Storage is SparseCounts: CSR rows with a per-row delta buffer that is periodically
+ * folded back into the CSR, so a session costs two small sorted inserts.
+ *
+ * suggest(u, n) is the 2-hop query "classmates your study partners study with": every v
+ * reached through a partner m scores w(u,m) * w(m,v), summed over m; u and u's direct
+ * partners are left out. It visits only u's row and its partners' rows and sorts what it
+ * reached, so it costs microseconds for realistic degrees. mutualScore(a, b) is the same
+ * score for one pair; MatchSuggester uses it to rank suggestions (useStudyGraph).
+ *
+ * Const members are safe to call concurrently; addSessions() (and events from the
+ * watched log) are not.
+ *
+ * STANDARD LIBRARIES USED:
+ *  <cstdint>     : ids and weights
+ *  <string_view> : interned student keys
+ *  <vector>      : results, key table
+ ****************************************************************************************/
+#pragma once
+#include "FlatMap.hpp"
+#include "SparseCounts.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace sb {
+
+class ChangeLog;
+
+class StudyGraph {
+public:
+    struct Partner {
+        std::string_view student; // email (or name)
+        std::uint32_t sessions;   // confirmed sessions together
+    };
+    struct Suggestion {
+        std::string_view student;
+        std::uint64_t score;       // sum over shared partners m of w(self, m) * w(m, student)
+        std::uint32_t via;         // number of shared partners
+    };
+
+    StudyGraph() = default;
+    ~StudyGraph();
+    StudyGraph(const StudyGraph&) = delete;
+    StudyGraph& operator=(const StudyGraph&) = delete;
+
+    // Record 'by' more (or, if negative, fewer) confirmed sessions between a and b.
+    // Weights never go below zero; a == b is ignored.
+    void addSessions(std::string_view a, std::string_view b, std::int32_t by = 1);
+
+    // Follow SessionConfirmed / SessionCancelled events of 'log'. One log at a time; the
+    // graph must not outlive it.
+    void watch(ChangeLog& log);
+
+    std::uint32_t sessionsBetween(std::string_view a, std::string_view b) const;
+    // Direct partners by sessions DESC, then key ASC.
+    std::vector<Partner> partnersOf(std::string_view student) const;
+    // Up to 'n' 2-hop suggestions by score DESC, via DESC, then key ASC.
+    std::vector<Suggestion> suggest(std::string_view student, std::size_t n) const;
+    // 2-hop score between a and b (0 if either is unknown or a == b).
+    std::uint64_t mutualScore(std::string_view a, std::string_view b) const;
+
+    std::size_t studentCount() const { return keys_.size(); }
+    std::size_t edgeCount() const { return weights_.nonZeros() / 2; } // upper bound while deltas are pending
+
+private:
+    const std::uint32_t* find(std::string_view key) const { return ids_.find(key); }
+    std::uint32_t idOf(std::string_view key); // creates on first use
+
+    FlatMap<std::string_view, std::uint32_t, StrHash> ids_; // interned keys
+    std::vector<std::string_view> keys_;                    // by id
+    SparseCounts weights_;                                  // symmetric
+
+    ChangeLog* log_ = nullptr;
+    std::size_t logToken_ = 0;
+};
+
+} // namespace sb
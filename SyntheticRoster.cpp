@@ -0,0 +1,72 @@
+/***************************************************************************************
+ * SyntheticRoster.cpp — implementation
+ ****************************************************************************************/
+#include "SyntheticRoster.hpp"
+#include "AvailabilityManager.hpp"
+#include "ThreadPool.hpp"
+
+#include <random>
+
+namespace sb {
+
+const std::vector<std::string>& syntheticCourseCatalog() {
+    static const std::vector<std::string> catalog = [] {
+        std::vector<std::string> c;
+        const char* subjects[] = {"CPSC", "MATH", "ENGL", "PHYS", "CHEM", "ECE", "BIOL", "HIST"};
+        const int numbers[]    = {1010, 1020, 1060, 1080, 2120, 2150, 2310, 3220};
+        for (const char* s : subjects)
+            for (int n : numbers)
+                c.push_back(std::string(s) + " " + std::to_string(n));
+        return c;
+    }();
+    return catalog;
+}
+
+std::vector<Profile> makeSyntheticRoster(std::size_t count, unsigned seed, std::size_t sections) {
+    const auto& catalog = syntheticCourseCatalog();
+
+    // Each profile draws from its own generator seeded by (seed, index), so the roster is
+    // identical whether it is built sequentially or in parallel chunks.
+    auto makeOne = [&](std::size_t i) {
+        std::mt19937 rng(seed * 1000003u + static_cast<unsigned>(i));
+        std::uniform_int_distribution<std::size_t> pickCourse(0, catalog.size() - 1);
+        std::uniform_int_distribution<int> numCourses(2, 5);
+        std::uniform_int_distribution<int> numSlots(2, 6);
+        std::uniform_int_distribution<int> pickDay(0, 4);            // weekdays only
+        std::uniform_int_distribution<int> pickStartHalfHour(16, 38); // 08:00 .. 19:00
+        std::uniform_int_distribution<int> pickLenHalfHours(1, 6);
+
+        std::vector<std::string> courses;
+        int nc = numCourses(rng);
+        while (static_cast<int>(courses.size()) < nc) {
+            const std::string& c = catalog[pickCourse(rng)];
+            bool dup = false;
+            for (const auto& have : courses) if (have == c) { dup = true; break; }
+            if (!dup) courses.push_back(c);
+        }
+
+        Profile p;
+        p.createOrReset("Student " + std::to_string(i),
+                        "user" + std::to_string(i) + "@clemson.edu", courses);
+        // Section timetables come from their own generator so every member gets the same slots.
+        std::mt19937 sectionRng(seed * 7919u + static_cast<unsigned>(sections ? i % sections : 0));
+        std::mt19937& slotRng = sections ? sectionRng : rng;
+        int ns = numSlots(slotRng);
+        std::vector<AvailabilityEdit> edits;
+        for (int k = 0; k < ns; ++k) {
+            int start = pickStartHalfHour(slotRng) * 30;
+            int end   = start + pickLenHalfHours(slotRng) * 30;
+            edits.push_back({AvailabilityEdit::Kind::Add, {static_cast<Day>(pickDay(slotRng)), start, end}});
+        }
+        AvailabilityManager::applyBatch(p, edits);
+        return p;
+    };
+
+    return parallelCollectAbove<Profile>(count,
+        [&](std::size_t lo, std::size_t hi, std::vector<Profile>& out) {
+            out.reserve(out.size() + (hi - lo));
+            for (std::size_t i = lo; i < hi; ++i) out.push_back(makeOne(i));
+        });
+}
+
+} // namespace sb
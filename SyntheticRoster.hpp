@@ -0,0 +1,28 @@
+/***************************************************************************************
+ * SyntheticRoster.hpp
+ * Deterministic synthetic classmates for load tests and benchmarks.
+ *
+ * STANDARD LIBRARIES USED:
+ *  <vector>   : generated roster
+ *  <string>   : course codes
+ *  <cstddef>  : size_t
+ ****************************************************************************************/
+#pragma once
+#include "Profile.hpp"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace sb {
+
+// Course codes drawn from by makeSyntheticRoster ("CPSC 1010", "MATH 1080", ...).
+const std::vector<std::string>& syntheticCourseCatalog();
+
+// Build 'count' profiles named "Student <i>" with emails "user<i>@clemson.edu".
+// Each gets 2-5 catalog courses and 2-6 merged weekly slots. Same seed → same roster.
+// With sections > 0, student i takes the availability of timetable (i % sections), as
+// students of one section do; otherwise every student's slots are drawn independently.
+std::vector<Profile> makeSyntheticRoster(std::size_t count, unsigned seed = 2150,
+                                         std::size_t sections = 0);
+
+} // namespace sb
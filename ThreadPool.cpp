@@ -0,0 +1,110 @@
+/***************************************************************************************
+ * ThreadPool.cpp — implementation
+ ****************************************************************************************/
+#include "ThreadPool.hpp"
+
+namespace sb {
+
+static std::atomic<std::size_t> gParallelThreshold{2048};
+
+std::size_t parallelThreshold() { return gParallelThreshold.load(std::memory_order_relaxed); }
+void setParallelThreshold(std::size_t items) { gParallelThreshold.store(items, std::memory_order_relaxed); }
+
+// Identifies the pool (and queue) a worker thread belongs to.
+static thread_local const ThreadPool* tlsPool = nullptr;
+static thread_local std::size_t tlsIndex = 0;
+
+ThreadPool::ThreadPool(std::size_t threads) {
+    if (threads == 0) threads = std::thread::hardware_concurrency();
+    if (threads == 0) threads = 1;
+    workers_.reserve(threads);
+    for (std::size_t i = 0; i < threads; ++i) workers_.push_back(std::make_unique<Worker>());
+    threads_.reserve(threads);
+    for (std::size_t i = 0; i < threads; ++i) threads_.emplace_back([this, i]{ workerLoop(i); });
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lk(sleepMu_);
+        stopping_ = true;
+    }
+    sleepCv_.notify_all();
+    for (auto& t : threads_) t.join();
+}
+
+static std::atomic<ThreadPool*> gSharedOverride{nullptr};
+
+ThreadPool& ThreadPool::shared() {
+    if (ThreadPool* p = gSharedOverride.load(std::memory_order_acquire)) return *p;
+    static ThreadPool pool;
+    return pool;
+}
+
+void ThreadPool::useAsShared(ThreadPool* pool) {
+    gSharedOverride.store(pool, std::memory_order_release);
+}
+
+std::size_t ThreadPool::homeQueue() {
+    if (tlsPool == this) return tlsIndex;
+    return nextQueue_.fetch_add(1, std::memory_order_relaxed) % workers_.size();
+}
+
+std::size_t ThreadPool::chunkSize(std::size_t n, std::size_t grain) const {
+    if (grain > 0) return grain;
+    std::size_t target = size() * 4;
+    std::size_t c = (n + target - 1) / target;
+    return c == 0 ? 1 : c;
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+    Worker& w = *workers_[homeQueue()];
+    {
+        std::lock_guard<std::mutex> lk(w.mu);
+        w.tasks.push_back(std::move(task));
+    }
+    {
+        std::lock_guard<std::mutex> lk(sleepMu_);
+        pending_.fetch_add(1, std::memory_order_release);
+    }
+    sleepCv_.notify_one();
+}
+
+bool ThreadPool::tryRunOne(std::size_t home) {
+    std::function<void()> task;
+    const std::size_t n = workers_.size();
+    {
+        // Own queue: newest first.
+        Worker& w = *workers_[home];
+        std::lock_guard<std::mutex> lk(w.mu);
+        if (!w.tasks.empty()) {
+            task = std::move(w.tasks.back());
+            w.tasks.pop_back();
+        }
+    }
+    for (std::size_t k = 1; !task && k < n; ++k) {
+        // Steal the oldest task from a victim.
+        Worker& v = *workers_[(home + k) % n];
+        std::lock_guard<std::mutex> lk(v.mu);
+        if (!v.tasks.empty()) {
+            task = std::move(v.tasks.front());
+            v.tasks.pop_front();
+        }
+    }
+    if (!task) return false;
+    pending_.fetch_sub(1, std::memory_order_acq_rel);
+    task();
+    return true;
+}
+
+void ThreadPool::workerLoop(std::size_t index) {
+    tlsPool = this;
+    tlsIndex = index;
+    while (true) {
+        if (tryRunOne(index)) continue;
+        std::unique_lock<std::mutex> lk(sleepMu_);
+        sleepCv_.wait(lk, [this]{ return stopping_ || pending_.load(std::memory_order_acquire) > 0; });
+        if (stopping_ && pending_.load(std::memory_order_acquire) == 0) return;
+    }
+}
+
+} // namespace sb
@@ -0,0 +1,196 @@
+/***************************************************************************************
+ * ThreadPool.hpp
+ * Shared work-stealing thread pool with parallel_for / parallel_reduce.
+ *
+ * Each worker owns a deque: it pushes and pops its own tasks at the back (LIFO, cache-warm)
+ * while idle workers steal from the front of other deques. Tasks submitted from outside
+ * the pool are spread round-robin. A thread waiting in parallel_for keeps running queued
+ * tasks instead of blocking, so nested parallel calls cannot deadlock.
+ *
+ * Determinism: parallel_reduce combines chunk results strictly left-to-right in index
+ * order, so callers that concatenate get exactly the sequential order.
+ *
+ * STANDARD LIBRARIES USED:
+ *  <atomic>             : pending-task count, completion counters
+ *  <condition_variable> : idle worker sleep/wake
+ *  <deque>              : per-worker task queues
+ *  <exception>          : propagating the first task exception to the caller
+ *  <functional>         : type-erased tasks
+ *  <mutex>              : per-queue guards
+ *  <thread>             : workers
+ *  <vector>             : workers, reduce partials
+ ****************************************************************************************/
+#pragma once
+#include "AllocStats.hpp"
+#include "Trace.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace sb {
+
+// Inputs with fewer items than this run sequentially on the calling thread.
+// Used by MatchSuggester, AvailabilityBrowser, ClassmateSearch and roster import.
+std::size_t parallelThreshold();
+void setParallelThreshold(std::size_t items);
+
+class ThreadPool {
+public:
+    // threads == 0 → std::thread::hardware_concurrency() (at least 1).
+    explicit ThreadPool(std::size_t threads = 0);
+    ~ThreadPool(); // runs every queued task, then joins
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    std::size_t size() const { return workers_.size(); }
+
+    // Fire-and-forget task.
+    void submit(std::function<void()> task);
+
+    // Call body(lo, hi) over disjoint chunks covering [begin, end). grain == 0 picks a chunk
+    // size giving ~4 chunks per worker. Blocks until all chunks ran; rethrows the first
+    // exception thrown by body.
+    template <class Body>
+    void parallel_for(std::size_t begin, std::size_t end, std::size_t grain, Body&& body);
+
+    // Map each chunk with map(lo, hi) -> T, then fold partials left-to-right with
+    // combine(T acc, T next) -> T starting from 'identity'.
+    template <class T, class Map, class Combine>
+    T parallel_reduce(std::size_t begin, std::size_t end, std::size_t grain,
+                      T identity, Map&& map, Combine&& combine);
+
+    // Process-wide pool used by the core modules (hardware_concurrency threads).
+    static ThreadPool& shared();
+
+    // Route shared() to 'pool' (e.g. benchmarks sweeping thread counts); nullptr restores
+    // the default. The caller keeps 'pool' alive until it is unset.
+    static void useAsShared(ThreadPool* pool);
+
+private:
+    struct Worker {
+        std::mutex mu;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    void workerLoop(std::size_t index);
+    bool tryRunOne(std::size_t home); // own queue first, then steal
+    std::size_t homeQueue();          // calling worker's own queue, else round-robin
+    std::size_t chunkSize(std::size_t n, std::size_t grain) const;
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::vector<std::thread> threads_;
+    std::atomic<std::size_t> pending_{0};
+    std::atomic<std::size_t> nextQueue_{0};
+    std::mutex sleepMu_;
+    std::condition_variable sleepCv_;
+    bool stopping_ = false;
+};
+
+/* ------------------------------ template members ------------------------------ */
+
+template <class Body>
+void ThreadPool::parallel_for(std::size_t begin, std::size_t end, std::size_t grain, Body&& body) {
+    if (end <= begin) return;
+    const std::size_t n = end - begin;
+    const std::size_t chunk = chunkSize(n, grain);
+    const std::size_t chunks = (n + chunk - 1) / chunk;
+    if (chunks == 1 || size() <= 1) { body(begin, end); return; }
+
+    struct Join {
+        std::atomic<std::size_t> remaining;
+        std::mutex errMu;
+        std::exception_ptr err;
+    };
+    auto join = std::make_shared<Join>();
+    join->remaining.store(chunks - 1, std::memory_order_relaxed);
+
+    auto runChunk = [&body, join, begin, end, chunk](std::size_t c) {
+        std::size_t lo = begin + c * chunk;
+        std::size_t hi = lo + chunk < end ? lo + chunk : end;
+        try {
+            body(lo, hi);
+        } catch (...) {
+            std::lock_guard<std::mutex> lk(join->errMu);
+            if (!join->err) join->err = std::current_exception();
+        }
+    };
+    for (std::size_t c = 1; c < chunks; ++c) {
+        submit([runChunk, join, c] {
+            runChunk(c);
+            join->remaining.fetch_sub(1, std::memory_order_acq_rel);
+        });
+    }
+    runChunk(0);
+
+    // Help with queued work until our chunks are done.
+    std::size_t home = homeQueue();
+    while (join->remaining.load(std::memory_order_acquire) != 0) {
+        if (!tryRunOne(home)) std::this_thread::yield();
+    }
+    if (join->err) std::rethrow_exception(join->err);
+}
+
+template <class T, class Map, class Combine>
+T ThreadPool::parallel_reduce(std::size_t begin, std::size_t end, std::size_t grain,
+                              T identity, Map&& map, Combine&& combine) {
+    if (end <= begin) return identity;
+    const std::size_t n = end - begin;
+    const std::size_t chunk = chunkSize(n, grain);
+    const std::size_t chunks = (n + chunk - 1) / chunk;
+
+    std::vector<T> partial(chunks);
+    parallel_for(0, chunks, 1, [&](std::size_t lo, std::size_t hi) {
+        for (std::size_t c = lo; c < hi; ++c) {
+            std::size_t a = begin + c * chunk;
+            std::size_t b = a + chunk < end ? a + chunk : end;
+            partial[c] = map(a, b);
+        }
+    });
+    T acc = std::move(identity);
+    for (auto& p : partial) acc = combine(std::move(acc), std::move(p));
+    return acc;
+}
+
+// Run body(lo, hi) on the shared pool when n >= parallelThreshold(), inline otherwise.
+template <class Body>
+void parallelForAbove(std::size_t n, Body&& body) {
+    if (n < parallelThreshold()) { if (n) body(std::size_t{0}, n); return; }
+    ThreadPool::shared().parallel_for(0, n, 0, std::forward<Body>(body));
+}
+
+// Chunked filter over [0, n): collect(lo, hi, out) appends matches for its chunk to 'out'.
+// Output order equals the sequential order regardless of thread count.
+template <class T, class Collect>
+std::vector<T> parallelCollectAbove(std::size_t n, Collect&& collect) {
+    std::vector<T> out;
+    if (n < parallelThreshold()) { collect(std::size_t{0}, n, out); return out; }
+    AllocScope::Counter* scope = AllocScope::current(); // charge chunks to the caller's op
+    Tracer::Context trace = Tracer::capture();          // and keep its trace sampling
+    return ThreadPool::shared().parallel_reduce(
+        0, n, 0, std::move(out),
+        [&](std::size_t lo, std::size_t hi) {
+            AllocScope::Attach attach(scope);
+            Tracer::Adopt adopt(trace);
+            std::vector<T> part;
+            collect(lo, hi, part);
+            return part;
+        },
+        [](std::vector<T> acc, std::vector<T> next) {
+            if (acc.empty()) return next;
+            acc.insert(acc.end(), std::make_move_iterator(next.begin()),
+                       std::make_move_iterator(next.end()));
+            return acc;
+        });
+}
+
+} // namespace sb
@@ -0,0 +1,205 @@
+/***************************************************************************************
+ * Trace.cpp — implementation
+ ****************************************************************************************/
+#include "Trace.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace sb {
+
+std::atomic<bool> Tracer::enabled_{false};
+
+namespace {
+
+struct Event {
+    const char* name;
+    const char* category;
+    std::uint64_t startNs;
+    std::uint64_t durNs;
+    int nargs;
+    const char* argKeys[Tracer::kMaxArgs];
+    std::int64_t argValues[Tracer::kMaxArgs];
+};
+
+struct Buffer {
+    explicit Buffer(std::uint32_t tid) : tid(tid), ring(Tracer::kRingCapacity) {}
+    std::uint32_t tid;
+    std::mutex mu;
+    std::vector<Event> ring;
+    std::uint64_t written = 0; // total events ever written (ring index = written % size)
+};
+
+std::atomic<std::uint32_t> gSampleEvery{1};
+
+std::mutex gRegistryMu;
+std::vector<std::shared_ptr<Buffer>>& registry() {
+    static auto* r = new std::vector<std::shared_ptr<Buffer>>(); // outlives thread exits
+    return *r;
+}
+
+thread_local Buffer* tlsBuffer = nullptr;
+thread_local int tlsDepth = 0;
+thread_local bool tlsSampled = false;
+thread_local std::uint32_t tlsRoots = 0;
+
+Buffer& threadBuffer() {
+    if (!tlsBuffer) {
+        std::lock_guard<std::mutex> lk(gRegistryMu);
+        auto& r = registry();
+        r.push_back(std::make_shared<Buffer>(static_cast<std::uint32_t>(r.size() + 1)));
+        tlsBuffer = r.back().get();
+    }
+    return *tlsBuffer;
+}
+
+const std::chrono::steady_clock::time_point gEpoch = std::chrono::steady_clock::now();
+
+void writeJsonString(std::ostream& os, const char* s) {
+    os << '"';
+    for (; *s; ++s) {
+        if (*s == '"' || *s == '\\') os << '\\';
+        os << *s;
+    }
+    os << '"';
+}
+
+} // namespace
+
+std::uint64_t traceNowNs() {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - gEpoch).count());
+}
+
+/* ---------------- Tracer ---------------- */
+
+void Tracer::setSampleEvery(std::uint32_t n) { gSampleEvery.store(n ? n : 1, std::memory_order_relaxed); }
+std::uint32_t Tracer::sampleEvery() { return gSampleEvery.load(std::memory_order_relaxed); }
+
+Tracer::Stats Tracer::stats() {
+    std::lock_guard<std::mutex> lk(gRegistryMu);
+    Stats st;
+    for (const auto& b : registry()) {
+        std::lock_guard<std::mutex> bl(b->mu);
+        if (b->written == 0) continue;
+        ++st.threads;
+        st.events += std::min<std::uint64_t>(b->written, b->ring.size());
+        if (b->written > b->ring.size()) st.dropped += b->written - b->ring.size();
+    }
+    return st;
+}
+
+void Tracer::clear() {
+    std::lock_guard<std::mutex> lk(gRegistryMu);
+    for (const auto& b : registry()) {
+        std::lock_guard<std::mutex> bl(b->mu);
+        b->written = 0;
+    }
+}
+
+void Tracer::writeChromeJson(std::ostream& os) {
+    struct Row { std::uint32_t tid; Event e; };
+    std::vector<Row> rows;
+    {
+        std::lock_guard<std::mutex> lk(gRegistryMu);
+        for (const auto& b : registry()) {
+            std::lock_guard<std::mutex> bl(b->mu);
+            std::uint64_t n = std::min<std::uint64_t>(b->written, b->ring.size());
+            for (std::uint64_t i = b->written - n; i < b->written; ++i) {
+                rows.push_back(Row{b->tid, b->ring[i % b->ring.size()]});
+            }
+        }
+    }
+    std::sort(rows.begin(), rows.end(), [](const Row& a, const Row& b) {
+        if (a.e.startNs != b.e.startNs) return a.e.startNs < b.e.startNs;
+        return a.e.durNs > b.e.durNs; // parents before children that start together
+    });
+
+    std::ios::fmtflags flags = os.flags();
+    os << std::fixed << std::setprecision(3);
+    os << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    for (std::size_t i = 0; i < rows.size(); ++i) {
+        const Event& e = rows[i].e;
+        if (i) os << ",";
+        os << "\n{\"name\":";
+        writeJsonString(os, e.name);
+        os << ",\"cat\":";
+        writeJsonString(os, e.category);
+        os << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << rows[i].tid
+           << ",\"ts\":" << static_cast<double>(e.startNs) / 1000.0
+           << ",\"dur\":" << static_cast<double>(e.durNs) / 1000.0;
+        if (e.nargs) {
+            os << ",\"args\":{";
+            for (int a = 0; a < e.nargs; ++a) {
+                if (a) os << ",";
+                writeJsonString(os, e.argKeys[a]);
+                os << ":" << e.argValues[a];
+            }
+            os << "}";
+        }
+        os << "}";
+    }
+    os << "\n]}\n";
+    os.flags(flags);
+}
+
+bool Tracer::flushToFile(const std::string& path, std::string& err) {
+    std::ofstream out(path, std::ios::trunc);
+    if (!out) { err = "cannot open " + path; return false; }
+    writeChromeJson(out);
+    if (!out.flush()) { err = "write failed: " + path; return false; }
+    err.clear();
+    return true;
+}
+
+Tracer::Context Tracer::capture() { return Context{tlsDepth > 0, tlsSampled}; }
+
+Tracer::Adopt::Adopt(const Context& ctx) : savedDepth_(tlsDepth), savedSampled_(tlsSampled) {
+    if (!ctx.inSpan) return;
+    tlsDepth = savedDepth_ + 1; // spans opened here are nested, not new roots
+    tlsSampled = ctx.sampled;
+}
+
+Tracer::Adopt::~Adopt() {
+    tlsDepth = savedDepth_;
+    tlsSampled = savedSampled_;
+}
+
+/* ---------------- TraceSpan ---------------- */
+
+void TraceSpan::begin(const char* name, const char* category) {
+    if (tlsDepth == 0) tlsSampled = (++tlsRoots % Tracer::sampleEvery()) == 0;
+    ++tlsDepth;
+    entered_ = true;
+    active_ = tlsSampled;
+    if (!active_) return;
+    name_ = name;
+    category_ = category;
+    startNs_ = traceNowNs();
+}
+
+void TraceSpan::end() {
+    --tlsDepth;
+    if (!active_) return;
+    std::uint64_t endNs = traceNowNs();
+    Buffer& b = threadBuffer();
+    std::lock_guard<std::mutex> lk(b.mu);
+    Event& e = b.ring[b.written++ % b.ring.size()];
+    e.name = name_;
+    e.category = category_;
+    e.startNs = startNs_;
+    e.durNs = endNs - startNs_;
+    e.nargs = nargs_;
+    for (int i = 0; i < nargs_; ++i) {
+        e.argKeys[i] = argKeys_[i];
+        e.argValues[i] = argValues_[i];
+    }
+}
+
+} // namespace sb
@@ -0,0 +1,121 @@
+/***************************************************************************************
+ * Trace.hpp
+ * Scoped trace spans recorded into per-thread ring buffers, flushed as Chrome
+ * trace-event JSON (load the file in chrome://tracing or Perfetto).
+ *
+ *     TraceSpan span("suggest.score", "match");
+ *     span.arg("candidates", n);      // up to kMaxArgs integer args, shown in the viewer
+ *
+ * Off by default. While off, a span's constructor is one relaxed load and a branch, and
+ * nothing else happens. When on, sampling is decided per top-level span (1 in
+ * sampleEvery); nested spans follow their root, and parallelCollectAbove carries the
+ * decision onto pool workers so a sampled operation is traced across threads.
+ *
+ * Each thread writes complete events into its own fixed-size ring (kRingCapacity
+ * events, oldest overwritten), guarded by a mutex that only the flusher contends for.
+ * Buffers outlive their threads, so a flush after joining workers still sees their events.
+ *
+ * STANDARD LIBRARIES USED:
+ *  <atomic>  : enabled flag, sampling rate
+ *  <cstdint> : timestamps, args
+ *  <ostream> : Chrome JSON writer
+ *  <string>  : file paths, errors
+ ****************************************************************************************/
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace sb {
+
+class Tracer {
+public:
+    static constexpr std::size_t kRingCapacity = 1u << 14; // events per thread
+    static constexpr int kMaxArgs = 4;
+
+    struct Stats {
+        std::size_t threads = 0;  // threads that recorded at least one span
+        std::size_t events = 0;   // events currently buffered
+        std::size_t dropped = 0;  // events overwritten by ring wrap-around
+    };
+
+    static void enable(bool on) { enabled_.store(on, std::memory_order_relaxed); }
+    static bool enabled() { return enabled_.load(std::memory_order_relaxed); }
+
+    // Trace one in every 'n' top-level spans (n <= 1: all of them).
+    static void setSampleEvery(std::uint32_t n);
+    static std::uint32_t sampleEvery();
+
+    static Stats stats();
+    static void clear();
+
+    // {"traceEvents":[...]} with "X" (complete) events sorted by start time.
+    static void writeChromeJson(std::ostream& os);
+    static bool flushToFile(const std::string& path, std::string& err);
+
+    // Sampling state of the calling thread, for handing work to another thread.
+    struct Context {
+        bool inSpan = false;
+        bool sampled = false;
+    };
+    static Context capture();
+
+    // Run the current thread as if inside the captured span until destroyed.
+    class Adopt {
+    public:
+        explicit Adopt(const Context& ctx);
+        ~Adopt();
+        Adopt(const Adopt&) = delete;
+        Adopt& operator=(const Adopt&) = delete;
+    private:
+        int savedDepth_;
+        bool savedSampled_;
+    };
+
+private:
+    static std::atomic<bool> enabled_;
+};
+
+class TraceSpan {
+public:
+    // 'name' and 'category' must be string literals (only the pointers are stored).
+    explicit TraceSpan(const char* name, const char* category = "sb") {
+        if (Tracer::enabled()) begin(name, category);
+    }
+    ~TraceSpan() {
+        if (entered_) end();
+    }
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+    // True when this span will be recorded (tracing on and sampled).
+    bool active() const { return active_; }
+
+    // Attach an integer argument ('key' must be a string literal); ignored when inactive.
+    void arg(const char* key, std::int64_t value) {
+        if (active_ && nargs_ < Tracer::kMaxArgs) {
+            argKeys_[nargs_] = key;
+            argValues_[nargs_++] = value;
+        }
+    }
+
+private:
+    void begin(const char* name, const char* category);
+    void end();
+
+    bool entered_ = false;
+    bool active_ = false;
+    int nargs_ = 0;
+    const char* name_ = nullptr;
+    const char* category_ = nullptr;
+    std::uint64_t startNs_ = 0;
+    const char* argKeys_[Tracer::kMaxArgs];
+    std::int64_t argValues_[Tracer::kMaxArgs];
+};
+
+// Nanoseconds on the trace clock (steady, relative to process start).
+std::uint64_t traceNowNs();
+
+} // namespace sb
@@ -19,6 +19,13 @@ std::string trim(std::string s) {
     return s;
 }
 
+std::string_view trimView(std::string_view s) {
+    auto isSpace = [](unsigned char ch){ return std::isspace(ch) != 0; };
+    while (!s.empty() && isSpace(s.front())) s.remove_prefix(1);
+    while (!s.empty() && isSpace(s.back())) s.remove_suffix(1);
+    return s;
+}
+
 std::string upperCopy(std::string s) {
     std::transform(s.begin(), s.end(), s.begin(),
                    [](unsigned char c){ return std::toupper(c); });
@@ -4,6 +4,7 @@
  *
  * STANDARD LIBRARIES USED:
  *  <string>     : std::string for textual data.
+ *  <string_view>: non-owning trims.
  *  <vector>     : std::vector for token lists.
  *  <sstream>    : std::stringstream for tokenization.
  *  <algorithm>  : std::find_if, std::transform for trimming & case conversion.
@@ -12,6 +13,7 @@
  ****************************************************************************************/
 #pragma once
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace sb {
@@ -19,6 +21,9 @@ namespace sb {
 // Trim whitespace from both ends.
 std::string trim(std::string s);
 
+// Same as trim(), but returns a view into 's' instead of a copy.
+std::string_view trimView(std::string_view s);
+
 // Uppercase copy (useful for course codes like "CPSC 2150").
 std::string upperCopy(std::string s);
 
@@ -0,0 +1,92 @@
+/***************************************************************************************
+ * WeeklySlots.cpp — implementation
+ ****************************************************************************************/
+#include "WeeklySlots.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+namespace sb {
+
+WeeklySlots::WeeklySlots(const std::vector<AvailabilitySlot>& slots) {
+    for (const auto& s : slots) {
+        if (!validDay(s.day) || s.start >= s.end) continue;
+        auto& day = days_[static_cast<std::size_t>(s.day)];
+        // Ordered, separated input appends at the end in O(1); anything else takes add().
+        if (day.empty() || std::prev(day.end())->second < s.start) day.emplace_hint(day.end(), s.start, s.end);
+        else add(s);
+    }
+}
+
+bool WeeklySlots::add(const AvailabilitySlot& s) {
+    if (!validDay(s.day) || s.start >= s.end) return false;
+    auto& day = days_[static_cast<std::size_t>(s.day)];
+    int start = s.start, end = s.end;
+
+    auto it = day.upper_bound(start);
+    if (it != day.begin()) {
+        auto before = std::prev(it);
+        if (before->second >= start) {          // overlaps or touches the run before
+            if (before->second >= end) return false;
+            start = before->first;
+            it = before;
+        }
+    }
+    while (it != day.end() && it->first <= end) { // absorb runs starting inside (or at the end)
+        end = std::max(end, it->second);
+        it = day.erase(it);
+    }
+    day.emplace_hint(it, start, end);
+    return true;
+}
+
+bool WeeklySlots::remove(Day d, int start, int end) {
+    if (!validDay(d) || start >= end) return false;
+    auto& day = days_[static_cast<std::size_t>(d)];
+
+    auto it = day.upper_bound(start);
+    if (it != day.begin() && std::prev(it)->second > start) --it;
+    bool changed = false;
+    while (it != day.end() && it->first < end) {
+        int runStart = it->first, runEnd = it->second;
+        it = day.erase(it);
+        changed = true;
+        if (runStart < start) day.emplace_hint(it, runStart, start);
+        if (runEnd > end) day.emplace_hint(it, end, runEnd);
+    }
+    return changed;
+}
+
+bool WeeklySlots::apply(const std::vector<AvailabilityEdit>& edits) {
+    bool changed = false;
+    for (const auto& e : edits) {
+        if (e.kind == AvailabilityEdit::Kind::Add) changed |= add(e.slot);
+        else changed |= remove(e.slot.day, e.slot.start, e.slot.end);
+    }
+    return changed;
+}
+
+bool WeeklySlots::covers(Day d, int start, int end) const {
+    if (!validDay(d) || start >= end) return false;
+    const auto& day = on(d);
+    auto it = day.upper_bound(start);
+    if (it == day.begin()) return false;
+    return std::prev(it)->second >= end;
+}
+
+std::size_t WeeklySlots::size() const {
+    std::size_t n = 0;
+    for (const auto& day : days_) n += day.size();
+    return n;
+}
+
+std::vector<AvailabilitySlot> WeeklySlots::slots() const {
+    std::vector<AvailabilitySlot> out;
+    out.reserve(size());
+    for (int d = 0; d < 7; ++d) {
+        for (const auto& run : days_[static_cast<std::size_t>(d)]) out.push_back({static_cast<Day>(d), run.first, run.second});
+    }
+    return out;
+}
+
+} // namespace sb
@@ -0,0 +1,65 @@
+/***************************************************************************************
+ * WeeklySlots.hpp
+ * Editable weekly availability: seven ordered interval sets (one per day).
+ *
+ * Each day maps start → end for disjoint free runs; overlapping or touching slots are
+ * coalesced on insert, the same rule AvailabilityManager has always applied. That makes
+ *  - add()    : O(log n + k) for k runs absorbed,
+ *  - remove() : O(log n + k) to carve a time range out of k runs (splitting at the edges),
+ *  - build from a profile's (day, start)-ordered slots and flatten back: O(n).
+ * Profiles keep storing the flat, hash-consed slot list (see Schedule.hpp); WeeklySlots
+ * is the working form for edits, so a batch costs one build, m log n edits and one commit
+ * instead of a sort + rebuild + re-intern per slot.
+ *
+ * STANDARD LIBRARIES USED:
+ *  <array>   : one set per day
+ *  <cstddef> : sizes
+ *  <map>     : ordered start → end runs
+ *  <vector>  : flat slot lists, edit batches
+ ****************************************************************************************/
+#pragma once
+#include "Schedule.hpp"
+
+#include <array>
+#include <cstddef>
+#include <map>
+#include <vector>
+
+namespace sb {
+
+// One step of a batch edit. Remove clears [slot.start, slot.end) on slot.day.
+struct AvailabilityEdit {
+    enum class Kind { Add, Remove };
+    Kind kind;
+    AvailabilitySlot slot;
+};
+
+class WeeklySlots {
+public:
+    WeeklySlots() = default;
+    // Any order; slots are coalesced. O(n) when already in (day, start) order and merged.
+    explicit WeeklySlots(const std::vector<AvailabilitySlot>& slots);
+
+    // Insert and coalesce. Returns false if nothing changed (empty, invalid, or covered).
+    bool add(const AvailabilitySlot& s);
+    // Clear [start, end) on 'day'. Returns false if nothing was free there.
+    bool remove(Day day, int start, int end);
+    // Apply edits in order. Returns true if anything changed.
+    bool apply(const std::vector<AvailabilityEdit>& edits);
+
+    // True if one run covers all of [start, end) on 'day'.
+    bool covers(Day day, int start, int end) const;
+
+    const std::map<int, int>& on(Day day) const { return days_[static_cast<std::size_t>(day)]; }
+    std::size_t size() const;
+
+    // Flat list in (day, start) order, as Profile stores it.
+    std::vector<AvailabilitySlot> slots() const;
+
+private:
+    static bool validDay(Day d) { return static_cast<int>(d) >= 0 && static_cast<int>(d) < 7; }
+
+    std::array<std::map<int, int>, 7> days_;
+};
+
+} // namespace sb
@@ -0,0 +1,109 @@
+/***************************************************************************************
+ * bench_admission.cpp
+ * SessionRequests under a request flood: a few popular tutors receive most requests,
+ * with retries of the same request mixed in. Compares sending everything (sendRequest)
+ * against admission control (trySendRequest): pending queue sizes, notifications sent,
+ * and pendingFor() latency for a tutor and for an ordinary student.
+ *
+ * Time is simulated: requests arrive evenly over 'hours' hours.
+ *
+ * Usage: bench_admission [students=20000] [requests=200000] [hours=8]
+ *
+ * STANDARD LIBRARIES USED:
+ *  <chrono>   : timing, simulated clock
+ *  <iomanip>  : formatting
+ *  <iostream> : report
+ *  <random>   : synthetic traffic
+ *  <string>   : argument parsing
+ *  <vector>   : roster
+ ****************************************************************************************/
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "NotificationCenter.hpp"
+#include "SessionRequests.hpp"
+
+using namespace sb;
+using Clock = std::chrono::steady_clock;
+
+static double usSince(Clock::time_point t0) {
+    return std::chrono::duration<double, std::micro>(Clock::now() - t0).count();
+}
+
+struct Request {
+    std::size_t from, to;
+    Day day;
+    int start;
+};
+
+static void report(const char* label, SessionRequests& sr, NotificationCenter& nc,
+                   const std::vector<Profile>& roster, std::size_t tutors, double sendUs) {
+    const std::size_t reps = 200;
+    auto t0 = Clock::now();
+    std::size_t tutorPending = 0;
+    for (std::size_t i = 0; i < reps; ++i) tutorPending = sr.pendingRefs(roster[i % tutors]).size();
+    double tutorUs = usSince(t0) / reps;
+    t0 = Clock::now();
+    for (std::size_t i = 0; i < reps; ++i) sr.pendingRefs(roster[tutors + i]);
+    double studentUs = usSince(t0) / reps;
+    std::size_t inbox = 0;
+    for (std::size_t t = 0; t < tutors; ++t) inbox += nc.peek(roster[t].email()).size();
+    std::cout << label << "\n"
+              << "  send                      : " << sendUs << " us/request\n"
+              << "  pending, one tutor        : " << tutorPending << " requests, " << tutorUs << " us/pendingFor\n"
+              << "  tutor inboxes (total)     : " << inbox << " notifications\n"
+              << "  pendingFor, other student : " << studentUs << " us\n";
+}
+
+int main(int argc, char** argv) {
+    std::size_t students = argc > 1 ? std::stoul(argv[1]) : 20000;
+    std::size_t requests = argc > 2 ? std::stoul(argv[2]) : 200000;
+    double hours = argc > 3 ? std::stod(argv[3]) : 8;
+    const std::size_t tutors = 10;
+
+    std::vector<Profile> roster(students);
+    for (std::size_t i = 0; i < students; ++i) {
+        roster[i].createOrReset("s" + std::to_string(i), "s" + std::to_string(i) + "@clemson.edu", {"CPSC 2150"});
+    }
+    std::mt19937 rng(48);
+    std::vector<Request> traffic(requests);
+    for (auto& r : traffic) {
+        r.from = tutors + rng() % (students - tutors);
+        r.to = rng() % 2 ? rng() % tutors : tutors + rng() % (students - tutors);
+        r.day = static_cast<Day>(rng() % 5);
+        r.start = 8 * 60 + static_cast<int>(rng() % 4) * 120; // few slots, so retries collide
+    }
+    const auto step = std::chrono::nanoseconds(static_cast<std::int64_t>(hours * 3.6e12 / requests));
+
+    std::cout << std::fixed << std::setprecision(2) << students << " students, " << requests
+              << " requests over " << hours << " h, half to " << tutors << " tutors\n";
+    {
+        NotificationCenter nc;
+        SessionRequests sr(&nc);
+        auto t0 = Clock::now();
+        for (const auto& r : traffic) {
+            sr.sendRequest(roster[r.from], roster[r.to], "CPSC 2150", r.day, r.start, r.start + 60);
+        }
+        report("sendRequest (no admission control)", sr, nc, roster, tutors, usSince(t0) / requests);
+    }
+    {
+        NotificationCenter nc;
+        SessionRequests sr(&nc);
+        std::size_t counts[5] = {};
+        SessionRequests::Clock::time_point now{};
+        auto t0 = Clock::now();
+        for (const auto& r : traffic) {
+            now += step;
+            auto res = sr.trySendRequest(roster[r.from], roster[r.to], "CPSC 2150", r.day, r.start, r.start + 60, now);
+            ++counts[static_cast<int>(res.admission)];
+        }
+        report("trySendRequest (default policy)", sr, nc, roster, tutors, usSince(t0) / requests);
+        std::cout << "  admitted " << counts[0] << ", coalesced " << counts[1] << ", requester throttled "
+                  << counts[2] << ", invitee throttled " << counts[3] << ", queue full " << counts[4] << "\n";
+    }
+    return 0;
+}
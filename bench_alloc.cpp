@@ -0,0 +1,50 @@
+/***************************************************************************************
+ * bench_alloc.cpp
+ * Allocations per operation for the hot CLI/server operations (suggest, byName, byCourse,
+ * sendRequest) on a synthetic roster, as counted by AllocStats. Use it to check that an
+ * optimization actually removed allocations, not just time.
+ *
+ * Usage: bench_alloc [users=2000] [iterations=200]
+ *
+ * STANDARD LIBRARIES USED:
+ *  <iostream> : report
+ *  <string>   : argument parsing, queries
+ *  <vector>   : roster
+ ****************************************************************************************/
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "AllocStats.hpp"
+#include "ClassmateSearch.hpp"
+#include "MatchSuggester.hpp"
+#include "NotificationCenter.hpp"
+#include "SessionRequests.hpp"
+#include "SyntheticRoster.hpp"
+
+using namespace sb;
+
+int main(int argc, char** argv) {
+    std::size_t users = argc > 1 ? std::stoul(argv[1]) : 2000;
+    std::size_t iterations = argc > 2 ? std::stoul(argv[2]) : 200;
+
+    std::vector<Profile> roster = makeSyntheticRoster(users);
+    const Profile& me = roster[0];
+    const std::string course = me.courses().empty() ? "CPSC 1010" : me.courses().front();
+    MatchSuggester matcher;
+    NotificationCenter nc;
+    SessionRequests sessions(&nc);
+
+    AllocStats::enable(true);
+    for (std::size_t i = 0; i < iterations; ++i) {
+        matcher.suggest(me, roster);
+        ClassmateSearch::byName(roster, me, "student 1" + std::to_string(i % 10));
+        ClassmateSearch::byCourse(roster, me, course);
+        sessions.sendRequest(me, roster[1 + i % (users - 1)], course, Day::Mon, 600, 660);
+    }
+    AllocStats::enable(false);
+
+    std::cout << "users=" << users << " iterations=" << iterations << "\n";
+    AllocStats::print(std::cout);
+    return 0;
+}
@@ -0,0 +1,134 @@
+/***************************************************************************************
+ * bench_autocomplete.cpp
+ * Type-ahead latency on a large roster: Autocomplete (radix trie with cached top-N per
+ * node) vs a linear scan that counts matching courses/names and picks the top N.
+ * Also reports the cost of keeping the index current (one course add + remove).
+ *
+ * Usage: bench_autocomplete [users=100000] [repeats=2000]
+ *
+ * STANDARD LIBRARIES USED:
+ *  <algorithm>     : scan baseline top-N
+ *  <chrono>        : timing
+ *  <iomanip>       : formatting
+ *  <iostream>      : report
+ *  <random>        : synthetic roster
+ *  <string>        : names, course codes
+ *  <unordered_map> : scan baseline counts
+ *  <vector>        : roster
+ ****************************************************************************************/
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Autocomplete.hpp"
+#include "CourseManager.hpp"
+
+using namespace sb;
+using Clock = std::chrono::steady_clock;
+
+template <class F>
+static double avgUs(int reps, F&& f) {
+    auto t0 = Clock::now();
+    for (int r = 0; r < reps; ++r) f();
+    return std::chrono::duration<double, std::micro>(Clock::now() - t0).count() / reps;
+}
+
+// What a caller without the index does: count every matching course, then take the top N.
+static std::size_t scanCourses(const std::vector<Profile>& roster, const std::string& prefix) {
+    std::string want = PrefixIndex::normalize(prefix);
+    std::unordered_map<std::string, std::uint32_t> counts;
+    for (const auto& p : roster) {
+        for (const auto& c : p.courses()) {
+            std::string key = PrefixIndex::normalize(c);
+            if (key.compare(0, want.size(), want) == 0) ++counts[key];
+        }
+    }
+    std::vector<std::pair<std::uint32_t, std::string>> ranked;
+    for (auto& kv : counts) ranked.push_back({kv.second, kv.first});
+    std::size_t n = std::min<std::size_t>(ranked.size(), PrefixIndex::kMaxCompletions);
+    std::partial_sort(ranked.begin(), ranked.begin() + static_cast<std::ptrdiff_t>(n), ranked.end(),
+                      [](const auto& a, const auto& b) { return a.first > b.first || (a.first == b.first && a.second < b.second); });
+    return n;
+}
+
+int main(int argc, char** argv) {
+    std::size_t users = argc > 1 ? std::stoul(argv[1]) : 100000;
+    int repeats = argc > 2 ? std::stoi(argv[2]) : 2000;
+
+    const std::vector<std::string> first = {
+        "James", "Mary", "John", "Patricia", "Robert", "Jennifer", "Michael", "Linda", "William",
+        "Elizabeth", "David", "Barbara", "Richard", "Susan", "Joseph", "Jessica", "Thomas", "Sarah",
+        "Wei", "Fatima", "Aarav", "Sofia", "Mateo", "Olivia", "Liam", "Chloe", "Noah", "Priya"};
+    const std::vector<std::string> last = {
+        "Smith", "Johnson", "Williams", "Brown", "Jones", "Garcia", "Miller", "Davis", "Rodriguez",
+        "Martinez", "Hernandez", "Lopez", "Gonzalez", "Wilson", "Anderson", "Thomas", "Taylor",
+        "Moore", "Jackson", "Martin", "Lee", "Chen", "Nguyen", "Patel", "Khan", "Kim", "Okafor"};
+    const std::vector<std::string> depts = {"CPSC", "MATH", "ECE", "PHYS", "CHEM", "ENGL", "HIST", "BIOL"};
+
+    // ~1200 course codes; enrollment skewed towards low-numbered sections (Zipf-like).
+    std::vector<std::string> catalog;
+    for (const auto& d : depts) {
+        for (int n = 1000; n < 4800; n += 25) catalog.push_back(d + " " + std::to_string(n));
+    }
+    std::mt19937 rng(9);
+    auto pickCourse = [&] {
+        double u = std::uniform_real_distribution<double>(0.0, 1.0)(rng);
+        return catalog[static_cast<std::size_t>(u * u * u * catalog.size())];
+    };
+    std::vector<Profile> roster(users);
+    for (std::size_t i = 0; i < users; ++i) {
+        std::vector<std::string> courses;
+        for (int k = 0; k < 5; ++k) courses.push_back(pickCourse());
+        std::string initial(1, static_cast<char>('A' + rng() % 26));
+        roster[i].createOrReset(first[rng() % first.size()] + " " + initial + ". " + last[rng() % last.size()],
+                                "u" + std::to_string(i) + "@clemson.edu",
+                                CourseManager::normalizeDedup(courses));
+    }
+
+    auto t0 = Clock::now();
+    Autocomplete ac(roster);
+    double buildMs = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    std::cout << "users=" << users << " courses=" << ac.courseIndex().size()
+              << " names=" << ac.nameIndex().size()
+              << " nodes=" << ac.courseIndex().nodeCount() + ac.nameIndex().nodeCount()
+              << " build " << std::fixed << std::setprecision(1) << buildMs << " ms\n\n";
+
+    std::cout << std::left << std::setw(14) << "prefix" << std::setw(7) << "hits"
+              << std::setw(14) << "index us" << std::setw(14) << "scan us" << "top\n"
+              << std::setprecision(2);
+    for (const char* q : {"C", "CPSC", "CPSC 1", "cpsc 21", "MATH 10", "XYZ"}) {
+        std::vector<Completion> got;
+        double idx = avgUs(repeats, [&] { got = ac.courses(q); });
+        double scan = avgUs(std::max(1, repeats / 500), [&] { scanCourses(roster, q); });
+        std::cout << std::setw(14) << q << std::setw(7) << got.size() << std::setw(14) << idx
+                  << std::setw(14) << scan << (got.empty() ? std::string("-") : std::string(got[0].text))
+                  << "\n";
+    }
+    for (const char* q : {"J", "Jo", "John K", "Priya Z. Ok"}) {
+        std::vector<Completion> got;
+        double idx = avgUs(repeats, [&] { got = ac.names(q); });
+        std::cout << std::setw(14) << q << std::setw(7) << got.size() << std::setw(14) << idx
+                  << std::setw(14) << "" << (got.empty() ? std::string("-") : std::string(got[0].text))
+                  << "\n";
+    }
+
+    // Incremental maintenance: one student adds a popular course and drops it again
+    // (the drop re-ranks every cached list the course appears in).
+    Profile edited = roster[0];
+    auto& own = edited.coursesMutable();
+    own.erase(std::remove(own.begin(), own.end(), catalog[0]), own.end());
+    ac.update(0, edited);
+    double upd = avgUs(repeats, [&] {
+        edited.coursesMutable().push_back(catalog[0]);
+        ac.update(0, edited);
+        edited.coursesMutable().pop_back();
+        ac.update(0, edited);
+    });
+    std::cout << "\nupdate (add + remove one course): " << upd / 2 << " us per update\n";
+    return 0;
+}
@@ -0,0 +1,69 @@
+/***************************************************************************************
+ * bench_availability_batch.cpp
+ * Calendar import into one profile: a loop of AvailabilityManager::addMerged (one commit
+ * per slot, as before) vs a single AvailabilityManager::applyBatch over the same slots.
+ *
+ * Usage: bench_availability_batch [slots=2000,8000,32000]
+ *
+ * STANDARD LIBRARIES USED:
+ *  <chrono>   : timing
+ *  <iomanip>  : formatting
+ *  <iostream> : report
+ *  <random>   : imported slots
+ *  <string>   : argument parsing
+ *  <vector>   : edit batches
+ ****************************************************************************************/
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "AvailabilityManager.hpp"
+#include "Utils.hpp"
+
+using namespace sb;
+using Clock = std::chrono::steady_clock;
+
+static double msSince(Clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+}
+
+int main(int argc, char** argv) {
+    std::vector<std::size_t> sizes = {2000, 8000, 32000};
+    if (argc > 1) {
+        sizes.clear();
+        for (const auto& t : split(argv[1], ',')) sizes.push_back(std::stoul(t));
+    }
+
+    std::cout << std::left << std::setw(10) << "slots" << std::setw(10) << "merged"
+              << std::setw(16) << "addMerged ms" << std::setw(16) << "applyBatch ms" << "\n"
+              << std::fixed << std::setprecision(2);
+    for (std::size_t n : sizes) {
+        // Short, mostly disjoint minute-level slots (a fine-grained calendar export).
+        std::mt19937 rng(42);
+        std::vector<AvailabilityEdit> edits;
+        for (std::size_t i = 0; i < n; ++i) {
+            int start = static_cast<int>(rng() % (24 * 60 - 5));
+            edits.push_back({AvailabilityEdit::Kind::Add, {static_cast<Day>(rng() % 7), start, start + 1 + static_cast<int>(rng() % 4)}});
+        }
+
+        Profile loop;
+        loop.createOrReset("Bench", "bench@clemson.edu", {});
+        auto t0 = Clock::now();
+        for (const auto& e : edits) AvailabilityManager::addMerged(loop, e.slot);
+        double loopMs = msSince(t0);
+
+        Profile batch;
+        batch.createOrReset("Bench", "bench@clemson.edu", {});
+        t0 = Clock::now();
+        AvailabilityManager::applyBatch(batch, edits);
+        double batchMs = msSince(t0);
+
+        if (loop.schedule() != batch.schedule()) { std::cerr << "mismatch at " << n << "\n"; return 1; }
+        std::cout << std::setw(10) << n << std::setw(10) << batch.availability().size()
+                  << std::setw(16) << loopMs << std::setw(16) << batchMs << "\n";
+    }
+    return 0;
+}
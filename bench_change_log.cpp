@@ -0,0 +1,121 @@
+/***************************************************************************************
+ * bench_change_log.cpp
+ * ChangeLog costs: publish overhead with no / synchronous / queued consumers, queue
+ * throughput to a consumer thread, and an enrollment-style burst of 10k course edits
+ * applied to an OccupancyIndex per event vs rebuilt once from a batched subscriber.
+ *
+ * Usage: bench_change_log [users=20000] [edits=10000]
+ *
+ * STANDARD LIBRARIES USED:
+ *  <algorithm>: std::min
+ *  <atomic>   : consumer progress
+ *  <chrono>   : timing
+ *  <iomanip>  : formatting
+ *  <iostream> : report
+ *  <optional> : rebuilt index
+ *  <thread>   : queue consumer
+ *  <vector>   : rosters, batches
+ ****************************************************************************************/
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "ChangeLog.hpp"
+#include "OccupancyIndex.hpp"
+#include "SyntheticRoster.hpp"
+
+using namespace sb;
+using Clock = std::chrono::steady_clock;
+
+static double msSince(Clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+}
+
+static double publishNs(ChangeLog& log, std::size_t n) {
+    auto t0 = Clock::now();
+    for (std::size_t i = 0; i < n; ++i) log.publish(ChangeEvent{});
+    return msSince(t0) * 1e6 / static_cast<double>(n);
+}
+
+// Adds one course to each of the first 'edits' students through the roster.
+static void courseBurst(Roster& roster, std::size_t edits) {
+    for (std::size_t i = 0; i < edits; ++i) {
+        roster.edit(roster.handle(i), [](Profile& p) { p.coursesMutable().push_back("CPSC 1010"); });
+    }
+}
+
+int main(int argc, char** argv) {
+    std::size_t users = argc > 1 ? std::stoul(argv[1]) : 20000;
+    std::size_t edits = argc > 2 ? std::stoul(argv[2]) : 10000;
+    const std::size_t n = 1000000;
+
+    std::cout << std::fixed << std::setprecision(1);
+    {
+        ChangeLog log;
+        std::cout << "publish, no consumers      : " << publishNs(log, n) << " ns/event\n";
+        std::size_t count = 0;
+        log.subscribe([&](const ChangeEvent&) { ++count; });
+        std::cout << "publish, 1 sync listener   : " << publishNs(log, n) << " ns/event\n";
+    }
+    {
+        ChangeLog log;
+        auto q = log.openQueue(1 << 16);
+        std::atomic<bool> done{false};
+        std::size_t received = 0;
+        std::thread consumer([&] {
+            std::vector<ChangeEvent> batch;
+            while (!done.load() || !batch.empty()) {
+                batch.clear();
+                received += q->drain(batch, 4096);
+                if (batch.empty()) std::this_thread::yield();
+            }
+        });
+        double ns = publishNs(log, n);
+        done = true;
+        consumer.join();
+        std::cout << "publish, 1 queue consumer  : " << ns << " ns/event (received " << received
+                  << ", dropped " << q->dropped() << ")\n";
+    }
+
+    std::vector<Profile> base = makeSyntheticRoster(users);
+    edits = std::min(edits, users);
+
+    double perEventMs, batchedMs;
+    {
+        Roster roster;
+        for (const auto& p : base) roster.add(p);
+        OccupancyIndex index(roster.profiles());
+        ChangeLog log;
+        log.watch(roster);
+        log.subscribe([&](const ChangeEvent& e) { index.update(e.profileId, e.profile); });
+        auto t0 = Clock::now();
+        courseBurst(roster, edits);
+        perEventMs = msSince(t0);
+    }
+    {
+        Roster roster;
+        for (const auto& p : base) roster.add(p);
+        std::optional<OccupancyIndex> index(std::in_place, roster.profiles());
+        ChangeLog log;
+        log.watch(roster);
+        log.subscribeBatch([&](const std::vector<ChangeEvent>& batch) {
+            if (batch.size() > 1) index.emplace(roster.profiles()); // one rebuild for the burst
+            else index->update(batch.front().profileId, batch.front().profile);
+        });
+        auto t0 = Clock::now();
+        {
+            ChangeLog::Batch burst(log);
+            courseBurst(roster, edits);
+        }
+        batchedMs = msSince(t0);
+    }
+    std::cout << "\n" << edits << " course edits on " << users << " users, OccupancyIndex:\n"
+              << "  update per event       : " << perEventMs << " ms\n"
+              << "  one rebuild per batch  : " << batchedMs << " ms\n";
+    return 0;
+}
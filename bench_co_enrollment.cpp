@@ -0,0 +1,126 @@
+/***************************************************************************************
+ * bench_co_enrollment.cpp
+ * CoEnrollment: CSR build time (1 thread vs the shared pool), top-N "also take" queries
+ * vs scanning every profile's course list per query, and incremental course edits.
+ *
+ * Students take 5 courses from a catalog of departments, mostly within their own
+ * department, so rows are skewed the way real enrollments are.
+ *
+ * Usage: bench_co_enrollment [students=100000] [courses=2000]
+ *
+ * STANDARD LIBRARIES USED:
+ *  <algorithm>     : top-N of the scan baseline
+ *  <chrono>        : timing
+ *  <iomanip>       : formatting
+ *  <iostream>      : report
+ *  <random>        : synthetic enrollments
+ *  <string>        : course codes
+ *  <unordered_map> : scan baseline counts
+ *  <vector>        : roster
+ ****************************************************************************************/
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "CoEnrollment.hpp"
+#include "Roster.hpp"
+#include "ThreadPool.hpp"
+
+using namespace sb;
+using Clock = std::chrono::steady_clock;
+
+static double msSince(Clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+}
+
+// What a query costs without the matrix: count co-enrollments over every profile.
+static std::size_t scanTop(const std::vector<Profile>& all, const std::string& course, std::size_t n) {
+    std::unordered_map<std::string, std::uint32_t> counts;
+    for (const auto& p : all) {
+        const auto& cs = p.courses();
+        if (std::find(cs.begin(), cs.end(), course) == cs.end()) continue;
+        for (const auto& c : cs) {
+            if (c != course) ++counts[c];
+        }
+    }
+    std::vector<std::pair<std::uint32_t, std::string>> rows;
+    for (auto& kv : counts) rows.emplace_back(kv.second, kv.first);
+    std::size_t k = std::min(n, rows.size());
+    std::partial_sort(rows.begin(), rows.begin() + static_cast<std::ptrdiff_t>(k), rows.end(),
+                      [](const auto& a, const auto& b) { return a.first > b.first; });
+    return k;
+}
+
+int main(int argc, char** argv) {
+    std::size_t students = argc > 1 ? std::stoul(argv[1]) : 100000;
+    std::size_t courses = argc > 2 ? std::stoul(argv[2]) : 2000;
+    const std::size_t perDept = 50;
+
+    std::vector<std::string> codes;
+    for (std::size_t c = 0; c < courses; ++c) {
+        codes.push_back("D" + std::to_string(c / perDept) + " " + std::to_string(1000 + c % perDept));
+    }
+    std::mt19937 rng(46);
+    auto enroll = [&] {
+        std::size_t dept = rng() % (courses / perDept);
+        std::vector<std::string> cs;
+        while (cs.size() < 5) {
+            std::size_t c = rng() % 4 ? dept * perDept + rng() % perDept : rng() % courses;
+            if (std::find(cs.begin(), cs.end(), codes[c]) == cs.end()) cs.push_back(codes[c]);
+        }
+        return cs;
+    };
+    std::vector<Profile> roster(students);
+    for (std::size_t i = 0; i < students; ++i) {
+        roster[i].createOrReset("s" + std::to_string(i), "s" + std::to_string(i) + "@clemson.edu", enroll());
+    }
+
+    std::cout << std::fixed << std::setprecision(1)
+              << students << " students x 5 courses, " << courses << " courses\n";
+    double oneThreadMs;
+    {
+        ThreadPool pool(1);
+        ThreadPool::useAsShared(&pool);
+        auto t0 = Clock::now();
+        CoEnrollment co(roster);
+        oneThreadMs = msSince(t0);
+        ThreadPool::useAsShared(nullptr);
+        std::cout << "build, 1 thread           : " << oneThreadMs << " ms (" << co.nonZeros() << " non-zeros)\n";
+    }
+    auto t0 = Clock::now();
+    CoEnrollment co(roster);
+    double poolMs = msSince(t0);
+    std::cout << "build, shared pool        : " << poolMs << " ms (" << ThreadPool::shared().size()
+              << " threads, x" << std::setprecision(2) << oneThreadMs / poolMs << ")\n" << std::setprecision(1);
+
+    const std::size_t queries = 20000;
+    std::size_t sink = 0;
+    t0 = Clock::now();
+    for (std::size_t q = 0; q < queries; ++q) sink += co.topWith(codes[q % courses], 10).size();
+    double topUs = msSince(t0) * 1000.0 / queries;
+
+    const std::size_t scans = 20;
+    t0 = Clock::now();
+    for (std::size_t q = 0; q < scans; ++q) sink += scanTop(roster, codes[q * 97 % courses], 10);
+    double scanUs = msSince(t0) * 1000.0 / scans;
+    std::cout << "top-10, CSR row           : " << topUs << " us/query\n"
+              << "top-10, scan all profiles : " << scanUs << " us/query\n";
+
+    Roster live;
+    for (const auto& p : roster) live.add(p);
+    CoEnrollment tracked(live.profiles());
+    live.subscribe([&](const RosterChange& c) { tracked.update(c.id, c.profile); });
+    const std::size_t edits = 20000;
+    t0 = Clock::now();
+    for (std::size_t e = 0; e < edits; ++e) {
+        live.edit(live.handle(rng() % students), [&](Profile& p) { p.coursesMutable() = enroll(); });
+    }
+    double editUs = msSince(t0) * 1000.0 / edits;
+    std::cout << "course edit via roster    : " << editUs << " us/edit (includes Roster::edit)\n";
+    return sink == 0; // keep the work observable
+}
@@ -0,0 +1,105 @@
+/***************************************************************************************
+ * bench_common_window.cpp
+ * nextCommonWindow (merged cursor walk) vs filling a per-minute week grid for each query,
+ * on random pairs and groups from a synthetic roster, with a few busy sessions.
+ *
+ * Usage: bench_common_window [users=2000] [queries=200000]
+ *
+ * STANDARD LIBRARIES USED:
+ *  <chrono>   : timing
+ *  <iomanip>  : formatting
+ *  <iostream> : report
+ *  <random>   : query mix
+ *  <vector>   : roster, grid, groups
+ ****************************************************************************************/
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "CommonWindow.hpp"
+#include "SyntheticRoster.hpp"
+
+using namespace sb;
+using Clock = std::chrono::steady_clock;
+
+constexpr int kDay = 24 * 60;
+constexpr int kWeek = 7 * kDay;
+
+// Baseline: mark every free minute shared by the group, blank out sessions, then scan.
+static int gridSearch(const std::vector<const Profile*>& people, int from, int duration,
+                      const std::vector<StudySession>& busy, std::vector<unsigned char>& grid) {
+    grid.assign(kWeek, 0);
+    for (const Profile* p : people) {
+        for (const auto& s : p->availability()) {
+            for (int m = s.start; m < s.end; ++m) ++grid[static_cast<int>(s.day) * kDay + m];
+        }
+    }
+    for (const auto& s : busy) {
+        for (int m = s.start; m < s.end; ++m) grid[static_cast<int>(s.day) * kDay + m] = 0;
+    }
+    for (int pass = 0; pass < 2; ++pass) {
+        int run = 0;
+        for (int t = pass ? 0 : from; t < kWeek; ++t) {
+            if (t % kDay == 0) run = 0;
+            run = grid[t] == people.size() ? run + 1 : 0;
+            if (run == duration) return t + 1 - duration;
+        }
+    }
+    return -1;
+}
+
+int main(int argc, char** argv) {
+    std::size_t users = argc > 1 ? std::stoul(argv[1]) : 2000;
+    std::size_t queries = argc > 2 ? std::stoul(argv[2]) : 200000;
+    std::vector<Profile> roster = makeSyntheticRoster(users);
+
+    std::vector<StudySession> sessions;
+    std::vector<const StudySession*> busy;
+    for (int d = 0; d < 5; ++d) {
+        sessions.push_back(StudySession{"", "", static_cast<Day>(d), 600, 660, "", "", StudySession::Status::Confirmed});
+    }
+    for (const auto& s : sessions) busy.push_back(&s);
+
+    std::cout << std::fixed << std::setprecision(2);
+    for (std::size_t groupSize : {std::size_t{2}, std::size_t{4}}) {
+        std::mt19937 rng(45);
+        std::vector<std::vector<const Profile*>> groups(1024);
+        std::vector<WeekTime> starts(1024);
+        for (std::size_t i = 0; i < groups.size(); ++i) {
+            for (std::size_t k = 0; k < groupSize; ++k) groups[i].push_back(&roster[rng() % roster.size()]);
+            starts[i] = WeekTime{static_cast<Day>(rng() % 7), static_cast<int>(rng() % kDay)};
+        }
+
+        std::size_t found = 0;
+        auto t0 = Clock::now();
+        for (std::size_t q = 0; q < queries; ++q) {
+            const auto& g = groups[q % groups.size()];
+            found += nextCommonWindow(g, starts[q % starts.size()], 60, busy).has_value();
+        }
+        double walkNs = std::chrono::duration<double, std::nano>(Clock::now() - t0).count() / static_cast<double>(queries);
+
+        std::size_t gridQueries = queries / 100 + 1;
+        std::size_t mismatches = 0;
+        std::vector<unsigned char> grid;
+        t0 = Clock::now();
+        for (std::size_t q = 0; q < gridQueries; ++q) {
+            const WeekTime& w = starts[q % starts.size()];
+            int from = static_cast<int>(w.day) * kDay + w.minute;
+            int start = gridSearch(groups[q % groups.size()], from, 60, sessions, grid);
+            auto walk = nextCommonWindow(groups[q % groups.size()], w, 60, busy);
+            int walkStart = walk ? static_cast<int>(walk->day) * kDay + walk->start : -1;
+            mismatches += start != walkStart;
+        }
+        double gridNs = std::chrono::duration<double, std::nano>(Clock::now() - t0).count() / static_cast<double>(gridQueries)
+                        - walkNs; // the loop also re-runs the walk to cross-check
+
+        std::cout << groupSize << " students, 60-minute window (" << found * 100.0 / static_cast<double>(queries)
+                  << "% found):\n"
+                  << "  cursor walk     : " << walkNs / 1000.0 << " us/query\n"
+                  << "  per-minute grid : " << gridNs / 1000.0 << " us/query (" << mismatches
+                  << " disagreements in " << gridQueries << ")\n";
+    }
+    return 0;
+}
@@ -0,0 +1,91 @@
+/***************************************************************************************
+ * bench_flat_map.cpp
+ * FlatMap vs std::unordered_map for email-keyed indexes: insert N emails, then look up
+ * hits and misses from a string_view (what NotificationCenter and the id index do).
+ * std::unordered_map<std::string, V> needs a temporary std::string per lookup in C++17;
+ * the string_view-keyed variant over interned keys is shown as well.
+ *
+ * Usage: bench_flat_map [keys=200000] [lookups=2000000]
+ *
+ * STANDARD LIBRARIES USED:
+ *  <chrono>        : timing
+ *  <iomanip>       : formatting
+ *  <iostream>      : report
+ *  <string>        : keys
+ *  <unordered_map> : baseline
+ *  <vector>        : key and probe lists
+ ****************************************************************************************/
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "FlatMap.hpp"
+
+using namespace sb;
+using Clock = std::chrono::steady_clock;
+
+static double msSince(Clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+}
+
+struct Row { const char* name; double insertMs; double lookupMs; long found; };
+
+template <class Map, class Insert, class Find>
+static Row run(const char* name, const std::vector<std::string>& keys,
+               const std::vector<std::string_view>& probes, Insert&& insert, Find&& find) {
+    Map m;
+    auto t0 = Clock::now();
+    for (std::size_t i = 0; i < keys.size(); ++i) insert(m, keys[i], i);
+    double ins = msSince(t0);
+    long found = 0;
+    t0 = Clock::now();
+    for (std::string_view p : probes) found += find(m, p);
+    return Row{name, ins, msSince(t0), found};
+}
+
+int main(int argc, char** argv) {
+    std::size_t n = argc > 1 ? std::stoul(argv[1]) : 200000;
+    std::size_t lookups = argc > 2 ? std::stoul(argv[2]) : 2000000;
+
+    std::vector<std::string> keys, misses;
+    for (std::size_t i = 0; i < n; ++i) {
+        keys.push_back("user" + std::to_string(i) + "@clemson.edu");
+        misses.push_back("ghost" + std::to_string(i) + "@clemson.edu");
+    }
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<std::size_t> pick(0, n - 1);
+    std::vector<std::string_view> probes;
+    for (std::size_t i = 0; i < lookups; ++i) {
+        probes.push_back(i % 4 == 3 ? std::string_view(misses[pick(rng)]) : std::string_view(keys[pick(rng)]));
+    }
+
+    std::vector<Row> rows;
+    rows.push_back(run<std::unordered_map<std::string, std::size_t>>("unordered_map<string>", keys, probes,
+        [](auto& m, const std::string& k, std::size_t v) { m.emplace(k, v); },
+        [](auto& m, std::string_view p) { return m.count(std::string(p)) ? 1L : 0L; }));
+    rows.push_back(run<std::unordered_map<std::string_view, std::size_t>>("unordered_map<string_view>", keys, probes,
+        [](auto& m, const std::string& k, std::size_t v) { m.emplace(k, v); },
+        [](auto& m, std::string_view p) { return m.count(p) ? 1L : 0L; }));
+    rows.push_back(run<FlatMap<std::string, std::size_t, StrHash>>("FlatMap<string>", keys, probes,
+        [](auto& m, const std::string& k, std::size_t v) { m.tryEmplace(k, v); },
+        [](auto& m, std::string_view p) { return m.find(p) ? 1L : 0L; }));
+    rows.push_back(run<FlatMap<std::string_view, std::size_t, StrHash>>("FlatMap<string_view>", keys, probes,
+        [](auto& m, const std::string& k, std::size_t v) { m.tryEmplace(k, v); },
+        [](auto& m, std::string_view p) { return m.find(p) ? 1L : 0L; }));
+
+    std::cout << "keys=" << n << " lookups=" << lookups << " (25% misses)\n"
+              << std::left << std::setw(30) << "map" << std::setw(14) << "insert ms"
+              << std::setw(14) << "lookup ms" << "ns/lookup\n" << std::fixed << std::setprecision(1);
+    for (const auto& r : rows) {
+        std::cout << std::setw(30) << r.name << std::setw(14) << r.insertMs << std::setw(14) << r.lookupMs
+                  << r.lookupMs * 1e6 / static_cast<double>(lookups) << "\n";
+        if (r.found != rows[0].found) { std::cerr << "result mismatch\n"; return 1; }
+    }
+    return 0;
+}
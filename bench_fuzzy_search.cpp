@@ -0,0 +1,83 @@
+/***************************************************************************************
+ * bench_fuzzy_search.cpp
+ * Fuzzy name search latency on a large roster with realistic names: FuzzyNameIndex
+ * (bigram prefilter + bit-parallel verify) vs the direct scan, for typo'd queries of
+ * different lengths and edit budgets. Also shows the exact substring byName for scale.
+ *
+ * Usage: bench_fuzzy_search [users=100000] [repeats=20]
+ *
+ * STANDARD LIBRARIES USED:
+ *  <chrono>   : timing
+ *  <iomanip>  : formatting
+ *  <iostream> : report
+ *  <random>   : names
+ *  <string>   : queries
+ *  <vector>   : roster
+ ****************************************************************************************/
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "ClassmateSearch.hpp"
+#include "FuzzySearch.hpp"
+
+using namespace sb;
+using Clock = std::chrono::steady_clock;
+
+template <class F>
+static double avgMs(int reps, F&& f) {
+    auto t0 = Clock::now();
+    for (int r = 0; r < reps; ++r) f();
+    return std::chrono::duration<double, std::milli>(Clock::now() - t0).count() / reps;
+}
+
+int main(int argc, char** argv) {
+    std::size_t users = argc > 1 ? std::stoul(argv[1]) : 100000;
+    int repeats = argc > 2 ? std::stoi(argv[2]) : 20;
+
+    const std::vector<std::string> first = {
+        "James", "Mary", "John", "Patricia", "Robert", "Jennifer", "Michael", "Linda", "William",
+        "Elizabeth", "David", "Barbara", "Richard", "Susan", "Joseph", "Jessica", "Thomas", "Sarah",
+        "Wei", "Fatima", "Aarav", "Sofia", "Mateo", "Olivia", "Liam", "Chloe", "Noah", "Priya"};
+    const std::vector<std::string> last = {
+        "Smith", "Johnson", "Williams", "Brown", "Jones", "Garcia", "Miller", "Davis", "Rodriguez",
+        "Martinez", "Hernandez", "Lopez", "Gonzalez", "Wilson", "Anderson", "Thomas", "Taylor",
+        "Moore", "Jackson", "Martin", "Lee", "Chen", "Nguyen", "Patel", "Khan", "Kim", "Okafor"};
+    std::mt19937 rng(5);
+    std::vector<Profile> roster(users);
+    for (std::size_t i = 0; i < users; ++i) {
+        const std::string& f = first[rng() % first.size()];
+        const std::string& l = last[rng() % last.size()];
+        roster[i].createOrReset(f + " " + l, foldCase(f.substr(0, 1) + l) + std::to_string(i) + "@clemson.edu",
+                                {"CPSC 2150"});
+    }
+    Profile me;
+    me.createOrReset("Bench User", "bench@clemson.edu", {"CPSC 2150"});
+
+    auto t0 = Clock::now();
+    FuzzyNameIndex index(roster);
+    double buildMs = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    std::cout << "users=" << users << " keys=" << index.size() << " index build " << std::fixed
+              << std::setprecision(1) << buildMs << " ms\n\n";
+
+    struct Q { const char* text; int k; };
+    const Q queries[] = {{"Jonh", 1}, {"Jenifer", 1}, {"Rodrigez", 2}, {"Hernadez", 2},
+                         {"Elizabth Tayler", 2}, {"okfaor", 1}, {"jsmith1234", 1}, {"Li", 1}};
+
+    std::cout << std::left << std::setw(18) << "query" << std::setw(4) << "k" << std::setw(9) << "hits"
+              << std::setw(12) << "index ms" << std::setw(12) << "scan ms" << "\n"
+              << std::setprecision(3);
+    for (const Q& q : queries) {
+        std::size_t hits = 0;
+        double idx = avgMs(repeats, [&] { hits = ClassmateSearch::byNameFuzzy(index, roster, me, q.text, q.k).size(); });
+        double scan = avgMs(std::max(1, repeats / 5), [&] { ClassmateSearch::byNameFuzzy(roster, me, q.text, q.k); });
+        std::cout << std::setw(18) << q.text << std::setw(4) << q.k << std::setw(9) << hits
+                  << std::setw(12) << idx << std::setw(12) << scan << "\n";
+    }
+    double exact = avgMs(repeats, [&] { ClassmateSearch::byName(roster, me, "john"); });
+    std::cout << "\nexact byName(\"john\"): " << exact << " ms\n";
+    return 0;
+}
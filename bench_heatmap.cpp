@@ -0,0 +1,116 @@
+/***************************************************************************************
+ * bench_heatmap.cpp
+ * "Best 90-minute review window for <course>": recounting every enrolled student's
+ * availability per query vs CourseHeatmap::bestWindow on the incremental Fenwick aggregates.
+ * Also reports build time and the cost of one incremental update.
+ *
+ * Usage: bench_heatmap [users=100000] [repeats=200]
+ *
+ * STANDARD LIBRARIES USED:
+ *  <algorithm> : std::find
+ *  <chrono>    : timing
+ *  <cmath>     : std::llround
+ *  <iomanip>   : formatting
+ *  <iostream>  : report
+ *  <optional>  : query result
+ *  <string>    : course codes
+ *  <vector>    : roster, counts
+ ****************************************************************************************/
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "AvailabilityManager.hpp"
+#include "CourseHeatmap.hpp"
+#include "OccupancyIndex.hpp"
+#include "SyntheticRoster.hpp"
+#include "Utils.hpp"
+
+using namespace sb;
+using Clock = std::chrono::steady_clock;
+using H = CourseHeatmap;
+
+template <class F>
+static double avgUs(int reps, F&& f) {
+    auto t0 = Clock::now();
+    for (int r = 0; r < reps; ++r) f();
+    return std::chrono::duration<double, std::micro>(Clock::now() - t0).count() / reps;
+}
+
+// Per-request path: bucket every enrolled student's slots, then slide the window.
+static long long scanBest(const std::vector<Profile>& all, const std::string& course, int width) {
+    std::vector<int> diff(H::kBuckets + 1, 0);
+    for (const auto& p : all) {
+        const auto& cs = p.courses();
+        if (std::find(cs.begin(), cs.end(), course) == cs.end()) continue;
+        DayRuns runs = freeRunsByDay(p.availability());
+        for (int d = 0; d < 7; ++d) {
+            for (const auto& r : runs[d]) {
+                int lo = (r.first + H::kBucketMinutes - 1) / H::kBucketMinutes;
+                int hi = std::min(H::kBucketsPerDay, r.second / H::kBucketMinutes);
+                if (lo < hi) { diff[d * H::kBucketsPerDay + lo]++; diff[d * H::kBucketsPerDay + hi]--; }
+            }
+        }
+    }
+    std::vector<long long> counts(H::kBuckets);
+    long long run = 0;
+    for (int b = 0; b < H::kBuckets; ++b) counts[b] = run += diff[b];
+    long long best = -1;
+    for (int d = 0; d < 7; ++d) {
+        const long long* c = counts.data() + d * H::kBucketsPerDay;
+        long long sum = 0;
+        for (int b = 0; b < H::kBucketsPerDay; ++b) {
+            sum += c[b];
+            if (b >= width) sum -= c[b - width];
+            if (b >= width - 1) best = std::max(best, sum);
+        }
+    }
+    return best;
+}
+
+int main(int argc, char** argv) {
+    std::size_t users = argc > 1 ? std::stoul(argv[1]) : 100000;
+    int repeats = argc > 2 ? std::stoi(argv[2]) : 200;
+
+    std::vector<Profile> roster = makeSyntheticRoster(users);
+    auto t0 = Clock::now();
+    H map(roster);
+    double buildMs = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    std::cout << "users=" << users << " courses=" << map.courseCount() << " build " << std::fixed
+              << std::setprecision(1) << buildMs << " ms\n\n";
+
+    const int minutes = 90, width = minutes / H::kBucketMinutes;
+    std::cout << std::left << std::setw(12) << "course" << std::setw(9) << "enrolled" << std::setw(16) << "best"
+              << std::setw(12) << "index us" << std::setw(12) << "scan us" << "\n" << std::setprecision(2);
+    const auto& catalog = syntheticCourseCatalog();
+    for (const std::string& course : {catalog.front(), catalog[catalog.size() / 2], catalog.back()}) {
+        std::optional<H::Window> w;
+        long long scanned = 0;
+        double idx = avgUs(repeats, [&] { w = map.bestWindow(course, minutes); });
+        double scan = avgUs(std::max(1, repeats / 20), [&] { scanned = scanBest(roster, course, width); });
+        if (!w || std::llround(w->averageFree * width) != scanned) {
+            std::cerr << "mismatch for " << course << "\n";
+            return 1;
+        }
+        std::cout << std::setw(12) << course << std::setw(9) << map.enrolled(course)
+                  << std::setw(16) << (std::string(kDayNames[static_cast<int>(w->day)]).substr(0, 3) + " " +
+                                       formatHHMM(w->start) + "-" + formatHHMM(w->end))
+                  << std::setw(12) << idx << std::setw(12) << scan << "\n";
+    }
+
+    // One student adds a slot (the roster listener would call update() the same way).
+    Profile edited = roster[0];
+    int flip = 0;
+    double upd = avgUs(repeats, [&] {
+        AvailabilityManager::addMerged(edited, {Day::Tue, 60 + flip, 120 + flip});
+        map.update(0, edited);
+        ++flip;
+    });
+    std::cout << "\nupdate (one Tuesday slot added): " << upd << " us\n";
+    return 0;
+}
@@ -0,0 +1,97 @@
+/***************************************************************************************
+ * bench_occupancy.cpp
+ * "Who in <course> is free <day> <start>-<end>": browseByCourseAndDayView plus a client-side
+ * time filter (today's path) vs AvailabilityBrowser::freeInWindow on an OccupancyIndex.
+ * Also reports index build time and the cost of one incremental update.
+ *
+ * Usage: bench_occupancy [users=100000] [repeats=200]
+ *
+ * STANDARD LIBRARIES USED:
+ *  <chrono>   : timing
+ *  <iomanip>  : formatting
+ *  <iostream> : report
+ *  <string>   : course codes
+ *  <vector>   : roster
+ ****************************************************************************************/
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "AvailabilityBrowser.hpp"
+#include "AvailabilityManager.hpp"
+#include "OccupancyIndex.hpp"
+#include "SyntheticRoster.hpp"
+#include "Utils.hpp"
+
+using namespace sb;
+using Clock = std::chrono::steady_clock;
+
+template <class F>
+static double avgUs(int reps, F&& f) {
+    auto t0 = Clock::now();
+    for (int r = 0; r < reps; ++r) f();
+    return std::chrono::duration<double, std::micro>(Clock::now() - t0).count() / reps;
+}
+
+// Today's path: browse the course/day, then keep members with one slot covering the window.
+static std::size_t scanFree(const std::vector<Profile>& all, const Profile& self,
+                            const std::string& course, Day day, int start, int end) {
+    std::size_t n = 0;
+    for (const auto& v : AvailabilityBrowser::browseByCourseAndDayView(all, self, course, day)) {
+        for (const auto& s : v.slots) {
+            if (s.start <= start && s.end >= end) { ++n; break; }
+        }
+    }
+    return n;
+}
+
+int main(int argc, char** argv) {
+    std::size_t users = argc > 1 ? std::stoul(argv[1]) : 100000;
+    int repeats = argc > 2 ? std::stoi(argv[2]) : 200;
+
+    std::vector<Profile> roster = makeSyntheticRoster(users);
+    Profile me;
+    me.createOrReset("Bench User", "bench@clemson.edu", {"CPSC 2150"});
+
+    auto t0 = Clock::now();
+    OccupancyIndex index(roster);
+    double buildMs = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    std::cout << "users=" << users << " courses=" << index.courseCount()
+              << " intervals=" << index.intervalCount() << " build " << std::fixed
+              << std::setprecision(1) << buildMs << " ms\n\n";
+
+    struct Q { const char* course; Day day; int start; int end; };
+    const std::string& popular = syntheticCourseCatalog().front();
+    const Q queries[] = {{popular.c_str(), Day::Tue, 14 * 60, 15 * 60},
+                         {popular.c_str(), Day::Mon, 9 * 60, 9 * 60 + 1},
+                         {popular.c_str(), Day::Thu, 8 * 60, 20 * 60},
+                         {"NOPE 0000", Day::Wed, 600, 660}};
+
+    std::cout << std::left << std::setw(12) << "course" << std::setw(5) << "day" << std::setw(14) << "window"
+              << std::setw(9) << "free" << std::setw(12) << "index us" << std::setw(12) << "scan us" << "\n"
+              << std::setprecision(2);
+    for (const Q& q : queries) {
+        std::size_t hits = 0, scanned = 0;
+        double idx = avgUs(repeats, [&] {
+            hits = AvailabilityBrowser::freeInWindow(index, roster, me, q.course, q.day, q.start, q.end).size();
+        });
+        double scan = avgUs(std::max(1, repeats / 20), [&] { scanned = scanFree(roster, me, q.course, q.day, q.start, q.end); });
+        if (hits != scanned) { std::cerr << "mismatch: " << hits << " vs " << scanned << "\n"; return 1; }
+        std::cout << std::setw(12) << q.course << std::setw(5) << kDayNames[static_cast<int>(q.day)]
+                  << std::setw(14) << (formatHHMM(q.start) + "-" + formatHHMM(q.end)) << std::setw(9) << hits
+                  << std::setw(12) << idx << std::setw(12) << scan << "\n";
+    }
+
+    // One student adds a slot (the roster listener would call update() the same way).
+    Profile edited = roster[0];
+    int flip = 0;
+    double upd = avgUs(repeats, [&] {
+        AvailabilityManager::addMerged(edited, {Day::Tue, 60 + flip, 120 + flip});
+        index.update(0, edited);
+        ++flip;
+    });
+    std::cout << "\nupdate (one Tuesday slot added): " << upd << " us\n";
+    return 0;
+}
@@ -0,0 +1,86 @@
+/***************************************************************************************
+ * bench_parallel.cpp
+ * Scaling benchmark for the shared ThreadPool: runs the parallelized core operations on a
+ * synthetic roster with 1, 2, 4, ... up to N worker threads and prints speedup vs 1 thread.
+ *
+ * Usage: bench_parallel [rosterSize=200000] [maxThreads=hardware_concurrency]
+ *
+ * STANDARD LIBRARIES USED:
+ *  <chrono>   : timing
+ *  <iomanip>  : table formatting
+ *  <iostream> : report
+ *  <string>   : argument parsing
+ *  <vector>   : thread counts, roster
+ ****************************************************************************************/
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "AvailabilityBrowser.hpp"
+#include "ClassmateSearch.hpp"
+#include "MatchSuggester.hpp"
+#include "SyntheticRoster.hpp"
+#include "ThreadPool.hpp"
+
+using namespace sb;
+using Clock = std::chrono::steady_clock;
+
+template <class F>
+static double bestOfMs(int reps, F&& f) {
+    double best = 1e300;
+    for (int r = 0; r < reps; ++r) {
+        auto t0 = Clock::now();
+        f();
+        best = std::min(best, std::chrono::duration<double, std::milli>(Clock::now() - t0).count());
+    }
+    return best;
+}
+
+int main(int argc, char** argv) {
+    std::size_t n = argc > 1 ? std::stoul(argv[1]) : 200000;
+    std::size_t maxThreads = argc > 2 ? std::stoul(argv[2]) : std::thread::hardware_concurrency();
+    if (maxThreads == 0) maxThreads = 1;
+
+    std::vector<std::size_t> counts;
+    for (std::size_t t = 1; t < maxThreads; t *= 2) counts.push_back(t);
+    counts.push_back(maxThreads);
+
+    auto roster = makeSyntheticRoster(n);
+    const Profile& me = roster[0];
+    const std::string course = me.courses()[0];
+    MatchSuggester ms;
+
+    std::cout << "roster=" << n << " (times in ms, best of 3; speedup vs 1 thread)\n"
+              << std::left << std::setw(9) << "threads"
+              << std::setw(20) << "suggest" << std::setw(20) << "byName"
+              << std::setw(20) << "byCourseAndDay" << std::setw(20) << "import" << "\n";
+
+    double base[4] = {0, 0, 0, 0};
+    for (std::size_t t : counts) {
+        ThreadPool pool(t);
+        ThreadPool::useAsShared(&pool);
+        double ms4[4] = {
+            bestOfMs(3, [&]{ ms.suggest(me, roster, 30, 10); }),
+            bestOfMs(3, [&]{ ClassmateSearch::byName(roster, me, "student 12"); }),
+            bestOfMs(3, [&]{ AvailabilityBrowser::browseByCourseAndDay(roster, me, course, Day::Wed); }),
+            bestOfMs(3, [&]{ makeSyntheticRoster(n / 4, 7); }),
+        };
+        ThreadPool::useAsShared(nullptr);
+
+        std::cout << std::setw(9) << t;
+        for (int k = 0; k < 4; ++k) {
+            if (t == counts.front()) base[k] = ms4[k];
+            std::ostringstream cell;
+            cell << std::fixed << std::setprecision(1) << ms4[k] << " (x"
+                 << std::setprecision(2) << base[k] / ms4[k] << ")";
+            std::cout << std::setw(20) << cell.str();
+        }
+        std::cout << "\n";
+    }
+    return 0;
+}
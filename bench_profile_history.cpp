@@ -0,0 +1,101 @@
+/***************************************************************************************
+ * bench_profile_history.cpp
+ * Cost of keeping a version per profile edit: ProfileHistory (shared COW profiles and
+ * hash-consed schedules) vs deep-copying each edited profile into an audit log.
+ * Reports heap bytes allocated per edit (AllocStats) and time.
+ *
+ * Usage: bench_profile_history [users=1000] [edits=20000]
+ *
+ * STANDARD LIBRARIES USED:
+ *  <chrono>   : timing
+ *  <iomanip>  : formatting
+ *  <iostream> : report
+ *  <optional> : history on/off
+ *  <random>   : edit mix
+ *  <string>   : deep-copied fields
+ *  <vector>   : roster, deep-copy log
+ ****************************************************************************************/
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "AllocStats.hpp"
+#include "AvailabilityManager.hpp"
+#include "ProfileHistory.hpp"
+#include "SyntheticRoster.hpp"
+
+using namespace sb;
+using Clock = std::chrono::steady_clock;
+
+// What "copy the profile on every edit" keeps.
+struct DeepCopy {
+    std::string name, email;
+    std::vector<std::string> courses;
+    std::vector<AvailabilitySlot> slots;
+};
+
+struct Run {
+    double ms;
+    std::size_t bytes;
+};
+
+// Apply the same deterministic edit mix to a fresh roster; 'keep' records each edit.
+template <class Keep>
+static Run run(const std::vector<Profile>& base, std::size_t edits, bool withHistory, Keep&& keep) {
+    Roster roster;
+    for (const auto& p : base) roster.add(p);
+    std::optional<ProfileHistory> history;
+    if (withHistory) history.emplace(roster, 64);
+    roster.subscribe([&](const RosterChange& c) { keep(c.profile); });
+
+    std::mt19937 rng(43);
+    AllocStats::reset();
+    AllocStats::enable(true);
+    auto t0 = Clock::now();
+    for (std::size_t i = 0; i < edits; ++i) {
+        auto h = roster.handle(rng() % roster.size());
+        if (rng() % 4) {
+            int start = static_cast<int>(rng() % 40) * 30;
+            roster.edit(h, [&](Profile& p) {
+                AvailabilityManager::addMerged(p, {static_cast<Day>(rng() % 5), start, start + 60});
+            });
+        } else {
+            roster.edit(h, [&](Profile& p) { p.coursesMutable().push_back("ELECTIVE " + std::to_string(rng() % 100)); });
+        }
+    }
+    double ms = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    AllocStats::enable(false);
+    return Run{ms, AllocStats::totals().bytes};
+}
+
+int main(int argc, char** argv) {
+    std::size_t users = argc > 1 ? std::stoul(argv[1]) : 1000;
+    std::size_t edits = argc > 2 ? std::stoul(argv[2]) : 20000;
+    if (!AllocStats::hooked()) std::cout << "(allocation hooks not linked: byte counts are 0)\n";
+
+    std::vector<Profile> base = makeSyntheticRoster(users);
+    Run plain = run(base, edits, false, [](const Profile&) {});
+    Run versioned = run(base, edits, true, [](const Profile&) {});
+    std::vector<DeepCopy> log;
+    Run deep = run(base, edits, false, [&](const Profile& p) {
+        log.push_back(DeepCopy{std::string(p.name()), std::string(p.email()), p.courses(), p.availability()});
+    });
+
+    auto row = [&](const char* label, const Run& r) {
+        double extra = (static_cast<double>(r.bytes) - static_cast<double>(plain.bytes)) / static_cast<double>(edits);
+        std::cout << std::left << std::setw(22) << label << std::setw(12) << r.ms
+                  << std::setw(16) << static_cast<double>(r.bytes) / static_cast<double>(edits)
+                  << extra << "\n";
+    };
+    std::cout << "users=" << users << " edits=" << edits << "\n"
+              << std::left << std::setw(22) << "" << std::setw(12) << "ms" << std::setw(16) << "bytes/edit"
+              << "extra bytes/edit vs no history\n" << std::fixed << std::setprecision(1);
+    row("no history", plain);
+    row("ProfileHistory", versioned);
+    row("deep copy per edit", deep);
+    return 0;
+}
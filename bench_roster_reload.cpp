@@ -0,0 +1,130 @@
+/***************************************************************************************
+ * bench_roster_reload.cpp
+ * Hot reload of a full enrollment file into a large resident roster, with a few percent
+ * of students changing courses: parse, diff and apply times, and how long concurrent
+ * requests are held up while it happens.
+ *
+ * Two reader threads run throughout: one answers PendingFor (pins the roster only), the
+ * other FreeIn (also takes the index lock a reload holds while it applies). Each reports
+ * its worst latency with no reload running and while reloads run back to back.
+ *
+ * Usage: bench_roster_reload [students=200000] [changedPercent=1] [reloads=5]
+ *
+ * STANDARD LIBRARIES USED:
+ *  <algorithm> : max latency
+ *  <atomic>    : phase flags
+ *  <chrono>    : timing
+ *  <iomanip>   : formatting
+ *  <iostream>  : report
+ *  <random>    : which students change
+ *  <sstream>   : the enrollment file, in memory
+ *  <string>    : arguments
+ *  <thread>    : reader threads
+ *  <vector>    : roster, latencies
+ ****************************************************************************************/
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Protocol.hpp"
+#include "StudyBuddyService.hpp"
+#include "SyntheticRoster.hpp"
+
+using namespace sb;
+using Clock = std::chrono::steady_clock;
+
+// Enrollment file for the synthetic roster; 'changed' students get one more course.
+static std::string enrollmentFile(const std::vector<Profile>& roster, const std::vector<char>& changed,
+                                  const std::string& extra) {
+    std::ostringstream os;
+    for (std::size_t i = 0; i < roster.size(); ++i) {
+        for (const auto& c : roster[i].courses()) os << roster[i].email() << ',' << c << '\n';
+        if (changed[i]) os << roster[i].email() << ',' << extra << '\n';
+    }
+    return os.str();
+}
+
+int main(int argc, char** argv) {
+    std::size_t students = argc > 1 ? std::stoul(argv[1]) : 200000;
+    double percent = argc > 2 ? std::stod(argv[2]) : 1.0;
+    int reloads = argc > 3 ? std::stoi(argv[3]) : 5;
+
+    StudyBuddyService svc;
+    svc.seedSynthetic(students);
+    std::vector<Profile> roster = makeSyntheticRoster(students); // same seed as the service
+
+    // Alternate between two files so every reload has work to do.
+    std::mt19937 rng(50);
+    std::vector<char> changed(students, 0);
+    std::size_t nChanged = 0;
+    for (std::size_t i = 0; i < students; ++i) {
+        if (rng() % 10000 < percent * 100) { changed[i] = 1; ++nChanged; }
+    }
+    const std::string files[2] = {enrollmentFile(roster, changed, "PHYS 9990"),
+                                  enrollmentFile(roster, changed, "PHYS 9991")};
+
+    auto request = [](wire::Op op, auto fill) {
+        wire::Writer w;
+        w.u8(static_cast<std::uint8_t>(op)); w.u32(1);
+        fill(w);
+        return w.finishFrame();
+    };
+    const auto pending = request(wire::Op::PendingFor, [](wire::Writer& w) { w.str("user7@clemson.edu"); });
+    const auto freeIn = request(wire::Op::FreeIn, [&](wire::Writer& w) {
+        w.str("user7@clemson.edu"); w.str(roster[7].courses().front());
+        w.u8(0); w.i32(600); w.i32(660); w.u8(1);
+    });
+
+    std::atomic<int> phase{0}; // 0 baseline, 1 reloading, 2 done
+    double worst[2][2] = {{0, 0}, {0, 0}}; // [reader][phase]
+    std::size_t served[2][2] = {{0, 0}, {0, 0}};
+    auto reader = [&](int which, const std::vector<std::uint8_t>& frame) {
+        for (int p; (p = phase.load()) < 2;) {
+            auto t0 = Clock::now();
+            svc.handle(frame.data() + 4, frame.size() - 4);
+            double us = std::chrono::duration<double, std::micro>(Clock::now() - t0).count();
+            worst[which][p] = std::max(worst[which][p], us);
+            ++served[which][p];
+        }
+    };
+    std::thread r0(reader, 0, std::cref(pending));
+    std::thread r1(reader, 1, std::cref(freeIn));
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    phase = 1;
+    double parse = 0, plan = 0, apply = 0, total = 0;
+    std::size_t applied = 0;
+    for (int i = 0; i < reloads; ++i) {
+        std::istringstream in(files[i % 2]);
+        auto t0 = Clock::now();
+        auto r = svc.reloadEnrollments(in);
+        total += std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+        parse += r.parseMs;
+        plan += r.planMs;
+        apply += r.applyMs;
+        applied += r.changed;
+    }
+    phase = 2;
+    r0.join();
+    r1.join();
+
+    std::cout << std::fixed << std::setprecision(2)
+              << students << " students, " << nChanged << " changed per reload, "
+              << files[0].size() / (1024.0 * 1024.0) << " MiB file, " << reloads << " reloads ("
+              << applied << " profiles republished)\n"
+              << "per reload: parse " << parse / reloads << " ms, diff " << plan / reloads
+              << " ms, apply (lock held) " << apply / reloads << " ms, total " << total / reloads << " ms\n"
+              << std::setprecision(1)
+              << "worst PendingFor latency: " << worst[0][0] << " us idle, " << worst[0][1]
+              << " us during reloads (" << served[0][1] << " served)\n"
+              << "worst FreeIn latency    : " << worst[1][0] << " us idle, " << worst[1][1]
+              << " us during reloads (" << served[1][1] << " served)\n";
+    return 0;
+}
@@ -0,0 +1,124 @@
+/***************************************************************************************
+ * bench_roster_snapshot.cpp
+ * Reader throughput with and without an active writer: RosterSnapshot (RCU) versus a
+ * std::shared_mutex-protected roster. Readers run ClassmateSearch::byCourse for a
+ * random user; the writer keeps adding availability to random profiles.
+ *
+ * Usage: bench_roster_snapshot [rosterSize=20000] [readers=4] [millis=1000]
+ *
+ * STANDARD LIBRARIES USED:
+ *  <atomic>, <chrono>, <iostream>, <shared_mutex>, <thread>, <vector>
+ ****************************************************************************************/
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "AvailabilityManager.hpp"
+#include "ClassmateSearch.hpp"
+#include "RosterSnapshot.hpp"
+#include "SyntheticRoster.hpp"
+#include "ThreadPool.hpp"
+
+using namespace sb;
+
+struct Result { double readsPerSec; long writes; };
+
+// Runs 'readers' threads calling read() and optionally one thread calling write() for 'ms'.
+template <class Read, class Write>
+static Result run(int readers, int ms, bool withWriter, Read&& read, Write&& write) {
+    std::atomic<bool> stop{false};
+    std::atomic<long> reads{0};
+    long writes = 0;
+    std::vector<std::thread> ts;
+    for (int r = 0; r < readers; ++r) {
+        ts.emplace_back([&, r] {
+            unsigned x = static_cast<unsigned>(r) * 2654435761u + 1;
+            long local = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                x = x * 1103515245u + 12345u;
+                read(x);
+                ++local;
+            }
+            reads += local;
+        });
+    }
+    std::thread writer;
+    if (withWriter) {
+        writer = std::thread([&] {
+            unsigned x = 99;
+            while (!stop.load(std::memory_order_relaxed)) {
+                x = x * 1103515245u + 12345u;
+                write(x);
+                ++writes;
+            }
+        });
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+    stop = true;
+    for (auto& t : ts) t.join();
+    if (writer.joinable()) writer.join();
+    return Result{reads.load() * 1000.0 / ms, writes};
+}
+
+int main(int argc, char** argv) {
+    std::size_t n = argc > 1 ? std::stoul(argv[1]) : 20000;
+    int readers = argc > 2 ? std::stoi(argv[2]) : 4;
+    int ms = argc > 3 ? std::stoi(argv[3]) : 1000;
+    setParallelThreshold(SIZE_MAX); // measure reader threads, not the pool
+
+    auto roster = makeSyntheticRoster(n);
+    const auto& catalog = syntheticCourseCatalog();
+
+    // --- RCU snapshot ---
+    RosterSnapshot snap(roster);
+    auto rcuRead = [&](unsigned x) {
+        auto pin = snap.pin();
+        const auto& ps = pin.profiles();
+        ClassmateSearch::byCourse(ps, ps[x % ps.size()], catalog[x % catalog.size()]);
+    };
+    auto rcuWrite = [&](unsigned x) {
+        snap.updateProfile(x % n, [x](Profile& p) {
+            AvailabilityManager::addMerged(p, AvailabilitySlot{static_cast<Day>(x % 5),
+                                                               static_cast<int>(x % 1200), static_cast<int>(x % 1200) + 30});
+        });
+    };
+
+    // --- shared_mutex baseline (writer edits in place under the exclusive lock) ---
+    std::shared_mutex mu;
+    std::vector<Profile> locked = roster;
+    auto lockRead = [&](unsigned x) {
+        std::shared_lock<std::shared_mutex> lk(mu);
+        ClassmateSearch::byCourse(locked, locked[x % locked.size()], catalog[x % catalog.size()]);
+    };
+    auto lockWrite = [&](unsigned x) {
+        std::unique_lock<std::shared_mutex> lk(mu);
+        AvailabilityManager::addMerged(locked[x % n], AvailabilitySlot{static_cast<Day>(x % 5),
+                                       static_cast<int>(x % 1200), static_cast<int>(x % 1200) + 30});
+    };
+
+    std::cout << "roster=" << n << " readers=" << readers << " window=" << ms << "ms\n"
+              << std::left << std::setw(16) << "mode" << std::setw(16) << "writer"
+              << std::setw(18) << "reads/s" << "writes\n" << std::fixed << std::setprecision(0);
+    auto row = [&](const char* mode, const char* w, Result r) {
+        std::cout << std::setw(16) << mode << std::setw(16) << w
+                  << std::setw(18) << r.readsPerSec << r.writes << "\n";
+    };
+    Result a = run(readers, ms, false, rcuRead, rcuWrite);
+    Result b = run(readers, ms, true, rcuRead, rcuWrite);
+    row("rcu", "idle", a);
+    row("rcu", "active", b);
+    Result c = run(readers, ms, false, lockRead, lockWrite);
+    Result d = run(readers, ms, true, lockRead, lockWrite);
+    row("shared_mutex", "idle", c);
+    row("shared_mutex", "active", d);
+    std::cout << std::setprecision(2) << "reader throughput kept with writer active: rcu "
+              << b.readsPerSec / a.readsPerSec << "x, shared_mutex "
+              << d.readsPerSec / c.readsPerSec << "x\n";
+    snap.collect();
+    return 0;
+}
@@ -0,0 +1,78 @@
+/***************************************************************************************
+ * bench_schedule_pool.cpp
+ * Dedup report for hash-consed availability schedules. Builds a synthetic roster whose
+ * students take one of N section timetables, then reports how many distinct schedules
+ * back the roster, the memory that saves against one slot vector per profile, and
+ * MatchSuggester::suggest time with shared (memoized) vs unshared schedules.
+ *
+ * Usage: bench_schedule_pool [users=100000] [sections=400]
+ *
+ * STANDARD LIBRARIES USED:
+ *  <chrono>   : timing
+ *  <iomanip>  : formatting
+ *  <iostream> : report
+ *  <string>   : argument parsing
+ *  <vector>   : roster
+ ****************************************************************************************/
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "MatchSuggester.hpp"
+#include "Schedule.hpp"
+#include "SyntheticRoster.hpp"
+
+using namespace sb;
+using Clock = std::chrono::steady_clock;
+
+template <class F>
+static double bestOfMs(int reps, F&& f) {
+    double best = 1e300;
+    for (int r = 0; r < reps; ++r) {
+        auto t0 = Clock::now();
+        f();
+        best = std::min(best, std::chrono::duration<double, std::milli>(Clock::now() - t0).count());
+    }
+    return best;
+}
+
+int main(int argc, char** argv) {
+    std::size_t users = argc > 1 ? std::stoul(argv[1]) : 100000;
+    std::size_t sections = argc > 2 ? std::stoul(argv[2]) : 400;
+
+    auto roster = makeSyntheticRoster(users, 2150, sections);
+    SchedulePool::Stats st = SchedulePool::global().stats();
+
+    std::size_t slots = 0;
+    for (const auto& p : roster) slots += p.availability().size();
+
+    // One std::vector<AvailabilitySlot> per profile (header + heap slots) ...
+    std::size_t perProfile = users * sizeof(std::vector<AvailabilitySlot>) + slots * sizeof(AvailabilitySlot);
+    // ... versus one shared_ptr per profile plus each distinct Schedule once
+    // (object, slots and shared_ptr control block).
+    std::size_t shared = users * sizeof(ScheduleRef) +
+                         st.live * (sizeof(Schedule) + 2 * sizeof(void*) + 16) +
+                         st.liveSlots * sizeof(AvailabilitySlot);
+    auto mib = [](std::size_t b) { return b / (1024.0 * 1024.0); };
+
+    std::cout << std::fixed << std::setprecision(2)
+              << "users=" << users << " sections=" << sections << "\n"
+              << "distinct schedules: " << st.live << "  dedup ratio: "
+              << static_cast<double>(users) / std::max<std::size_t>(1, st.live) << "x"
+              << "  (pool hits " << st.hits << "/" << st.requests << ")\n"
+              << "availability memory: per-profile vectors " << mib(perProfile) << " MiB, shared "
+              << mib(shared) << " MiB, saved " << mib(perProfile - shared) << " MiB\n";
+
+    // Suggest with memoized shared schedules vs the same roster with private slot copies.
+    std::vector<Profile> unshared = roster;
+    for (auto& p : unshared) p.availabilityMutable();
+    MatchSuggester m;
+    double tShared = bestOfMs(3, [&] { m.suggest(roster[0], roster, 30, 10); });
+    double tUnshared = bestOfMs(3, [&] { m.suggest(unshared[0], unshared, 30, 10); });
+    std::cout << "suggest: shared " << tShared << " ms, unshared " << tUnshared << " ms ("
+              << tUnshared / tShared << "x)\n";
+    return 0;
+}
@@ -0,0 +1,97 @@
+/***************************************************************************************
+ * bench_string_pool.cpp
+ * Memory report for interned identity strings. Builds a synthetic roster, sends study
+ * requests between random classmates (filling sessions and notification inboxes), then
+ * compares the bytes the identity strings take in the pool against what the previous
+ * layout (one std::string per field, per profile/session/inbox key) needed. Names and
+ * session courses stay owned std::strings in both layouts (they are not pooled).
+ *
+ * Usage: bench_string_pool [users=100000] [sessions=users*2]
+ *
+ * STANDARD LIBRARIES USED:
+ *  <iomanip>  : table formatting
+ *  <iostream> : report
+ *  <random>   : request pairs
+ *  <string>   : argument parsing, size model
+ *  <vector>   : roster
+ ****************************************************************************************/
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "NotificationCenter.hpp"
+#include "SessionRequests.hpp"
+#include "StringPool.hpp"
+#include "SyntheticRoster.hpp"
+
+using namespace sb;
+
+// Heap bytes one std::string of length n owns (libstdc++: 15 chars inline, else n+1),
+// rounded up to the 16-byte malloc granularity.
+static std::size_t stringHeap(std::size_t n) {
+    if (n <= 15) return 0;
+    return (n + 1 + 8 + 15) / 16 * 16; // payload + malloc header
+}
+
+int main(int argc, char** argv) {
+    std::size_t users = argc > 1 ? std::stoul(argv[1]) : 100000;
+    std::size_t nSessions = argc > 2 ? std::stoul(argv[2]) : users * 2;
+
+    StringPool::Stats before = StringPool::global().stats();
+    auto roster = makeSyntheticRoster(users);
+
+    NotificationCenter nc;
+    SessionRequests sr(&nc);
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<std::size_t> pick(0, users - 1);
+    std::unordered_set<std::string_view> inboxKeys;
+    for (std::size_t i = 0; i < nSessions; ++i) {
+        const Profile& a = roster[pick(rng)];
+        const Profile& b = roster[pick(rng)];
+        const auto& s = sr.sendRequest(a, b, a.courses().front(), Day::Mon, 600, 660);
+        inboxKeys.insert(s.invitee);
+    }
+    StringPool::Stats after = StringPool::global().stats();
+
+    // Previous layout: each field an owning std::string.
+    std::size_t oldInline = 0, oldHeap = 0;
+    for (const auto& p : roster) {
+        oldInline += 2 * sizeof(std::string);
+        oldHeap += stringHeap(p.name().size()) + stringHeap(p.email().size());
+    }
+    // Every session copied requester, invitee and course.
+    std::size_t avgEmail = 0;
+    for (const auto& p : roster) avgEmail += p.email().size();
+    avgEmail /= users;
+    oldInline += nSessions * 3 * sizeof(std::string);
+    oldHeap += nSessions * (2 * stringHeap(avgEmail) + stringHeap(9));
+    // Each inbox key was another copy of the email.
+    oldInline += inboxKeys.size() * sizeof(std::string);
+    oldHeap += inboxKeys.size() * stringHeap(avgEmail);
+
+    std::size_t newInline = users * (sizeof(std::string) + sizeof(std::string_view)) +
+                            nSessions * (sizeof(std::string) + 2 * sizeof(std::string_view)) +
+                            inboxKeys.size() * sizeof(std::string_view);
+    std::size_t newHeap = (after.arenaBytes - before.arenaBytes) + (after.indexBytes - before.indexBytes) +
+                          nSessions * stringHeap(9);
+    for (const auto& p : roster) newHeap += stringHeap(p.name().size());
+
+    std::size_t oldTotal = oldInline + oldHeap, newTotal = newInline + newHeap;
+    auto mib = [](std::size_t b) { return b / (1024.0 * 1024.0); };
+    std::cout << std::fixed << std::setprecision(2)
+              << "users=" << users << " sessions=" << nSessions << " inboxes=" << inboxKeys.size() << "\n"
+              << "interned strings: " << after.strings - before.strings
+              << " (" << after.requests - before.requests << " intern requests)\n\n"
+              << std::left << std::setw(28) << "identity strings" << std::setw(14) << "inline MiB"
+              << std::setw(14) << "heap MiB" << "total MiB\n"
+              << std::setw(28) << "std::string per field" << std::setw(14) << mib(oldInline)
+              << std::setw(14) << mib(oldHeap) << mib(oldTotal) << "\n"
+              << std::setw(28) << "StringPool (arena+index)" << std::setw(14) << mib(newInline)
+              << std::setw(14) << mib(newHeap) << mib(newTotal) << "\n\n"
+              << "saved: " << mib(oldTotal - newTotal) << " MiB ("
+              << 100.0 * (oldTotal - newTotal) / oldTotal << "%)\n";
+    return 0;
+}
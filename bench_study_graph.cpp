@@ -0,0 +1,115 @@
+/***************************************************************************************
+ * bench_study_graph.cpp
+ * StudyGraph: cost of recording sessions (including delta compactions), 2-hop "partners
+ * of partners" queries vs scanning the whole session list per query, and the per-pair
+ * mutualScore MatchSuggester calls for each candidate.
+ *
+ * Students mostly study within a small cohort, with some sessions across cohorts, so
+ * degrees are small and uneven the way real study circles are.
+ *
+ * Usage: bench_study_graph [students=100000] [sessions=500000]
+ *
+ * STANDARD LIBRARIES USED:
+ *  <algorithm>     : top-N of the scan baseline
+ *  <chrono>        : timing
+ *  <iomanip>       : formatting
+ *  <iostream>      : report
+ *  <random>        : synthetic sessions
+ *  <string>        : student keys
+ *  <unordered_map> : scan baseline adjacency
+ *  <vector>        : session list
+ ****************************************************************************************/
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "StudyGraph.hpp"
+
+using namespace sb;
+using Clock = std::chrono::steady_clock;
+
+static double msSince(Clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+}
+
+// What a query costs without the graph: walk the session list twice (partners, then
+// their partners) and rank in a hash map.
+static std::size_t scanSuggest(const std::vector<std::pair<std::uint32_t, std::uint32_t>>& sessions,
+                               std::uint32_t u, std::size_t n) {
+    std::unordered_map<std::uint32_t, std::uint64_t> direct, score;
+    for (const auto& s : sessions) {
+        if (s.first == u) ++direct[s.second];
+        else if (s.second == u) ++direct[s.first];
+    }
+    for (const auto& s : sessions) {
+        auto a = direct.find(s.first), b = direct.find(s.second);
+        if (a != direct.end() && s.second != u) score[s.second] += a->second;
+        if (b != direct.end() && s.first != u) score[s.first] += b->second;
+    }
+    std::vector<std::pair<std::uint64_t, std::uint32_t>> rows;
+    for (auto& kv : score) {
+        if (!direct.count(kv.first)) rows.emplace_back(kv.second, kv.first);
+    }
+    std::size_t k = std::min(n, rows.size());
+    std::partial_sort(rows.begin(), rows.begin() + static_cast<std::ptrdiff_t>(k), rows.end(),
+                      [](const auto& a, const auto& b) { return a.first > b.first; });
+    return k;
+}
+
+int main(int argc, char** argv) {
+    std::size_t students = argc > 1 ? std::stoul(argv[1]) : 100000;
+    std::size_t count = argc > 2 ? std::stoul(argv[2]) : 500000;
+    const std::size_t cohort = 40;
+
+    std::vector<std::string> keys;
+    keys.reserve(students);
+    for (std::size_t i = 0; i < students; ++i) keys.push_back("s" + std::to_string(i) + "@clemson.edu");
+    std::mt19937 rng(47);
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> sessions;
+    sessions.reserve(count);
+    while (sessions.size() < count) {
+        auto a = static_cast<std::uint32_t>(rng() % students);
+        auto b = rng() % 8 ? static_cast<std::uint32_t>(a / cohort * cohort + rng() % cohort)
+                           : static_cast<std::uint32_t>(rng() % students);
+        if (a != b && b < students) sessions.emplace_back(a, b);
+    }
+
+    std::cout << std::fixed << std::setprecision(2)
+              << students << " students, " << count << " confirmed sessions\n";
+    StudyGraph g;
+    auto t0 = Clock::now();
+    for (const auto& s : sessions) g.addSessions(keys[s.first], keys[s.second]);
+    double addUs = msSince(t0) * 1000.0 / count;
+    std::cout << "record session            : " << addUs << " us/session (" << g.edgeCount() << " edges)\n";
+
+    const std::size_t queries = 20000;
+    std::size_t sink = 0;
+    t0 = Clock::now();
+    for (std::size_t q = 0; q < queries; ++q) sink += g.suggest(keys[q * 7919 % students], 10).size();
+    double graphUs = msSince(t0) * 1000.0 / queries;
+
+    const std::size_t scans = 10;
+    t0 = Clock::now();
+    for (std::size_t q = 0; q < scans; ++q) {
+        sink += scanSuggest(sessions, static_cast<std::uint32_t>(q * 7919 % students), 10);
+    }
+    double scanUs = msSince(t0) * 1000.0 / scans;
+    std::cout << "2-hop top-10, CSR rows    : " << graphUs << " us/query\n"
+              << "2-hop top-10, scan list   : " << std::setprecision(0) << scanUs << " us/query\n"
+              << std::setprecision(2);
+
+    t0 = Clock::now();
+    std::uint64_t total = 0;
+    for (std::size_t q = 0; q < queries; ++q) {
+        std::size_t u = q * 7919 % students;
+        total += g.mutualScore(keys[u], keys[u / cohort * cohort + q % cohort]);
+    }
+    double pairUs = msSince(t0) * 1000.0 / queries;
+    std::cout << "mutualScore (one pair)    : " << pairUs << " us/pair\n";
+    return sink + total == 0; // keep the work observable
+}
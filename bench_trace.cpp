@@ -0,0 +1,69 @@
+/***************************************************************************************
+ * bench_trace.cpp
+ * Cost of trace spans on MatchSuggester::suggest: tracing off vs on (every call sampled)
+ * vs on with 1-in-N sampling, plus the raw cost of an inert and a recorded span.
+ *
+ * Usage: bench_trace [users=50000] [calls=20]
+ *
+ * STANDARD LIBRARIES USED:
+ *  <chrono>   : timing
+ *  <iomanip>  : formatting
+ *  <iostream> : report
+ *  <string>   : argument parsing
+ *  <vector>   : roster
+ ****************************************************************************************/
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "MatchSuggester.hpp"
+#include "SyntheticRoster.hpp"
+#include "Trace.hpp"
+
+using namespace sb;
+using Clock = std::chrono::steady_clock;
+
+template <class F>
+static double bestOfMs(int reps, F&& f) {
+    double best = 1e300;
+    for (int r = 0; r < reps; ++r) {
+        auto t0 = Clock::now();
+        f();
+        double ms = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+        if (ms < best) best = ms;
+    }
+    return best;
+}
+
+int main(int argc, char** argv) {
+    std::size_t users = argc > 1 ? std::stoul(argv[1]) : 50000;
+    int calls = argc > 2 ? std::stoi(argv[2]) : 20;
+
+    auto roster = makeSyntheticRoster(users);
+    MatchSuggester m;
+    auto run = [&] { for (int i = 0; i < calls; ++i) m.suggest(roster[static_cast<std::size_t>(i)], roster); };
+
+    Tracer::enable(false);
+    double off = bestOfMs(3, run);
+    Tracer::enable(true);
+    Tracer::setSampleEvery(1);
+    double all = bestOfMs(3, run);
+    Tracer::setSampleEvery(10);
+    double sampled = bestOfMs(3, run);
+
+    constexpr int kSpans = 1000000;
+    Tracer::setSampleEvery(1);
+    double recordedNs = bestOfMs(3, [] { for (int i = 0; i < kSpans; ++i) TraceSpan s("x"); }) * 1e6 / kSpans;
+    Tracer::enable(false);
+    double inertNs = bestOfMs(3, [] { for (int i = 0; i < kSpans; ++i) TraceSpan s("x"); }) * 1e6 / kSpans;
+
+    std::cout << "users=" << users << " suggest calls=" << calls << "\n" << std::fixed << std::setprecision(2)
+              << "  tracing off        : " << off / calls << " ms/call\n"
+              << "  tracing on (1/1)   : " << all / calls << " ms/call\n"
+              << "  tracing on (1/10)  : " << sampled / calls << " ms/call\n"
+              << "  span cost          : " << inertNs << " ns inert, " << recordedNs << " ns recorded\n"
+              << "  buffered events    : " << Tracer::stats().events << " (dropped " << Tracer::stats().dropped << ")\n";
+    return 0;
+}
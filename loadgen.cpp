@@ -0,0 +1,173 @@
+/***************************************************************************************
+ * loadgen.cpp — study_buddy_loadgen
+ *
+ * Closed-loop load generator for study_buddy_server. Opens one connection per client
+ * thread, issues requests back to back and reports latency percentiles + throughput.
+ * Target users are drawn from the synthetic roster (run the server with --seed-roster).
+ *
+ * Usage:
+ *   study_buddy_loadgen [--socket PATH] [--concurrency C] [--requests N]
+ *                       [--op suggest|byname|bycourse|pending|ping] [--roster N]
+ *
+ * STANDARD LIBRARIES USED:
+ *  <algorithm> : sort for percentiles
+ *  <chrono>    : per-request timing
+ *  <iostream>  : report
+ *  <random>    : target user selection
+ *  <thread>    : client threads
+ *  <vector>    : latency samples
+ ****************************************************************************************/
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "Protocol.hpp"
+#include "SyntheticRoster.hpp"
+
+using namespace sb;
+using Clock = std::chrono::steady_clock;
+
+static int connectTo(const std::string& path) {
+    int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) return -1;
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static bool writeAll(int fd, const std::vector<std::uint8_t>& buf) {
+    std::size_t off = 0;
+    while (off < buf.size()) {
+        ssize_t w = ::send(fd, buf.data() + off, buf.size() - off, MSG_NOSIGNAL);
+        if (w <= 0) return false;
+        off += static_cast<std::size_t>(w);
+    }
+    return true;
+}
+
+static bool readExact(int fd, std::uint8_t* p, std::size_t n) {
+    while (n > 0) {
+        ssize_t r = ::read(fd, p, n);
+        if (r <= 0) return false;
+        p += r;
+        n -= static_cast<std::size_t>(r);
+    }
+    return true;
+}
+
+// Reads one response frame; returns false on disconnect.
+static bool readFrame(int fd, std::vector<std::uint8_t>& body) {
+    std::uint8_t hdr[4];
+    if (!readExact(fd, hdr, 4)) return false;
+    std::uint32_t n = static_cast<std::uint32_t>(hdr[0]) | (static_cast<std::uint32_t>(hdr[1]) << 8) |
+                      (static_cast<std::uint32_t>(hdr[2]) << 16) | (static_cast<std::uint32_t>(hdr[3]) << 24);
+    if (n > wire::kMaxFrameBytes) return false;
+    body.resize(n);
+    return readExact(fd, body.data(), n);
+}
+
+static std::vector<std::uint8_t> buildRequest(const std::string& op, std::uint32_t tag,
+                                              std::size_t user, std::mt19937& rng) {
+    wire::Writer w;
+    std::string email = "user" + std::to_string(user) + "@clemson.edu";
+    if (op == "suggest") {
+        w.u8(static_cast<std::uint8_t>(wire::Op::Suggest)); w.u32(tag);
+        w.str(email); w.i32(30); w.u16(5);
+    } else if (op == "byname") {
+        w.u8(static_cast<std::uint8_t>(wire::Op::SearchByName)); w.u32(tag);
+        w.str(email); w.str("student " + std::to_string(rng() % 100));
+    } else if (op == "bycourse") {
+        const auto& cat = syntheticCourseCatalog();
+        w.u8(static_cast<std::uint8_t>(wire::Op::SearchByCourse)); w.u32(tag);
+        w.str(email); w.str(cat[rng() % cat.size()]);
+    } else if (op == "pending") {
+        w.u8(static_cast<std::uint8_t>(wire::Op::PendingFor)); w.u32(tag);
+        w.str(email);
+    } else {
+        w.u8(static_cast<std::uint8_t>(wire::Op::Ping)); w.u32(tag);
+    }
+    return w.finishFrame();
+}
+
+int main(int argc, char** argv) {
+    std::string path = "/tmp/study_buddy.sock";
+    std::string op = "suggest";
+    std::size_t concurrency = 4, requests = 1000, roster = 1000;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string a = argv[i], v = argv[i + 1];
+        try {
+            if (a == "--socket")           path = v;
+            else if (a == "--op")          op = v;
+            else if (a == "--concurrency") concurrency = std::max<std::size_t>(1, std::stoul(v));
+            else if (a == "--requests")    requests = std::stoul(v);
+            else if (a == "--roster")      roster = std::max<std::size_t>(1, std::stoul(v));
+            else { std::cerr << "Unknown option: " << a << "\n"; return 2; }
+        } catch (...) {
+            std::cerr << "Invalid value for " << a << "\n";
+            return 2;
+        }
+    }
+
+    std::vector<std::vector<double>> samples(concurrency);
+    std::atomic<std::size_t> failures{0};
+    std::vector<std::thread> clients;
+
+    auto t0 = Clock::now();
+    for (std::size_t c = 0; c < concurrency; ++c) {
+        clients.emplace_back([&, c] {
+            int fd = connectTo(path);
+            if (fd < 0) { failures += requests; return; }
+            std::mt19937 rng(static_cast<unsigned>(c * 7919 + 1));
+            std::vector<std::uint8_t> body;
+            samples[c].reserve(requests);
+            for (std::size_t r = 0; r < requests; ++r) {
+                auto req = buildRequest(op, static_cast<std::uint32_t>(r), rng() % roster, rng);
+                auto start = Clock::now();
+                if (!writeAll(fd, req) || !readFrame(fd, body)) { failures += requests - r; break; }
+                auto us = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+                samples[c].push_back(us);
+                if (body.empty() || body[0] != static_cast<std::uint8_t>(wire::Status::Ok)) ++failures;
+            }
+            ::close(fd);
+        });
+    }
+    for (auto& t : clients) t.join();
+    double secs = std::chrono::duration<double>(Clock::now() - t0).count();
+
+    std::vector<double> all;
+    for (auto& s : samples) all.insert(all.end(), s.begin(), s.end());
+    if (all.empty()) {
+        std::cerr << "No successful requests (is the server running on " << path << "?)\n";
+        return 1;
+    }
+    std::sort(all.begin(), all.end());
+    auto pct = [&](double p) {
+        std::size_t idx = static_cast<std::size_t>(p * static_cast<double>(all.size() - 1));
+        return all[idx];
+    };
+
+    std::cout << std::fixed << std::setprecision(1)
+              << "op=" << op << " concurrency=" << concurrency
+              << " requests=" << all.size() << " failures=" << failures.load() << "\n"
+              << "throughput: " << static_cast<double>(all.size()) / secs << " req/s\n"
+              << "latency us: p50=" << pct(0.50) << " p99=" << pct(0.99)
+              << " max=" << all.back() << "\n";
+    return 0;
+}
@@ -2,26 +2,39 @@
  * main.cpp — Study Buddy (CLI) — ALL FEATURES WIRED
  *
  * This demo keeps everything in-memory:
- *  - "Me" (your profile) + a vector<Profile> "roster" (classmates)
+ *  - A Roster owning every profile; "me" is a handle to your own entry
  *  - NotificationCenter for inboxes
  *  - SessionRequests for sending/confirming/canceling sessions
  *
  * STANDARD LIBRARIES USED:
  *  <iostream>  : CLI I/O
  *  <string>    : input text
- *  <vector>    : roster of classmates, course lists
+ *  <vector>    : course lists, query results
  *  <limits>    : input flushing
  *  <algorithm> : simple searches/sorts where needed
+ *  <chrono>    : metrics dump interval
+ *  <memory>    : optional metrics dumper
+ *  <fstream>   : optional change feed file
+ *  <ctime>     : "now" for the next common window search
  *
  * MODULES USED (your headers):
- *  Utils.hpp, Profile.hpp, CourseManager.hpp, AvailabilityManager.hpp
+ *  Utils.hpp, Profile.hpp, Roster.hpp, CourseManager.hpp, AvailabilityManager.hpp
  *  AvailabilityEditor.hpp, AvailabilityBrowser.hpp, MatchSuggester.hpp
  *  ClassmateSearch.hpp, NotificationCenter.hpp, SessionRequests.hpp, CalendarView.hpp
+ *  AllocStats.hpp, Metrics.hpp, Trace.hpp, FuzzySearch.hpp, Autocomplete.hpp
+ *  OccupancyIndex.hpp, CourseHeatmap.hpp, ProfileHistory.hpp, ChangeLog.hpp
+ *  CommonWindow.hpp, CoEnrollment.hpp, StudyGraph.hpp
  *
  * Notes:
  *  - Identity uses email primarily (fallback to name if email blank).
  *  - Times are minutes since midnight; format "HH:MM" for input/output.
  *  - This is a CLI demo; persistence (save/load) is not included yet.
+ *  - Run with --stats to print per-operation allocation counts (AllocStats) on exit.
+ *  - Run with --metrics FILE to dump API latency metrics (Prometheus text, or JSON for a
+ *    *.json path) to FILE every 10 seconds and on exit.
+ *  - Run with --trace FILE to record trace spans and write them as Chrome trace JSON on exit.
+ *  - Run with --changes FILE to append every profile/session change (ChangeLog) to FILE,
+ *    one "seq<TAB>kind<TAB>subject" line per event.
  ****************************************************************************************/
 
  #include <iostream>
@@ -29,9 +42,14 @@
  #include <vector>
  #include <limits>
  #include <algorithm>
+ #include <chrono>
+ #include <memory>
+ #include <fstream>
+ #include <ctime>
  
  #include "Utils.hpp"
  #include "Profile.hpp"
+ #include "Roster.hpp"
  #include "CourseManager.hpp"
  #include "AvailabilityManager.hpp"
  #include "AvailabilityEditor.hpp"
@@ -41,6 +59,18 @@
  #include "NotificationCenter.hpp"
  #include "SessionRequests.hpp"
  #include "CalendarView.hpp"
+ #include "AllocStats.hpp"
+ #include "Metrics.hpp"
+ #include "Trace.hpp"
+ #include "FuzzySearch.hpp"
+ #include "Autocomplete.hpp"
+ #include "OccupancyIndex.hpp"
+ #include "CourseHeatmap.hpp"
+ #include "ProfileHistory.hpp"
+ #include "ChangeLog.hpp"
+ #include "CommonWindow.hpp"
+ #include "CoEnrollment.hpp"
+ #include "StudyGraph.hpp"
  
  using namespace sb;
  
@@ -62,6 +92,7 @@
  5)  Add Availability (ME)
  6)  Remove Availability (ME)
  7)  Edit Availability (ME)
+ 23) Undo My Last Profile Change
  
  ------ Classmates (Roster) ------
  8)  Add a Classmate Profile (for testing)
@@ -72,6 +103,11 @@
  11) Search Classmates by Name
  12) Browse Classmates’ Availability by Course
  13) Browse Classmates’ Availability by Course & Day
+ 21) Who Is Free in a Course (day + time window)
+ 22) Course Availability Heatmap + Best Meeting Window
+ 24) Next Free Time in Common with Classmates
+ 25) Courses Often Taken with a Course
+ 26) Classmates Your Study Partners Study With
  
  ------ Requests / Notifications / Calendar ------
  14) Send Study Session Request
@@ -98,6 +134,13 @@
      return static_cast<Day>(choice - 1);
  }
  
+ // Current local day and time as a point in the weekly timetable (Monday first).
+ static WeekTime nowInWeek() {
+     std::time_t t = std::time(nullptr);
+     std::tm local = *std::localtime(&t);
+     return WeekTime{static_cast<Day>((local.tm_wday + 6) % 7), local.tm_hour * 60 + local.tm_min};
+ }
+ 
  static int promptTime(const std::string& label) {
      while (true) {
          std::cout << label << " (24h HH:MM): ";
@@ -117,7 +160,7 @@
      std::cout << "Classmates:\n";
      for (size_t i = 0; i < roster.size(); ++i) {
          const Profile& p = roster[i];
-         // Skip ME (assume me is roster[0])
+         // Skip ME
          if ((!p.email().empty() && p.email() == me.email()) ||
              (!p.name().empty()  && !me.name().empty() && p.name() == me.name())) {
              continue;
@@ -129,35 +172,136 @@
      }
  }
  
- /* Find classmate by email (exact) */
- static const Profile* findByEmail(const std::vector<Profile>& roster, const std::string& email) {
-     for (const auto& p : roster) {
-         if (!email.empty() && trim(p.email()) == trim(email)) return &p;
+ /* Course codes starting with what was typed, most enrolled first ("CPSC 21" → CPSC 2150) */
+ static void printCourseHints(const Autocomplete& ac, const std::string& typed) {
+     auto hints = ac.courses(typed, 5);
+     if (hints.empty()) return;
+     std::cout << "Courses starting with \"" << typed << "\":\n";
+     for (const auto& h : hints) {
+         std::cout << "  - " << h.text << " (" << h.count << " enrolled)\n";
      }
-     return nullptr;
  }
- 
+
+ /* Weekly heatmap of a course, 08:00-22:00 in 15-minute columns, shaded by share of the class free */
+ static void printHeatmap(const CourseHeatmap& map, const std::string& course) {
+     const int first = 8 * 60 / CourseHeatmap::kBucketMinutes;
+     const int last  = 22 * 60 / CourseHeatmap::kBucketMinutes;
+     const int perHour = 60 / CourseHeatmap::kBucketMinutes;
+     const char* shades = " .:-=+*#%@";
+     int enrolled = map.enrolled(course);
+
+     std::cout << "     ";
+     for (int b = first; b < last; b += perHour) {
+         std::string hour = std::to_string(b / perHour);
+         std::cout << hour << std::string(static_cast<size_t>(perHour) - hour.size(), ' ');
+     }
+     std::cout << "\n";
+     for (int d = 0; d < 7; ++d) {
+         auto counts = map.dayCounts(course, static_cast<Day>(d));
+         std::cout << std::string(kDayNames[d]).substr(0, 3) << "  ";
+         for (int b = first; b < last; ++b) {
+             int level = enrolled ? counts[static_cast<size_t>(b)] * 9 / enrolled : 0;
+             std::cout << shades[level];
+         }
+         std::cout << "\n";
+     }
+     std::cout << "Scale: ' ' nobody free ... '@' everyone free (" << enrolled << " enrolled)\n";
+ }
+
  /* -------------------------- main() -------------------------- */
  
- int main() {
-     // Core single-user + roster
-     Profile me; // me will be added as roster[0] once created
-     std::vector<Profile> roster; // [0] reserved for me when exists
+ int main(int argc, char** argv) {
+     bool stats = false;
+     std::string metricsPath;
+     std::string tracePath;
+     std::string changesPath;
+     for (int i = 1; i < argc; ++i) {
+         std::string a = argv[i];
+         if (a == "--stats") stats = true;
+         else if (a == "--metrics" && i + 1 < argc) metricsPath = argv[++i];
+         else if (a == "--trace" && i + 1 < argc) tracePath = argv[++i];
+         else if (a == "--changes" && i + 1 < argc) changesPath = argv[++i];
+         else {
+             std::cerr << "usage: " << argv[0] << " [--stats] [--metrics FILE] [--trace FILE] [--changes FILE]\n";
+             return 2;
+         }
+     }
+     AllocStats::enable(stats);
+     Tracer::enable(!tracePath.empty());
+     std::unique_ptr<MetricsDumper> metricsDumper;
+     if (!metricsPath.empty()) {
+         metricsDumper = std::make_unique<MetricsDumper>(Metrics::global(), metricsPath,
+                                                         std::chrono::seconds(10));
+     }
+ 
+     // Every profile lives in the roster; 'me' refers to your own entry once created
+     Roster roster;
+     Roster::Handle me;
+
+     // Typo-tolerant name index for "Search by Name", kept current by roster change events
+     FuzzyNameIndex fuzzyNames;
+     roster.subscribe([&](const RosterChange& c) { fuzzyNames.add(c.id, c.profile); });
+
+     // Course/name completions, following course adds/removes through the same events
+     Autocomplete completions;
+     roster.subscribe([&](const RosterChange& c) { completions.update(c.id, c.profile); });
+
+     // Per-course, per-day free intervals for "who is free" queries
+     OccupancyIndex occupancy;
+     roster.subscribe([&](const RosterChange& c) { occupancy.update(c.id, c.profile); });
+
+     // Per-course weekly free-student histogram for the heatmap
+     CourseHeatmap heatmap;
+     roster.subscribe([&](const RosterChange& c) { heatmap.update(c.id, c.profile); });
+
+     // Course co-enrollment counts ("also take"; ranks equal-overlap match suggestions)
+     CoEnrollment coEnrollment;
+     roster.subscribe([&](const RosterChange& c) { coEnrollment.update(c.id, c.profile); });
+
+     // Version log of every profile (undo for course and availability edits)
+     ProfileHistory history(roster);
+
+     // Typed change stream from the roster and session requests
+     ChangeLog changes;
+     changes.watch(roster);
+     std::ofstream changeFeed;
+     if (!changesPath.empty()) {
+         changeFeed.open(changesPath, std::ios::app);
+         if (!changeFeed) { std::cerr << "changes: cannot open " << changesPath << "\n"; return 2; }
+         changes.subscribe([&](const ChangeEvent& e) {
+             changeFeed << e.seq << '\t' << changeKindName(e.kind) << '\t'
+                        << (e.isProfileEvent() ? std::string(e.profile.email()) : e.session.id) << std::endl;
+         });
+     }
  
+     // Who has studied with whom (confirmed sessions; ranks equal-overlap match suggestions)
+     StudyGraph studyGraph;
+     studyGraph.watch(changes);
+
      // Managers
      CourseManager courseMgr;
      AvailabilityManager availMgr;
      AvailabilityEditor availEditor;
      NotificationCenter notif;
-     SessionRequests sessions(&notif);
+     SessionRequests sessions(&notif, &changes);
      MatchSuggester matcher;
+     matcher.useCoEnrollment(&coEnrollment);
+     matcher.useStudyGraph(&studyGraph);
  
      while (true) {
          printMainMenu();
-         int choice = promptIntInRange("Choose an option [0-20]: ", 0, 20);
+         int choice = promptIntInRange("Choose an option [0-26]: ", 0, 26);
  
          if (choice == 0) {
              std::cout << "Goodbye!\n";
+             if (stats) {
+                 std::cout << "\n--- Allocation stats ---\n";
+                 AllocStats::print(std::cout);
+             }
+             if (!tracePath.empty()) {
+                 std::string err;
+                 if (!Tracer::flushToFile(tracePath, err)) std::cerr << "trace: " << err << "\n";
+             }
              return 0;
          }
  
@@ -174,57 +318,56 @@
              auto tokens = split(raw, ',');
              auto normalized = CourseManager::normalizeDedup(tokens);
  
-             me.createOrReset(name, email, normalized);
- 
-             // Put ME at roster[0]; if first time, push_back; else replace index 0
-             if (roster.empty()) roster.push_back(me);
-             else roster[0] = me;
+             if (!me.valid()) {
+                 Profile p;
+                 p.createOrReset(name, email, normalized);
+                 me = roster.add(std::move(p));
+             } else {
+                 roster.edit(me, [&](Profile& p) { p.createOrReset(name, email, normalized); });
+             }
  
              std::cout << "Profile created/reset successfully.\n";
-             me.show();
+             me->show();
              break;
          }
          case 2: { // View MY Profile
-             me.show();
+             me->show();
              pauseEnter();
              break;
          }
          case 3: { // Add Courses (ME)
-             if (!me.exists()) { std::cout << "Create your profile first.\n"; break; }
+             if (!me->exists()) { std::cout << "Create your profile first.\n"; break; }
              std::cout << "Enter courses to ADD (comma-separated):\n> ";
              std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
              std::string line = trim(safeGetLine());
-             courseMgr.addCourses(me, line);
-             roster[0] = me;
+             roster.edit(me, [&](Profile& p) { courseMgr.addCourses(p, line); });
              break;
          }
          case 4: { // Remove Courses (ME)
-             if (!me.exists()) { std::cout << "Create your profile first.\n"; break; }
+             if (!me->exists()) { std::cout << "Create your profile first.\n"; break; }
              std::cout << "Your current courses:\n";
-             me.printCourses();
+             me->printCourses();
              std::cout << "Enter indices to REMOVE (comma-separated), e.g., 2,4 :\n> ";
              std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
              std::string line = trim(safeGetLine());
-             courseMgr.removeCourses(me, line);
-             roster[0] = me;
+             roster.edit(me, [&](Profile& p) { courseMgr.removeCourses(p, line); });
              break;
          }
          case 5: { // Add Availability (ME)
-             if (!me.exists()) { std::cout << "Create your profile first.\n"; break; }
+             if (!me->exists()) { std::cout << "Create your profile first.\n"; break; }
              Day d = promptDay();
              std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
              int startMin = promptTime("Start time");
              int endMin   = promptTime("End time");
              if (endMin <= startMin) { std::cout << "End must be after start.\n"; break; }
-             availMgr.addAvailability(me, d, startMin, endMin);
-             roster[0] = me;
+             roster.edit(me, [&](Profile& p) { availMgr.addAvailability(p, d, startMin, endMin); });
              break;
          }
          case 6: { // Remove Availability (ME)
-             if (!me.exists()) { std::cout << "Create your profile first.\n"; break; }
+             if (!me->exists()) { std::cout << "Create your profile first.\n"; break; }
              std::cout << "Current availability:\n";
-             AvailabilityManager::listIndexed(me);
-             std::cout << "Enter an index to remove (or 0 to cancel): ";
+             AvailabilityManager::listIndexed(*me);
+             std::cout << "Enter an index to remove, -1 to clear a time range (or 0 to cancel): ";
              int idx;
              if (!(std::cin >> idx)) {
                  std::cin.clear();
@@ -233,15 +376,25 @@
              }
              std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
              if (idx == 0) { std::cout << "Cancelled.\n"; break; }
-             availMgr.removeAvailability(me, idx);
-             roster[0] = me;
+             if (idx == -1) {
+                 Day d = promptDay();
+                 std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+                 int startMin = promptTime("Clear from");
+                 int endMin   = promptTime("Clear until");
+                 if (endMin <= startMin) { std::cout << "End must be after start.\n"; break; }
+                 bool removed = false;
+                 roster.edit(me, [&](Profile& p) { removed = AvailabilityManager::removeRange(p, d, startMin, endMin); });
+                 std::cout << (removed ? "Time range cleared.\n" : "You were not free in that range.\n");
+                 break;
+             }
+             roster.edit(me, [&](Profile& p) { availMgr.removeAvailability(p, idx); });
              break;
          }
          case 7: { // Edit Availability (ME)
-             if (!me.exists()) { std::cout << "Create your profile first.\n"; break; }
-             if (me.availability().empty()) { std::cout << "You have no availability to edit.\n"; break; }
+             if (!me->exists()) { std::cout << "Create your profile first.\n"; break; }
+             if (me->availability().empty()) { std::cout << "You have no availability to edit.\n"; break; }
              std::cout << "Current availability:\n";
-             AvailabilityManager::listIndexed(me);
+             AvailabilityManager::listIndexed(*me);
              std::cout << "Enter index to EDIT: ";
              int idx; if (!(std::cin >> idx)) {
                  std::cin.clear();
@@ -253,8 +406,7 @@
              int startMin = promptTime("New start");
              int endMin   = promptTime("New end");
              std::cin.clear();
-             bool ok = availEditor.editSlot(me, idx, d, startMin, endMin);
-             if (ok) roster[0] = me;
+             roster.edit(me, [&](Profile& p) { availEditor.editSlot(p, idx, d, startMin, endMin); });
              break;
          }
          case 8: { // Add a Classmate Profile
@@ -279,43 +431,31 @@
                  int startMin = promptTime("Start");
                  int endMin   = promptTime("End");
                  if (endMin > startMin) {
-                     AvailabilitySlot s{d, startMin, endMin};
-                     p.availabilityMutable().push_back(s);
-                     // Merge like in AvailabilityManager (quick sort/merge):
-                     std::vector<AvailabilitySlot>& v = p.availabilityMutable();
-                     std::sort(v.begin(), v.end(), [](const AvailabilitySlot& a, const AvailabilitySlot& b){
-                         if (a.day != b.day) return static_cast<int>(a.day) < static_cast<int>(b.day);
-                         return a.start < b.start;
-                     });
-                     std::vector<AvailabilitySlot> merged;
-                     for (const auto& slot : v) {
-                         if (merged.empty() || merged.back().day != slot.day || merged.back().end < slot.start) {
-                             merged.push_back(slot);
-                         } else {
-                             merged.back().end = std::max(merged.back().end, slot.end);
-                         }
-                     }
-                     v.swap(merged);
+                     AvailabilityManager::addMerged(p, AvailabilitySlot{d, startMin, endMin});
                  }
              }
  
-             roster.push_back(p);
+             roster.add(std::move(p));
              std::cout << "Classmate added.\n";
              break;
          }
          case 9: { // List Classmates
-             if (!me.exists()) { std::cout << "Create your profile first.\n"; break; }
-             listClassmates(roster, me);
+             if (!me->exists()) { std::cout << "Create your profile first.\n"; break; }
+             listClassmates(roster.profiles(), *me);
              pauseEnter();
              break;
          }
          case 10: { // Search by Course
-             if (!me.exists()) { std::cout << "Create your profile first.\n"; break; }
+             if (!me->exists()) { std::cout << "Create your profile first.\n"; break; }
              std::cout << "Course code to search (e.g., CPSC 2150): ";
              std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
              std::string code = trim(safeGetLine());
-             auto results = ClassmateSearch::byCourse(roster, me, code);
-             if (results.empty()) { std::cout << "No classmates found for that course.\n"; break; }
+             auto results = ClassmateSearch::byCourse(roster.profiles(), *me, code);
+             if (results.empty()) {
+                 std::cout << "No classmates found for that course.\n";
+                 printCourseHints(completions, code);
+                 break;
+             }
              std::cout << "Found:\n";
              for (auto* p : results) {
                  std::cout << "  - " << (p->name().empty()? "(no name)" : p->name())
@@ -324,12 +464,24 @@
              break;
          }
          case 11: { // Search by Name
-             if (!me.exists()) { std::cout << "Create your profile first.\n"; break; }
+             if (!me->exists()) { std::cout << "Create your profile first.\n"; break; }
              std::cout << "Name (or part of it): ";
              std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
              std::string q = trim(safeGetLine());
-             auto results = ClassmateSearch::byName(roster, me, q);
-             if (results.empty()) { std::cout << "No classmates matched that name.\n"; break; }
+             auto results = ClassmateSearch::byName(roster.profiles(), *me, q);
+             if (results.empty()) {
+                 // Fall back to near matches: 1 typo for short queries, 2 otherwise
+                 auto close = ClassmateSearch::byNameFuzzy(fuzzyNames, roster.profiles(), *me, q,
+                                                           q.size() <= 4 ? 1 : 2);
+                 if (close.empty()) { std::cout << "No classmates matched that name.\n"; break; }
+                 std::cout << "No exact matches. Did you mean:\n";
+                 for (const auto& m : close) {
+                     std::cout << "  - " << (m.person->name().empty()? "(no name)" : m.person->name())
+                               << " <" << m.person->email() << ">"
+                               << " (" << m.distance << (m.distance == 1 ? " edit" : " edits") << ")\n";
+                 }
+                 break;
+             }
              std::cout << "Found:\n";
              for (auto* p : results) {
                  std::cout << "  - " << (p->name().empty()? "(no name)" : p->name())
@@ -338,17 +490,21 @@
              break;
          }
          case 12: { // Browse availability by course
-             if (!me.exists()) { std::cout << "Create your profile first.\n"; break; }
+             if (!me->exists()) { std::cout << "Create your profile first.\n"; break; }
              std::cout << "Course code: ";
              std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
              std::string code = trim(safeGetLine());
-             auto list = AvailabilityBrowser::browseByCourse(roster, me, code);
-             if (list.empty()) { std::cout << "No classmates in that course.\n"; break; }
-             for (auto& entry : list) {
-                 std::cout << entry.first << ":\n";
-                 if (entry.second.empty()) { std::cout << "  (no availability)\n"; continue; }
+             auto list = AvailabilityBrowser::browseByCourseView(roster.profiles(), *me, code);
+             if (list.empty()) {
+                 std::cout << "No classmates in that course.\n";
+                 printCourseHints(completions, code);
+                 break;
+             }
+             for (const auto& entry : list) {
+                 std::cout << entry.name << ":\n";
+                 if (entry.slots.empty()) { std::cout << "  (no availability)\n"; continue; }
                  Day current = static_cast<Day>(-1);
-                 for (const auto& s : entry.second) {
+                 for (const auto& s : entry.slots) {
                      if (current != s.day) {
                          current = s.day;
                          std::cout << "  " << kDayNames[static_cast<int>(s.day)] << ": ";
@@ -361,20 +517,20 @@
              break;
          }
          case 13: { // Browse availability by course & day
-             if (!me.exists()) { std::cout << "Create your profile first.\n"; break; }
+             if (!me->exists()) { std::cout << "Create your profile first.\n"; break; }
              std::cout << "Course code: ";
              std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
              std::string code = trim(safeGetLine());
              Day d = promptDay();
-             auto list = AvailabilityBrowser::browseByCourseAndDay(roster, me, code, d);
+             auto list = AvailabilityBrowser::browseByCourseAndDayView(roster.profiles(), *me, code, d);
              if (list.empty()) {
                  std::cout << "No classmates have availability on "
                            << kDayNames[static_cast<int>(d)] << " for that course.\n";
                  break;
              }
-             for (auto& entry : list) {
-                 std::cout << entry.first << ":\n";
-                 for (const auto& s : entry.second) {
+             for (const auto& entry : list) {
+                 std::cout << entry.name << ":\n";
+                 for (const auto& s : entry.slots) {
                      std::cout << "  " << kDayNames[static_cast<int>(s.day)] << " "
                                << formatHHMM(s.start) << "-" << formatHHMM(s.end) << "\n";
                  }
@@ -382,11 +538,11 @@
              break;
          }
          case 14: { // Send study request
-             if (!me.exists()) { std::cout << "Create your profile first.\n"; break; }
+             if (!me->exists()) { std::cout << "Create your profile first.\n"; break; }
              std::cout << "Invitee email: ";
              std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
              std::string email = trim(safeGetLine());
-             const Profile* target = findByEmail(roster, email);
+             const Profile* target = roster.findByEmail(email);
              if (!target) { std::cout << "No classmate found with that email.\n"; break; }
  
              std::cout << "Course code: ";
@@ -394,37 +550,53 @@
              Day d = promptDay();
              int startMin = promptTime("Start");
              int endMin   = promptTime("End");
-             const auto& s = sessions.sendRequest(me, *target, code, d, startMin, endMin);
-             std::cout << "Sent request " << s.id << " to " << target->email() << ".\n";
+             auto sent = sessions.trySendRequest(*me, *target, code, d, startMin, endMin);
+             switch (sent.admission) {
+             case SessionRequests::Admission::Admitted:
+                 std::cout << "Sent request " << sent.session->id << " to " << target->email() << ".\n";
+                 break;
+             case SessionRequests::Admission::Coalesced:
+                 std::cout << "You already have request " << sent.session->id
+                           << " pending with " << target->email() << " for that time.\n";
+                 break;
+             case SessionRequests::Admission::RequesterThrottled:
+                 std::cout << "You have sent too many requests recently. Try again later.\n";
+                 break;
+             case SessionRequests::Admission::InviteeThrottled:
+                 std::cout << target->email() << " is receiving too many requests right now. Try again later.\n";
+                 break;
+             case SessionRequests::Admission::InviteeQueueFull:
+                 std::cout << target->email() << " has too many unanswered requests. Try again later.\n";
+                 break;
+             }
              break;
          }
          case 15: { // View MY pending requests (as invitee)
-             if (!me.exists()) { std::cout << "Create your profile first.\n"; break; }
-             auto pending = sessions.pendingFor(me);
+             if (!me->exists()) { std::cout << "Create your profile first.\n"; break; }
+             auto pending = sessions.pendingRefs(*me);
              if (pending.empty()) { std::cout << "No pending requests.\n"; break; }
-             for (const auto& s : pending) {
-                 std::cout << "[" << s.id << "] "
-                           << kDayNames[static_cast<int>(s.day)] << " "
-                           << formatHHMM(s.start) << "-" << formatHHMM(s.end)
-                           << " " << s.course
-                           << " from " << s.requester << "\n";
+             for (const StudySession* s : pending) {
+                 std::cout << "[" << s->id << "] "
+                           << kDayNames[static_cast<int>(s->day)] << " "
+                           << formatHHMM(s->start) << "-" << formatHHMM(s->end)
+                           << " " << s->course
+                           << " from " << s->requester << "\n";
              }
              break;
          }
          case 16: { // Confirm a pending request (ME)
-             if (!me.exists()) { std::cout << "Create your profile first.\n"; break; }
-             auto pending = sessions.pendingFor(me);
-             if (pending.empty()) { std::cout << "No pending requests.\n"; break; }
+             if (!me->exists()) { std::cout << "Create your profile first.\n"; break; }
+             if (sessions.pendingRefs(*me).empty()) { std::cout << "No pending requests.\n"; break; }
              std::cout << "Enter request ID to confirm: ";
              std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
              std::string id = trim(safeGetLine());
-             bool ok = sessions.confirmRequest(id, me);
+             bool ok = sessions.confirmRequest(id, *me);
              std::cout << (ok ? "Confirmed.\n" : "Could not confirm (check ID or permissions).\n");
              break;
          }
          case 17: { // Notifications
-             if (!me.exists()) { std::cout << "Create your profile first.\n"; break; }
-             std::string key = me.email().empty() ? me.name() : me.email();
+             if (!me->exists()) { std::cout << "Create your profile first.\n"; break; }
+             std::string key(me->email().empty() ? me->name() : me->email());
              auto msgs = notif.fetchAndClear(trim(key));
              if (msgs.empty()) { std::cout << "(No notifications)\n"; break; }
              std::cout << "Notifications:\n";
@@ -432,10 +604,10 @@
              break;
          }
          case 18: { // Calendar list (confirmed)
-             if (!me.exists()) { std::cout << "Create your profile first.\n"; break; }
-             auto list = CalendarView::list(me, sessions);
+             if (!me->exists()) { std::cout << "Create your profile first.\n"; break; }
+             auto list = CalendarView::list(*me, sessions);
              if (list.empty()) { std::cout << "(No confirmed sessions)\n"; break; }
-             std::string myKey = trim(me.email().empty() ? me.name() : me.email());
+             std::string myKey(trimView(me->email().empty() ? me->name() : me->email()));
              std::cout << "Your confirmed sessions:\n";
              for (const auto& s : list) {
                  std::cout << "  " << CalendarView::pretty(s, myKey) << "\n";
@@ -443,18 +615,18 @@
              break;
          }
          case 19: { // Cancel confirmed
-             if (!me.exists()) { std::cout << "Create your profile first.\n"; break; }
-             auto list = CalendarView::list(me, sessions);
+             if (!me->exists()) { std::cout << "Create your profile first.\n"; break; }
+             auto list = CalendarView::list(*me, sessions);
              if (list.empty()) { std::cout << "(No confirmed sessions)\n"; break; }
              std::cout << "Enter session ID to cancel: ";
              std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
              std::string id = trim(safeGetLine());
-             bool ok = CalendarView::cancel(id, me, sessions);
+             bool ok = CalendarView::cancel(id, *me, sessions);
              std::cout << (ok ? "Canceled.\n" : "Could not cancel (check ID or permissions).\n");
              break;
          }
          case 20: { // Match suggestions
-             if (!me.exists()) { std::cout << "Create your profile first.\n"; break; }
+             if (!me->exists()) { std::cout << "Create your profile first.\n"; break; }
              std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
              std::cout << "Minimum overlap minutes (default 30): ";
              std::string mins = trim(safeGetLine());
@@ -468,7 +640,7 @@
              if (!maxr.empty()) {
                  try { k = static_cast<size_t>(std::max(1, std::stoi(maxr))); } catch(...) {}
              }
-             auto matches = matcher.suggest(me, roster, minOverlap, k);
+             auto matches = matcher.suggest(*me, roster.profiles(), minOverlap, k);
              if (matches.empty()) { std::cout << "No suggestions at the moment.\n"; break; }
              std::cout << "Suggestions:\n";
              for (const auto& m : matches) {
@@ -483,6 +655,158 @@
              }
              break;
          }
+         case 21: { // Who is free in a course (day + window)
+             if (!me->exists()) { std::cout << "Create your profile first.\n"; break; }
+             std::cout << "Course code: ";
+             std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+             std::string code = trim(safeGetLine());
+             Day d = promptDay();
+             std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+             int startMin = promptTime("From");
+             int endMin   = promptTime("To");
+             if (endMin <= startMin) { std::cout << "End must be after start.\n"; break; }
+
+             auto full = AvailabilityBrowser::freeInWindow(occupancy, roster.profiles(), *me, code, d,
+                                                           startMin, endMin);
+             auto some = AvailabilityBrowser::freeInWindow(occupancy, roster.profiles(), *me, code, d,
+                                                           startMin, endMin, OccupancyIndex::Match::Partial);
+             if (some.empty()) {
+                 std::cout << "Nobody in that course is free then.\n";
+                 printCourseHints(completions, code);
+                 break;
+             }
+             std::cout << "Free the whole time:\n";
+             if (full.empty()) std::cout << "  (nobody)\n";
+             for (const auto& e : full) std::cout << "  - " << e.name << "\n";
+             if (some.size() > full.size()) {
+                 std::cout << "Free part of the time:\n";
+                 for (const auto& e : some) {
+                     bool whole = std::any_of(full.begin(), full.end(),
+                                              [&](const ClassmateSlotsView& f) { return f.person == e.person; });
+                     if (whole) continue;
+                     std::cout << "  - " << e.name << ":";
+                     for (const auto& s : e.slots) {
+                         if (s.end > startMin && s.start < endMin) {
+                             std::cout << " " << formatHHMM(s.start) << "-" << formatHHMM(s.end);
+                         }
+                     }
+                     std::cout << "\n";
+                 }
+             }
+             break;
+         }
+         case 22: { // Course heatmap + best window
+             std::cout << "Course code: ";
+             std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+             std::string code = trim(safeGetLine());
+             if (heatmap.enrolled(code) == 0) {
+                 std::cout << "Nobody is enrolled in that course.\n";
+                 printCourseHints(completions, code);
+                 break;
+             }
+             printHeatmap(heatmap, code);
+             std::cout << "Meeting length in minutes (default 90): ";
+             std::string len = trim(safeGetLine());
+             int minutes = 90;
+             if (!len.empty()) {
+                 try { minutes = std::max(1, std::stoi(len)); } catch(...) {}
+             }
+             auto best = heatmap.bestWindow(code, minutes, std::nullopt, 8 * 60, 22 * 60);
+             if (!best) { std::cout << "That meeting does not fit between 08:00 and 22:00.\n"; break; }
+             std::cout << "Best window: " << kDayNames[static_cast<int>(best->day)] << " "
+                       << formatHHMM(best->start) << "-" << formatHHMM(best->end)
+                       << " (on average " << best->averageFree << " of " << heatmap.enrolled(code)
+                       << " free; at least " << best->minFree << " in every 15 minutes)\n";
+             break;
+         }
+         case 23: { // Undo last profile change (ME)
+             if (!me->exists()) { std::cout << "Create your profile first.\n"; break; }
+             if (!history.undo(me.id())) { std::cout << "Nothing to undo.\n"; break; }
+             std::cout << "Undone. Your profile is now:\n";
+             me->show();
+             break;
+         }
+         case 24: { // Next common free window with one or more classmates
+             if (!me->exists()) { std::cout << "Create your profile first.\n"; break; }
+             std::cout << "Classmate email(s), comma-separated: ";
+             std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+             std::vector<const Profile*> people{&*me};
+             bool unknown = false;
+             for (const auto& raw : split(safeGetLine(), ',')) {
+                 std::string email = trim(raw);
+                 if (email.empty()) continue;
+                 const Profile* p = roster.findByEmail(email);
+                 if (!p) { std::cout << "No classmate found with email " << email << ".\n"; unknown = true; break; }
+                 people.push_back(p);
+             }
+             if (unknown) break;
+             if (people.size() < 2) { std::cout << "Enter at least one classmate.\n"; break; }
+
+             std::cout << "Meeting length in minutes (default 60): ";
+             std::string len = trim(safeGetLine());
+             int minutes = 60;
+             if (!len.empty()) {
+                 try { minutes = std::max(1, std::stoi(len)); } catch(...) {}
+             }
+             WeekTime from = nowInWeek();
+             std::cout << "Search from now (" << kDayNames[static_cast<int>(from.day)] << " "
+                       << formatHHMM(from.minute) << ")? [Y/n]: ";
+             std::string ans = trim(safeGetLine());
+             if (!ans.empty() && (ans[0] == 'n' || ans[0] == 'N')) {
+                 from.day = promptDay();
+                 std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+                 from.minute = promptTime("From");
+             }
+
+             auto w = nextCommonWindow(people, from, minutes, sessions.confirmedAmong(people));
+             if (!w) { std::cout << "No common " << minutes << "-minute window in your weekly availability.\n"; break; }
+             std::cout << "Next common " << minutes << "-minute window: "
+                       << kDayNames[static_cast<int>(w->day)] << " "
+                       << formatHHMM(w->start) << "-" << formatHHMM(w->end)
+                       << (w->nextWeek ? " (next week)" : "") << "\n";
+             break;
+         }
+         case 25: { // Courses most often co-enrolled with a course
+             std::cout << "Course code: ";
+             std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+             std::string code = trim(safeGetLine());
+             std::uint32_t total = coEnrollment.enrolled(code);
+             if (total == 0) {
+                 std::cout << "Nobody is enrolled in that course.\n";
+                 printCourseHints(completions, code);
+                 break;
+             }
+             auto related = coEnrollment.topWith(code, 10);
+             if (related.empty()) { std::cout << "Its " << total << " student(s) take no other courses.\n"; break; }
+             std::cout << "Students in " << upperCopy(code) << " (" << total << ") also take:\n";
+             for (const auto& r : related) {
+                 std::cout << "  " << r.course << "  " << r.together << " ("
+                           << static_cast<int>(r.share * 100 + 0.5) << "%)\n";
+             }
+             break;
+         }
+         case 26: { // 2-hop study partners
+             if (!me->exists()) { std::cout << "Create your profile first.\n"; break; }
+             std::string_view key = trimView(me->email()).empty() ? trimView(me->name()) : trimView(me->email());
+             auto displayOf = [&](std::string_view k) {
+                 const Profile* p = roster.findByEmail(std::string(k));
+                 return p && !p->name().empty() ? std::string(p->name()) + " <" + std::string(k) + ">" : std::string(k);
+             };
+             auto partners = studyGraph.partnersOf(key);
+             if (partners.empty()) { std::cout << "You have no confirmed study sessions yet.\n"; break; }
+             std::cout << "Your study partners:\n";
+             for (const auto& p : partners) {
+                 std::cout << "  " << displayOf(p.student) << "  " << p.sessions << " session(s)\n";
+             }
+             auto twoHop = studyGraph.suggest(key, 10);
+             if (twoHop.empty()) { std::cout << "Your partners have not studied with anyone else yet.\n"; break; }
+             std::cout << "Classmates your study partners study with:\n";
+             for (const auto& s : twoHop) {
+                 std::cout << "  " << displayOf(s.student) << "  score " << s.score
+                           << " via " << s.via << " partner(s)\n";
+             }
+             break;
+         }
          default:
              std::cout << "Unknown option.\n";
          }
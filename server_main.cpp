@@ -0,0 +1,157 @@
+/***************************************************************************************
+ * server_main.cpp — study_buddy_server
+ *
+ * Keeps the roster, SessionRequests and NotificationCenter resident and serves the binary
+ * protocol from Protocol.hpp over a Unix domain socket.
+ *
+ * Usage:
+ *   study_buddy_server [--socket PATH] [--workers N] [--seed-roster N]
+ *                      [--metrics FILE] [--metrics-interval SEC]
+ *                      [--trace FILE] [--trace-sample N] [--roster-file FILE]...
+ *                      [--snapshot-dir DIR]
+ *     --socket           socket path (default /tmp/study_buddy.sock)
+ *     --workers          worker threads for heavy requests (default: hardware threads)
+ *     --seed-roster      preload N synthetic classmates user0..user<N-1>@clemson.edu
+ *     --metrics          dump API latency metrics to FILE (Prometheus text; JSON if *.json)
+ *     --metrics-interval seconds between dumps (default 10)
+ *     --trace            record trace spans; written as Chrome trace JSON on shutdown
+ *     --trace-sample     trace 1 in N top-level operations (default 1)
+ *     --roster-file      "email,course" enrollment CSV, applied at startup and again
+ *                        whenever the file is rewritten (repeatable; files apply in order)
+ *     --snapshot-dir     directory Snapshot requests write into (off without it)
+ *
+ * STANDARD LIBRARIES USED:
+ *  <chrono>   : metrics dump interval
+ *  <csignal>  : SIGINT/SIGTERM shutdown
+ *  <fstream>  : roster files
+ *  <iostream> : status output
+ *  <memory>   : optional metrics dumper
+ *  <string>   : argument parsing
+ *  <thread>   : hardware_concurrency
+ *  <vector>   : roster files
+ ****************************************************************************************/
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "EpollServer.hpp"
+#include "FileWatcher.hpp"
+#include "Metrics.hpp"
+#include "Trace.hpp"
+#include "StudyBuddyService.hpp"
+
+using namespace sb;
+
+static EpollServer* gServer = nullptr;
+
+static void onSignal(int) {
+    if (gServer) gServer->stop();
+}
+
+static void reloadRosterFile(StudyBuddyService& svc, const std::string& file) {
+    std::ifstream in(file);
+    if (!in) {
+        std::cerr << "roster file " << file << ": cannot open\n";
+        return;
+    }
+    auto r = svc.reloadEnrollments(in);
+    std::cout << "Reloaded " << file << ": " << r.changed << " changed, " << r.unchanged
+              << " unchanged, " << r.unknownEmails.size() << " unknown emails (parse "
+              << r.parseMs << " ms, diff " << r.planMs << " ms, apply " << r.applyMs << " ms)\n";
+}
+
+int main(int argc, char** argv) {
+    std::string path = "/tmp/study_buddy.sock";
+    std::size_t workers = std::thread::hardware_concurrency();
+    std::size_t seed = 0;
+    std::string metricsPath;
+    long metricsInterval = 10;
+    std::string tracePath;
+    unsigned long traceSample = 1;
+    std::vector<std::string> rosterFiles;
+    std::string snapshotDir;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        auto next = [&](const char* flag) -> std::string {
+            if (i + 1 >= argc) { std::cerr << flag << " needs a value\n"; std::exit(2); }
+            return argv[++i];
+        };
+        try {
+            if (a == "--socket")           path = next("--socket");
+            else if (a == "--workers")     workers = static_cast<std::size_t>(std::stoul(next("--workers")));
+            else if (a == "--seed-roster") seed = static_cast<std::size_t>(std::stoul(next("--seed-roster")));
+            else if (a == "--metrics")     metricsPath = next("--metrics");
+            else if (a == "--metrics-interval") metricsInterval = std::stol(next("--metrics-interval"));
+            else if (a == "--trace")       tracePath = next("--trace");
+            else if (a == "--trace-sample") traceSample = std::stoul(next("--trace-sample"));
+            else if (a == "--roster-file") rosterFiles.push_back(next("--roster-file"));
+            else if (a == "--snapshot-dir") snapshotDir = next("--snapshot-dir");
+            else { std::cerr << "Unknown option: " << a << "\n"; return 2; }
+        } catch (...) {
+            std::cerr << "Invalid value for " << a << "\n";
+            return 2;
+        }
+    }
+
+    StudyBuddyService svc;
+    svc.setSnapshotDir(snapshotDir);
+    if (seed > 0) {
+        svc.seedSynthetic(seed);
+        std::cout << "Seeded " << svc.rosterSize() << " synthetic classmates.\n";
+    }
+
+    std::unique_ptr<FileWatcher> rosterWatcher;
+    if (!rosterFiles.empty()) {
+        for (const auto& f : rosterFiles) reloadRosterFile(svc, f);
+        rosterWatcher = std::make_unique<FileWatcher>(
+            rosterFiles, [&svc](const std::string& f) { reloadRosterFile(svc, f); });
+        rosterWatcher->setErrorHandler([](const std::string& msg) {
+            std::cerr << "study_buddy_server: roster watch: " << msg << "\n";
+        });
+        std::string err;
+        if (!rosterWatcher->start(err)) {
+            std::cerr << "study_buddy_server: " << err << "\n";
+            return 1;
+        }
+    }
+
+    std::unique_ptr<MetricsDumper> metricsDumper;
+    if (!metricsPath.empty()) {
+        if (metricsInterval < 1) metricsInterval = 1;
+        metricsDumper = std::make_unique<MetricsDumper>(Metrics::global(), metricsPath,
+                                                        std::chrono::seconds(metricsInterval));
+    }
+
+    if (!tracePath.empty()) {
+        Tracer::setSampleEvery(static_cast<std::uint32_t>(traceSample));
+        Tracer::enable(true);
+    }
+
+    EpollServer server(svc, path, workers);
+    std::string err;
+    if (!server.start(err)) {
+        std::cerr << "study_buddy_server: " << err << "\n";
+        return 1;
+    }
+    gServer = &server;
+    std::signal(SIGINT, onSignal);
+    std::signal(SIGTERM, onSignal);
+
+    std::cout << "Listening on " << path << " (" << (workers ? workers : 1) << " workers)\n";
+    server.run();
+    gServer = nullptr;
+    std::cout << "Server stopped.\n";
+    if (!tracePath.empty()) {
+        std::string err;
+        if (!Tracer::flushToFile(tracePath, err)) std::cerr << "trace: " << err << "\n";
+        else std::cout << "Trace written to " << tracePath << "\n";
+    }
+    return 0;
+}
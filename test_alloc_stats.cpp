@@ -0,0 +1,109 @@
+/***************************************************************************************
+ * test_alloc_stats.cpp
+ * Tests for allocation accounting (AllocStats / AllocScope with AllocHooks.o linked).
+ *
+ * STANDARD LIBRARIES USED:
+ *  <cassert>, <iostream>, <memory>, <sstream>, <string>, <vector>
+ ****************************************************************************************/
+#include <cassert>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "AllocStats.hpp"
+#include "ClassmateSearch.hpp"
+#include "NotificationCenter.hpp"
+#include "SessionRequests.hpp"
+#include "SyntheticRoster.hpp"
+#include "ThreadPool.hpp"
+
+using namespace sb;
+
+static const AllocStats::OpStats* row(const std::vector<AllocStats::OpStats>& rows, const std::string& name) {
+    for (const auto& r : rows) if (r.name == name) return &r;
+    return nullptr;
+}
+
+int main() {
+    assert(AllocStats::hooked());
+
+    {
+        // Test 1: disabled by default — nothing is counted, scopes are not recorded
+        AllocStats::reset();
+        {
+            AllocScope s("idle");
+            auto p = std::make_unique<int>(1);
+        }
+        assert(AllocStats::totals().allocs == 0 && AllocStats::report().empty());
+    }
+
+    AllocStats::enable(true);
+
+    {
+        // Test 2: counts and bytes attributed to the innermost scope, inclusive of nesting
+        AllocStats::reset();
+        {
+            AllocScope outer("outer");
+            auto a = std::make_unique<char[]>(100);
+            {
+                AllocScope inner("inner");
+                auto b = std::make_unique<char[]>(50);
+                auto c = std::make_unique<char[]>(25);
+            }
+        }
+        auto rows = AllocStats::report();
+        const auto* in = row(rows, "inner");
+        const auto* out = row(rows, "outer");
+        assert(in && in->calls == 1 && in->allocs == 2 && in->bytes == 75);
+        assert(out && out->calls == 1 && out->allocs == 3 && out->bytes == 175);
+        auto t = AllocStats::totals();
+        assert(t.allocs >= 3 && t.frees >= 3 && t.bytes >= 175);
+    }
+
+    {
+        // Test 3: instrumented operations show up by name, with per-call averages
+        AllocStats::reset();
+        Profile me;
+        me.createOrReset("Me", "me@clemson.edu", {"CPSC 1010"});
+        std::vector<Profile> roster = makeSyntheticRoster(200);
+        NotificationCenter nc;
+        SessionRequests sr(&nc);
+        for (int i = 0; i < 3; ++i) ClassmateSearch::byName(roster, me, "student 1");
+        sr.sendRequest(me, roster[0], "CPSC 1010", Day::Mon, 600, 660);
+        auto rows = AllocStats::report();
+        const auto* byName = row(rows, "byName");
+        const auto* send = row(rows, "sendRequest");
+        assert(byName && byName->calls == 3 && byName->allocs > 0);
+        assert(byName->allocsPerCall() * 3 == static_cast<double>(byName->allocs));
+        assert(send && send->calls == 1 && send->allocs > 0);
+
+        std::ostringstream os;
+        AllocStats::print(os);
+        assert(os.str().find("sendRequest") != std::string::npos);
+    }
+
+    {
+        // Test 4: parallel chunks on pool workers are charged to the caller's scope
+        std::vector<Profile> roster = makeSyntheticRoster(400);
+        Profile me;
+        me.createOrReset("Me", "me@clemson.edu", {"CPSC 1010"});
+        setParallelThreshold(1u << 30);
+        AllocStats::reset();
+        ClassmateSearch::byName(roster, me, "student");
+        std::size_t sequential = row(AllocStats::report(), "byName")->allocs;
+        setParallelThreshold(16);
+        AllocStats::reset();
+        ClassmateSearch::byName(roster, me, "student");
+        std::size_t parallel = row(AllocStats::report(), "byName")->allocs;
+        setParallelThreshold(2048);
+        // Per-profile work dominates either way; missing worker allocations would show up
+        // as a large drop.
+        assert(parallel * 2 >= sequential);
+    }
+
+    AllocStats::enable(false);
+    std::cout << "[test_alloc_stats] All tests passed.\n";
+    return 0;
+}
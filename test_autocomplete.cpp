@@ -0,0 +1,184 @@
+/***************************************************************************************
+ * test_autocomplete.cpp
+ * Tests for PrefixIndex (radix trie with cached top completions) and Autocomplete.
+ *
+ * STANDARD LIBRARIES USED:
+ *  <algorithm>, <cassert>, <iostream>, <map>, <random>, <string>, <vector>
+ ****************************************************************************************/
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Autocomplete.hpp"
+#include "CourseManager.hpp"
+#include "Roster.hpp"
+
+using namespace sb;
+
+static std::vector<std::string> texts(const std::vector<Completion>& cs) {
+    std::vector<std::string> out;
+    for (const auto& c : cs) out.emplace_back(c.text);
+    return out;
+}
+
+int main() {
+    {
+        // Test 1: course codes ranked by enrollment, normalized prefixes
+        PrefixIndex idx;
+        idx.adjust("CPSC 2150", 5);
+        idx.adjust("CPSC 2120", 9);
+        idx.adjust("CPSC 1010", 3);
+        idx.adjust("MATH 2060", 4);
+
+        auto c = idx.complete("CPSC 21");
+        assert((texts(c) == std::vector<std::string>{"CPSC 2120", "CPSC 2150"}));
+        assert(c[0].count == 9 && c[1].count == 5);
+        assert(texts(idx.complete("  cpsc   21")) == texts(c)); // case and spacing folded
+        assert((texts(idx.complete("c")) == std::vector<std::string>{"CPSC 2120", "CPSC 2150", "CPSC 1010"}));
+        assert(idx.complete("").size() == 4);
+        assert(idx.complete("cpsc 2150").size() == 1);  // a whole key is its own prefix
+        assert(idx.complete("cpsc 21509").empty());
+        assert(idx.complete("phys").empty());
+        assert(idx.complete("c", 2).size() == 2);
+        assert(idx.size() == 4 && idx.count("cpsc 2150") == 5);
+    }
+
+    {
+        // Test 2: counts move entries between ranks; zero counts disappear
+        PrefixIndex idx;
+        idx.adjust("ab", 1);
+        idx.adjust("abc", 2);
+        idx.adjust("abd", 3);
+        assert((texts(idx.complete("ab")) == std::vector<std::string>{"abd", "abc", "ab"}));
+        idx.adjust("ab", 5);
+        assert((texts(idx.complete("a")) == std::vector<std::string>{"ab", "abd", "abc"}));
+        idx.adjust("abd", -3);
+        assert((texts(idx.complete("a")) == std::vector<std::string>{"ab", "abc"}));
+        assert(idx.size() == 2 && idx.count("abd") == 0);
+        idx.adjust("abd", -1);   // stays at zero
+        idx.adjust("zzz", -1);   // unknown key: ignored
+        assert(idx.size() == 2 && idx.count("zzz") == 0);
+        idx.adjust("abd", 1);
+        assert(idx.complete("abd").size() == 1);
+        // Ties rank alphabetically by key
+        idx.adjust("abc", -1);
+        assert((texts(idx.complete("abc")) == std::vector<std::string>{"abc"}));
+        assert((texts(idx.complete("ab")) == std::vector<std::string>{"ab", "abc", "abd"}));
+    }
+
+    {
+        // Test 3: randomized comparison against brute force (edge splits, deep keys)
+        std::mt19937 rng(11);
+        std::uniform_int_distribution<int> ch(0, 3), len(1, 7), delta(-2, 3);
+        PrefixIndex idx;
+        std::map<std::string, int> ref;
+        auto randomKey = [&] {
+            std::string s;
+            for (int i = len(rng); i > 0; --i) s.push_back(static_cast<char>('a' + ch(rng)));
+            return s;
+        };
+        for (int step = 0; step < 4000; ++step) {
+            std::string k = randomKey();
+            int d = delta(rng);
+            idx.adjust(k, d);
+            if (ref.count(k) || d > 0) ref[k] = std::max(0, ref[k] + d);
+
+            if (step % 20 != 0) continue;
+            std::string prefix = randomKey().substr(0, static_cast<std::size_t>(step / 20 % 4));
+            std::vector<std::pair<int, std::string>> expected;
+            for (const auto& [key, n] : ref) {
+                if (n > 0 && key.compare(0, prefix.size(), prefix) == 0) expected.push_back({-n, key});
+            }
+            std::sort(expected.begin(), expected.end());
+            if (expected.size() > PrefixIndex::kMaxCompletions) expected.resize(PrefixIndex::kMaxCompletions);
+            auto got = idx.complete(prefix);
+            assert(got.size() == expected.size());
+            for (std::size_t i = 0; i < got.size(); ++i) {
+                assert(got[i].text == expected[i].second);
+                assert(static_cast<int>(got[i].count) == -expected[i].first);
+            }
+        }
+        std::size_t live = 0;
+        for (const auto& kv : ref) live += kv.second > 0;
+        assert(idx.size() == live);
+    }
+
+    {
+        // Test 4: Autocomplete follows CourseManager edits through roster events
+        Roster roster;
+        Autocomplete ac;
+        roster.subscribe([&](const RosterChange& c) { ac.update(c.id, c.profile); });
+
+        Profile a, b, c;
+        a.createOrReset("John Smith", "js@clemson.edu", {"CPSC 2150", "CPSC 2120"});
+        b.createOrReset("Joan Smith", "jo@clemson.edu", {"CPSC 2150"});
+        c.createOrReset("John Smith", "js2@clemson.edu", {"MATH 2060"});
+        auto ha = roster.add(a);
+        roster.add(b);
+        roster.add(c);
+        roster.add(Profile()); // not created: contributes nothing
+
+        auto cs = ac.courses("cpsc 21");
+        assert((texts(cs) == std::vector<std::string>{"CPSC 2150", "CPSC 2120"}));
+        assert(cs[0].count == 2);
+        auto ns = ac.names("jo");
+        assert((texts(ns) == std::vector<std::string>{"John Smith", "Joan Smith"}));
+        assert(ns[0].count == 2);
+
+        CourseManager mgr;
+        roster.edit(ha, [&](Profile& p) { mgr.removeCourses(p, "2"); });  // drops CPSC 2120
+        roster.edit(ha, [&](Profile& p) { mgr.addCourses(p, "cpsc 2121"); });
+        assert((texts(ac.courses("CPSC 212")) == std::vector<std::string>{"CPSC 2121"}));
+        assert(ac.courseIndex().count("CPSC 2120") == 0);
+
+        roster.edit(ha, [&](Profile& p) { p.createOrReset("Jon Smith", "js@clemson.edu", {}); });
+        assert(ac.nameIndex().count("john smith") == 1);
+        assert(ac.courseIndex().count("CPSC 2150") == 1);
+        assert((texts(ac.names("jo")) == std::vector<std::string>{"Joan Smith", "John Smith", "Jon Smith"}));
+
+        // A bulk build gives the same answers as incremental updates
+        Autocomplete bulk(roster.profiles());
+        assert(texts(bulk.names("j")) == texts(ac.names("j")));
+        assert(texts(bulk.courses("")) == texts(ac.courses("")));
+    }
+
+    {
+        // Test 5: renames and invented course codes do not grow the index without bound
+        std::vector<Profile> all(50);
+        for (std::size_t i = 0; i < all.size(); ++i) {
+            all[i].createOrReset("Student " + std::to_string(i), "s" + std::to_string(i) + "@clemson.edu",
+                                 {"CPSC 2150", "MATH " + std::to_string(1000 + i)});
+        }
+        Autocomplete ac(all);
+        std::size_t maxEntries = 0, maxNodes = 0;
+        for (int round = 0; round < 20000; ++round) {
+            Profile& p = all[static_cast<std::size_t>(round) % 3];
+            p.createOrReset("Renamed " + std::to_string(round), p.email(),
+                            {"CPSC 2150", "XYZ " + std::to_string(round)});
+            ac.update(static_cast<std::size_t>(round) % 3, p);
+            maxEntries = std::max({maxEntries, ac.nameIndex().entryCount(), ac.courseIndex().entryCount()});
+            maxNodes = std::max({maxNodes, ac.nameIndex().nodeCount(), ac.courseIndex().nodeCount()});
+        }
+        assert(maxEntries <= 1025 && maxNodes <= 2 * 1025 + 1);
+        assert(ac.nameIndex().size() == 50 && ac.courseIndex().size() == 51);
+
+        // Same answers as a fresh build
+        Autocomplete bulk(all);
+        for (const char* prefix : {"", "r", "renamed 1999", "s", "student 4"}) {
+            auto got = ac.names(prefix), want = bulk.names(prefix);
+            assert(texts(got) == texts(want));
+        }
+        for (const char* prefix : {"", "x", "xyz 1999", "m", "cpsc"}) {
+            auto got = ac.courses(prefix), want = bulk.courses(prefix);
+            assert(texts(got) == texts(want) && got[0].count == want[0].count);
+        }
+        assert(ac.courseIndex().count("CPSC 2150") == 50 && ac.courseIndex().count("XYZ 19998") == 1);
+    }
+
+    std::cout << "[test_autocomplete] All tests passed.\n";
+    return 0;
+}
@@ -78,6 +78,18 @@ int main() {
         assert(mon[0].second[0].start == 11*60);
     }
 
+    {
+        // Test 4: view variants point into the roster instead of copying
+        auto views = AvailabilityBrowser::browseByCourseView(all, me, "CPSC 2150");
+        assert(views.size() == 2);
+        assert(views[0].person == &all[1] && views[0].name == "Alice");
+        assert(views[0].slots.size() == 2);
+
+        auto mon = AvailabilityBrowser::browseByCourseAndDayView(all, me, "cpsc 2150", Day::Mon);
+        assert(mon.size() == 1 && mon[0].name.data() == all[1].name().data());
+        assert(&*mon[0].slots.begin() == &all[1].availability()[0]);
+    }
+
     std::cout << "[test_availability_browser] All tests passed.\n";
     return 0;
 }
\ No newline at end of file
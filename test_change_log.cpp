@@ -0,0 +1,146 @@
+/***************************************************************************************
+ * test_change_log.cpp
+ * Tests for ChangeLog (typed, sequenced change events; sync, batched and queued consumers).
+ *
+ * STANDARD LIBRARIES USED:
+ *  <atomic>, <cassert>, <iostream>, <thread>, <vector>
+ ****************************************************************************************/
+#include <atomic>
+#include <cassert>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "AvailabilityManager.hpp"
+#include "ChangeLog.hpp"
+#include "CourseManager.hpp"
+#include "NotificationCenter.hpp"
+#include "Roster.hpp"
+#include "SessionRequests.hpp"
+
+using namespace sb;
+using K = ChangeEvent::Kind;
+
+static Profile student(const std::string& name, std::vector<std::string> courses) {
+    Profile p;
+    p.createOrReset(name, name + "@clemson.edu", courses);
+    return p;
+}
+
+int main() {
+    {
+        // Test 1: roster and session mutations become typed events with consecutive seqs
+        Roster roster;
+        roster.add(student("pre", {"X 1"})); // baseline, not published
+        ChangeLog log;
+        log.watch(roster);
+        std::vector<ChangeEvent> seen;
+        log.subscribe([&](const ChangeEvent& e) { seen.push_back(e); });
+
+        auto ann = roster.add(student("ann", {"CPSC 2150"}));
+        auto bob = roster.add(student("bob", {"CPSC 2150"}));
+        roster.edit(ann, [](Profile& p) { p.coursesMutable().push_back("MATH 1080"); });
+        roster.edit(ann, [](Profile& p) { AvailabilityManager::addMerged(p, {Day::Mon, 600, 660}); });
+        roster.edit(ann, [](Profile&) {});                                  // nothing changed
+        roster.edit(bob, [](Profile& p) { p.createOrReset("Bobby", "bob@clemson.edu", {"ECE 2010"}); });
+
+        NotificationCenter nc;
+        SessionRequests sessions(&nc, &log);
+        const StudySession& s = sessions.sendRequest(*ann, *bob, "CPSC 2150", Day::Mon, 600, 660);
+        std::string sid = s.id;
+        assert(sessions.confirmRequest(sid, *bob));
+        assert(sessions.cancelConfirmed(sid, *ann));
+
+        std::vector<K> kinds;
+        for (const auto& e : seen) kinds.push_back(e.kind);
+        assert((kinds == std::vector<K>{K::ProfileAdded, K::ProfileAdded, K::CoursesChanged, K::AvailabilityChanged,
+                                        K::IdentityChanged, K::CoursesChanged, K::SessionRequested,
+                                        K::SessionConfirmed, K::SessionCancelled}));
+        for (std::size_t i = 0; i < seen.size(); ++i) assert(seen[i].seq == i + 1);
+        assert(log.lastSeq() == seen.size());
+
+        const ChangeEvent& courses = seen[2];
+        assert(courses.profileId == ann.id() && courses.isProfileEvent());
+        assert(courses.before.courses().size() == 1 && courses.profile.courses().size() == 2);
+        assert(seen[4].profile.name() == "Bobby" && seen[4].before.name() == "bob");
+        assert(seen[6].session.id == sid && !seen[6].isProfileEvent());
+        assert(seen[7].session.status == StudySession::Status::Confirmed);
+        assert(std::string(changeKindName(K::SessionCancelled)) == "sessionCancelled");
+    }
+
+    {
+        // Test 2: a Batch coalesces 10k changes into one batch-listener call
+        Roster roster;
+        ChangeLog log;
+        log.watch(roster);
+        std::size_t calls = 0, events = 0, immediate = 0;
+        log.subscribeBatch([&](const std::vector<ChangeEvent>& b) { ++calls; events += b.size(); });
+        std::size_t token = log.subscribe([&](const ChangeEvent&) { ++immediate; });
+
+        roster.add(student("solo", {}));
+        assert(calls == 1 && events == 1);
+        {
+            ChangeLog::Batch batch(log);
+            {
+                ChangeLog::Batch nested(log);
+                for (int i = 0; i < 5000; ++i) roster.add(student("s" + std::to_string(i), {"A 1"}));
+            }
+            assert(calls == 1); // still inside the outer batch
+            for (std::size_t i = 1; i <= 5000; ++i) {
+                roster.edit(roster.handle(i), [](Profile& p) { p.coursesMutable().push_back("B 2"); });
+            }
+        }
+        assert(calls == 2 && events == 10001 && immediate == 10001);
+        log.unsubscribe(token);
+        roster.add(student("late", {}));
+        assert(calls == 3 && immediate == 10001);
+    }
+
+    {
+        // Test 3: lock-free queue drained by another thread, in order, no loss
+        ChangeLog log;
+        auto q = log.openQueue(1024);
+        const std::uint64_t n = 200000;
+        std::atomic<std::uint64_t> consumed{0};
+        bool ordered = true;
+        std::thread consumer([&] {
+            std::vector<ChangeEvent> batch;
+            std::uint64_t last = 0;
+            while (last < n) {
+                batch.clear();
+                if (q->drain(batch, 256) == 0) { std::this_thread::yield(); continue; }
+                for (const auto& e : batch) { ordered = ordered && e.seq == last + 1; last = e.seq; }
+                consumed.store(last, std::memory_order_release);
+            }
+        });
+        for (std::uint64_t i = 0; i < n; ++i) {
+            // Stay within the ring so nothing is dropped.
+            while (log.lastSeq() - consumed.load(std::memory_order_acquire) >= q->capacity()) std::this_thread::yield();
+            ChangeEvent e;
+            e.kind = K::SessionRequested;
+            log.publish(std::move(e));
+        }
+        consumer.join();
+        assert(ordered && consumed.load() == n && q->dropped() == 0);
+    }
+
+    {
+        // Test 4: a full queue drops (and counts) instead of blocking; dropped queues detach
+        ChangeLog log;
+        auto q = log.openQueue(4);
+        for (int i = 0; i < 10; ++i) log.publish(ChangeEvent{});
+        assert(q->dropped() == 6);
+        ChangeEvent e;
+        assert(q->tryPop(e) && e.seq == 1);
+        std::vector<ChangeEvent> rest;
+        assert(q->drain(rest) == 3 && rest.back().seq == 4 && !q->tryPop(e));
+
+        std::weak_ptr<ChangeQueue> weak = q;
+        q.reset();
+        log.publish(ChangeEvent{});
+        assert(weak.expired());
+    }
+
+    std::cout << "[test_change_log] All tests passed.\n";
+    return 0;
+}
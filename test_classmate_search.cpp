@@ -35,7 +35,7 @@ int main() {
         auto v = ClassmateSearch::byCourse(all, me, "cPsC 2150");
         assert(v.size() == 2);
         std::vector<std::string> emails;
-        for (auto* p : v) emails.push_back(p->email());
+        for (auto* p : v) emails.emplace_back(p->email());
         assert((emails[0] == "alice@clemson.edu" || emails[1] == "alice@clemson.edu"));
         assert((emails[0] == "alina@clemson.edu" || emails[1] == "alina@clemson.edu"));
     }
@@ -0,0 +1,167 @@
+/***************************************************************************************
+ * test_co_enrollment.cpp
+ * Tests for CoEnrollment (CSR co-enrollment counts, incremental updates, parallel build)
+ * and its use as a MatchSuggester tie-break.
+ *
+ * STANDARD LIBRARIES USED:
+ *  <cassert>, <iostream>, <random>, <string>, <vector>
+ ****************************************************************************************/
+#include <cassert>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "AvailabilityManager.hpp"
+#include "CoEnrollment.hpp"
+#include "MatchSuggester.hpp"
+#include "Roster.hpp"
+#include "ThreadPool.hpp"
+
+using namespace sb;
+
+static Profile student(const std::string& name, std::vector<std::string> courses) {
+    Profile p;
+    p.createOrReset(name, name + "@clemson.edu", courses);
+    return p;
+}
+
+// Students enrolled in both, by scanning every profile.
+static std::uint32_t bruteTogether(const std::vector<Profile>& all, const std::string& a, const std::string& b) {
+    std::uint32_t n = 0;
+    for (const auto& p : all) {
+        bool hasA = false, hasB = false;
+        for (const auto& c : p.courses()) { hasA = hasA || c == a; hasB = hasB || c == b; }
+        n += hasA && hasB;
+    }
+    return n;
+}
+
+static std::vector<std::string> catalog() {
+    std::vector<std::string> codes;
+    for (int i = 0; i < 30; ++i) codes.push_back("C " + std::to_string(1000 + i));
+    return codes;
+}
+
+static bool matchesBrute(const CoEnrollment& co, const std::vector<Profile>& all) {
+    for (const auto& a : catalog()) {
+        for (const auto& b : catalog()) {
+            if (a != b && co.together(a, b) != bruteTogether(all, a, b)) return false;
+        }
+    }
+    return true;
+}
+
+int main() {
+    {
+        // Test 1: counts, ranking (count DESC, code ASC), shares, normalization
+        std::vector<Profile> all = {
+            student("a", {"CPSC 2150", "MATH 1080", "ENGL 1030"}),
+            student("b", {"CPSC 2150", "MATH 1080"}),
+            student("c", {"CPSC 2150", "PHYS 1220", "ENGL 1030"}),
+            student("d", {"MATH 1080", "PHYS 1220"}),
+            student("e", {"cpsc 2150 ", "CPSC 2150"}), // duplicate after normalization
+        };
+        CoEnrollment co(all);
+        assert(co.courseCount() == 4);
+        assert(co.enrolled("CPSC 2150") == 4 && co.enrolled(" cpsc 2150") == 4);
+        assert(co.together("CPSC 2150", "MATH 1080") == 2 && co.together("MATH 1080", "CPSC 2150") == 2);
+        assert(co.together("CPSC 2150", "CPSC 2150") == 0 && co.together("CPSC 2150", "NOPE 1") == 0);
+
+        auto top = co.topWith("cpsc 2150", 10);
+        assert(top.size() == 3);
+        assert(top[0].course == "ENGL 1030" && top[0].together == 2 && top[0].share == 0.5);
+        assert(top[1].course == "MATH 1080" && top[1].together == 2);
+        assert(top[2].course == "PHYS 1220" && top[2].together == 1);
+        assert(co.topWith("CPSC 2150", 1).size() == 1);
+        assert(co.topWith("NOPE 1", 5).empty());
+    }
+
+    {
+        // Test 2: roster-driven updates (with compactions) agree with scanning profiles
+        auto codes = catalog();
+        std::mt19937 rng(46);
+        auto randomCourses = [&] {
+            std::vector<std::string> cs;
+            for (int k = 0; k < 2 + static_cast<int>(rng() % 4); ++k) cs.push_back(codes[rng() % codes.size()]);
+            return cs;
+        };
+        Roster roster;
+        for (int i = 0; i < 200; ++i) roster.add(student("s" + std::to_string(i), randomCourses()));
+        CoEnrollment co(roster.profiles());
+        roster.subscribe([&](const RosterChange& c) { co.update(c.id, c.profile); });
+        assert(matchesBrute(co, roster.profiles()));
+
+        for (int i = 0; i < 3000; ++i) {
+            auto h = roster.handle(rng() % roster.size());
+            if (i % 10 == 0) {
+                roster.add(student("n" + std::to_string(i), randomCourses()));
+            } else if (i % 3 == 0) {
+                roster.edit(h, [&](Profile& p) { p.coursesMutable() = randomCourses(); });
+            } else {
+                roster.edit(h, [&](Profile& p) {
+                    auto& cs = p.coursesMutable();
+                    if (!cs.empty()) cs.erase(cs.begin());
+                });
+            }
+        }
+        assert(matchesBrute(co, roster.profiles()));
+        CoEnrollment rebuilt(roster.profiles());
+        for (const auto& c : codes) {
+            assert(co.enrolled(c) == rebuilt.enrolled(c));
+            auto x = co.topWith(c, 8), y = rebuilt.topWith(c, 8);
+            assert(x.size() == y.size());
+            for (std::size_t i = 0; i < x.size(); ++i) assert(x[i].course == y[i].course && x[i].together == y[i].together);
+        }
+        assert(rebuilt.nonZeros() <= co.nonZeros());
+    }
+
+    {
+        // Test 3: the parallel build produces the same rows as the sequential one
+        std::vector<Profile> all;
+        auto codes = catalog();
+        std::mt19937 rng(7);
+        for (int i = 0; i < 3000; ++i) {
+            all.push_back(student("p" + std::to_string(i), {codes[rng() % 30], codes[rng() % 30], codes[rng() % 30]}));
+        }
+        std::size_t savedThreshold = parallelThreshold();
+        setParallelThreshold(1u << 30);
+        CoEnrollment sequential(all);
+        setParallelThreshold(16);
+        CoEnrollment parallel(all);
+        setParallelThreshold(savedThreshold);
+        for (const auto& c : codes) {
+            auto x = sequential.topWith(c, 30), y = parallel.topWith(c, 30);
+            assert(x.size() == y.size());
+            for (std::size_t i = 0; i < x.size(); ++i) assert(x[i].course == y[i].course && x[i].together == y[i].together);
+        }
+        assert(matchesBrute(parallel, all));
+    }
+
+    {
+        // Test 4: MatchSuggester ranks equal-overlap matches by co-enrollment affinity
+        auto withSlot = [](Profile p) {
+            AvailabilityManager::addMerged(p, {Day::Mon, 600, 720});
+            return p;
+        };
+        std::vector<Profile> all = {
+            withSlot(student("me", {"CPSC 2150"})),
+            withSlot(student("Amy", {"CPSC 2150", "ARTS 1010"})),
+            withSlot(student("Zed", {"CPSC 2150", "MATH 1080"})),
+            student("x1", {"CPSC 2150", "MATH 1080"}),
+            student("x2", {"CPSC 2150", "MATH 1080"}),
+        };
+        MatchSuggester ms;
+        auto plain = ms.suggest(all[0], all, 30, 5);
+        assert(plain.size() == 2 && plain[0].person->name() == "Amy" && plain[0].affinity == 0);
+
+        CoEnrollment co(all);
+        ms.useCoEnrollment(&co);
+        auto ranked = ms.suggest(all[0], all, 30, 5);
+        assert(ranked.size() == 2 && ranked[0].person->name() == "Zed");
+        assert(ranked[0].affinity == 0.6 && ranked[1].affinity == 0.2);
+    }
+
+    std::cout << "[test_co_enrollment] All tests passed.\n";
+    return 0;
+}
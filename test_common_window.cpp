@@ -0,0 +1,106 @@
+/***************************************************************************************
+ * test_common_window.cpp
+ * Tests for nextCommonWindow (pair and n-user forms, busy sessions, week wrap).
+ *
+ * STANDARD LIBRARIES USED:
+ *  <cassert>, <iostream>, <vector>
+ ****************************************************************************************/
+#include <cassert>
+#include <iostream>
+#include <vector>
+
+#include "AllocStats.hpp"
+#include "AvailabilityManager.hpp"
+#include "CommonWindow.hpp"
+#include "NotificationCenter.hpp"
+#include "SessionRequests.hpp"
+
+using namespace sb;
+
+static Profile student(const std::string& name, std::vector<AvailabilitySlot> slots) {
+    Profile p;
+    p.createOrReset(name, name + "@clemson.edu", {"CPSC 2150"});
+    AvailabilityManager::applyBatch(p, [&] {
+        std::vector<AvailabilityEdit> edits;
+        for (const auto& s : slots) edits.push_back({AvailabilityEdit::Kind::Add, s});
+        return edits;
+    }());
+    return p;
+}
+
+static bool is(const std::optional<FreeWindow>& w, Day day, int start, int end, bool nextWeek = false) {
+    return w && w->day == day && w->start == start && w->end == end && w->nextWeek == nextWeek;
+}
+
+int main() {
+    Profile ann = student("ann", {{Day::Mon, 540, 600}, {Day::Mon, 780, 900}, {Day::Wed, 600, 720}});
+    Profile bob = student("bob", {{Day::Mon, 570, 660}, {Day::Mon, 840, 960}, {Day::Wed, 540, 660}});
+
+    {
+        // Test 1: earliest overlap long enough, from different starting points
+        assert(is(nextCommonWindow(ann, bob, {Day::Mon, 0}, 30), Day::Mon, 570, 600));
+        assert(is(nextCommonWindow(ann, bob, {Day::Mon, 0}, 45), Day::Mon, 840, 885)); // 9:30-10 too short
+        assert(is(nextCommonWindow(ann, bob, {Day::Mon, 860}, 30), Day::Mon, 860, 890)); // starts mid-overlap
+        assert(is(nextCommonWindow(ann, bob, {Day::Mon, 880}, 30), Day::Wed, 600, 630));
+        assert(!nextCommonWindow(ann, bob, {Day::Mon, 0}, 90));
+        assert(!nextCommonWindow(ann, bob, {Day::Mon, 0}, 0));
+    }
+
+    {
+        // Test 2: wraps to next week when nothing is left this week
+        auto w = nextCommonWindow(ann, bob, {Day::Thu, 0}, 60);
+        assert(is(w, Day::Mon, 840, 900, true));
+        assert(is(nextCommonWindow(ann, bob, {Day::Wed, 700}, 30), Day::Mon, 570, 600, true));
+    }
+
+    {
+        // Test 3: touching slots coalesce; windows never cross midnight
+        Profile c = student("c", {{Day::Tue, 600, 660}, {Day::Tue, 660, 720}, {Day::Tue, 1380, 1440}, {Day::Wed, 0, 60}});
+        Profile d = student("d", {{Day::Tue, 0, 1440}, {Day::Wed, 0, 1440}});
+        assert(is(nextCommonWindow(c, d, {Day::Mon, 0}, 120), Day::Tue, 600, 720));
+        assert(is(nextCommonWindow(c, d, {Day::Tue, 700}, 60), Day::Tue, 1380, 1440));
+        assert(!nextCommonWindow(c, d, {Day::Mon, 0}, 121));
+    }
+
+    {
+        // Test 4: confirmed sessions of either student block the window; pending ones do not
+        NotificationCenter nc;
+        SessionRequests sessions(&nc);
+        Profile carl = student("carl", {{Day::Mon, 0, 1440}});
+        std::string s1 = sessions.sendRequest(ann, carl, "CPSC 2150", Day::Mon, 570, 600).id;
+        assert(sessions.confirmRequest(s1, carl));
+        std::string s2 = sessions.sendRequest(carl, bob, "CPSC 2150", Day::Mon, 840, 870).id;
+        assert(sessions.confirmRequest(s2, bob));
+        sessions.sendRequest(carl, ann, "CPSC 2150", Day::Mon, 870, 900); // pending only
+
+        auto busy = sessions.confirmedAmong({&ann, &bob});
+        assert(busy.size() == 2 && busy[0]->id == s1 && busy[1]->id == s2);
+        assert(is(nextCommonWindow(ann, bob, {Day::Mon, 0}, 30, busy), Day::Mon, 870, 900));
+        assert(is(nextCommonWindow(ann, bob, {Day::Mon, 0}, 31, busy), Day::Wed, 600, 631));
+        assert(sessions.confirmedAmong({&carl}).size() == 2);
+    }
+
+    {
+        // Test 5: n-user form and no allocation on the walk
+        Profile c = student("c", {{Day::Wed, 630, 700}});
+        std::vector<const Profile*> three{&ann, &bob, &c};
+        assert(is(nextCommonWindow(three, {Day::Mon, 0}, 30), Day::Wed, 630, 660));
+        assert(!nextCommonWindow(three, {Day::Mon, 0}, 71));
+        assert(!nextCommonWindow(std::vector<const Profile*>{}, {Day::Mon, 0}, 30));
+        assert(is(nextCommonWindow(std::vector<const Profile*>{&ann}, {Day::Mon, 600}, 60), Day::Mon, 780, 840));
+
+        std::vector<const Profile*> many(20, &bob); // past the inline cursor array
+        assert(is(nextCommonWindow(many, {Day::Mon, 0}, 90), Day::Mon, 570, 660));
+
+        if (AllocStats::hooked()) {
+            AllocStats::reset();
+            AllocStats::enable(true);
+            auto w = nextCommonWindow(three, {Day::Tue, 0}, 30);
+            AllocStats::enable(false);
+            assert(w && AllocStats::totals().allocs == 0);
+        }
+    }
+
+    std::cout << "[test_common_window] All tests passed.\n";
+    return 0;
+}
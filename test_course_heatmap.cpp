@@ -0,0 +1,151 @@
+/***************************************************************************************
+ * test_course_heatmap.cpp
+ * Tests for CourseHeatmap (per-course weekly free-student histogram on Fenwick trees).
+ *
+ * STANDARD LIBRARIES USED:
+ *  <algorithm>, <cassert>, <cmath>, <iostream>, <random>, <string>, <vector>
+ ****************************************************************************************/
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "AvailabilityManager.hpp"
+#include "CourseHeatmap.hpp"
+#include "Roster.hpp"
+
+using namespace sb;
+using H = CourseHeatmap;
+
+static Profile student(const std::string& name, std::vector<std::string> courses,
+                       std::vector<AvailabilitySlot> slots) {
+    Profile p;
+    p.createOrReset(name, name + "@clemson.edu", courses);
+    p.availabilityMutable() = std::move(slots);
+    p.commitAvailability();
+    return p;
+}
+
+// Reference: students in 'course' with a slot covering bucket b of 'day' entirely
+// (after coalescing touching slots, as the heatmap does).
+static std::vector<int> bruteDay(const std::vector<Profile>& all, const std::string& course, Day day) {
+    std::vector<int> counts(H::kBucketsPerDay, 0);
+    for (const auto& p : all) {
+        const auto& cs = p.courses();
+        if (std::find(cs.begin(), cs.end(), course) == cs.end()) continue;
+        std::vector<char> freeMin(24 * 60 + 1, 0);
+        for (const auto& s : p.availability()) {
+            if (s.day != day) continue;
+            for (int m = std::max(0, s.start); m < std::min(24 * 60, s.end); ++m) freeMin[m] = 1;
+        }
+        for (int b = 0; b < H::kBucketsPerDay; ++b) {
+            bool all15 = true;
+            for (int m = b * H::kBucketMinutes; m < (b + 1) * H::kBucketMinutes; ++m) all15 = all15 && freeMin[m];
+            counts[b] += all15;
+        }
+    }
+    return counts;
+}
+
+int main() {
+    {
+        // Test 1: bucket counts, partial buckets, enrollment
+        std::vector<Profile> all = {
+            student("ann", {"CPSC 2150"}, {{Day::Tue, 14 * 60, 16 * 60}}),
+            student("bob", {"CPSC 2150"}, {{Day::Tue, 14 * 60 + 10, 15 * 60}}), // 14:10 → from 14:15
+            student("cat", {"CPSC 2150", "MATH 2060"}, {{Day::Tue, 15 * 60, 15 * 60 + 20}}),
+            student("dan", {"MATH 2060"}, {{Day::Tue, 8 * 60, 18 * 60}}),
+        };
+        H map(all);
+        assert(map.enrolled("cpsc 2150") == 3 && map.enrolled("MATH 2060") == 2 && map.enrolled("X") == 0);
+        auto tue = map.dayCounts("CPSC 2150", Day::Tue);
+        assert(tue.size() == static_cast<std::size_t>(H::kBucketsPerDay));
+        int b14 = 14 * 60 / H::kBucketMinutes;
+        assert(tue[b14] == 1 && tue[b14 + 1] == 2 && tue[b14 + 3] == 2 && tue[b14 + 4] == 2 && tue[b14 + 5] == 1);
+        assert(tue == bruteDay(all, "CPSC 2150", Day::Tue));
+        assert(map.dayCounts("NOPE", Day::Tue).empty());
+
+        // 14:00-15:00 → buckets 14:00(1) 14:15(2) 14:30(2) 14:45(2)
+        assert(map.freeStudentBuckets("CPSC 2150", Day::Tue, 14 * 60, 15 * 60) == 7);
+        assert(map.freeStudentBuckets("CPSC 2150", Day::Wed, 0, 24 * 60) == 0);
+
+        // Best hour: 14:15-15:15 (2,2,2,2) beats 14:00-15:00 (1,2,2,2)
+        auto w = map.bestWindow("CPSC 2150", 60);
+        assert(w && w->day == Day::Tue && w->start == 14 * 60 + 15 && w->end == 15 * 60 + 15);
+        assert(w->averageFree == 2.0 && w->minFree == 2);
+        // 50 minutes round up to 4 buckets; restricting the search range moves the window
+        auto w2 = map.bestWindow("CPSC 2150", 50, Day::Tue, 15 * 60 + 30, 17 * 60);
+        assert(w2 && w2->start == 15 * 60 + 30 && w2->averageFree == 0.5 && w2->minFree == 0);
+        assert(!map.bestWindow("CPSC 2150", 120, Day::Tue, 15 * 60, 16 * 60));
+        assert(!map.bestWindow("NOPE", 60));
+        // Empty course still has a (zero) best window, earliest first
+        auto w3 = map.bestWindow("MATH 2060", 90, Day::Mon);
+        assert(w3 && w3->start == 0 && w3->averageFree == 0.0);
+    }
+
+    {
+        // Test 2: incremental updates through roster events
+        Roster roster;
+        H map;
+        roster.subscribe([&](const RosterChange& c) { map.update(c.id, c.profile); });
+        auto a = roster.add(student("ann", {"CPSC 2150"}, {{Day::Mon, 600, 660}}));
+        roster.add(student("bob", {"CPSC 2150"}, {{Day::Mon, 630, 720}}));
+        assert(map.freeStudentBuckets("CPSC 2150", Day::Mon, 600, 720) == 4 + 6);
+
+        roster.edit(a, [](Profile& p) { AvailabilityManager::addMerged(p, {Day::Mon, 660, 720}); });
+        assert(map.freeStudentBuckets("CPSC 2150", Day::Mon, 600, 720) == 8 + 6);
+        roster.edit(a, [](Profile& p) { p.coursesMutable() = {"ECE 2010"}; });
+        assert(map.enrolled("CPSC 2150") == 1 && map.enrolled("ECE 2010") == 1);
+        assert(map.freeStudentBuckets("CPSC 2150", Day::Mon, 600, 720) == 6);
+        assert(map.freeStudentBuckets("ECE 2010", Day::Mon, 600, 720) == 8);
+        roster.edit(a, [](Profile& p) { p.createOrReset("ann", "ann@clemson.edu", {}); });
+        assert(map.enrolled("ECE 2010") == 0 && map.freeStudentBuckets("ECE 2010", Day::Mon, 0, 1440) == 0);
+    }
+
+    {
+        // Test 3: randomized updates vs brute force, including best-window search
+        std::mt19937 rng(17);
+        const std::vector<std::string> courses = {"A 1", "B 2"};
+        auto randomProfile = [&](std::size_t i) {
+            std::vector<std::string> cs;
+            for (const auto& c : courses) if (rng() % 2) cs.push_back(c);
+            std::vector<AvailabilitySlot> slots;
+            for (int k = static_cast<int>(rng() % 4); k > 0; --k) {
+                int s = static_cast<int>(rng() % (24 * 60));
+                slots.push_back({static_cast<Day>(rng() % 7), s, std::min(24 * 60, s + 1 + static_cast<int>(rng() % 240))});
+            }
+            return student("s" + std::to_string(i), cs, slots);
+        };
+        std::vector<Profile> all;
+        for (std::size_t i = 0; i < 30; ++i) all.push_back(randomProfile(i));
+        H map(all);
+        for (int step = 0; step < 300; ++step) {
+            std::size_t i = rng() % all.size();
+            all[i] = randomProfile(i);
+            map.update(i, all[i]);
+
+            const std::string& c = courses[rng() % courses.size()];
+            Day d = static_cast<Day>(rng() % 7);
+            auto ref = bruteDay(all, c, d);
+            assert(map.dayCounts(c, d) == ref);
+
+            int width = 1 + static_cast<int>(rng() % 12);
+            long long best = -1; int bestB = 0;
+            for (int b = 0; b + width <= H::kBucketsPerDay; ++b) {
+                long long sum = 0;
+                for (int k = b; k < b + width; ++k) sum += ref[k];
+                if (sum > best) { best = sum; bestB = b; }
+            }
+            auto w = map.bestWindow(c, width * H::kBucketMinutes, d);
+            assert(w && w->start == bestB * H::kBucketMinutes);
+            assert(std::llround(w->averageFree * width) == best);
+            assert(map.freeStudentBuckets(c, d, w->start, w->end) == best);
+        }
+    }
+
+    std::cout << "[test_course_heatmap] All tests passed.\n";
+    return 0;
+}
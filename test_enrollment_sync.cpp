@@ -0,0 +1,129 @@
+/***************************************************************************************
+ * test_enrollment_sync.cpp
+ * Tests for EnrollmentSync (registrar dump → per-student course diffs → roster edits).
+ *
+ * STANDARD LIBRARIES USED:
+ *  <cassert>, <iostream>, <sstream>, <string>, <vector>
+ ****************************************************************************************/
+#include <cassert>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "EnrollmentSync.hpp"
+#include "OccupancyIndex.hpp"
+#include "Roster.hpp"
+#include "RosterSnapshot.hpp"
+
+using namespace sb;
+using Strings = std::vector<std::string>;
+
+static Profile student(const std::string& name, const Strings& courses) {
+    Profile p;
+    p.createOrReset(name, name + "@clemson.edu", courses);
+    return p;
+}
+
+int main() {
+    {
+        // Test 1: reading and grouping a CSV dump
+        std::istringstream csv("# registrar export\n"
+                               "bob@clemson.edu, cpsc 2150\n"
+                               "\n"
+                               "ann@clemson.edu,MATH 1080\n"
+                               "  bob@clemson.edu ,ECE 2010 \n"
+                               "no-comma-line\n"
+                               ",MISSING EMAIL\n");
+        auto rows = EnrollmentSync::readRows(csv);
+        assert(rows.size() == 3);
+        auto dump = EnrollmentSync::groupRows(rows);
+        assert(dump.size() == 2);
+        assert(dump[0].email == "ann@clemson.edu" && dump[0].courses == Strings{"MATH 1080"});
+        assert(dump[1].email == "bob@clemson.edu" && dump[1].courses == (Strings{"cpsc 2150", "ECE 2010"}));
+    }
+
+    {
+        // Test 2: plan computes sorted set differences and leaves the roster alone
+        Roster roster;
+        roster.add(student("ann", {"CPSC 2150", "MATH 1080"}));
+        roster.add(student("bob", {"ECE 2010"}));
+        roster.add(student("cat", {"HIST 1010"}));
+        std::vector<Enrollment> dump = {
+            {"ann@clemson.edu", {"math 1080", " CPSC 2150 ", "MATH 1080"}}, // same set, other spelling
+            {"bob@clemson.edu", {"PHYS 1220", "CPSC 1010"}},
+            {"zed@clemson.edu", {"CPSC 2150"}},
+            {"bob@clemson.edu", {"ECE 2010"}}, // listed twice: union
+        };
+        EnrollmentPlan plan = EnrollmentSync::plan(roster, dump);
+        assert(plan.unchanged == 1 && plan.unknownEmails == Strings{"zed@clemson.edu"});
+        assert(plan.changes.size() == 1 && plan.changes[0].id == 1);
+        assert(plan.changes[0].added == (Strings{"CPSC 1010", "PHYS 1220"}) && plan.changes[0].dropped.empty());
+        assert(roster.profiles()[1].courses() == Strings{"ECE 2010"});
+
+        // Unlisted students only change with DropAll
+        EnrollmentPlan full = EnrollmentSync::plan(roster, dump, EnrollmentSync::Unlisted::DropAll);
+        assert(full.changes.size() == 2 && full.changes[1].id == 2);
+        assert(full.changes[1].dropped == Strings{"HIST 1010"} && full.changes[1].added.empty());
+    }
+
+    {
+        // Test 3: apply edits only changed students, keeps order, and drives indexes
+        Roster roster;
+        OccupancyIndex occupancy;
+        roster.subscribe([&](const RosterChange& c) { occupancy.update(c.id, c.profile); });
+        std::size_t events = 0;
+        roster.subscribe([&](const RosterChange&) { ++events; });
+        roster.add(student("ann", {"CPSC 2150", "MATH 1080", "ECE 2010"}));
+        roster.add(student("bob", {"ECE 2010"}));
+        roster.add(student("cat", {"HIST 1010"}));
+        roster.edit(roster.handle(0), [](Profile& p) { p.availabilityMutable() = {{Day::Mon, 600, 720}}; });
+        events = 0;
+
+        std::vector<Enrollment> dump = {
+            {"ann@clemson.edu", {"ECE 2010", "CPSC 2150", "ENGL 1030"}},
+            {"bob@clemson.edu", {"ece 2010"}},
+        };
+        EnrollmentPlan plan = EnrollmentSync::sync(roster, dump, EnrollmentSync::Unlisted::DropAll);
+        assert(plan.changes.size() == 2 && plan.unchanged == 1 && events == 2);
+        assert(roster.profiles()[0].courses() == (Strings{"CPSC 2150", "ECE 2010", "ENGL 1030"}));
+        assert(roster.profiles()[1].courses() == Strings{"ECE 2010"});
+        assert(roster.profiles()[2].courses().empty());
+        assert(occupancy.freeIn("ENGL 1030", Day::Mon, 600, 660) == std::vector<std::size_t>{0});
+        assert(occupancy.freeIn("MATH 1080", Day::Mon, 600, 660).empty());
+
+        // Re-syncing the same dump is a no-op
+        events = 0;
+        plan = EnrollmentSync::sync(roster, dump, EnrollmentSync::Unlisted::DropAll);
+        assert(plan.changes.empty() && plan.unchanged == 2 && events == 0);
+    }
+
+    {
+        // Test 4: on a RosterSnapshot the whole plan is one publish; pinned readers keep the old courses
+        RosterSnapshot snap;
+        snap.replaceAll({student("ann", {"MATH 1080"}), student("bob", {"ECE 2010"}), student("cy", {"HIST 1010"})});
+        std::vector<Enrollment> dump = {{"ann@clemson.edu", {"MATH 1080", "CPSC 2150"}},
+                                        {"cy@clemson.edu", {}},
+                                        {"zed@clemson.edu", {"CPSC 2150"}}};
+        auto before = snap.pin();
+        auto plan = EnrollmentSync::plan(before, dump);
+        assert(plan.changes.size() == 2 && plan.changes[1].dropped == Strings{"HIST 1010"});
+        assert(plan.unchanged == 0 && plan.unknownEmails == Strings{"zed@clemson.edu"}); // bob unlisted: kept
+
+        plan = EnrollmentSync::plan(before, dump, EnrollmentSync::Unlisted::DropAll);
+        assert(plan.changes.size() == 3);
+        EnrollmentSync::apply(snap, plan);
+        assert(snap.currentVersion() == before.version() + 1);
+        auto after = snap.pin();
+        assert(after.profiles()[0].courses() == (Strings{"MATH 1080", "CPSC 2150"}));
+        assert(after.profiles()[1].courses().empty() && after.profiles()[2].courses().empty());
+        assert(after.findByEmail("bob@clemson.edu") == &after.profiles()[1]);
+        assert(before.profiles()[0].courses() == Strings{"MATH 1080"});
+
+        EnrollmentSync::apply(snap, EnrollmentSync::plan(after, dump));
+        assert(snap.currentVersion() == after.version()); // nothing to do, nothing published
+    }
+
+    std::cout << "[test_enrollment_sync] All tests passed.\n";
+    return 0;
+}
@@ -0,0 +1,76 @@
+/***************************************************************************************
+ * test_flat_map.cpp
+ * Tests for the open-addressing FlatMap (insert/find/erase vs std::unordered_map,
+ * heterogeneous string_view lookup, move, clear).
+ *
+ * STANDARD LIBRARIES USED:
+ *  <cassert>, <iostream>, <random>, <string>, <unordered_map>
+ ****************************************************************************************/
+#include <cassert>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include "FlatMap.hpp"
+
+using namespace sb;
+
+int main() {
+    {
+        // Test 1: basic insert/find/erase with heterogeneous keys
+        FlatMap<std::string, int, StrHash> m;
+        assert(m.find("missing") == nullptr && m.empty());
+        auto r = m.tryEmplace("alice@clemson.edu", 1);
+        assert(r.second && *r.first == 1);
+        assert(!m.tryEmplace("alice@clemson.edu", 2).second);
+        m["bob@clemson.edu"] = 7;
+        std::string_view probe = "bob@clemson.edu";
+        assert(m.find(probe) && *m.find(probe) == 7 && m.size() == 2);
+        assert(m.erase(std::string_view("alice@clemson.edu")) && !m.erase("alice@clemson.edu"));
+        assert(m.size() == 1 && !m.contains("alice@clemson.edu"));
+    }
+
+    {
+        // Test 2: randomized agreement with std::unordered_map, including backward-shift erase
+        FlatMap<int, int> m;       // identity std::hash<int>: exercises the hash mixing
+        std::unordered_map<int, int> ref;
+        std::mt19937 rng(12);
+        std::uniform_int_distribution<int> key(0, 5000), op(0, 9);
+        for (int step = 0; step < 200000; ++step) {
+            int k = key(rng) * 64; // clustered keys
+            int o = op(rng);
+            if (o < 5) {
+                bool inserted = m.tryEmplace(k, step).second;
+                assert(inserted == ref.emplace(k, step).second);
+            } else if (o < 8) {
+                assert(m.erase(k) == (ref.erase(k) == 1));
+            } else {
+                const int* v = m.find(k);
+                auto it = ref.find(k);
+                assert((v != nullptr) == (it != ref.end()));
+                if (v) assert(*v == it->second);
+            }
+            assert(m.size() == ref.size());
+        }
+        std::size_t seen = 0;
+        m.forEach([&](const int& k, int& v) { assert(ref.at(k) == v); ++seen; });
+        assert(seen == ref.size());
+    }
+
+    {
+        // Test 3: move and clear; non-trivial values survive rehashing
+        FlatMap<std::string, std::string, StrHash> a(4);
+        for (int i = 0; i < 1000; ++i) a.tryEmplace("k" + std::to_string(i), std::string(40, 'a' + i % 26));
+        FlatMap<std::string, std::string, StrHash> b(std::move(a));
+        assert(a.size() == 0 && b.size() == 1000);
+        assert(*b.find("k999") == std::string(40, 'a' + 999 % 26));
+        b.clear();
+        assert(b.empty() && b.find("k1") == nullptr);
+        b["again"] = "x";
+        assert(b.size() == 1);
+    }
+
+    std::cout << "[test_flat_map] All tests passed.\n";
+    return 0;
+}
@@ -0,0 +1,160 @@
+/***************************************************************************************
+ * test_fuzzy_search.cpp
+ * Tests for the bit-parallel OSA matcher, FuzzyNameIndex and ClassmateSearch::byNameFuzzy.
+ *
+ * STANDARD LIBRARIES USED:
+ *  <algorithm>, <cassert>, <iostream>, <random>, <string>, <vector>
+ ****************************************************************************************/
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "ClassmateSearch.hpp"
+#include "FuzzySearch.hpp"
+
+using namespace sb;
+
+// Reference: min OSA distance between p and any substring of t (textbook DP).
+static int bruteSubstringOsa(const std::string& p, const std::string& t) {
+    const std::size_t m = p.size(), n = t.size();
+    std::vector<std::vector<int>> d(m + 1, std::vector<int>(n + 1, 0));
+    for (std::size_t i = 0; i <= m; ++i) d[i][0] = static_cast<int>(i);
+    for (std::size_t i = 1; i <= m; ++i) {
+        for (std::size_t j = 1; j <= n; ++j) {
+            int cost = p[i - 1] == t[j - 1] ? 0 : 1;
+            int v = std::min({d[i - 1][j] + 1, d[i][j - 1] + 1, d[i - 1][j - 1] + cost});
+            if (i > 1 && j > 1 && p[i - 1] == t[j - 2] && p[i - 2] == t[j - 1]) v = std::min(v, d[i - 2][j - 2] + 1);
+            d[i][j] = v;
+        }
+    }
+    int best = static_cast<int>(m);
+    for (std::size_t j = 0; j <= n; ++j) best = std::min(best, d[m][j]);
+    return best;
+}
+
+static Profile person(const std::string& name, const std::string& email) {
+    Profile p;
+    p.createOrReset(name, email, {"CPSC 2150"});
+    return p;
+}
+
+int main() {
+    {
+        // Test 1: the bit-parallel matcher agrees with the DP on random strings
+        std::mt19937 rng(7);
+        std::uniform_int_distribution<int> ch(0, 2), plen(1, 12), tlen(0, 20);
+        for (int trial = 0; trial < 20000; ++trial) {
+            std::string p, t;
+            for (int i = plen(rng); i > 0; --i) p.push_back(static_cast<char>('a' + ch(rng)));
+            for (int i = tlen(rng); i > 0; --i) t.push_back(static_cast<char>('a' + ch(rng)));
+            assert(FuzzyPattern(p).bestDistance(t) == bruteSubstringOsa(p, t));
+        }
+        // Full 64-byte patterns use every bit of the word
+        std::string longP(64, 'x'), longT = std::string(30, 'y') + std::string(63, 'x');
+        assert(FuzzyPattern(longP).bestDistance(longT) == 1);
+    }
+
+    {
+        // Test 2: typical typos
+        assert(FuzzyPattern("jonh").bestDistance("john smith") == 1);   // transposition
+        assert(FuzzyPattern("smith").bestDistance("john smith") == 0);  // plain substring
+        assert(FuzzyPattern("smtih").bestDistance("john smith") == 1);
+        assert(FuzzyPattern("jhon").bestDistance("john smith") == 1);
+        assert(FuzzyPattern("jon").bestDistance("john smith") == 1);    // deletion
+        assert(FuzzyPattern("zzz").bestDistance("john") == 3);
+        assert(FuzzyPattern("").bestDistance("john") == 0);
+        assert(foldCase("JoHn 42@X") == "john 42@x");
+        assert(FuzzyPattern("li").clampEdits(1) == 0 && FuzzyPattern("jonh").clampEdits(5) == 2);
+        assert(FuzzyPattern("jonh").clampEdits(-3) == 0 && FuzzyPattern("").clampEdits(2) == 0);
+    }
+
+    std::vector<Profile> all = {
+        person("John Smith", "jsmith@clemson.edu"),
+        person("Jon Smyth", "jsmyth@clemson.edu"),
+        person("Joan Smith", "joan@clemson.edu"),
+        person("Alice Johnson", "alice@clemson.edu"),
+        person("", "johnny@clemson.edu"),
+        person("Me Myself", "me@clemson.edu"),
+    };
+    const Profile& me = all[5];
+
+    {
+        // Test 3: byNameFuzzy ranks by distance, then roster order, and skips self
+        auto r = ClassmateSearch::byNameFuzzy(all, me, "Jonh", 1);
+        // John Smith, Jon Smyth, Alice Johnson and johnny are one edit away; Joan is two
+        assert(r.size() == 4);
+        for (const auto& m : r) assert(m.distance == 1 && m.person != &all[2]);
+        assert(r[0].person == &all[0] && r[3].person == &all[4]); // ties in roster order
+        auto r2 = ClassmateSearch::byNameFuzzy(all, me, "Jonh", 2);
+        assert(r2.size() == 5 && r2.back().person == &all[2] && r2.back().distance == 2);
+        auto exact = ClassmateSearch::byNameFuzzy(all, me, "smith", 0);
+        assert(exact.size() == 2);
+        assert(ClassmateSearch::byNameFuzzy(all, me, "myself", 2).empty()); // self excluded
+        assert(ClassmateSearch::byNameFuzzy(all, me, "   ", 2).empty());
+    }
+
+    {
+        // Test 4: the index returns exactly what the scan returns
+        FuzzyNameIndex index(all);
+        assert(index.size() == 11 && index.distinctKeys() == 11); // 5 names + 6 email local parts
+        const char* queries[] = {"jonh", "smith", "smtih", "alcie", "johny", "xyz", "JOAN", "s"};
+        for (const char* q : queries) {
+            for (int k = 0; k <= 2; ++k) {
+                auto a = ClassmateSearch::byNameFuzzy(all, me, q, k);
+                auto b = ClassmateSearch::byNameFuzzy(index, all, me, q, k);
+                assert(a.size() == b.size());
+                for (std::size_t i = 0; i < a.size(); ++i) {
+                    assert(a[i].person == b[i].person && a[i].distance == b[i].distance);
+                }
+            }
+        }
+    }
+
+    {
+        // Test 5: re-adding an id replaces its keys; heavy churn compacts
+        FuzzyNameIndex index(all);
+        all[0] = person("Zed Quux", "zq@clemson.edu");
+        index.add(0, all[0]);
+        assert(ClassmateSearch::byNameFuzzy(index, all, me, "quux", 0).size() == 1);
+        for (const auto& m : ClassmateSearch::byNameFuzzy(index, all, me, "jsmith", 0)) {
+            assert(m.person != &all[0]);
+        }
+        for (int round = 0; round < 2000; ++round) {
+            all[1] = person("Name" + std::to_string(round), "n" + std::to_string(round) + "@clemson.edu");
+            index.add(1, all[1]);
+        }
+        assert(index.size() == 11);
+        auto r = ClassmateSearch::byNameFuzzy(index, all, me, "name1999", 0);
+        assert(r.size() == 1 && r[0].person == &all[1]);
+    }
+
+    {
+        // Test 6: randomized index vs scan on a larger roster
+        std::vector<std::string> first = {"john", "maria", "wei", "fatima", "liam", "olivia", "noah", "ava"};
+        std::vector<std::string> last = {"smith", "garcia", "chen", "khan", "brown", "nguyen", "miller"};
+        std::mt19937 rng(11);
+        std::vector<Profile> roster;
+        for (int i = 0; i < 3000; ++i) {
+            const std::string& f = first[rng() % first.size()];
+            const std::string& l = last[rng() % last.size()];
+            roster.push_back(person(f + " " + l, f.substr(0, 1) + l + std::to_string(i) + "@clemson.edu"));
+        }
+        Profile outsider = person("Out Sider", "out@clemson.edu");
+        FuzzyNameIndex index(roster);
+        const char* queries[] = {"jonh", "garica", "nguyn", "olvia smith", "chen", "khna", "mllr", "w"};
+        for (const char* q : queries) {
+            for (int k = 0; k <= 2; ++k) {
+                auto a = ClassmateSearch::byNameFuzzy(roster, outsider, q, k);
+                auto b = ClassmateSearch::byNameFuzzy(index, roster, outsider, q, k);
+                assert(a.size() == b.size());
+                for (std::size_t i = 0; i < a.size(); ++i) assert(a[i].distance == b[i].distance);
+            }
+        }
+    }
+
+    std::cout << "[test_fuzzy_search] All tests passed.\n";
+    return 0;
+}
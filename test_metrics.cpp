@@ -0,0 +1,138 @@
+/***************************************************************************************
+ * test_metrics.cpp
+ * Tests for API latency histograms, counters and the Prometheus/JSON exporters.
+ *
+ * STANDARD LIBRARIES USED:
+ *  <cassert>, <chrono>, <cstdio>, <fstream>, <iostream>, <sstream>, <string>, <thread>,
+ *  <type_traits>, <vector>
+ ****************************************************************************************/
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "Metrics.hpp"
+#include "NotificationCenter.hpp"
+#include "SessionRequests.hpp"
+
+using namespace sb;
+
+static_assert(std::is_empty<BasicApiTimer<false>>::value, "compiled-out timer must carry no state");
+
+static bool within(std::uint64_t got, std::uint64_t want, double rel) {
+    double d = static_cast<double>(got) - static_cast<double>(want);
+    return (d < 0 ? -d : d) <= rel * static_cast<double>(want);
+}
+
+static std::string slurp(const std::string& path) {
+    std::ifstream in(path);
+    std::stringstream ss;
+    ss << in.rdbuf();
+    return ss.str();
+}
+
+int main() {
+    {
+        // Test 1: bucket bounds are exact for small values and within 1/16 above that
+        for (std::uint64_t v = 0; v < 32; ++v) {
+            assert(LatencyHistogram::bucketUpper(LatencyHistogram::bucketOf(v)) == v);
+        }
+        std::size_t prev = 0;
+        for (std::uint64_t v = 1; v < (std::uint64_t{1} << 40); v = v * 3 / 2 + 1) {
+            std::size_t b = LatencyHistogram::bucketOf(v);
+            std::uint64_t up = LatencyHistogram::bucketUpper(b);
+            assert(b >= prev && b < LatencyHistogram::kBuckets);
+            assert(up >= v && up - v <= v / 16);
+            prev = b;
+        }
+        assert(LatencyHistogram::bucketOf(~std::uint64_t{0}) == LatencyHistogram::kBuckets - 1);
+        assert(LatencyHistogram::bucketUpper(LatencyHistogram::kBuckets - 1) == ~std::uint64_t{0});
+    }
+
+    {
+        // Test 2: quantiles of a uniform distribution
+        LatencyHistogram h;
+        for (std::uint64_t v = 1; v <= 10000; ++v) h.record(v * 1000);
+        auto s = h.snapshot();
+        assert(s.count == 10000 && s.maxNs == 10000000);
+        assert(s.sumNs == 1000ull * 10000 * 10001 / 2);
+        assert(within(s.p50Ns, 5000000, 0.07) && within(s.p90Ns, 9000000, 0.07));
+        assert(within(s.p99Ns, 9900000, 0.07) && s.p999Ns <= s.maxNs);
+        h.reset();
+        assert(h.snapshot().count == 0 && h.snapshot().p50Ns == 0);
+    }
+
+    {
+        // Test 3: concurrent recording loses nothing
+        LatencyHistogram h;
+        std::vector<std::thread> ts;
+        for (int t = 0; t < 4; ++t) {
+            ts.emplace_back([&h, t] { for (int i = 0; i < 50000; ++i) h.record(static_cast<std::uint64_t>(i + t)); });
+        }
+        for (auto& t : ts) t.join();
+        auto s = h.snapshot();
+        assert(s.count == 200000 && s.maxNs == 50002);
+    }
+
+    {
+        // Test 4: instrumented APIs record calls and failures; exporters show them
+        Metrics& m = Metrics::global();
+        m.reset();
+        NotificationCenter nc;
+        SessionRequests sr(&nc);
+        Profile a, b;
+        a.createOrReset("A", "a@clemson.edu", {"CPSC 1010"});
+        b.createOrReset("B", "b@clemson.edu", {"CPSC 1010"});
+        const StudySession& s = sr.sendRequest(a, b, "CPSC 1010", Day::Mon, 600, 660);
+        assert(!sr.confirmRequest("S-none", b));
+        assert(!sr.confirmRequest(s.id, a)); // only the invitee may confirm
+        assert(sr.confirmRequest(s.id, b));
+        nc.fetchAndClear("a@clemson.edu");
+
+        std::uint64_t expect = kMetricsEnabled ? 1 : 0;
+        assert(m.latency(Api::SendRequest).snapshot().count == expect);
+        assert(m.latency(Api::ConfirmRequest).snapshot().count == 3 * expect);
+        assert(m.failures(Api::ConfirmRequest) == 2 * expect);
+        assert(m.latency(Api::Notify).snapshot().count == 3 * expect);
+        assert(m.latency(Api::FetchAndClear).snapshot().count == expect);
+
+        std::ostringstream prom, json;
+        m.writePrometheus(prom);
+        m.writeJson(json);
+        assert(prom.str().find("# TYPE sb_api_latency_seconds summary") != std::string::npos);
+        assert(prom.str().find("sb_api_latency_seconds_count{api=\"confirmRequest\"} " +
+                               std::to_string(3 * expect)) != std::string::npos);
+        assert(prom.str().find("sb_api_failures_total{api=\"confirmRequest\"} " +
+                               std::to_string(2 * expect)) != std::string::npos);
+        assert(json.str().find("\"confirmRequest\":{\"count\":" + std::to_string(3 * expect) +
+                               ",\"failures\":" + std::to_string(2 * expect)) != std::string::npos);
+    }
+
+    {
+        // Test 5: file dumps (format by extension) and the periodic dumper
+        const std::string prom = "/tmp/sb_test_metrics.prom";
+        const std::string json = "/tmp/sb_test_metrics.json";
+        std::string err;
+        assert(Metrics::global().dumpToFile(prom, err) && err.empty());
+        assert(slurp(prom).find("sb_api_latency_seconds") != std::string::npos);
+        std::remove(json.c_str());
+        {
+            MetricsDumper d(Metrics::global(), json, std::chrono::milliseconds(10));
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            assert(d.lastError().empty());
+        }
+        assert(slurp(json).rfind("{\"metrics_enabled\":", 0) == 0);
+        assert(!Metrics::global().dumpToFile("/nonexistent-dir/x.prom", err) && !err.empty());
+        std::remove(prom.c_str());
+        std::remove(json.c_str());
+    }
+
+    std::cout << "[test_metrics] All tests passed.\n";
+    return 0;
+}
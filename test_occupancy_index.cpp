@@ -0,0 +1,170 @@
+/***************************************************************************************
+ * test_occupancy_index.cpp
+ * Tests for OccupancyIndex (per-course, per-day free-interval index) and
+ * AvailabilityBrowser::freeInWindow.
+ *
+ * STANDARD LIBRARIES USED:
+ *  <algorithm>, <cassert>, <iostream>, <random>, <string>, <vector>
+ ****************************************************************************************/
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "AvailabilityBrowser.hpp"
+#include "AvailabilityManager.hpp"
+#include "OccupancyIndex.hpp"
+#include "Roster.hpp"
+
+using namespace sb;
+using Match = OccupancyIndex::Match;
+
+static Profile student(const std::string& name, std::vector<std::string> courses,
+                       std::vector<AvailabilitySlot> slots) {
+    Profile p;
+    p.createOrReset(name, name + "@clemson.edu", courses);
+    p.availabilityMutable() = std::move(slots);
+    p.commitAvailability();
+    return p;
+}
+
+// Reference answer straight from the slots (after coalescing touching/overlapping ones).
+static std::vector<std::size_t> brute(const std::vector<Profile>& all, const std::string& course,
+                                      Day day, int s, int e, Match m) {
+    std::vector<std::size_t> out;
+    for (std::size_t i = 0; i < all.size(); ++i) {
+        const auto& cs = all[i].courses();
+        if (std::find(cs.begin(), cs.end(), course) == cs.end()) continue;
+        std::vector<std::pair<int, int>> runs;
+        for (const auto& sl : all[i].availability()) if (sl.day == day) runs.push_back({sl.start, sl.end});
+        std::sort(runs.begin(), runs.end());
+        std::vector<std::pair<int, int>> merged;
+        for (const auto& r : runs) {
+            if (!merged.empty() && r.first <= merged.back().second) merged.back().second = std::max(merged.back().second, r.second);
+            else merged.push_back(r);
+        }
+        bool hit = false;
+        for (const auto& r : merged) {
+            if (m == Match::Full ? (r.first <= s && r.second >= e) : (r.first < e && r.second > s)) hit = true;
+        }
+        if (hit) out.push_back(i);
+    }
+    return out;
+}
+
+int main() {
+    {
+        // Test 1: full vs partial windows, time points, case-insensitive course codes
+        std::vector<Profile> all = {
+            student("ann", {"CPSC 2150"}, {{Day::Tue, 13 * 60, 16 * 60}}),
+            student("bob", {"CPSC 2150"}, {{Day::Tue, 14 * 60 + 30, 17 * 60}}),
+            student("cat", {"CPSC 2150", "MATH 2060"}, {{Day::Tue, 14 * 60, 15 * 60}, {Day::Wed, 600, 700}}),
+            student("dan", {"MATH 2060"}, {{Day::Tue, 13 * 60, 18 * 60}}),
+            // split but touching slots count as one free run
+            student("eve", {"CPSC 2150"}, {{Day::Tue, 14 * 60, 14 * 60 + 30}, {Day::Tue, 14 * 60 + 30, 15 * 60}}),
+        };
+        OccupancyIndex idx(all);
+        assert((idx.freeIn("cpsc 2150", Day::Tue, 14 * 60, 15 * 60) == std::vector<std::size_t>{0, 2, 4}));
+        assert((idx.freeIn("CPSC 2150", Day::Tue, 14 * 60, 15 * 60, Match::Partial) == std::vector<std::size_t>{0, 1, 2, 4}));
+        assert((idx.freeAt("CPSC 2150", Day::Tue, 15 * 60) == std::vector<std::size_t>{0, 1}));  // end is exclusive
+        assert((idx.freeAt("MATH 2060", Day::Wed, 650) == std::vector<std::size_t>{2}));
+        assert(idx.freeIn("CPSC 2150", Day::Mon, 0, 1440, Match::Partial).empty());
+        assert(idx.freeIn("CPSC 2150", Day::Tue, 900, 900).empty());
+        assert(idx.freeIn("PHYS 1000", Day::Tue, 0, 1440).empty());
+        assert(idx.courseCount() == 2);
+
+        // Browser wrapper: roster order, self excluded, that day's slots
+        auto views = AvailabilityBrowser::freeInWindow(idx, all, all[0], "CPSC 2150", Day::Tue, 14 * 60, 15 * 60);
+        assert(views.size() == 2 && views[0].name == "cat" && views[1].name == "eve");
+        assert(views[1].slots.size() == 2);
+    }
+
+    {
+        // Test 2: updates through roster events (add slot, remove course, reset profile)
+        Roster roster;
+        OccupancyIndex idx;
+        roster.subscribe([&](const RosterChange& c) { idx.update(c.id, c.profile); });
+        auto a = roster.add(student("ann", {"CPSC 2150"}, {}));
+        auto b = roster.add(student("bob", {"CPSC 2150", "ECE 2010"}, {{Day::Fri, 600, 720}}));
+        assert((idx.freeAt("CPSC 2150", Day::Fri, 660) == std::vector<std::size_t>{1}));
+
+        roster.edit(a, [](Profile& p) { AvailabilityManager::addMerged(p, {Day::Fri, 640, 700}); });
+        assert((idx.freeAt("CPSC 2150", Day::Fri, 660) == std::vector<std::size_t>{0, 1}));
+        roster.edit(a, [](Profile& p) { AvailabilityManager::addMerged(p, {Day::Fri, 700, 760}); });
+        assert((idx.freeIn("CPSC 2150", Day::Fri, 650, 750) == std::vector<std::size_t>{0}));
+
+        roster.edit(b, [](Profile& p) { p.coursesMutable() = {"ECE 2010"}; });
+        assert((idx.freeAt("CPSC 2150", Day::Fri, 660) == std::vector<std::size_t>{0}));
+        assert((idx.freeAt("ECE 2010", Day::Fri, 660) == std::vector<std::size_t>{1}));
+
+        roster.edit(a, [](Profile& p) { p.createOrReset("ann", "ann@clemson.edu", {"CPSC 2150"}); });
+        assert(idx.freeAt("CPSC 2150", Day::Fri, 660).empty());
+        assert(idx.intervalCount() == 1);
+    }
+
+    {
+        // Test 3: randomized incremental updates vs brute force
+        std::mt19937 rng(3);
+        const std::vector<std::string> courses = {"A 1", "B 2", "C 3"};
+        auto randomProfile = [&](std::size_t i) {
+            std::vector<std::string> cs;
+            for (const auto& c : courses) if (rng() % 2) cs.push_back(c);
+            std::vector<AvailabilitySlot> slots;
+            for (int k = static_cast<int>(rng() % 5); k > 0; --k) {
+                int s = static_cast<int>(rng() % 60);
+                slots.push_back({static_cast<Day>(rng() % 2), s, s + 1 + static_cast<int>(rng() % 20)});
+            }
+            return student("s" + std::to_string(i), cs, slots);
+        };
+        std::vector<Profile> all;
+        for (std::size_t i = 0; i < 40; ++i) all.push_back(randomProfile(i));
+        OccupancyIndex idx(all);
+        for (int step = 0; step < 3000; ++step) {
+            if (step % 3 == 0) {
+                std::size_t i = rng() % (all.size() + 1);
+                if (i == all.size()) all.push_back(randomProfile(i));
+                else all[i] = randomProfile(i);
+                idx.update(i, all[i]);
+            }
+            const std::string& c = courses[rng() % courses.size()];
+            Day d = static_cast<Day>(rng() % 2);
+            int s = static_cast<int>(rng() % 80), e = s + static_cast<int>(rng() % 15);
+            Match m = rng() % 2 ? Match::Full : Match::Partial;
+            assert(idx.freeIn(c, d, s, e, m) == (s < e ? brute(all, c, d, s, e, m) : std::vector<std::size_t>{}));
+        }
+        OccupancyIndex rebuilt(all);
+        assert(rebuilt.intervalCount() == idx.intervalCount());
+    }
+
+    {
+        // Test 4: courses nobody takes any more are dropped; the others keep answering
+        std::vector<Profile> all;
+        for (int i = 0; i < 20; ++i) {
+            all.push_back(student("s" + std::to_string(i), {"CPSC 2150", "MATH " + std::to_string(1000 + i)},
+                                  {{Day::Mon, 600, 700 + i}}));
+        }
+        OccupancyIndex idx(all);
+        std::size_t maxCourses = 0;
+        for (int round = 0; round < 10000; ++round) {
+            std::size_t i = static_cast<std::size_t>(round) % 4;
+            all[i] = student("s" + std::to_string(i), {"CPSC 2150", "XYZ " + std::to_string(round)},
+                             {{Day::Mon, 600, 700 + static_cast<int>(i)}});
+            idx.update(i, all[i]);
+            maxCourses = std::max(maxCourses, idx.courseCount());
+        }
+        assert(maxCourses <= 1025 && idx.courseCount() < 1025);
+        assert(idx.freeIn("CPSC 2150", Day::Mon, 600, 700).size() == 20);
+        assert((idx.freeAt("MATH 1019", Day::Mon, 650) == std::vector<std::size_t>{19}));
+        assert(idx.freeAt("MATH 1000", Day::Mon, 650).empty()); // s0 left it
+        assert((idx.freeAt("xyz 9998", Day::Mon, 650) == std::vector<std::size_t>{2}));
+        assert(idx.freeAt("XYZ 9000", Day::Mon, 650).empty());
+        for (std::size_t i = 0; i < all.size(); ++i) idx.update(i, all[i]); // no-ops after remapping
+        assert(idx.freeIn("CPSC 2150", Day::Mon, 600, 700).size() == 20);
+        assert(OccupancyIndex(all).intervalCount() == idx.intervalCount());
+    }
+
+    std::cout << "[test_occupancy_index] All tests passed.\n";
+    return 0;
+}
@@ -74,6 +74,26 @@
          assert(p.availability().empty()); // cleared
      }
  
+     {
+         // Test 4: slotsOn uses the day index and falls back to scanning unordered slots
+         Profile p;
+         p.createOrReset("", "c@clemson.edu", {});
+         assert(p.displayName() == "c@clemson.edu");
+         auto& v = p.availabilityMutable();
+         v = {{Day::Wed, 600, 660}, {Day::Mon, 540, 600}, {Day::Wed, 700, 760}};
+         assert(!p.availabilityCommitted());
+         assert(p.slotsOn(Day::Wed).size() == 2 && p.slotsOn(Day::Tue).empty());
+         assert(!p.commitAvailability()); // not in day order → committed without a day index
+         assert(p.availabilityCommitted() && p.slotsOn(Day::Wed).size() == 2);
+
+         p.availabilityMutable() = {{Day::Mon, 540, 600}, {Day::Wed, 600, 660}, {Day::Wed, 700, 760}};
+         assert(p.commitAvailability());
+         auto wed = p.slotsOn(Day::Wed);
+         assert(wed.size() == 2 && (*wed.begin()).start == 600);
+         assert(&*wed.begin() == &p.availability()[1]); // a span, not a copy
+         assert(p.slotsOn(Day::Sun).empty() && p.slotsOn(Day::Mon).size() == 1);
+     }
+ 
      std::cout << "[test_profile] All tests passed.\n";
      return 0;
  }
\ No newline at end of file
@@ -0,0 +1,103 @@
+/***************************************************************************************
+ * test_profile_history.cpp
+ * Tests for ProfileHistory (versioned roster profiles: undo, at(version), retention).
+ *
+ * STANDARD LIBRARIES USED:
+ *  <cassert>, <iostream>, <string>, <vector>
+ ****************************************************************************************/
+#include <cassert>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "AvailabilityEditor.hpp"
+#include "AvailabilityManager.hpp"
+#include "CourseManager.hpp"
+#include "OccupancyIndex.hpp"
+#include "ProfileHistory.hpp"
+#include "Roster.hpp"
+
+using namespace sb;
+using Strings = std::vector<std::string>;
+
+int main() {
+    // The managers print feedback; keep the test output readable.
+    std::streambuf* saved = std::cout.rdbuf(nullptr);
+
+    {
+        // Test 1: every changing edit is a version; no-op edits are not
+        Roster roster;
+        Profile seed;
+        seed.createOrReset("Ann", "ann@clemson.edu", {"CPSC 2150"});
+        auto ann = roster.add(seed);
+        ProfileHistory history(roster); // picks up existing profiles
+        assert(history.versions(ann.id()).size() == 1 && history.now() == 1);
+
+        CourseManager cm;
+        AvailabilityManager am;
+        AvailabilityEditor ae;
+        roster.edit(ann, [&](Profile& p) { cm.addCourses(p, "MATH 1080"); });          // v2
+        ProfileHistory::Version afterCourses = history.now();
+        roster.edit(ann, [&](Profile& p) { am.addAvailability(p, Day::Mon, 600, 660); }); // v3
+        roster.edit(ann, [&](Profile& p) { cm.addCourses(p, "cpsc 2150"); });          // duplicate: no version
+        roster.edit(ann, [&](Profile& p) { ae.editSlot(p, 1, Day::Tue, 700, 760); });    // v4
+        assert(history.now() == 4 && history.versions(ann.id()).size() == 4);
+
+        // Point-in-time reads
+        assert(!history.at(ann.id(), 0));
+        assert(history.at(ann.id(), 1)->courses() == Strings{"CPSC 2150"});
+        auto then = history.at(ann.id(), afterCourses);
+        assert(then && then->courses() == (Strings{"CPSC 2150", "MATH 1080"}) && then->availability().empty());
+        assert(history.at(ann.id(), 99)->slotsOn(Day::Tue).size() == 1);
+
+        // Versions share schedules with the live profile (no availability copies)
+        assert(history.versions(ann.id()).back().profile.schedule() == ann->schedule());
+    }
+
+    {
+        // Test 2: undo walks back through Roster::edit (indexes follow) and is itself logged
+        Roster roster;
+        ProfileHistory history(roster);
+        OccupancyIndex occupancy;
+        roster.subscribe([&](const RosterChange& c) { occupancy.update(c.id, c.profile); });
+        Profile seed;
+        seed.createOrReset("Bob", "bob@clemson.edu", {"ECE 2010"});
+        auto bob = roster.add(seed);
+        roster.edit(bob, [](Profile& p) { AvailabilityManager::addMerged(p, {Day::Wed, 600, 700}); });
+        roster.edit(bob, [](Profile& p) { p.coursesMutable().push_back("PHYS 1220"); });
+        assert(occupancy.freeIn("PHYS 1220", Day::Wed, 600, 650).size() == 1);
+
+        assert(history.undo(bob.id()));                       // drop PHYS 1220
+        assert(bob->courses() == Strings{"ECE 2010"} && bob->slotsOn(Day::Wed).size() == 1);
+        assert(occupancy.freeIn("PHYS 1220", Day::Wed, 600, 650).empty());
+        assert(history.undo(bob.id()));                       // drop the slot
+        assert(bob->availability().empty() && occupancy.freeIn("ECE 2010", Day::Wed, 600, 650).empty());
+        assert(!history.undo(bob.id()));                      // back at the first version
+        assert(history.versions(bob.id()).size() == 5);       // undos are appended, not erased
+
+        // A new edit after undo continues from the restored state
+        roster.edit(bob, [](Profile& p) { p.coursesMutable().push_back("HIST 1010"); });
+        assert(history.undo(bob.id()) && bob->courses() == Strings{"ECE 2010"});
+    }
+
+    {
+        // Test 3: bounded retention
+        Roster roster;
+        ProfileHistory history(roster, 3);
+        Profile seed;
+        seed.createOrReset("Cat", "cat@clemson.edu", {});
+        auto cat = roster.add(seed);
+        for (int i = 0; i < 10; ++i) {
+            roster.edit(cat, [i](Profile& p) { AvailabilityManager::addMerged(p, {Day::Fri, i * 100, i * 100 + 50}); });
+        }
+        assert(history.versions(cat.id()).size() == 3 && history.versionCount() == 3);
+        assert(!history.at(cat.id(), 2));                     // dropped
+        assert(history.at(cat.id(), history.now())->availability().size() == 10);
+        assert(history.undo(cat.id()) && cat->availability().size() == 9);
+        assert(!history.undo(cat.id()));                      // parent fell out of the window
+    }
+
+    std::cout.rdbuf(saved);
+    std::cout << "[test_profile_history] All tests passed.\n";
+    return 0;
+}
@@ -0,0 +1,86 @@
+/***************************************************************************************
+ * test_roster.cpp
+ * Tests for the profile-owning Roster: handles, in-place edits, change events.
+ *
+ * STANDARD LIBRARIES USED:
+ *  <cassert>, <iostream>, <vector>, <string>
+ ****************************************************************************************/
+#include <cassert>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "Roster.hpp"
+#include "CourseManager.hpp"
+#include "AvailabilityManager.hpp"
+
+using namespace sb;
+
+static Profile makeProfile(const std::string& name, const std::string& email,
+                           const std::vector<std::string>& courses) {
+    Profile p;
+    p.createOrReset(name, email, CourseManager::normalizeDedup(courses));
+    return p;
+}
+
+int main() {
+    Roster roster;
+    std::vector<RosterChange::Kind> events;
+    std::vector<std::string> prevEmails;
+    std::size_t token = roster.subscribe([&](const RosterChange& c) {
+        events.push_back(c.kind);
+        prevEmails.emplace_back(c.previousEmail);
+    });
+
+    {
+        // Test 1: an unset handle reads as a non-existent profile
+        Roster::Handle none;
+        assert(!none.valid() && !none->exists());
+    }
+
+    Roster::Handle me = roster.add(makeProfile("Me", "me@clemson.edu", {"CPSC 2150"}));
+    roster.add(makeProfile("Alice", "alice@clemson.edu", {"CPSC 2150"}));
+    {
+        // Test 2: handles resolve to the owned profile; adds are announced
+        assert(me.valid() && me.id() == 0 && me->name() == "Me");
+        assert(events.size() == 2 && events[0] == RosterChange::Kind::Added);
+        assert(roster.findByEmail(" alice@clemson.edu ") == &roster.profiles()[1]);
+    }
+
+    {
+        // Test 3: edits mutate in place (no copy) and notify with the old email
+        const void* before = &roster.profiles()[0].courses();
+        roster.edit(me, [](Profile& p) {
+            CourseManager cm;
+            cm.addCourses(p, "math 1080");
+            AvailabilityManager::addMerged(p, AvailabilitySlot{Day::Mon, 600, 660});
+        });
+        assert(&roster.profiles()[0].courses() == before);
+        assert(me->courses().size() == 2 && me->availability().size() == 1);
+        assert(events.back() == RosterChange::Kind::Updated && prevEmails.back() == "me@clemson.edu");
+    }
+
+    {
+        // Test 4: changing an email keeps the email index in sync
+        roster.edit(me, [](Profile& p) { p.createOrReset("Me", "me2@clemson.edu", {}); });
+        assert(roster.findByEmail("me@clemson.edu") == nullptr);
+        assert(roster.findByEmail("me2@clemson.edu") == &*me);
+        assert(me->courses().empty());
+
+        // Duplicate emails: the first profile wins, the next takes over when it changes
+        Roster::Handle dup = roster.add(makeProfile("Alice 2", "alice@clemson.edu", {}));
+        assert(roster.findByEmail("alice@clemson.edu")->name() == "Alice");
+        roster.edit(roster.handle(1), [](Profile& p) { p.createOrReset("Alice", "al@clemson.edu", {}); });
+        assert(roster.findByEmail("alice@clemson.edu") == &*dup);
+    }
+
+    {
+        // Test 5: unsubscribed listeners stop receiving events
+        std::size_t n = events.size();
+        roster.unsubscribe(token);
+        roster.add(makeProfile("Bob", "bob@clemson.edu", {}));
+        assert(events.size() == n);
+    }
+
+    std::cout << "[test_roster] All tests passed.\n";
+    return 0;
+}
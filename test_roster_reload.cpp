@@ -0,0 +1,232 @@
+/***************************************************************************************
+ * test_roster_reload.cpp
+ * Tests for roster hot reload: StudyBuddyService::reloadEnrollments (only changed
+ * profiles republished; sessions, inboxes and indexes kept consistent) and FileWatcher
+ * (in-place writes and atomic renames both trigger, other files do not; a removed
+ * directory is reported and watched again once it is back).
+ *
+ * STANDARD LIBRARIES USED:
+ *  <atomic>, <cassert>, <chrono>, <cstdio>, <fstream>, <iostream>, <mutex>, <sstream>,
+ *  <string>, <thread>, <vector>
+ ****************************************************************************************/
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "FileWatcher.hpp"
+#include "Protocol.hpp"
+#include "StudyBuddyService.hpp"
+
+using namespace sb;
+using Strings = std::vector<std::string>;
+
+static wire::Status call(StudyBuddyService& svc, std::vector<std::uint8_t> frame,
+                         std::vector<std::uint8_t>& respBody) {
+    auto resp = svc.handle(frame.data() + 4, frame.size() - 4);
+    respBody.assign(resp.begin() + 4, resp.end());
+    return static_cast<wire::Status>(respBody[0]);
+}
+
+static std::vector<std::uint8_t> addProfile(const std::string& name, std::vector<std::string> courses) {
+    wire::Writer w;
+    w.u8(static_cast<std::uint8_t>(wire::Op::AddProfile)); w.u32(1);
+    w.str(name); w.str(name + "@clemson.edu");
+    w.u16(static_cast<std::uint16_t>(courses.size()));
+    for (auto& c : courses) w.str(c);
+    return w.finishFrame();
+}
+
+static std::vector<std::uint8_t> emailOp(wire::Op op, const std::string& email) {
+    wire::Writer w;
+    w.u8(static_cast<std::uint8_t>(op)); w.u32(2);
+    w.str(email);
+    return w.finishFrame();
+}
+
+// Emails of classmates in 'course' free for all of Mon 10:00-11:00, as seen by 'self'.
+static Strings freeMonday(StudyBuddyService& svc, const std::string& self, const std::string& course) {
+    wire::Writer w;
+    w.u8(static_cast<std::uint8_t>(wire::Op::FreeIn)); w.u32(3);
+    w.str(self); w.str(course); w.u8(0); w.i32(600); w.i32(660); w.u8(0);
+    std::vector<std::uint8_t> body;
+    assert(call(svc, w.finishFrame(), body) == wire::Status::Ok);
+    wire::Reader r(body.data() + 5, body.size() - 5);
+    Strings out(r.u16());
+    for (auto& e : out) {
+        e = r.str();
+        r.str(); // name
+    }
+    return out;
+}
+
+static void writeFile(const std::string& path, const std::string& text) {
+    std::ofstream(path, std::ios::trunc) << text;
+}
+
+int main() {
+    std::vector<std::uint8_t> body;
+    {
+        // Test 1: a reload republishes only changed enrollments; sessions and inboxes survive
+        StudyBuddyService svc;
+        assert(call(svc, addProfile("ann", {"CPSC 2150"}), body) == wire::Status::Ok);
+        assert(call(svc, addProfile("bob", {"CPSC 2150", "MATH 1080"}), body) == wire::Status::Ok);
+        assert(call(svc, addProfile("cy", {"MATH 1080"}), body) == wire::Status::Ok);
+        for (const char* who : {"ann", "bob", "cy"}) {
+            wire::Writer w;
+            w.u8(static_cast<std::uint8_t>(wire::Op::AddAvailability)); w.u32(4);
+            w.str(std::string(who) + "@clemson.edu"); w.u8(0); w.i32(540); w.i32(720);
+            assert(call(svc, w.finishFrame(), body) == wire::Status::Ok);
+        }
+        wire::Writer s;
+        s.u8(static_cast<std::uint8_t>(wire::Op::SendRequest)); s.u32(5);
+        s.str("ann@clemson.edu"); s.str("bob@clemson.edu"); s.str("CPSC 2150");
+        s.u8(2); s.i32(600); s.i32(660);
+        assert(call(svc, s.finishFrame(), body) == wire::Status::Ok);
+        assert(freeMonday(svc, "cy@clemson.edu", "CPSC 2150") == (Strings{"ann@clemson.edu", "bob@clemson.edu"}));
+
+        // bob leaves CPSC 2150 for ECE 2010; ann is unchanged; zed is not on the roster
+        std::istringstream csv("ann@clemson.edu,CPSC 2150\n"
+                               "bob@clemson.edu,MATH 1080\n"
+                               "bob@clemson.edu,ece 2010\n"
+                               "zed@clemson.edu,CPSC 2150\n");
+        auto r = svc.reloadEnrollments(csv);
+        assert(r.changed == 1 && r.unchanged == 1 && r.unknownEmails == Strings{"zed@clemson.edu"});
+        assert(!r.replanned && r.parseMs >= 0 && r.applyMs >= 0);
+        assert(svc.rosterSize() == 3); // unknown emails are reported, not created
+
+        assert(freeMonday(svc, "cy@clemson.edu", "CPSC 2150") == Strings{"ann@clemson.edu"});
+        assert(freeMonday(svc, "cy@clemson.edu", "ECE 2010") == Strings{"bob@clemson.edu"});
+        assert(freeMonday(svc, "bob@clemson.edu", "MATH 1080") == Strings{"cy@clemson.edu"}); // cy unlisted: kept
+
+        assert(call(svc, emailOp(wire::Op::PendingFor, "bob@clemson.edu"), body) == wire::Status::Ok);
+        assert(wire::Reader(body.data() + 5, body.size() - 5).u16() == 1);
+        assert(call(svc, emailOp(wire::Op::FetchNotifications, "bob@clemson.edu"), body) == wire::Status::Ok);
+        assert(wire::Reader(body.data() + 5, body.size() - 5).u16() == 1);
+
+        // The same file again changes nothing; DropAll empties unlisted students
+        csv.clear();
+        csv.seekg(0);
+        r = svc.reloadEnrollments(csv);
+        assert(r.changed == 0 && r.unchanged == 2);
+        std::istringstream only("ann@clemson.edu,CPSC 2150\n");
+        r = svc.reloadEnrollments(only, EnrollmentSync::Unlisted::DropAll);
+        assert(r.changed == 2 && r.unchanged == 1);
+        assert(freeMonday(svc, "ann@clemson.edu", "MATH 1080").empty());
+    }
+
+    const std::string dir = "/tmp";
+    const std::string tag = "sb_test_reload_" + std::to_string(::getpid());
+    const std::string a = dir + "/" + tag + "_a.csv";
+    const std::string b = dir + "/" + tag + "_b.csv";
+    {
+        // Test 2: the watcher reports in-place writes and renames, once per burst
+        std::mutex mu;
+        Strings seen;
+        std::atomic<int> calls{0};
+        FileWatcher watcher({a, b}, [&](const std::string& path) {
+            std::lock_guard<std::mutex> lk(mu);
+            seen.push_back(path);
+            ++calls;
+        }, std::chrono::milliseconds(20));
+        std::string err;
+        assert(watcher.start(err));
+
+        auto waitFor = [&](int n) {
+            for (int i = 0; i < 200 && calls.load() < n; ++i) std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            std::this_thread::sleep_for(std::chrono::milliseconds(60)); // any extra call would land by now
+            std::lock_guard<std::mutex> lk(mu);
+            Strings out = seen;
+            seen.clear();
+            calls = 0;
+            return out;
+        };
+
+        writeFile(a, "ann@clemson.edu,CPSC 2150\n");
+        writeFile(a, "ann@clemson.edu,CPSC 2150\nann@clemson.edu,MATH 1080\n");
+        assert(waitFor(1) == Strings{a}); // two writes, one call
+
+        writeFile(b + ".tmp", "bob@clemson.edu,ECE 2010\n");
+        assert(std::rename((b + ".tmp").c_str(), b.c_str()) == 0);
+        writeFile(dir + "/" + tag + "_other.csv", "x,y\n");
+        assert(waitFor(1) == Strings{b}); // the .tmp write and unrelated files are ignored
+
+        watcher.stop();
+        writeFile(a, "\n");
+        assert(waitFor(1).empty());
+    }
+    {
+        // Test 3: watcher + service, as server_main wires them
+        StudyBuddyService svc;
+        assert(call(svc, addProfile("ann", {"CPSC 2150"}), body) == wire::Status::Ok);
+        assert(call(svc, addProfile("bob", {"PHYS 1220"}), body) == wire::Status::Ok);
+        wire::Writer w;
+        w.u8(static_cast<std::uint8_t>(wire::Op::AddAvailability)); w.u32(4);
+        w.str("ann@clemson.edu"); w.u8(0); w.i32(600); w.i32(660);
+        assert(call(svc, w.finishFrame(), body) == wire::Status::Ok);
+        std::atomic<std::size_t> changed{0};
+        FileWatcher watcher({a}, [&](const std::string& path) {
+            std::ifstream in(path);
+            changed += svc.reloadEnrollments(in).changed;
+        }, std::chrono::milliseconds(10));
+        std::string err;
+        assert(watcher.start(err));
+        writeFile(a, "ann@clemson.edu,PHYS 1220\n");
+        for (int i = 0; i < 400 && changed.load() == 0; ++i) std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        assert(changed.load() == 1);
+        assert(freeMonday(svc, "bob@clemson.edu", "PHYS 1220") == Strings{"ann@clemson.edu"});
+    }
+    {
+        // Test 4: a removed directory is reported, re-watched once it is back, and its
+        // files count as changed then
+        const std::string sub = dir + "/" + tag + "_dir";
+        const std::string c = sub + "/c.csv";
+        assert(::mkdir(sub.c_str(), 0700) == 0);
+        std::mutex mu;
+        Strings errors;
+        std::atomic<int> calls{0};
+        FileWatcher watcher({c}, [&](const std::string& path) {
+            assert(path == c);
+            ++calls;
+        }, std::chrono::milliseconds(10));
+        watcher.setErrorHandler([&](const std::string& msg) {
+            std::lock_guard<std::mutex> lk(mu);
+            errors.push_back(msg);
+        });
+        std::string err;
+        assert(watcher.start(err));
+        auto errorCount = [&] {
+            std::lock_guard<std::mutex> lk(mu);
+            return errors.size();
+        };
+
+        assert(::rmdir(sub.c_str()) == 0);
+        for (int i = 0; i < 200 && errorCount() == 0; ++i) std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        assert(errorCount() == 1 && errors[0].find("lost watch on " + sub) == 0);
+
+        assert(::mkdir(sub.c_str(), 0700) == 0);
+        writeFile(c, "ann@clemson.edu,CPSC 2150\n"); // may land before the retry: still reported
+        for (int i = 0; i < 600 && calls.load() == 0; ++i) std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        assert(calls.load() >= 1);
+        assert(errorCount() == 2 && errors[1] == "watching " + sub + " again");
+        watcher.stop();
+        std::remove(c.c_str());
+        ::rmdir(sub.c_str());
+    }
+    std::remove(a.c_str());
+    std::remove(b.c_str());
+    std::remove((dir + "/" + tag + "_other.csv").c_str());
+
+    std::cout << "[test_roster_reload] All tests passed.\n";
+    return 0;
+}
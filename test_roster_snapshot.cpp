@@ -0,0 +1,112 @@
+/***************************************************************************************
+ * test_roster_snapshot.cpp
+ * Tests for copy-on-write Profiles and RCU roster snapshots.
+ *
+ * STANDARD LIBRARIES USED:
+ *  <cassert>, <iostream>, <vector>, <thread>, <atomic>
+ ****************************************************************************************/
+#include <atomic>
+#include <cassert>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "RosterSnapshot.hpp"
+#include "CourseManager.hpp"
+#include "Profile.hpp"
+
+using namespace sb;
+
+static Profile makeProfile(const std::string& name, const std::string& email,
+                           const std::vector<std::string>& courses) {
+    Profile p;
+    p.createOrReset(name, email, CourseManager::normalizeDedup(courses));
+    return p;
+}
+
+int main() {
+    {
+        // Test 1: Profile copies share data until one side mutates
+        Profile a = makeProfile("Alice", "alice@clemson.edu", {"CPSC 2150"});
+        Profile b = a;
+        assert(a.sharesDataWith(b));
+        b.coursesMutable().push_back("MATH 1080");
+        assert(!a.sharesDataWith(b));
+        assert(a.courses().size() == 1 && b.courses().size() == 2);
+
+        Profile moved = std::move(b);
+        assert(moved.courses().size() == 2);
+        assert(!b.exists() && b.courses().empty()); // moved-from stays readable
+    }
+
+    RosterSnapshot snap({makeProfile("Me", "me@clemson.edu", {"CPSC 2150"}),
+                         makeProfile("Alice", "alice@clemson.edu", {"CPSC 2150"})});
+    {
+        // Test 2: a pinned version is immutable while writers publish
+        auto pin = snap.pin();
+        const Profile* alice = pin.findByEmail(" alice@clemson.edu ");
+        assert(alice && alice->courses().size() == 1);
+
+        assert(snap.updateByEmail("alice@clemson.edu", [](Profile& p) {
+            p.coursesMutable().push_back("MATH 1080");
+        }));
+        assert(!snap.updateByEmail("ghost@clemson.edu", [](Profile&) {}));
+        assert(alice->courses().size() == 1); // old version untouched
+        assert(snap.retiredCount() == 1);     // still pinned → not reclaimed
+
+        auto fresh = snap.pin();
+        assert(fresh.version() == pin.version() + 1);
+        assert(fresh.findByEmail("alice@clemson.edu")->courses().size() == 2);
+        // Unchanged profiles are shared between versions, not copied.
+        assert(fresh.profiles()[0].sharesDataWith(pin.profiles()[0]));
+    }
+
+    {
+        // Test 3: retired versions are reclaimed once pins are released
+        snap.collect();
+        assert(snap.retiredCount() == 0);
+        std::size_t idx = snap.upsert(makeProfile("Bob", "bob@clemson.edu", {"ENGL 1030"}));
+        assert(idx == 2);
+        assert(snap.upsert(makeProfile("Bob B.", "bob@clemson.edu", {"ENGL 1030"})) == 2);
+        auto pin = snap.pin();
+        assert(pin.profiles().size() == 3 && pin.findByEmail("bob@clemson.edu")->name() == "Bob B.");
+        assert(snap.retiredCount() == 0);
+    }
+
+    {
+        // Test 4: concurrent readers always observe internally consistent profiles
+        std::vector<Profile> base;
+        for (int i = 0; i < 200; ++i)
+            base.push_back(makeProfile("U" + std::to_string(i), "u" + std::to_string(i) + "@x.edu", {"CPSC 2150"}));
+        RosterSnapshot rs(base);
+
+        std::atomic<bool> done{false};
+        std::atomic<long> reads{0};
+        std::vector<std::thread> readers;
+        for (int r = 0; r < 3; ++r) {
+            readers.emplace_back([&] {
+                while (!done.load()) {
+                    auto pin = rs.pin();
+                    for (const auto& p : pin.profiles()) {
+                        for (const auto& s : p.availability()) assert(s.end == s.start + 30);
+                    }
+                    ++reads;
+                }
+            });
+        }
+        for (int k = 0; k < 2000; ++k) {
+            rs.updateProfile(static_cast<std::size_t>(k % 200), [k](Profile& p) {
+                auto& v = p.availabilityMutable();
+                v.clear();
+                v.push_back({Day::Mon, k % 600, k % 600 + 30});
+            });
+        }
+        done = true;
+        for (auto& t : readers) t.join();
+        assert(reads.load() > 0);
+        rs.collect();
+        assert(rs.retiredCount() == 0);
+    }
+
+    std::cout << "[test_roster_snapshot] All tests passed.\n";
+    return 0;
+}
@@ -0,0 +1,87 @@
+/***************************************************************************************
+ * test_schedule.cpp
+ * Tests for hash-consed availability schedules and copy-on-write edits through Profile.
+ *
+ * STANDARD LIBRARIES USED:
+ *  <cassert>, <iostream>, <vector>
+ ****************************************************************************************/
+#include <cassert>
+#include <iostream>
+#include <vector>
+#include "Schedule.hpp"
+#include "Profile.hpp"
+#include "AvailabilityManager.hpp"
+#include "MatchSuggester.hpp"
+#include "SyntheticRoster.hpp"
+
+using namespace sb;
+
+int main() {
+    {
+        // Test 1: identical slot lists intern to one schedule; it leaves the pool when unused
+        SchedulePool pool;
+        std::vector<AvailabilitySlot> v = {{Day::Mon, 600, 660}, {Day::Wed, 540, 600}};
+        ScheduleRef a = pool.intern(v);
+        ScheduleRef b = pool.intern(v);
+        ScheduleRef c = pool.intern({{Day::Mon, 600, 690}});
+        assert(a == b && a != c);
+        assert(a->on(Day::Wed).size() == 1 && a->on(Day::Tue).empty());
+        assert(pool.intern({}) == Schedule::emptySchedule());
+
+        auto st = pool.stats();
+        assert(st.live == 2 && st.requests == 3 && st.hits == 1 && st.liveSlots == 3);
+        a.reset(); b.reset();
+        assert(pool.stats().live == 1);
+        ScheduleRef again = pool.intern(v); // rebuilt after being released
+        assert(again->slots().size() == 2 && pool.stats().live == 2);
+    }
+
+    {
+        // Test 2: profiles share schedules; editing one copies on write and re-interns
+        Profile x, y;
+        x.createOrReset("X", "x@clemson.edu", {"CPSC 2150"});
+        y.createOrReset("Y", "y@clemson.edu", {"CPSC 2150"});
+        AvailabilityManager::addMerged(x, {Day::Tue, 600, 700});
+        AvailabilityManager::addMerged(y, {Day::Tue, 600, 700});
+        assert(x.schedule() == y.schedule());
+
+        AvailabilityManager::addMerged(y, {Day::Thu, 600, 700});
+        assert(x.schedule() != y.schedule());
+        assert(x.availability().size() == 1 && y.availability().size() == 2);
+
+        // Uncommitted edits are visible to reads but do not touch the shared schedule.
+        const Schedule* before = x.schedule().get();
+        x.availabilityMutable().push_back({Day::Thu, 600, 700});
+        assert(!x.availabilityCommitted() && x.availability().size() == 2);
+        assert(x.schedule().get() == before && before->slots().size() == 1);
+        x.commitAvailability();
+        assert(x.schedule() == y.schedule());
+    }
+
+    {
+        // Test 3: section rosters dedupe; memoized suggestions equal unshared results
+        auto shared = makeSyntheticRoster(2000, 5, 20);
+        std::vector<const Schedule*> distinct;
+        for (const auto& p : shared) {
+            bool seen = false;
+            for (auto* s : distinct) if (s == p.schedule().get()) { seen = true; break; }
+            if (!seen) distinct.push_back(p.schedule().get());
+        }
+        assert(distinct.size() <= 20);
+
+        // Same roster with schedules copied into unshared (uncommitted) form.
+        std::vector<Profile> unshared = shared;
+        for (auto& p : unshared) p.availabilityMutable();
+        MatchSuggester m;
+        auto r1 = m.suggest(shared[0], shared, 30, 50);
+        auto r2 = m.suggest(unshared[0], unshared, 30, 50);
+        assert(r1.size() == r2.size());
+        for (std::size_t i = 0; i < r1.size(); ++i) {
+            assert(r1[i].person->email() == r2[i].person->email());
+            assert(r1[i].overlapMinutes == r2[i].overlapMinutes);
+        }
+    }
+
+    std::cout << "[test_schedule] All tests passed.\n";
+    return 0;
+}
@@ -0,0 +1,380 @@
+/***************************************************************************************
+ * test_server.cpp
+ * Tests for the wire protocol, StudyBuddyService dispatch and the epoll socket server.
+ *
+ * STANDARD LIBRARIES USED:
+ *  <cassert>, <chrono>, <cstdio>, <fstream>, <iostream>, <set>, <string>, <thread>,
+ *  <vector>
+ ****************************************************************************************/
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <cstring>
+#include <iostream>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "EpollServer.hpp"
+#include "Protocol.hpp"
+#include "StudyBuddyService.hpp"
+#include "StringPool.hpp"
+
+using namespace sb;
+
+// Strip the length prefix and return the response reader positioned after [status][tag].
+static wire::Status call(StudyBuddyService& svc, std::vector<std::uint8_t> frame,
+                         std::vector<std::uint8_t>& respBody) {
+    auto resp = svc.handle(frame.data() + 4, frame.size() - 4);
+    respBody.assign(resp.begin() + 4, resp.end());
+    return static_cast<wire::Status>(respBody[0]);
+}
+
+static std::vector<std::uint8_t> addProfile(const std::string& name, const std::string& email,
+                                            std::vector<std::string> courses) {
+    wire::Writer w;
+    w.u8(static_cast<std::uint8_t>(wire::Op::AddProfile)); w.u32(1);
+    w.str(name); w.str(email);
+    w.u16(static_cast<std::uint16_t>(courses.size()));
+    for (auto& c : courses) w.str(c);
+    return w.finishFrame();
+}
+
+static std::vector<std::uint8_t> addSlot(const std::string& email, Day d, int s, int e) {
+    wire::Writer w;
+    w.u8(static_cast<std::uint8_t>(wire::Op::AddAvailability)); w.u32(2);
+    w.str(email); w.u8(static_cast<std::uint8_t>(d)); w.i32(s); w.i32(e);
+    return w.finishFrame();
+}
+
+int main() {
+    {
+        // Test 1: writer/reader round trip and frame detection
+        wire::Writer w;
+        w.u8(7); w.u16(513); w.u32(70000); w.i32(-5); w.str("CPSC 2150");
+        auto frame = w.finishFrame();
+        std::uint32_t len = 0; bool bad = false;
+        assert(!wire::peekFrame(frame.data(), frame.size() - 1, len, bad) && !bad);
+        assert(wire::peekFrame(frame.data(), frame.size(), len, bad));
+        assert(len == frame.size() - 4);
+
+        wire::Reader r(frame.data() + 4, len);
+        assert(r.u8() == 7 && r.u16() == 513 && r.u32() == 70000 && r.i32() == -5);
+        assert(r.str() == "CPSC 2150" && r.atEnd() && r.ok());
+        r.u8(); // read past end
+        assert(!r.ok());
+    }
+
+    StudyBuddyService svc;
+    std::vector<std::uint8_t> body;
+    {
+        // Test 2: service builds a roster and suggests partners
+        assert(call(svc, addProfile("Me", "me@clemson.edu", {"cpsc 2150"}), body) == wire::Status::Ok);
+        assert(call(svc, addProfile("Alice", "alice@clemson.edu", {"CPSC 2150"}), body) == wire::Status::Ok);
+        assert(call(svc, addSlot("me@clemson.edu", Day::Mon, 600, 720), body) == wire::Status::Ok);
+        assert(call(svc, addSlot("alice@clemson.edu", Day::Mon, 660, 780), body) == wire::Status::Ok);
+        assert(call(svc, addSlot("ghost@clemson.edu", Day::Mon, 660, 780), body) == wire::Status::NotFound);
+        assert(call(svc, addSlot("me@clemson.edu", Day::Mon, 700, 650), body) == wire::Status::BadRequest);
+
+        wire::Writer w;
+        w.u8(static_cast<std::uint8_t>(wire::Op::Suggest)); w.u32(42);
+        w.str("me@clemson.edu"); w.i32(30); w.u16(5);
+        assert(call(svc, w.finishFrame(), body) == wire::Status::Ok);
+        wire::Reader r(body.data(), body.size());
+        r.u8();
+        assert(r.u32() == 42);
+        assert(r.u16() == 1);
+        assert(r.str() == "alice@clemson.edu");
+        r.str();
+        assert(r.i32() == 60);
+    }
+
+    {
+        // Test 3: request → pending → confirm → notifications
+        wire::Writer w;
+        w.u8(static_cast<std::uint8_t>(wire::Op::SendRequest)); w.u32(3);
+        w.str("me@clemson.edu"); w.str("alice@clemson.edu"); w.str("cpsc 2150");
+        w.u8(0); w.i32(660); w.i32(720);
+        assert(call(svc, w.finishFrame(), body) == wire::Status::Ok);
+        wire::Reader r(body.data() + 5, body.size() - 5);
+        std::string id = r.str();
+        assert(!id.empty());
+
+        wire::Writer c;
+        c.u8(static_cast<std::uint8_t>(wire::Op::ConfirmRequest)); c.u32(4);
+        c.str("me@clemson.edu"); c.str(id); // wrong party
+        assert(call(svc, c.finishFrame(), body) == wire::Status::Rejected);
+        c.u8(static_cast<std::uint8_t>(wire::Op::ConfirmRequest)); c.u32(5);
+        c.str("alice@clemson.edu"); c.str(id);
+        assert(call(svc, c.finishFrame(), body) == wire::Status::Ok);
+
+        wire::Writer f;
+        f.u8(static_cast<std::uint8_t>(wire::Op::FetchNotifications)); f.u32(6);
+        f.str("me@clemson.edu");
+        assert(call(svc, f.finishFrame(), body) == wire::Status::Ok);
+        wire::Reader fr(body.data() + 5, body.size() - 5);
+        assert(fr.u16() == 1);
+
+        // A repeat of a pending request answers with its id; a flood is throttled
+        auto send = [&](std::int32_t start) {
+            wire::Writer s;
+            s.u8(static_cast<std::uint8_t>(wire::Op::SendRequest)); s.u32(8);
+            s.str("me@clemson.edu"); s.str("alice@clemson.edu"); s.str("CPSC 2150");
+            s.u8(1); s.i32(start); s.i32(start + 30);
+            return call(svc, s.finishFrame(), body);
+        };
+        assert(send(600) == wire::Status::Ok);
+        std::string pendingId = wire::Reader(body.data() + 5, body.size() - 5).str();
+        assert(send(615) == wire::Status::Ok);
+        assert(wire::Reader(body.data() + 5, body.size() - 5).str() == pendingId);
+        wire::Status st = wire::Status::Ok;
+        for (std::int32_t start = 0; start < 24 * 60 && st == wire::Status::Ok; start += 30) st = send(start);
+        assert(st == wire::Status::Throttled);
+        assert(wire::Reader(body.data() + 5, body.size() - 5).u8() ==
+               static_cast<std::uint8_t>(SessionRequests::Admission::RequesterThrottled));
+    }
+
+    {
+        // Test 4: course/name completions follow AddProfile (including re-adds)
+        assert(call(svc, addProfile("Bob", "bob@clemson.edu", {"CPSC 2120", "CPSC 2150"}), body) == wire::Status::Ok);
+        auto complete = [&](std::uint8_t kind, const std::string& prefix) {
+            wire::Writer w;
+            w.u8(static_cast<std::uint8_t>(wire::Op::Complete)); w.u32(7);
+            w.u8(kind); w.str(prefix); w.u16(5);
+            return w.finishFrame();
+        };
+        assert(call(svc, complete(0, "cpsc 21"), body) == wire::Status::Ok);
+        wire::Reader r(body.data() + 5, body.size() - 5);
+        assert(r.u16() == 2);
+        assert(r.str() == "CPSC 2150" && r.u32() == 3);
+        assert(r.str() == "CPSC 2120" && r.u32() == 1);
+
+        assert(call(svc, addProfile("Bob", "bob@clemson.edu", {"MATH 2060"}), body) == wire::Status::Ok);
+        assert(call(svc, complete(0, "CPSC 212"), body) == wire::Status::Ok);
+        wire::Reader r2(body.data() + 5, body.size() - 5);
+        assert(r2.u16() == 0);
+
+        assert(call(svc, complete(1, "al"), body) == wire::Status::Ok);
+        wire::Reader r3(body.data() + 5, body.size() - 5);
+        assert(r3.u16() == 1 && r3.str() == "Alice");
+        assert(call(svc, complete(2, "al"), body) == wire::Status::BadRequest);
+    }
+
+    {
+        // Test 5: "who is free" follows AddAvailability
+        auto freeIn = [&](int start, int end, std::uint8_t partial) {
+            wire::Writer w;
+            w.u8(static_cast<std::uint8_t>(wire::Op::FreeIn)); w.u32(8);
+            w.str("alice@clemson.edu"); w.str("cpsc 2150"); w.u8(0); w.i32(start); w.i32(end); w.u8(partial);
+            return w.finishFrame();
+        };
+        assert(call(svc, freeIn(600, 700, 0), body) == wire::Status::Ok);
+        wire::Reader r(body.data() + 5, body.size() - 5);
+        assert(r.u16() == 1 && r.str() == "me@clemson.edu");
+        assert(call(svc, freeIn(700, 760, 0), body) == wire::Status::Ok);
+        assert(body.size() == 7 && body[5] == 0 && body[6] == 0); // nobody for the whole window
+        assert(call(svc, addSlot("me@clemson.edu", Day::Mon, 720, 780), body) == wire::Status::Ok);
+        assert(call(svc, freeIn(700, 760, 0), body) == wire::Status::Ok);
+        wire::Reader r2(body.data() + 5, body.size() - 5);
+        assert(r2.u16() == 1);
+        assert(call(svc, freeIn(700, 650, 1), body) == wire::Status::BadRequest);
+    }
+
+    {
+        // Test 6: next common window skips the confirmed Mon 11:00-12:00 session
+        auto nextCommon = [&](std::vector<std::string> emails, int from, int duration) {
+            wire::Writer w;
+            w.u8(static_cast<std::uint8_t>(wire::Op::NextCommon)); w.u32(9);
+            w.u8(static_cast<std::uint8_t>(emails.size()));
+            for (const auto& e : emails) w.str(e);
+            w.u8(0); w.i32(from); w.i32(duration);
+            return w.finishFrame();
+        };
+        assert(call(svc, nextCommon({"me@clemson.edu", "alice@clemson.edu"}, 0, 30), body) == wire::Status::Ok);
+        wire::Reader r(body.data() + 5, body.size() - 5);
+        assert(r.u8() == 1 && r.u8() == 0 && r.i32() == 720 && r.i32() == 750 && r.u8() == 0);
+        assert(call(svc, nextCommon({"me@clemson.edu", "alice@clemson.edu"}, 760, 30), body) == wire::Status::Ok);
+        wire::Reader r2(body.data() + 5, body.size() - 5);
+        assert(r2.u8() == 1 && r2.u8() == 0 && r2.i32() == 720 && r2.i32() == 750 && r2.u8() == 1); // next week
+        assert(call(svc, nextCommon({"me@clemson.edu", "alice@clemson.edu"}, 0, 61), body) == wire::Status::Ok);
+        assert(body[5] == 0);
+        assert(call(svc, nextCommon({"me@clemson.edu", "ghost@clemson.edu"}, 0, 30), body) == wire::Status::NotFound);
+        assert(call(svc, nextCommon({}, 0, 30), body) == wire::Status::BadRequest);
+        assert(call(svc, nextCommon({"me@clemson.edu"}, 0, 0), body) == wire::Status::BadRequest);
+    }
+
+    {
+        // Test 7: background snapshot into the configured dir; its outcome stays queryable by id
+        auto snapshot = [&](const std::string& name) {
+            wire::Writer w;
+            w.u8(static_cast<std::uint8_t>(wire::Op::Snapshot)); w.u32(10);
+            w.str(name);
+            return call(svc, w.finishFrame(), body);
+        };
+        auto status = [&](std::uint32_t id) {
+            wire::Writer s;
+            s.u8(static_cast<std::uint8_t>(wire::Op::SnapshotStatus)); s.u32(11);
+            s.u32(id);
+            return call(svc, s.finishFrame(), body);
+        };
+        std::string name = "sb_test_server_" + std::to_string(::getpid()) + ".snap";
+        assert(snapshot(name) == wire::Status::Rejected); // no directory configured
+        svc.setSnapshotDir("/tmp/");
+
+        assert(snapshot(name) == wire::Status::Ok);
+        std::uint32_t id = wire::Reader(body.data() + 5, body.size() - 5).u32();
+        assert(id == 1);
+        for (;;) {
+            assert(status(id) == wire::Status::Ok);
+            wire::Reader sr(body.data() + 5, body.size() - 5);
+            if (sr.u8() == 1) { // running
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+                continue;
+            }
+            assert(sr.u8() == 1 && sr.str() == name && sr.str().empty());
+            break;
+        }
+        // Asking again (or from another client) gives the same answer
+        assert(status(id) == wire::Status::Ok && body[5] == 0 && body[6] == 1);
+        assert(status(id + 1) == wire::Status::NotFound);
+        assert(status(0) == wire::Status::BadRequest);
+
+        std::ifstream in("/tmp/" + name);
+        std::string first;
+        std::getline(in, first);
+        assert(first == "studybuddy-snapshot 1");
+        std::remove(("/tmp/" + name).c_str());
+
+        // Only plain names inside the snapshot dir
+        for (const char* bad : {"", "  ", "../etc/passwd", "/tmp/x.snap", "a/b", ".hidden", "..", "sp ace"}) {
+            assert(snapshot(bad) == wire::Status::BadRequest);
+        }
+        assert(snapshot(std::string(65, 'a')) == wire::Status::BadRequest);
+    }
+
+    {
+        // Test 8: client text is capped, and replaceable text never reaches the global pool
+        auto before = StringPool::global().stats().strings;
+        for (int i = 0; i < 200; ++i) {
+            std::string course = "PHYS " + std::to_string(1000 + i);
+            assert(call(svc, addProfile("Name " + std::to_string(i), "me@clemson.edu", {"cpsc 2150", course}), body) ==
+                   wire::Status::Ok);
+            wire::Writer w;
+            w.u8(static_cast<std::uint8_t>(wire::Op::SendRequest)); w.u32(13);
+            w.str("alice@clemson.edu"); w.str("me@clemson.edu"); w.str("X" + std::to_string(i));
+            w.u8(3); w.i32(600); w.i32(630);
+            call(svc, w.finishFrame(), body); // admitted or throttled: either way nothing is interned
+        }
+        assert(StringPool::global().stats().strings == before);
+
+        assert(call(svc, addProfile(std::string(65, 'n'), "n@clemson.edu", {}), body) == wire::Status::BadRequest);
+        assert(call(svc, addProfile("N", std::string(250, 'e') + "@x.edu", {}), body) == wire::Status::BadRequest);
+        assert(call(svc, addProfile("N", "n@clemson.edu", {std::string(16, 'C')}), body) == wire::Status::BadRequest);
+        assert(call(svc, addProfile("N", "n@clemson.edu", std::vector<std::string>(17, "CPSC 2150")), body) ==
+               wire::Status::BadRequest);
+        wire::Writer w;
+        w.u8(static_cast<std::uint8_t>(wire::Op::SendRequest)); w.u32(14);
+        w.str("me@clemson.edu"); w.str("alice@clemson.edu"); w.str(std::string(16, 'C'));
+        w.u8(3); w.i32(600); w.i32(630);
+        assert(call(svc, w.finishFrame(), body) == wire::Status::BadRequest);
+        assert(call(svc, addProfile("Me", "me@clemson.edu", {"cpsc 2150"}), body) == wire::Status::Ok);
+    }
+
+    {
+        // Test 9: end-to-end over the Unix socket (one light + one worker-pool request)
+        std::string path = "/tmp/sb_test_server_" + std::to_string(::getpid()) + ".sock";
+        EpollServer server(svc, path, 2);
+        std::string err;
+        assert(server.start(err));
+        std::thread loop([&]{ server.run(); });
+
+        int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+        assert(::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0);
+
+        wire::Writer w;
+        w.u8(static_cast<std::uint8_t>(wire::Op::Suggest)); w.u32(100);
+        w.str("me@clemson.edu"); w.i32(30); w.u16(5);
+        auto req = w.finishFrame();
+        w.u8(static_cast<std::uint8_t>(wire::Op::Ping)); w.u32(101);
+        auto ping = w.finishFrame();
+        req.insert(req.end(), ping.begin(), ping.end()); // pipelined in one write
+        assert(::write(fd, req.data(), req.size()) == static_cast<ssize_t>(req.size()));
+
+        // Two responses, in either order.
+        std::vector<std::uint8_t> got;
+        std::uint8_t buf[4096];
+        std::uint32_t len = 0; bool bad = false;
+        int frames = 0;
+        std::vector<std::uint32_t> tags;
+        while (frames < 2) {
+            ssize_t n = ::read(fd, buf, sizeof(buf));
+            assert(n > 0);
+            got.insert(got.end(), buf, buf + n);
+            while (wire::peekFrame(got.data(), got.size(), len, bad)) {
+                wire::Reader r(got.data() + 4, len);
+                assert(static_cast<wire::Status>(r.u8()) == wire::Status::Ok);
+                tags.push_back(r.u32());
+                got.erase(got.begin(), got.begin() + 4 + len);
+                ++frames;
+            }
+        }
+        assert((tags[0] == 100 && tags[1] == 101) || (tags[0] == 101 && tags[1] == 100));
+        ::close(fd);
+
+        // Test 10: far more pipelined heavy requests than one client may have in flight
+        // (and more bytes than one wakeup reads) are all answered, held-back ones later
+        fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        assert(::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0);
+        const std::uint32_t kHeavy = 400;
+        req.clear();
+        for (std::uint32_t t = 0; t < kHeavy; ++t) {
+            w.u8(static_cast<std::uint8_t>(t % 2 ? wire::Op::SearchByName : wire::Op::Suggest)); w.u32(t);
+            if (t % 2) { w.str("me@clemson.edu"); w.str(std::string(1400, 'x')); }
+            else { w.str("me@clemson.edu"); w.i32(30); w.u16(5); }
+            auto f = w.finishFrame();
+            req.insert(req.end(), f.begin(), f.end());
+        }
+        w.u8(static_cast<std::uint8_t>(wire::Op::Ping)); w.u32(kHeavy);
+        ping = w.finishFrame();
+        req.insert(req.end(), ping.begin(), ping.end());
+        assert(req.size() > (256u << 10));
+        std::thread writer([&] {
+            for (std::size_t off = 0; off < req.size();) {
+                ssize_t n = ::write(fd, req.data() + off, req.size() - off);
+                assert(n > 0);
+                off += static_cast<std::size_t>(n);
+            }
+        });
+        std::set<std::uint32_t> seen;
+        got.clear();
+        while (seen.size() < kHeavy + 1) {
+            ssize_t n = ::read(fd, buf, sizeof(buf));
+            assert(n > 0);
+            got.insert(got.end(), buf, buf + n);
+            while (wire::peekFrame(got.data(), got.size(), len, bad)) {
+                wire::Reader r(got.data() + 4, len);
+                r.u8();
+                assert(seen.insert(r.u32()).second);
+                got.erase(got.begin(), got.begin() + 4 + len);
+            }
+        }
+        writer.join();
+        assert(*seen.rbegin() == kHeavy);
+        ::close(fd);
+
+        server.stop();
+        loop.join();
+    }
+
+    std::cout << "[test_server] All tests passed.\n";
+    return 0;
+}
@@ -1,11 +1,14 @@
 /***************************************************************************************
  * test_session_requests.cpp
- * Tests for sending & confirming study session requests (with notifications).
+ * Tests for sending & confirming study session requests (with notifications) and for
+ * admission control (coalescing, token buckets, pending queue bound).
  *
  * STANDARD LIBRARIES USED:
  *  <cassert>, <iostream>, <vector>, <string>
  ****************************************************************************************/
+#include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <iostream>
 #include "SessionRequests.hpp"
 #include "CourseManager.hpp"
@@ -61,6 +64,139 @@ int main() {
         assert(cm1.size() == 1 && cm2.size() == 1);
     }
 
+    {
+        // Test 4: reference queries match the copying ones without copying sessions
+        sr.sendRequest(bo, al, "CPSC 2150", Day::Tue, 9*60, 10*60);
+        auto refs = sr.pendingRefs(al);
+        auto copies = sr.pendingFor(al);
+        assert(refs.size() == 1 && copies.size() == 1);
+        assert(refs[0]->id == copies[0].id && refs[0]->requester == "bob@clemson.edu");
+        assert(refs[0] == sr.pendingRefs(al)[0]); // same stored object
+
+        auto conf = sr.confirmedRefs(me);
+        assert(conf.size() == 1 && conf[0]->status == StudySession::Status::Confirmed);
+    }
+
+    {
+        // Test 5: duplicates coalesce; buckets refuse bursts and refill over time
+        using Admission = SessionRequests::Admission;
+        using std::chrono::minutes;
+        NotificationCenter inbox;
+        SessionRequests rq(&inbox);
+        SessionRequests::AdmissionPolicy policy;
+        policy.requesterPerHour = 6;  // one every 10 minutes
+        policy.requesterBurst = 2;
+        policy.inviteePerHour = 0;    // off
+        policy.maxPendingPerInvitee = 0;
+        rq.setAdmissionPolicy(policy);
+        auto t0 = SessionRequests::Clock::time_point{} + std::chrono::hours(1000);
+
+        auto a = rq.trySendRequest(me, al, "cpsc 2150", Day::Mon, 600, 660, t0);
+        assert(a.admission == Admission::Admitted && a.session);
+        auto dup = rq.trySendRequest(me, al, "CPSC 2150 ", Day::Mon, 630, 700, t0);
+        assert(dup.admission == Admission::Coalesced && dup.session == a.session);
+        assert(rq.pendingRefs(al).size() == 1 && inbox.peek("alice@clemson.edu").size() == 1);
+
+        assert(rq.trySendRequest(me, al, "CPSC 2150", Day::Mon, 700, 760, t0).admission == Admission::Admitted);
+        auto refused = rq.trySendRequest(me, bo, "CPSC 2150", Day::Mon, 600, 660, t0);
+        assert(refused.admission == Admission::RequesterThrottled && !refused.session);
+        assert(rq.pendingRefs(bo).empty() && inbox.peek("bob@clemson.edu").empty());
+        assert(rq.trySendRequest(me, bo, "CPSC 2150", Day::Mon, 600, 660, t0 + minutes(9)).admission ==
+               Admission::RequesterThrottled);
+        assert(rq.trySendRequest(me, bo, "CPSC 2150", Day::Mon, 600, 660, t0 + minutes(10)).admission ==
+               Admission::Admitted);
+        assert(rq.trySendRequest(al, bo, "CPSC 2150", Day::Mon, 600, 660, t0).admission ==
+               Admission::Admitted); // buckets are per requester
+
+        // Invitee bucket
+        policy.requesterPerHour = 0;
+        policy.inviteePerHour = 1;
+        policy.inviteeBurst = 1;
+        rq.setAdmissionPolicy(policy);
+        Profile zed = makeProfile("Zed", "zed@clemson.edu", {"CPSC 2150"});
+        assert(rq.trySendRequest(me, zed, "CPSC 2150", Day::Fri, 600, 660, t0).admission == Admission::Admitted);
+        assert(rq.trySendRequest(al, zed, "CPSC 2150", Day::Fri, 600, 660, t0).admission ==
+               Admission::InviteeThrottled);
+    }
+
+    {
+        // Test 6: bounded pending queue; confirming frees a slot; pending index survives cancels
+        using Admission = SessionRequests::Admission;
+        NotificationCenter inbox;
+        SessionRequests rq(&inbox);
+        SessionRequests::AdmissionPolicy policy;
+        policy.maxPendingPerInvitee = 2;
+        rq.setAdmissionPolicy(policy);
+
+        auto s1 = rq.trySendRequest(me, al, "CPSC 2150", Day::Mon, 600, 660);
+        auto s2 = rq.trySendRequest(bo, al, "CPSC 2150", Day::Mon, 600, 660);
+        assert(s1.admission == Admission::Admitted && s2.admission == Admission::Admitted);
+        std::string id1 = s1.session->id, id2 = s2.session->id;
+        assert(rq.trySendRequest(me, al, "CPSC 2150", Day::Tue, 600, 660).admission ==
+               Admission::InviteeQueueFull);
+        assert(rq.trySendRequest(me, al, "CPSC 2150", Day::Mon, 610, 620).admission ==
+               Admission::Coalesced); // duplicates still resolve when full
+
+        assert(rq.confirmRequest(id1, al));
+        auto s3 = rq.trySendRequest(me, al, "CPSC 2150", Day::Tue, 600, 660);
+        assert(s3.admission == Admission::Admitted);
+        std::string id3 = s3.session->id;
+        assert(rq.cancelConfirmed(id1, me)); // shifts later sessions down one slot
+        auto pending = rq.pendingRefs(al);
+        assert(pending.size() == 2 && pending[0]->id == id2 && pending[1]->id == id3);
+        assert(rq.confirmRequest(id3, al) && rq.pendingRefs(al).size() == 1);
+    }
+
+    {
+        // Test 7: id and pending indexes stay exact through hundreds of cancels
+        std::vector<Profile> people;
+        for (int i = 0; i < 12; ++i) {
+            people.push_back(makeProfile("P" + std::to_string(i), "p" + std::to_string(i) + "@clemson.edu", {"CPSC 2150"}));
+        }
+        SessionRequests rq(nullptr);
+        std::vector<std::string> confirmed, pending;
+        for (int i = 0; i < 600; ++i) {
+            std::size_t a = i % people.size(), b = (i * 7 + 1) % people.size();
+            if (a == b) b = (b + 1) % people.size();
+            std::string id = rq.sendRequest(people[a], people[b], "CPSC 2150", Day::Mon, 600, 660).id;
+            if (i % 3 == 2) {
+                pending.push_back(id);
+            } else {
+                assert(rq.confirmRequest(id, people[b]));
+                confirmed.push_back(id);
+            }
+        }
+        auto check = [&] {
+            for (const auto* list : {&confirmed, &pending}) {
+                for (const auto& id : *list) {
+                    const StudySession* s = rq.findById(id);
+                    assert(s && s->id == id);
+                }
+            }
+            std::size_t seen = 0;
+            for (const auto& p : people) {
+                for (const StudySession* s : rq.pendingRefs(p)) {
+                    assert(s->status == StudySession::Status::Pending && s->invitee == p.email());
+                    assert(std::find(pending.begin(), pending.end(), s->id) != pending.end());
+                    ++seen;
+                }
+            }
+            assert(seen == pending.size());
+        };
+        // Cancel in a scattered order so erasures land all over the id map
+        for (std::size_t k = 0; !confirmed.empty(); ++k) {
+            std::size_t pick = (k * 37) % confirmed.size();
+            const StudySession* s = rq.findById(confirmed[pick]);
+            assert(s);
+            const Profile& by = *std::find_if(people.begin(), people.end(),
+                                              [&](const Profile& p) { return p.email() == s->requester; });
+            assert(rq.cancelConfirmed(confirmed[pick], by));
+            confirmed.erase(confirmed.begin() + static_cast<std::ptrdiff_t>(pick));
+            check();
+        }
+        assert(rq.size() == pending.size());
+    }
+
     std::cout << "[test_session_requests] All tests passed.\n";
     return 0;
 }
\ No newline at end of file
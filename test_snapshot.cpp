@@ -0,0 +1,149 @@
+/***************************************************************************************
+ * test_snapshot.cpp
+ * Tests for the snapshot format (Snapshot.hpp) and forked background snapshots
+ * (BackgroundSnapshot.hpp): frozen state, completion/error reports, concurrency bound,
+ * no inherited descriptors held open by the child.
+ *
+ * STANDARD LIBRARIES USED:
+ *  <cassert>, <chrono>, <cstdio>, <fstream>, <iostream>, <sstream>, <string>, <thread>,
+ *  <vector>
+ ****************************************************************************************/
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "AvailabilityManager.hpp"
+#include "BackgroundSnapshot.hpp"
+#include "NotificationCenter.hpp"
+#include "SessionRequests.hpp"
+#include "Snapshot.hpp"
+
+using namespace sb;
+
+static Profile student(const std::string& name, std::vector<std::string> courses) {
+    Profile p;
+    p.createOrReset(name, name + "@clemson.edu", courses);
+    return p;
+}
+
+static std::string slurp(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    std::ostringstream os;
+    os << in.rdbuf();
+    return os.str();
+}
+
+static bool exists(const std::string& path) { return std::ifstream(path).good(); }
+
+int main() {
+    const std::string dir = "/tmp/sb_test_snapshot_" + std::to_string(::getpid());
+    const std::string file = dir + ".snap";
+
+    std::vector<Profile> roster = {student("Ann", {"CPSC 2150", "MATH 1080"}), student("Bob\tB", {"CPSC 2150"})};
+    AvailabilityManager::addMerged(roster[0], {Day::Tue, 600, 660});
+    NotificationCenter nc;
+    SessionRequests sessions(&nc);
+    std::string id = sessions.sendRequest(roster[0], roster[1], "CPSC 2150", Day::Tue, 600, 660).id;
+    assert(sessions.confirmRequest(id, roster[1]));
+    sessions.sendRequest(roster[1], roster[0], "MATH 1080", Day::Wed, 540, 600);
+
+    std::ostringstream inline_;
+    assert(writeSnapshot(inline_, roster, sessions));
+    {
+        // Test 1: format
+        const std::string& s = inline_.str();
+        assert(s.rfind("studybuddy-snapshot 1\nprofiles 2\n", 0) == 0);
+        assert(s.find("P\tAnn\tAnn@clemson.edu\tCPSC 2150,MATH 1080\t1:600-660\n") != std::string::npos);
+        assert(s.find("P\tBob B\t") != std::string::npos); // separators never leak into fields
+        assert(s.find("sessions 2\n") != std::string::npos);
+        assert(s.find("\tCPSC 2150\t1\t600\t660\tAnn@clemson.edu\tBob B@clemson.edu\tconfirmed\n") != std::string::npos);
+        assert(s.find("\tpending\n") != std::string::npos);
+        assert(s.size() >= 4 && s.compare(s.size() - 4, 4, "end\n") == 0);
+    }
+
+    auto writer = [&](std::chrono::milliseconds delay) {
+        return [&, delay](std::ostream& os, std::string&) {
+            std::this_thread::sleep_for(delay);
+            return writeSnapshot(os, roster, sessions);
+        };
+    };
+    {
+        // Test 2: the child writes the state as of start(); the parent keeps going
+        BackgroundSnapshots snaps(1);
+        auto st = snaps.start(file, writer(std::chrono::milliseconds(200)));
+        assert(st.status == BackgroundSnapshots::Start::Started && st.id == 1 && st.pauseUs > 0);
+        sessions.sendRequest(roster[0], roster[1], "CPSC 2150", Day::Fri, 600, 660); // after the fork
+        assert(snaps.running() == 1);
+        assert(snaps.start(file, writer(std::chrono::milliseconds(0))).status ==
+               BackgroundSnapshots::Start::Busy); // bounded
+        assert(snaps.poll().empty());
+
+        auto done = snaps.wait();
+        assert(done.size() == 1 && done[0].id == 1 && done[0].ok && done[0].error.empty());
+        assert(done[0].path == file && done[0].writeMs >= 150);
+        std::string written = slurp(file);
+        assert(written == inline_.str() && done[0].bytes == written.size());
+        assert(!exists(file + ".tmp") && snaps.running() == 0);
+    }
+    {
+        // Test 3: failures come back as results; no partial files are left behind
+        BackgroundSnapshots snaps(2);
+        auto a = snaps.start(dir + "/missing/dir.snap", writer(std::chrono::milliseconds(0)));
+        auto b = snaps.start(file + "2", [](std::ostream& os, std::string& err) {
+            os << "partial";
+            err = "disk on fire";
+            return false;
+        });
+        assert(a.status == BackgroundSnapshots::Start::Started && b.status == BackgroundSnapshots::Start::Started);
+        auto done = snaps.wait();
+        assert(done.size() == 2);
+        for (const auto& r : done) {
+            assert(!r.ok);
+            if (r.id == a.id) assert(r.error.find("cannot open") != std::string::npos);
+            else assert(r.error == "disk on fire");
+        }
+        assert(!exists(file + "2") && !exists(file + "2.tmp"));
+
+        // Finished children are reaped by the next start() and reported by poll()
+        assert(snaps.start(file, writer(std::chrono::milliseconds(0))).status == BackgroundSnapshots::Start::Started);
+        while (snaps.running()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            auto r = snaps.poll();
+            if (!r.empty()) {
+                assert(r.size() == 1 && r[0].ok);
+                break;
+            }
+        }
+    }
+    {
+        // Test 4: the child does not keep the parent's descriptors open; a socket the
+        // parent closes during a snapshot reaches EOF at once
+        int sv[2];
+        assert(::socketpair(AF_UNIX, SOCK_STREAM, 0, sv) == 0); // no CLOEXEC either
+        BackgroundSnapshots snaps(1);
+        assert(snaps.start(file, writer(std::chrono::milliseconds(300))).status == BackgroundSnapshots::Start::Started);
+        ::close(sv[0]);
+        pollfd pfd{sv[1], POLLIN, 0};
+        assert(::poll(&pfd, 1, 100) == 1);
+        char c;
+        assert(::read(sv[1], &c, 1) == 0);
+        assert(snaps.running() == 1); // still writing
+        ::close(sv[1]);
+        auto done = snaps.wait();
+        assert(done.size() == 1 && done[0].ok);
+    }
+    std::remove(file.c_str());
+
+    std::cout << "[test_snapshot] All tests passed.\n";
+    return 0;
+}
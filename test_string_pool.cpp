@@ -0,0 +1,97 @@
+/***************************************************************************************
+ * test_string_pool.cpp
+ * Tests for the interned string arena and its use by Profile/sessions/notifications.
+ * Only emails go to the global pool; replaceable text (names, course codes) does not.
+ *
+ * STANDARD LIBRARIES USED:
+ *  <cassert>, <iostream>, <string>, <thread>, <vector>
+ ****************************************************************************************/
+#include <cassert>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "StringPool.hpp"
+#include "Profile.hpp"
+#include "SessionRequests.hpp"
+#include "NotificationCenter.hpp"
+
+using namespace sb;
+
+int main() {
+    {
+        // Test 1: equal strings intern to the same bytes; views survive the source
+        StringPool pool;
+        std::string a = "alice@clemson.edu";
+        std::string_view v1 = pool.intern(a);
+        a.assign("overwritten");
+        std::string_view v2 = pool.intern(std::string("alice@clemson.edu"));
+        assert(v1 == "alice@clemson.edu" && v1.data() == v2.data());
+        assert(pool.intern("").empty());
+
+        auto st = pool.stats();
+        assert(st.strings == 1 && st.bytes == v1.size() && st.requests == 2);
+    }
+
+    {
+        // Test 2: many strings spill across blocks and oversized ones get their own block
+        StringPool pool;
+        std::vector<std::string_view> views;
+        for (int i = 0; i < 10000; ++i) views.push_back(pool.intern("user" + std::to_string(i) + "@clemson.edu"));
+        std::string big(StringPool::kBlockSize, 'x');
+        std::string_view vb = pool.intern(big);
+        for (int i = 0; i < 10000; ++i) assert(views[i] == "user" + std::to_string(i) + "@clemson.edu");
+        assert(vb.size() == big.size() && pool.stats().arenaBytes > StringPool::kBlockSize * 2);
+    }
+
+    {
+        // Test 3: concurrent interning of the same keys yields one copy
+        StringPool pool;
+        std::vector<std::thread> ts;
+        std::vector<const char*> seen(4);
+        for (int t = 0; t < 4; ++t) {
+            ts.emplace_back([&, t] {
+                for (int i = 0; i < 2000; ++i) pool.intern("k" + std::to_string(i));
+                seen[t] = pool.intern("k7").data();
+            });
+        }
+        for (auto& th : ts) th.join();
+        assert(pool.stats().strings == 2000);
+        for (auto* p : seen) assert(p == seen[0]);
+    }
+
+    {
+        // Test 4: profiles, sessions and inbox keys share the pooled identity bytes
+        Profile me, al;
+        me.createOrReset("Me", "me@clemson.edu", {"CPSC 2150"});
+        al.createOrReset("Alice", "alice@clemson.edu", {"CPSC 2150"});
+        Profile copy;
+        copy.createOrReset("Alice", "alice@clemson.edu", {});
+        assert(copy.email().data() == al.email().data());
+
+        NotificationCenter nc;
+        SessionRequests sr(&nc);
+        const auto& s = sr.sendRequest(me, al, "cpsc 2150", Day::Mon, 600, 660);
+        assert(s.invitee.data() == al.email().data());
+        assert(s.requester.data() == me.email().data());
+        assert(nc.peek(std::string("alice@clemson.edu")).size() == 1);
+    }
+
+    {
+        // Test 5: renames and arbitrary course codes leave the global pool alone
+        Profile me, al;
+        me.createOrReset("Me", "me@clemson.edu", {"CPSC 2150"});
+        al.createOrReset("Alice", "alice@clemson.edu", {"CPSC 2150"});
+        SessionRequests sr(nullptr);
+        std::size_t before = StringPool::global().stats().strings;
+        for (int i = 0; i < 100; ++i) {
+            me.createOrReset("Me #" + std::to_string(i), "me@clemson.edu", {"CPSC 2150"});
+            sr.sendRequest(me, al, "ZZZ " + std::to_string(i), Day::Tue, 600, 660);
+        }
+        assert(StringPool::global().stats().strings == before);
+        assert(me.name() == "Me #99" && sr.size() == 100);
+    }
+
+    std::cout << "[test_string_pool] All tests passed.\n";
+    return 0;
+}
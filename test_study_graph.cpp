@@ -0,0 +1,161 @@
+/***************************************************************************************
+ * test_study_graph.cpp
+ * Tests for StudyGraph (session weights, ChangeLog wiring, 2-hop suggestions, delta
+ * compaction) and its use as a MatchSuggester tie-break.
+ *
+ * STANDARD LIBRARIES USED:
+ *  <cassert>, <iostream>, <map>, <random>, <string>, <vector>
+ ****************************************************************************************/
+#include <cassert>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "AvailabilityManager.hpp"
+#include "ChangeLog.hpp"
+#include "MatchSuggester.hpp"
+#include "NotificationCenter.hpp"
+#include "SessionRequests.hpp"
+#include "StudyGraph.hpp"
+
+using namespace sb;
+
+static Profile student(const std::string& name, std::vector<std::string> courses) {
+    Profile p;
+    p.createOrReset(name, name + "@clemson.edu", courses);
+    return p;
+}
+
+static std::string key(int i) { return "s" + std::to_string(i) + "@clemson.edu"; }
+
+int main() {
+    {
+        // Test 1: weights are symmetric, accumulate, and never go negative
+        StudyGraph g;
+        g.addSessions("a", "b");
+        g.addSessions("b", "a", 2);
+        g.addSessions("a", "c");
+        g.addSessions("a", "a"); // ignored
+        assert(g.sessionsBetween("a", "b") == 3 && g.sessionsBetween("b", "a") == 3);
+        assert(g.sessionsBetween("a", "c") == 1 && g.sessionsBetween("b", "c") == 0);
+        assert(g.sessionsBetween("a", "nobody") == 0);
+        g.addSessions("a", "c", -5);
+        assert(g.sessionsBetween("a", "c") == 0);
+
+        auto partners = g.partnersOf("a");
+        assert(partners.size() == 1 && partners[0].student == "b" && partners[0].sessions == 3);
+        assert(g.partnersOf("nobody").empty());
+    }
+    {
+        // Test 2: 2-hop ranking (score DESC, via DESC, key ASC); self and partners excluded
+        StudyGraph g;
+        g.addSessions("me", "p1", 2);
+        g.addSessions("me", "p2", 1);
+        g.addSessions("p1", "x", 1);   // x: 2*1 + 1*3 = 5, via 2
+        g.addSessions("p2", "x", 3);
+        g.addSessions("p1", "y", 2);   // y: 2*2 = 4, via 1
+        g.addSessions("p2", "z", 4);   // z: 1*4 = 4, via 1
+        g.addSessions("p2", "w", 4);   // w: 1*4 = 4, via 1
+        g.addSessions("p1", "p2", 7);  // p2 is already a partner
+
+        auto s = g.suggest("me", 10);
+        assert(s.size() == 4);
+        assert(s[0].student == "x" && s[0].score == 5 && s[0].via == 2);
+        assert(s[1].student == "w" && s[1].score == 4);
+        assert(s[2].student == "y" && s[3].student == "z");
+        assert(g.suggest("me", 2).size() == 2);
+        assert(g.suggest("nobody", 5).empty() && g.suggest("me", 0).empty());
+
+        assert(g.mutualScore("me", "x") == 5 && g.mutualScore("x", "me") == 5);
+        assert(g.mutualScore("me", "p2") == 2 * 7); // through p1
+        assert(g.mutualScore("me", "me") == 0 && g.mutualScore("me", "nobody") == 0);
+    }
+    {
+        // Test 3: follows confirmed and cancelled sessions through a ChangeLog
+        ChangeLog log;
+        StudyGraph g;
+        g.watch(log);
+        NotificationCenter nc;
+        SessionRequests sr(&nc, &log);
+        Profile me = student("me", {"CPSC 2150"});
+        Profile amy = student("amy", {"CPSC 2150"});
+
+        const StudySession& s1 = sr.sendRequest(me, amy, "CPSC 2150", Day::Mon, 600, 660);
+        std::string id1 = s1.id;
+        assert(g.sessionsBetween("me@clemson.edu", "amy@clemson.edu") == 0); // pending only
+        assert(sr.confirmRequest(id1, amy));
+        std::string id2 = sr.sendRequest(amy, me, "CPSC 2150", Day::Tue, 600, 660).id;
+        assert(sr.confirmRequest(id2, me));
+        assert(g.sessionsBetween("me@clemson.edu", "amy@clemson.edu") == 2);
+        assert(sr.cancelConfirmed(id1, me));
+        assert(g.sessionsBetween("amy@clemson.edu", "me@clemson.edu") == 1);
+    }
+    {
+        // Test 4: many edits (with compactions) agree with a brute-force adjacency map
+        StudyGraph g;
+        std::map<std::pair<int, int>, int> brute;
+        std::mt19937 rng(47);
+        const int n = 200;
+        for (int step = 0; step < 20000; ++step) {
+            int a = static_cast<int>(rng() % n), b = static_cast<int>(rng() % n);
+            if (a == b) continue;
+            int& w = brute[{std::min(a, b), std::max(a, b)}];
+            if (rng() % 4 == 0) {
+                g.addSessions(key(a), key(b), -1);
+                if (w > 0) --w;
+            } else {
+                g.addSessions(key(a), key(b), 1);
+                ++w;
+            }
+        }
+        auto weight = [&](int a, int b) {
+            auto it = brute.find({std::min(a, b), std::max(a, b)});
+            return it == brute.end() ? 0 : it->second;
+        };
+        for (int a = 0; a < n; ++a) {
+            for (int b = 0; b < n; ++b) {
+                if (a != b) assert(g.sessionsBetween(key(a), key(b)) == static_cast<std::uint32_t>(weight(a, b)));
+            }
+        }
+        for (int u = 0; u < n; u += 37) {
+            std::uint64_t best = 0;
+            for (int v = 0; v < n; ++v) {
+                if (v == u || weight(u, v) > 0) continue;
+                std::uint64_t score = 0;
+                for (int m = 0; m < n; ++m) score += static_cast<std::uint64_t>(weight(u, m)) * weight(m, v);
+                assert(g.mutualScore(key(u), key(v)) == score);
+                best = std::max(best, score);
+            }
+            auto top = g.suggest(key(u), 1);
+            assert(best == 0 ? top.empty() : top[0].score == best);
+        }
+    }
+    {
+        // Test 5: MatchSuggester ranks equal overlap by 2-hop score
+        auto withSlot = [](Profile p) {
+            AvailabilityManager::addMerged(p, {Day::Mon, 600, 720});
+            return p;
+        };
+        std::vector<Profile> all = {
+            withSlot(student("me", {"CPSC 2150"})),
+            withSlot(student("Amy", {"CPSC 2150"})),
+            withSlot(student("Zed", {"CPSC 2150"})),
+        };
+        MatchSuggester ms;
+        auto plain = ms.suggest(all[0], all, 30, 5);
+        assert(plain.size() == 2 && plain[0].person->name() == "Amy" && plain[0].social == 0);
+
+        StudyGraph g;
+        g.addSessions("me@clemson.edu", "pal@clemson.edu", 2);
+        g.addSessions("pal@clemson.edu", "Zed@clemson.edu", 3);
+        ms.useStudyGraph(&g);
+        auto ranked = ms.suggest(all[0], all, 30, 5);
+        assert(ranked.size() == 2 && ranked[0].person->name() == "Zed" && ranked[0].social == 6);
+        assert(ranked[1].social == 0);
+    }
+
+    std::cout << "[test_study_graph] All tests passed.\n";
+    return 0;
+}
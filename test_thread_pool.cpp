@@ -0,0 +1,107 @@
+/***************************************************************************************
+ * test_thread_pool.cpp
+ * Tests for the work-stealing ThreadPool and the parallel paths of the core modules.
+ *
+ * STANDARD LIBRARIES USED:
+ *  <cassert>, <iostream>, <vector>, <atomic>, <stdexcept>
+ ****************************************************************************************/
+#include <atomic>
+#include <cassert>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+#include "ThreadPool.hpp"
+#include "MatchSuggester.hpp"
+#include "ClassmateSearch.hpp"
+#include "AvailabilityBrowser.hpp"
+#include "SyntheticRoster.hpp"
+
+using namespace sb;
+
+int main() {
+    ThreadPool pool(4);
+
+    {
+        // Test 1: parallel_for visits every index exactly once
+        std::vector<int> hits(10007, 0);
+        pool.parallel_for(0, hits.size(), 0, [&](std::size_t lo, std::size_t hi) {
+            for (std::size_t i = lo; i < hi; ++i) ++hits[i];
+        });
+        for (int h : hits) assert(h == 1);
+    }
+
+    {
+        // Test 2: parallel_reduce combines in index order (non-commutative concat)
+        auto v = pool.parallel_reduce(0, 1000, 7, std::vector<int>{},
+            [](std::size_t lo, std::size_t hi) {
+                std::vector<int> part;
+                for (std::size_t i = lo; i < hi; ++i) part.push_back(static_cast<int>(i));
+                return part;
+            },
+            [](std::vector<int> a, std::vector<int> b) {
+                a.insert(a.end(), b.begin(), b.end());
+                return a;
+            });
+        assert(v.size() == 1000);
+        for (int i = 0; i < 1000; ++i) assert(v[i] == i);
+    }
+
+    {
+        // Test 3: nested parallel_for from inside a task does not deadlock
+        std::atomic<int> total{0};
+        pool.parallel_for(0, 8, 1, [&](std::size_t, std::size_t) {
+            pool.parallel_for(0, 100, 10, [&](std::size_t lo, std::size_t hi) {
+                total += static_cast<int>(hi - lo);
+            });
+        });
+        assert(total == 800);
+    }
+
+    {
+        // Test 4: the first exception thrown by a chunk reaches the caller
+        bool thrown = false;
+        try {
+            pool.parallel_for(0, 100, 1, [](std::size_t lo, std::size_t) {
+                if (lo == 57) throw std::runtime_error("boom");
+            });
+        } catch (const std::runtime_error&) { thrown = true; }
+        assert(thrown);
+    }
+
+    {
+        // Test 5: module results are identical below and above the parallel threshold
+        ThreadPool::useAsShared(&pool);
+        setParallelThreshold(1u << 30); // force sequential
+        auto roster = makeSyntheticRoster(3000);
+        const Profile& me = roster[0];
+        auto seqMatches = MatchSuggester().suggest(me, roster, 30, 50);
+        auto seqNames   = ClassmateSearch::byName(roster, me, "student 1");
+        auto seqDay     = AvailabilityBrowser::browseByCourseAndDay(roster, me, me.courses()[0], Day::Tue);
+
+        setParallelThreshold(1); // force parallel
+        auto parMatches = MatchSuggester().suggest(me, roster, 30, 50);
+        auto parNames   = ClassmateSearch::byName(roster, me, "student 1");
+        auto parDay     = AvailabilityBrowser::browseByCourseAndDay(roster, me, me.courses()[0], Day::Tue);
+        auto parRoster  = makeSyntheticRoster(3000);
+
+        assert(seqMatches.size() == parMatches.size());
+        for (std::size_t i = 0; i < seqMatches.size(); ++i) {
+            assert(seqMatches[i].person == parMatches[i].person);
+            assert(seqMatches[i].overlapMinutes == parMatches[i].overlapMinutes);
+        }
+        assert(seqNames == parNames);
+        assert(seqDay.size() == parDay.size());
+        for (std::size_t i = 0; i < seqDay.size(); ++i) assert(seqDay[i].first == parDay[i].first);
+        for (std::size_t i = 0; i < roster.size(); ++i) {
+            assert(roster[i].email() == parRoster[i].email());
+            assert(roster[i].courses() == parRoster[i].courses());
+            assert(roster[i].availability().size() == parRoster[i].availability().size());
+        }
+
+        setParallelThreshold(2048);
+        ThreadPool::useAsShared(nullptr);
+    }
+
+    std::cout << "[test_thread_pool] All tests passed.\n";
+    return 0;
+}
@@ -0,0 +1,119 @@
+/***************************************************************************************
+ * test_trace.cpp
+ * Tests for trace spans, sampling, per-thread rings and Chrome trace JSON output.
+ *
+ * STANDARD LIBRARIES USED:
+ *  <cassert>, <cstdio>, <fstream>, <iostream>, <sstream>, <string>, <thread>
+ ****************************************************************************************/
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "MatchSuggester.hpp"
+#include "SyntheticRoster.hpp"
+#include "ThreadPool.hpp"
+#include "Trace.hpp"
+
+using namespace sb;
+
+static std::size_t countOf(const std::string& hay, const std::string& needle) {
+    std::size_t n = 0;
+    for (std::size_t pos = hay.find(needle); pos != std::string::npos; pos = hay.find(needle, pos + 1)) ++n;
+    return n;
+}
+
+static std::string chromeJson() {
+    std::ostringstream os;
+    Tracer::writeChromeJson(os);
+    return os.str();
+}
+
+int main() {
+    {
+        // Test 1: off by default; spans are inert
+        Tracer::clear();
+        {
+            TraceSpan s("idle");
+            assert(!s.active());
+            s.arg("x", 1);
+        }
+        assert(Tracer::stats().events == 0);
+    }
+
+    Tracer::enable(true);
+
+    {
+        // Test 2: nested spans with args become complete events
+        Tracer::clear();
+        {
+            TraceSpan outer("outer", "test");
+            assert(outer.active());
+            TraceSpan inner("inner", "test");
+            inner.arg("items", 42);
+        }
+        auto st = Tracer::stats();
+        assert(st.events == 2 && st.threads >= 1 && st.dropped == 0);
+        std::string json = chromeJson();
+        assert(json.rfind("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", 0) == 0);
+        assert(json.find("\"name\":\"outer\",\"cat\":\"test\",\"ph\":\"X\"") != std::string::npos);
+        assert(json.find("\"args\":{\"items\":42}") != std::string::npos);
+        assert(json.find("outer") < json.find("inner")); // sorted by start time
+    }
+
+    {
+        // Test 3: sampling is decided per root span; children follow their root
+        Tracer::clear();
+        Tracer::setSampleEvery(3);
+        for (int i = 0; i < 9; ++i) {
+            TraceSpan root("root");
+            TraceSpan child("child");
+            assert(child.active() == root.active());
+        }
+        Tracer::setSampleEvery(1);
+        std::string json = chromeJson();
+        assert(countOf(json, "\"name\":\"root\"") == 3 && countOf(json, "\"name\":\"child\"") == 3);
+    }
+
+    {
+        // Test 4: the ring keeps the newest kRingCapacity events of a thread
+        Tracer::clear();
+        std::thread t([] {
+            for (std::size_t i = 0; i < Tracer::kRingCapacity + 100; ++i) TraceSpan s("spin");
+        });
+        t.join(); // buffer outlives the thread
+        auto st = Tracer::stats();
+        assert(st.events == Tracer::kRingCapacity && st.dropped == 100);
+    }
+
+    {
+        // Test 5: suggest emits its phases, including chunks run on pool workers
+        Tracer::clear();
+        auto roster = makeSyntheticRoster(3000);
+        setParallelThreshold(256);
+        MatchSuggester m;
+        m.suggest(roster[0], roster);
+        setParallelThreshold(2048);
+        std::string json = chromeJson();
+        assert(countOf(json, "\"name\":\"suggest\"") == 1);
+        assert(countOf(json, "\"name\":\"suggest.score\"") >= 2);
+        assert(countOf(json, "\"name\":\"suggest.sort\"") == 1);
+        assert(json.find("\"courses_ns\":") != std::string::npos);
+
+        const std::string path = "/tmp/sb_test_trace.json";
+        std::string err;
+        assert(Tracer::flushToFile(path, err));
+        std::ifstream in(path);
+        std::stringstream ss;
+        ss << in.rdbuf();
+        assert(ss.str() == json);
+        std::remove(path.c_str());
+    }
+
+    Tracer::enable(false);
+    std::cout << "[test_trace] All tests passed.\n";
+    return 0;
+}
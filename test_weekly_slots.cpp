@@ -0,0 +1,120 @@
+/***************************************************************************************
+ * test_weekly_slots.cpp
+ * Tests for WeeklySlots (per-day ordered interval sets) and AvailabilityManager's
+ * silent range removal and batch edits built on it.
+ *
+ * STANDARD LIBRARIES USED:
+ *  <algorithm>, <cassert>, <iostream>, <random>, <vector>
+ ****************************************************************************************/
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "AvailabilityManager.hpp"
+#include "Profile.hpp"
+#include "WeeklySlots.hpp"
+
+using namespace sb;
+using Edit = AvailabilityEdit;
+
+static bool sameSlots(const std::vector<AvailabilitySlot>& a, const std::vector<AvailabilitySlot>& b) {
+    if (a.size() != b.size()) return false;
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        if (a[i].day != b[i].day || a[i].start != b[i].start || a[i].end != b[i].end) return false;
+    }
+    return true;
+}
+
+// Reference model: one free flag per minute of the week, flattened into merged runs.
+struct MinuteModel {
+    std::vector<char> free = std::vector<char>(7 * 1440, 0);
+    void set(const AvailabilitySlot& s, char v) {
+        for (int m = s.start; m < s.end; ++m) free[static_cast<int>(s.day) * 1440 + m] = v;
+    }
+    std::vector<AvailabilitySlot> runs() const {
+        std::vector<AvailabilitySlot> out;
+        for (int d = 0; d < 7; ++d) {
+            for (int m = 0; m < 1440; ++m) {
+                if (!free[d * 1440 + m]) continue;
+                int e = m;
+                while (e < 1440 && free[d * 1440 + e]) ++e;
+                out.push_back({static_cast<Day>(d), m, e});
+                m = e;
+            }
+        }
+        return out;
+    }
+};
+
+int main() {
+    {
+        // Test 1: add coalesces overlapping and touching runs; covered adds are no-ops
+        WeeklySlots w;
+        assert(w.add({Day::Mon, 600, 660}));
+        assert(w.add({Day::Mon, 720, 780}));
+        assert(w.add({Day::Mon, 660, 700}));          // touches the first run
+        assert(!w.add({Day::Mon, 610, 650}));         // already free
+        assert(!w.add({Day::Mon, 700, 700}));         // empty
+        assert(sameSlots(w.slots(), {{Day::Mon, 600, 700}, {Day::Mon, 720, 780}}));
+        assert(w.add({Day::Mon, 500, 800}));          // swallows both
+        assert(w.size() == 1 && w.covers(Day::Mon, 500, 800) && !w.covers(Day::Mon, 499, 600));
+
+        // Test 2: remove carves ranges out, splitting at the edges
+        assert(w.remove(Day::Mon, 600, 630));
+        assert(sameSlots(w.slots(), {{Day::Mon, 500, 600}, {Day::Mon, 630, 800}}));
+        assert(!w.remove(Day::Mon, 600, 630) && !w.remove(Day::Tue, 0, 1440));
+        assert(w.remove(Day::Mon, 550, 700));
+        assert(sameSlots(w.slots(), {{Day::Mon, 500, 550}, {Day::Mon, 700, 800}}));
+        assert(w.remove(Day::Mon, 0, 1440) && w.size() == 0);
+    }
+
+    {
+        // Test 3: construction canonicalizes unordered, overlapping input
+        WeeklySlots w({{Day::Wed, 900, 960}, {Day::Mon, 600, 660}, {Day::Wed, 930, 1000}, {Day::Mon, 660, 690}});
+        assert(sameSlots(w.slots(), {{Day::Mon, 600, 690}, {Day::Wed, 900, 1000}}));
+    }
+
+    {
+        // Test 4: randomized edits against a per-minute model
+        std::mt19937 rng(42);
+        WeeklySlots w;
+        MinuteModel model;
+        for (int step = 0; step < 3000; ++step) {
+            AvailabilitySlot s{static_cast<Day>(rng() % 7), static_cast<int>(rng() % 1440), 0};
+            s.end = std::min(1440, s.start + 1 + static_cast<int>(rng() % 180));
+            if (rng() % 3) { w.add(s); model.set(s, 1); }
+            else           { w.remove(s.day, s.start, s.end); model.set(s, 0); }
+            if (step % 100 == 0) assert(sameSlots(w.slots(), model.runs()));
+        }
+        assert(sameSlots(w.slots(), model.runs()));
+    }
+
+    {
+        // Test 5: AvailabilityManager batch edits and range removal commit once
+        Profile p;
+        p.createOrReset("Me", "me@clemson.edu", {"CPSC 2150"});
+        AvailabilityManager::addMerged(p, {Day::Tue, 600, 720});
+        std::vector<Edit> edits = {
+            {Edit::Kind::Add, {Day::Thu, 800, 900}},
+            {Edit::Kind::Add, {Day::Tue, 720, 780}},
+            {Edit::Kind::Remove, {Day::Tue, 650, 660}},
+            {Edit::Kind::Add, {Day::Mon, 60, 120}},
+        };
+        assert(AvailabilityManager::applyBatch(p, edits));
+        assert(p.availabilityCommitted());
+        assert(sameSlots(p.availability(), {{Day::Mon, 60, 120}, {Day::Tue, 600, 650},
+                                            {Day::Tue, 660, 780}, {Day::Thu, 800, 900}}));
+        auto before = p.schedule();
+        assert(!AvailabilityManager::applyBatch(p, {{Edit::Kind::Add, {Day::Tue, 700, 720}}}));
+        assert(p.schedule() == before);
+
+        assert(AvailabilityManager::removeRange(p, Day::Tue, 0, 1440));
+        assert(!AvailabilityManager::removeRange(p, Day::Tue, 0, 1440));
+        assert(sameSlots(p.availability(), {{Day::Mon, 60, 120}, {Day::Thu, 800, 900}}));
+    }
+
+    std::cout << "[test_weekly_slots] All tests passed.\n";
+    return 0;
+}